@@ -1,7 +1,10 @@
 #include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Core/AssetArchive.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileView.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include <string.h>
 
 //-----------------------------------------------------------------------------------------------
 // To disable audio entirely (and remove requirement for fmod.dll / fmod64.dll) for any game,
@@ -79,7 +82,7 @@ void AudioSystem::EndFrame()
 //-----------------------------------------------------------------------------------------------
 SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
 {
-	std::map< std::string, SoundID >::iterator found = m_registeredSoundIDs.find( soundFilePath );
+	auto found = m_registeredSoundIDs.find( HashStringID( soundFilePath ) );
 	if( found != m_registeredSoundIDs.end() )
 	{
 		return found->second;
@@ -87,11 +90,26 @@ SoundID AudioSystem::CreateOrGetSound( const std::string& soundFilePath )
 	else
 	{
 		FMOD::Sound* newSound = nullptr;
-		m_fmodSystem->createSound( soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &newSound );
+		ArchivedFile archivedSound;
+		if( FindArchivedFile( soundFilePath, archivedSound ) )
+		{
+			// stored sounds play straight out of the mapped archive, compressed ones get copied by FMOD
+			FileView soundFile( soundFilePath );
+			FMOD_CREATESOUNDEXINFO soundInfo;
+			memset( &soundInfo, 0, sizeof( soundInfo ) );
+			soundInfo.cbsize = sizeof( soundInfo );
+			soundInfo.length = (unsigned int)soundFile.GetSize();
+			FMOD_MODE soundMode = FMOD_DEFAULT | ( soundFile.IsPersistent() ? FMOD_OPENMEMORY_POINT : FMOD_OPENMEMORY );
+			m_fmodSystem->createSound( soundFile.GetData(), soundMode, &soundInfo, &newSound );
+		}
+		else
+		{
+			m_fmodSystem->createSound( soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &newSound );
+		}
 		if( newSound )
 		{
 			SoundID newSoundID = m_registeredSounds.size();
-			m_registeredSoundIDs[ soundFilePath ] = newSoundID;
+			m_registeredSoundIDs[ InternStringID( soundFilePath ) ] = newSoundID;
 			m_registeredSounds.push_back( newSound );
 			return newSoundID;
 		}
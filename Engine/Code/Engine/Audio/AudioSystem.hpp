@@ -3,9 +3,9 @@
 
 //-----------------------------------------------------------------------------------------------
 #include "ThirdParty/fmod/fmod.hpp"
+#include "Engine/Core/StringID.hpp"
 #include <string>
 #include <vector>
-#include <map>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -42,7 +42,7 @@ public:
 
 protected:
 	FMOD::System*						m_fmodSystem;
-	std::map< std::string, SoundID >	m_registeredSoundIDs;
+	StringIDMap< SoundID >				m_registeredSoundIDs;		// by interned file path
 	std::vector< FMOD::Sound* >			m_registeredSounds;
 };
 
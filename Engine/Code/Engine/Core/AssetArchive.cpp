@@ -0,0 +1,239 @@
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FileView.hpp"
+#include <string.h>
+
+//------------------------------------------------------------------------
+struct MountedAssetArchive
+{
+	std::string m_path;
+	FileView m_file;
+	AssetArchiveHeader const* m_header = nullptr;
+	AssetArchiveEntry const* m_entries = nullptr;
+	char const* m_paths = nullptr;
+};
+
+static std::vector<MountedAssetArchive*> s_mountedArchives;
+
+//------------------------------------------------------------------------
+static bool AreAssetPathsEqual( char const* storedPath, char const* path, size_t pathLength )
+{
+	for( size_t charIndex = 0; charIndex < pathLength; charIndex++ )
+	{
+		if( storedPath[charIndex] == '\0' || NormalizeAssetPathChar( storedPath[charIndex] ) != NormalizeAssetPathChar( path[charIndex] ) )
+		{
+			return false;
+		}
+	}
+	return storedPath[pathLength] == '\0';
+}
+
+// the loaders sometimes build paths like "Data/Definitions/Cutscenes/" + name, or start them with "./"
+static void TrimAssetPath( char const*& path, size_t& pathLength )
+{
+	while( pathLength >= 2 && path[0] == '.' && ( path[1] == '/' || path[1] == '\\' ) )
+	{
+		path += 2;
+		pathLength -= 2;
+	}
+}
+
+//------------------------------------------------------------------------
+static bool ValidateAssetArchive( MountedAssetArchive& archive )
+{
+	size_t archiveSize = archive.m_file.GetSize();
+	char const* archiveData = archive.m_file.GetData();
+	if( archiveSize < sizeof( AssetArchiveHeader ) )
+	{
+		return false;
+	}
+
+	AssetArchiveHeader const* header = reinterpret_cast<AssetArchiveHeader const*>( archiveData );
+	if( header->m_magic != ASSET_ARCHIVE_MAGIC || header->m_version != ASSET_ARCHIVE_VERSION )
+	{
+		return false;
+	}
+	if( header->m_indexOffset % 8 != 0 || header->m_indexOffset + (unsigned long long)header->m_numEntries * sizeof( AssetArchiveEntry ) > archiveSize )
+	{
+		return false;
+	}
+	if( header->m_pathsOffset + header->m_pathsSize > archiveSize || ( header->m_pathsSize > 0 && archiveData[header->m_pathsOffset + header->m_pathsSize - 1] != '\0' ) )
+	{
+		return false;
+	}
+
+	archive.m_header = header;
+	archive.m_entries = reinterpret_cast<AssetArchiveEntry const*>( archiveData + header->m_indexOffset );
+	archive.m_paths = archiveData + header->m_pathsOffset;
+	for( unsigned int entryIndex = 0; entryIndex < header->m_numEntries; entryIndex++ )
+	{
+		AssetArchiveEntry const& entry = archive.m_entries[entryIndex];
+		if( entry.m_dataOffset + entry.m_storedSize > archiveSize || entry.m_pathOffset >= header->m_pathsSize )
+		{
+			return false;
+		}
+		if( entryIndex > 0 && entry.m_pathHash < archive.m_entries[entryIndex - 1].m_pathHash )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static AssetArchiveEntry const* FindAssetArchiveEntry( MountedAssetArchive const& archive, char const* path, size_t pathLength )
+{
+	unsigned long long pathHash = HashAssetPath( path, pathLength );
+
+	// lower bound on the sorted hashes, then rule out collisions by comparing the paths
+	unsigned int first = 0;
+	unsigned int count = archive.m_header->m_numEntries;
+	while( count > 0 )
+	{
+		unsigned int halfCount = count / 2;
+		if( archive.m_entries[first + halfCount].m_pathHash < pathHash )
+		{
+			first += halfCount + 1;
+			count -= halfCount + 1;
+		}
+		else
+		{
+			count = halfCount;
+		}
+	}
+
+	for( unsigned int entryIndex = first; entryIndex < archive.m_header->m_numEntries; entryIndex++ )
+	{
+		AssetArchiveEntry const& entry = archive.m_entries[entryIndex];
+		if( entry.m_pathHash != pathHash )
+		{
+			break;
+		}
+		if( AreAssetPathsEqual( archive.m_paths + entry.m_pathOffset, path, pathLength ) )
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+bool MountAssetArchive( std::string const& archivePath )
+{
+	MountedAssetArchive* archive = new MountedAssetArchive();
+	archive->m_path = archivePath;
+	if( !archive->m_file.OpenLoose( archivePath ) || !ValidateAssetArchive( *archive ) )
+	{
+		delete archive;
+		return false;
+	}
+
+	s_mountedArchives.push_back( archive );
+	return true;
+}
+
+void UnmountAllAssetArchives()
+{
+	for( MountedAssetArchive* archive : s_mountedArchives )
+	{
+		delete archive;
+	}
+	s_mountedArchives.clear();
+}
+
+int GetNumMountedAssetArchives()
+{
+	return (int)s_mountedArchives.size();
+}
+
+bool FindArchivedFile( std::string const& filePath, ArchivedFile& out_file )
+{
+	char const* path = filePath.c_str();
+	size_t pathLength = filePath.size();
+	TrimAssetPath( path, pathLength );
+
+	for( int archiveIndex = (int)s_mountedArchives.size() - 1; archiveIndex >= 0; archiveIndex-- )
+	{
+		MountedAssetArchive const& archive = *s_mountedArchives[archiveIndex];
+		AssetArchiveEntry const* entry = FindAssetArchiveEntry( archive, path, pathLength );
+		if( entry != nullptr )
+		{
+			out_file.m_data = archive.m_file.GetData() + entry->m_dataOffset;
+			out_file.m_storedSize = (size_t)entry->m_storedSize;
+			out_file.m_size = (size_t)entry->m_size;
+			out_file.m_isCompressed = ( entry->m_flags & ASSET_ARCHIVE_ENTRY_LZ4 ) != 0;
+			return true;
+		}
+	}
+	return false;
+}
+
+void AppendArchivedFileNamesInFolder( std::string const& folderPath, char const* filePattern, std::vector<std::string>& out_fileNames )
+{
+	char const* folder = folderPath.c_str();
+	size_t folderLength = folderPath.size();
+	TrimAssetPath( folder, folderLength );
+	while( folderLength > 0 && ( folder[folderLength - 1] == '/' || folder[folderLength - 1] == '\\' ) )
+	{
+		folderLength--;
+	}
+
+	for( MountedAssetArchive const* archive : s_mountedArchives )
+	{
+		for( unsigned int entryIndex = 0; entryIndex < archive->m_header->m_numEntries; entryIndex++ )
+		{
+			char const* path = archive->m_paths + archive->m_entries[entryIndex].m_pathOffset;
+			char const* lastSlash = strrchr( path, '/' );
+			if( lastSlash == nullptr || (size_t)( lastSlash - path ) != folderLength )
+			{
+				continue;
+			}
+
+			bool isSameFolder = true;
+			for( size_t charIndex = 0; charIndex < folderLength && isSameFolder; charIndex++ )
+			{
+				isSameFolder = NormalizeAssetPathChar( path[charIndex] ) == NormalizeAssetPathChar( folder[charIndex] );
+			}
+
+			char const* fileName = lastSlash + 1;
+			if( !isSameFolder || !DoesFileNameMatchPattern( fileName, filePattern ) )
+			{
+				continue;
+			}
+
+			bool isAlreadyListed = false;
+			for( std::string const& listedName : out_fileNames )
+			{
+				isAlreadyListed = isAlreadyListed || AreAssetPathsEqual( fileName, listedName.c_str(), listedName.size() );
+			}
+			if( !isAlreadyListed )
+			{
+				out_fileNames.push_back( fileName );
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+COMMAND( archive_info, "List mounted asset archives with their entry counts and sizes", "" )
+{
+	UNUSED( args );
+	if( s_mountedArchives.empty() )
+	{
+		g_theConsole->PrintString( Rgba8::WHITE, "No asset archives mounted, loading loose files" );
+		return;
+	}
+
+	for( MountedAssetArchive const* archive : s_mountedArchives )
+	{
+		unsigned int numCompressed = 0;
+		unsigned long long totalSize = 0;
+		for( unsigned int entryIndex = 0; entryIndex < archive->m_header->m_numEntries; entryIndex++ )
+		{
+			AssetArchiveEntry const& entry = archive->m_entries[entryIndex];
+			numCompressed += ( entry.m_flags & ASSET_ARCHIVE_ENTRY_LZ4 ) != 0 ? 1 : 0;
+			totalSize += entry.m_size;
+		}
+		g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%s: %u files (%u compressed), %.1f KB packed from %.1f KB",
+			archive->m_path.c_str(), archive->m_header->m_numEntries, numCompressed, archive->m_file.GetSize() / 1024.0, totalSize / 1024.0 ) );
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Packed asset archive, written offline by the AssetPacker tool (Engine/Code/Tools/AssetPacker).
+// Layout: header, entry data (each aligned), entry index sorted by path hash, then the paths.
+// Paths are stored as packed ("Data/Images/foo.png") and looked up case-insensitively.
+//------------------------------------------------------------------------
+constexpr unsigned int ASSET_ARCHIVE_MAGIC = 0x4B504E54;		// "TNPK"
+constexpr unsigned int ASSET_ARCHIVE_VERSION = 1;
+
+enum eAssetArchiveEntryFlags : unsigned int
+{
+	ASSET_ARCHIVE_ENTRY_LZ4 = 1 << 0,
+};
+
+struct AssetArchiveHeader
+{
+	unsigned int m_magic = ASSET_ARCHIVE_MAGIC;
+	unsigned int m_version = ASSET_ARCHIVE_VERSION;
+	unsigned int m_numEntries = 0;
+	unsigned int m_entryAlignment = 0;
+	unsigned long long m_indexOffset = 0;		// AssetArchiveEntry[m_numEntries]
+	unsigned long long m_pathsOffset = 0;		// null terminated paths
+	unsigned long long m_pathsSize = 0;
+};
+
+struct AssetArchiveEntry
+{
+	unsigned long long m_pathHash = 0;
+	unsigned long long m_dataOffset = 0;
+	unsigned long long m_storedSize = 0;		// bytes in the archive
+	unsigned long long m_size = 0;				// bytes once decompressed
+	unsigned int m_pathOffset = 0;				// into the path block
+	unsigned int m_flags = 0;
+};
+
+static_assert( sizeof( AssetArchiveHeader ) == 40, "archive header layout changed" );
+static_assert( sizeof( AssetArchiveEntry ) == 40, "archive entry layout changed" );
+
+//------------------------------------------------------------------------
+// Shared with the packer, which doesn't link the engine
+//------------------------------------------------------------------------
+inline char NormalizeAssetPathChar( char c )
+{
+	c = c == '\\' ? '/' : c;
+	return ( c >= 'A' && c <= 'Z' ) ? (char)( c - 'A' + 'a' ) : c;
+}
+
+// FNV-1a over the path with '\' as '/' and ASCII lowercased, so it matches however the game spells it
+inline unsigned long long HashAssetPath( char const* path, size_t length )
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	for( size_t charIndex = 0; charIndex < length; charIndex++ )
+	{
+		hash ^= (unsigned char)NormalizeAssetPathChar( path[charIndex] );
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// '*' and '?' wildcards, case-insensitive
+inline bool DoesFileNameMatchPattern( char const* fileName, char const* filePattern )
+{
+	if( filePattern == nullptr )
+	{
+		return true;
+	}
+
+	// greedy match, backtracking to the last '*' on a mismatch
+	char const* name = fileName;
+	char const* pattern = filePattern;
+	char const* lastStar = nullptr;
+	char const* lastStarName = nullptr;
+	while( *name != '\0' )
+	{
+		if( *pattern == '*' )
+		{
+			lastStar = pattern++;
+			lastStarName = name;
+		}
+		else if( *pattern == '?' || ( *pattern != '\0' && NormalizeAssetPathChar( *pattern ) == NormalizeAssetPathChar( *name ) ) )
+		{
+			pattern++;
+			name++;
+		}
+		else if( lastStar != nullptr )
+		{
+			pattern = lastStar + 1;
+			name = ++lastStarName;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while( *pattern == '*' )
+	{
+		pattern++;
+	}
+	return *pattern == '\0';
+}
+
+//------------------------------------------------------------------------
+struct ArchivedFile
+{
+	char const* m_data = nullptr;		// points into the mapped archive, valid until it is unmounted
+	size_t m_storedSize = 0;
+	size_t m_size = 0;
+	bool m_isCompressed = false;
+};
+
+//------------------------------------------------------------------------
+// Virtual file layer. FileView (and through it the loaders) checks mounted archives first and
+// falls back to loose files, so development builds run fine with no archive at all.
+// Mount at startup before anything loads; lookups are read-only and safe from any thread.
+//------------------------------------------------------------------------
+bool	MountAssetArchive( std::string const& archivePath );		// false if missing or invalid; later mounts win
+void	UnmountAllAssetArchives();									// after everything holding archive memory (sounds) is gone
+int		GetNumMountedAssetArchives();
+
+bool	FindArchivedFile( std::string const& filePath, ArchivedFile& out_file );
+void	AppendArchivedFileNamesInFolder( std::string const& folderPath, char const* filePattern, std::vector<std::string>& out_fileNames );
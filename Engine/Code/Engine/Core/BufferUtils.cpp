@@ -0,0 +1,176 @@
+#include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include <string.h>
+
+//------------------------------------------------------------------------
+void BufferWriter::AppendBytes( const void* data, size_t size )
+{
+	if( size == 0 )
+	{
+		return;
+	}
+
+	size_t offset = m_buffer.size();
+	m_buffer.resize( offset + size );
+	memcpy( &m_buffer[offset], data, size );
+}
+
+void BufferWriter::AppendByte( unsigned char value )
+{
+	m_buffer.push_back( value );
+}
+
+void BufferWriter::AppendBool( bool value )
+{
+	m_buffer.push_back( value ? 1 : 0 );
+}
+
+void BufferWriter::AppendInt32( int value )
+{
+	AppendBytes( &value, sizeof( value ) );
+}
+
+void BufferWriter::AppendUint32( unsigned int value )
+{
+	AppendBytes( &value, sizeof( value ) );
+}
+
+void BufferWriter::AppendUint64( unsigned long long value )
+{
+	AppendBytes( &value, sizeof( value ) );
+}
+
+void BufferWriter::AppendFloat( float value )
+{
+	AppendBytes( &value, sizeof( value ) );
+}
+
+void BufferWriter::AppendString( const std::string& value )
+{
+	AppendUint32( (unsigned int)value.size() );
+	AppendBytes( value.data(), value.size() );
+}
+
+void BufferWriter::AppendIntVec2( const IntVec2& value )
+{
+	AppendInt32( value.x );
+	AppendInt32( value.y );
+}
+
+void BufferWriter::AppendVec2( const Vec2& value )
+{
+	AppendFloat( value.x );
+	AppendFloat( value.y );
+}
+
+void BufferWriter::AppendAABB2( const AABB2& value )
+{
+	AppendVec2( value.mins );
+	AppendVec2( value.maxs );
+}
+
+void BufferWriter::AppendRgba8( const Rgba8& value )
+{
+	AppendByte( value.r );
+	AppendByte( value.g );
+	AppendByte( value.b );
+	AppendByte( value.a );
+}
+
+//------------------------------------------------------------------------
+BufferParser::BufferParser( const void* data, size_t size )
+	:m_current( static_cast<const unsigned char*>( data ) ),
+	m_end( static_cast<const unsigned char*>( data ) + size )
+{
+}
+
+void BufferParser::ParseBytes( void* out_data, size_t size )
+{
+	GUARANTEE_OR_DIE( size <= GetRemainingSize(), "BufferParser read past the end of its buffer" );
+	if( size > 0 )
+	{
+		memcpy( out_data, m_current, size );
+		m_current += size;
+	}
+}
+
+unsigned char BufferParser::ParseByte()
+{
+	unsigned char value = 0;
+	ParseBytes( &value, sizeof( value ) );
+	return value;
+}
+
+bool BufferParser::ParseBool()
+{
+	return ParseByte() != 0;
+}
+
+int BufferParser::ParseInt32()
+{
+	int value = 0;
+	ParseBytes( &value, sizeof( value ) );
+	return value;
+}
+
+unsigned int BufferParser::ParseUint32()
+{
+	unsigned int value = 0;
+	ParseBytes( &value, sizeof( value ) );
+	return value;
+}
+
+unsigned long long BufferParser::ParseUint64()
+{
+	unsigned long long value = 0;
+	ParseBytes( &value, sizeof( value ) );
+	return value;
+}
+
+float BufferParser::ParseFloat()
+{
+	float value = 0.f;
+	ParseBytes( &value, sizeof( value ) );
+	return value;
+}
+
+std::string BufferParser::ParseString()
+{
+	size_t length = ParseUint32();
+	GUARANTEE_OR_DIE( length <= GetRemainingSize(), "BufferParser read past the end of its buffer" );
+	std::string value( reinterpret_cast<const char*>( m_current ), length );
+	m_current += length;
+	return value;
+}
+
+IntVec2 BufferParser::ParseIntVec2()
+{
+	int x = ParseInt32();
+	int y = ParseInt32();
+	return IntVec2( x, y );
+}
+
+Vec2 BufferParser::ParseVec2()
+{
+	float x = ParseFloat();
+	float y = ParseFloat();
+	return Vec2( x, y );
+}
+
+AABB2 BufferParser::ParseAABB2()
+{
+	Vec2 mins = ParseVec2();
+	Vec2 maxs = ParseVec2();
+	return AABB2( mins, maxs );
+}
+
+Rgba8 BufferParser::ParseRgba8()
+{
+	unsigned char r = ParseByte();
+	unsigned char g = ParseByte();
+	unsigned char b = ParseByte();
+	unsigned char a = ParseByte();
+	return Rgba8( r, g, b, a );
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+struct IntVec2;
+struct Vec2;
+struct AABB2;
+struct Rgba8;
+
+//------------------------------------------------------------------------
+// Appends plain values to a byte buffer in native (little endian) layout, no padding.
+// Strings go in as a 32-bit length and then their bytes.
+//------------------------------------------------------------------------
+class BufferWriter
+{
+public:
+	explicit BufferWriter( std::vector<unsigned char>& buffer ) : m_buffer( buffer ) {}
+
+	void	AppendBytes( const void* data, size_t size );
+	void	AppendByte( unsigned char value );
+	void	AppendBool( bool value );
+	void	AppendInt32( int value );
+	void	AppendUint32( unsigned int value );
+	void	AppendUint64( unsigned long long value );
+	void	AppendFloat( float value );
+	void	AppendString( const std::string& value );
+	void	AppendIntVec2( const IntVec2& value );
+	void	AppendVec2( const Vec2& value );
+	void	AppendAABB2( const AABB2& value );
+	void	AppendRgba8( const Rgba8& value );
+
+	size_t	GetTotalSize() const	{ return m_buffer.size(); }
+
+private:
+	std::vector<unsigned char>& m_buffer;
+};
+
+//------------------------------------------------------------------------
+// Reads back what a BufferWriter wrote, in the same order. Reading past the end dies,
+// whoever hands over the buffer is expected to have checked its size.
+//------------------------------------------------------------------------
+class BufferParser
+{
+public:
+	BufferParser( const void* data, size_t size );
+
+	void				ParseBytes( void* out_data, size_t size );
+	unsigned char		ParseByte();
+	bool				ParseBool();
+	int					ParseInt32();
+	unsigned int		ParseUint32();
+	unsigned long long	ParseUint64();
+	float				ParseFloat();
+	std::string			ParseString();
+	IntVec2				ParseIntVec2();
+	Vec2				ParseVec2();
+	AABB2				ParseAABB2();
+	Rgba8				ParseRgba8();
+
+	bool				IsAtEnd() const			{ return m_current == m_end; }
+	size_t				GetRemainingSize() const	{ return (size_t)( m_end - m_current ); }
+
+private:
+	const unsigned char* m_current = nullptr;
+	const unsigned char* m_end = nullptr;
+};
@@ -1,4 +1,6 @@
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/TimerWheel.hpp"
+#include <algorithm>
 
 Clock* g_masterClock = nullptr;
 
@@ -27,28 +29,31 @@ Clock::Clock( Clock* parentClock )
 
 Clock::~Clock()
 {
-	for( int i = 0; i < (int)m_childClocks.size(); ++i )
+	// children move up to my parent, or become roots without one
+	for( Clock* childClock : m_childClocks )
 	{
+		childClock->m_parentClock = m_parentClock;
 		if( m_parentClock )
 		{
-			m_childClocks[i]->m_parentClock = m_parentClock;
-		}
-		else
-		{
-			m_parentClock = m_childClocks[i];
+			m_parentClock->m_childClocks.push_back( childClock );
 		}
 	}
+	m_childClocks.clear();
 
-	if ( m_parentClock )
+	// erased rather than nulled, Update walks the list without checking
+	if( m_parentClock )
 	{
-		for( int i = 0; i < (int) m_parentClock->m_childClocks.size(); ++i )
-		{
-			if ( this == m_parentClock->m_childClocks[i] )
-			{
-				m_parentClock->m_childClocks[i] = nullptr;
-			}
-		}
+		std::vector<Clock*>& siblingClocks = m_parentClock->m_childClocks;
+		siblingClocks.erase( std::remove( siblingClocks.begin(), siblingClocks.end(), this ), siblingClocks.end() );
+		m_parentClock = nullptr;
 	}
+	if( g_masterClock == this )
+	{
+		g_masterClock = nullptr;
+	}
+
+	delete m_timerWheel;
+	m_timerWheel = nullptr;
 }
 
 void Clock::Update( double dt )
@@ -67,6 +72,11 @@ void Clock::Update( double dt )
 	m_frameTime = dt;
 	m_totalTime += dt;
 
+	if( m_timerWheel )
+	{
+		m_timerWheel->AdvanceTo( m_totalTime );
+	}
+
 	for ( int i = 0; i < (int) m_childClocks.size(); ++i )
 	{
 		m_childClocks[i]->Update( dt );
@@ -76,6 +86,19 @@ void Clock::Update( double dt )
 void Clock::Reset()
 {
 	m_totalTime = 0.0;
+	if( m_timerWheel )
+	{
+		m_timerWheel->AdvanceTo( m_totalTime );
+	}
+}
+
+TimerWheel* Clock::GetTimerWheel()
+{
+	if( m_timerWheel == nullptr )
+	{
+		m_timerWheel = new TimerWheel( m_totalTime );
+	}
+	return m_timerWheel;
 }
 
 Clock* Clock::GetMaster()
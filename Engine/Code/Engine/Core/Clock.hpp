@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
 
+class TimerWheel;
+
 class Clock
 {
 public:
@@ -23,6 +25,9 @@ public:
 	double  GetTotalElapsedSeconds() const { return m_totalTime; }
 	double	GetLastDeltaSeconds() const { return m_lastFrameTime; }
 
+	TimerWheel*	GetTimerWheel();		// created on first use, advanced in Update
+	int			GetNumChildClocks() const { return (int)m_childClocks.size(); }
+
 public:
 	static Clock*	GetMaster();
 	static void		SystemStartup();
@@ -39,4 +44,6 @@ private:
 	Clock* m_parentClock = nullptr;
 	std::vector<Clock*> m_childClocks;
 
+	TimerWheel* m_timerWheel = nullptr;
+
 };
\ No newline at end of file
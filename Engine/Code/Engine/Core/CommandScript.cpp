@@ -0,0 +1,494 @@
+#include "Engine/Core/CommandScript.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/FileView.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <algorithm>
+
+//------------------------------------------------------------------------
+// the value of key=value or key="value with spaces" after the first word of a line
+static bool FindScriptArg( std::string_view line, std::string_view key, std::string_view* out_value )
+{
+	size_t tokenStart = line.find( ' ' );
+	while( tokenStart != std::string_view::npos && tokenStart < line.size() )
+	{
+		tokenStart = line.find_first_not_of( ' ', tokenStart );
+		if( tokenStart == std::string_view::npos )
+		{
+			return false;
+		}
+
+		size_t tokenEnd = line.find( ' ', tokenStart );
+		size_t equalIndex = line.find( '=', tokenStart );
+		if( equalIndex >= tokenEnd )
+		{
+			tokenStart = tokenEnd;
+			continue;
+		}
+
+		size_t valueStart = equalIndex + 1;
+		size_t valueEnd = tokenEnd == std::string_view::npos ? line.size() : tokenEnd;
+		if( valueStart < line.size() && line[valueStart] == '"' )
+		{
+			valueStart++;
+			valueEnd = std::min( line.find( '"', valueStart ), line.size() );
+			tokenEnd = valueEnd < line.size() ? valueEnd + 1 : std::string_view::npos;
+		}
+		if( line.substr( tokenStart, equalIndex - tokenStart ) == key )
+		{
+			*out_value = line.substr( valueStart, valueEnd - valueStart );
+			return true;
+		}
+		tokenStart = tokenEnd;
+	}
+	return false;
+}
+
+static float GetPercentileMilliseconds( std::vector<float> const& sortedMilliseconds, float fraction )
+{
+	if( sortedMilliseconds.empty() )
+	{
+		return 0.f;
+	}
+	size_t index = (size_t)( fraction * (float)( sortedMilliseconds.size() - 1 ) + 0.5f );
+	return sortedMilliseconds[std::min( index, sortedMilliseconds.size() - 1 )];
+}
+
+//------------------------------------------------------------------------
+bool CommandScript::LoadFromFile( std::string const& scriptFilePath )
+{
+	m_scriptFilePath = scriptFilePath;
+	m_steps.clear();
+	m_nextStepIndex = 0;
+	m_openRepeats.clear();
+	m_waitFramesLeft = 0;
+	m_waitSecondsLeft = 0.0;
+	m_numFailedCommands = 0;
+	m_numCommandsRun = 0;
+	m_totalSeconds = 0.0;
+	m_sections.clear();
+	m_sections.emplace_back();
+	m_sections[0].m_name = "script";
+
+	std::string scriptText = FileRend( scriptFilePath );
+	if( scriptText.empty() )
+	{
+		LOG_ERROR( "Script", "Couldn't read %s", scriptFilePath );
+		return false;
+	}
+
+	bool isValid = true;
+	std::vector<int> openBlockIndices;
+	int lineNumber = 0;
+	for( std::string_view line : SplitStringView( scriptText, '\n' ) )
+	{
+		lineNumber++;
+		isValid = ParseLine( TrimStringView( line ), lineNumber, openBlockIndices ) && isValid;
+	}
+	for( int openBlockIndex : openBlockIndices )
+	{
+		LOG_ERROR( "Script", "%s(%i): no matching end", scriptFilePath, m_steps[openBlockIndex].m_lineNumber );
+		isValid = false;
+	}
+
+	if( !isValid )
+	{
+		m_steps.clear();
+		return false;
+	}
+
+	m_sections[0].m_isOpen = true;
+	LOG_INFO( "Script", "Running %s, %i steps", scriptFilePath, (int)m_steps.size() );
+	return true;
+}
+
+bool CommandScript::ParseLine( std::string_view line, int lineNumber, std::vector<int>& openBlockIndices )
+{
+	if( line.empty() || line[0] == '#' )
+	{
+		return true;
+	}
+
+	ScriptStep step;
+	step.m_lineNumber = lineNumber;
+	std::string_view name = *SplitStringView( line, ' ' ).begin();
+	std::string_view value;
+	if( name == "wait" )
+	{
+		float seconds = 0.f;
+		if( FindScriptArg( line, "frames", &value ) && Parse( &step.m_count, value ) )
+		{
+			step.m_type = SCRIPT_STEP_WAIT_FRAMES;
+		}
+		else if( FindScriptArg( line, "seconds", &value ) && Parse( &seconds, value ) )
+		{
+			step.m_type = SCRIPT_STEP_WAIT_SECONDS;
+			step.m_seconds = (double)seconds;
+		}
+		else
+		{
+			LOG_ERROR( "Script", "%s(%i): wait needs frames=N or seconds=S", m_scriptFilePath, lineNumber );
+			return false;
+		}
+	}
+	else if( name == "repeat" )
+	{
+		if( !FindScriptArg( line, "count", &value ) || !Parse( &step.m_count, value ) )
+		{
+			LOG_ERROR( "Script", "%s(%i): repeat needs count=N", m_scriptFilePath, lineNumber );
+			return false;
+		}
+		step.m_type = SCRIPT_STEP_REPEAT;
+		openBlockIndices.push_back( (int)m_steps.size() );
+	}
+	else if( name == "stats_begin" )
+	{
+		step.m_type = SCRIPT_STEP_STATS_BEGIN;
+		step.m_text = FindScriptArg( line, "name", &value ) ? std::string( value ) : Stringf( "line %i", lineNumber );
+		step.m_count = (int)m_sections.size();
+		m_sections.emplace_back();
+		m_sections.back().m_name = step.m_text;
+		openBlockIndices.push_back( (int)m_steps.size() );
+	}
+	else if( name == "end" || name == "stats_end" )
+	{
+		eScriptStepType openType = name == "end" ? SCRIPT_STEP_REPEAT : SCRIPT_STEP_STATS_BEGIN;
+		if( openBlockIndices.empty() || m_steps[openBlockIndices.back()].m_type != openType )
+		{
+			LOG_ERROR( "Script", "%s(%i): %s without a matching %s", m_scriptFilePath, lineNumber, name, openType == SCRIPT_STEP_REPEAT ? "repeat" : "stats_begin" );
+			return false;
+		}
+
+		ScriptStep& openStep = m_steps[openBlockIndices.back()];
+		openBlockIndices.pop_back();
+		step.m_type = openType == SCRIPT_STEP_REPEAT ? SCRIPT_STEP_END_REPEAT : SCRIPT_STEP_STATS_END;
+		step.m_count = openStep.m_count;
+		step.m_matchingStepIndex = (int)( &openStep - m_steps.data() );
+		openStep.m_matchingStepIndex = (int)m_steps.size();
+	}
+	else
+	{
+		step.m_type = SCRIPT_STEP_COMMAND;
+		step.m_text = std::string( line );
+	}
+
+	m_steps.push_back( step );
+	return true;
+}
+
+//------------------------------------------------------------------------
+void CommandScript::Update( double frameSeconds )
+{
+	if( IsFinished() )
+	{
+		return;
+	}
+
+	// the frame that just ended belongs to every section that was open through it
+	if( m_nextStepIndex > 0 )
+	{
+		m_totalSeconds += frameSeconds;
+		for( FrameTimeSection& section : m_sections )
+		{
+			if( section.m_isOpen )
+			{
+				section.m_frameMilliseconds.push_back( (float)( frameSeconds * 1000.0 ) );
+			}
+		}
+	}
+
+	if( m_waitFramesLeft > 0 && --m_waitFramesLeft > 0 )
+	{
+		return;
+	}
+	if( m_waitSecondsLeft > 0.0 )
+	{
+		m_waitSecondsLeft -= frameSeconds;
+		if( m_waitSecondsLeft > 0.0 )
+		{
+			return;
+		}
+	}
+
+	while( !IsFinished() && m_waitFramesLeft == 0 && m_waitSecondsLeft <= 0.0 )
+	{
+		ScriptStep const& step = m_steps[m_nextStepIndex++];
+		RunStep( step );
+	}
+
+	if( IsFinished() )
+	{
+		for( FrameTimeSection& section : m_sections )
+		{
+			section.m_isOpen = false;
+		}
+		LOG_INFO( "Script", "Finished %s: %i commands, %i failed, %.2f s", m_scriptFilePath, m_numCommandsRun, m_numFailedCommands, m_totalSeconds );
+	}
+}
+
+void CommandScript::RunStep( ScriptStep const& step )
+{
+	switch( step.m_type )
+	{
+		case SCRIPT_STEP_COMMAND:
+		{
+			std::string_view name = *SplitStringView( step.m_text, ' ' ).begin();
+			m_numCommandsRun++;
+			if( g_theEventSystem->GetNumSubscribers( HashStringID( name ) ) == 0 )
+			{
+				LOG_ERROR( "Script", "%s(%i): nothing handles \"%s\"", m_scriptFilePath, step.m_lineNumber, name );
+				m_numFailedCommands++;
+				return;
+			}
+			LOG_VERBOSE( "Script", "%s", step.m_text );
+			g_theEventSystem->FireEventWithValue( step.m_text );
+			return;
+		}
+		case SCRIPT_STEP_WAIT_FRAMES:
+		{
+			m_waitFramesLeft = step.m_count > 0 ? step.m_count : 0;
+			return;
+		}
+		case SCRIPT_STEP_WAIT_SECONDS:
+		{
+			m_waitSecondsLeft = step.m_seconds;
+			return;
+		}
+		case SCRIPT_STEP_REPEAT:
+		{
+			if( step.m_count <= 0 )
+			{
+				m_nextStepIndex = step.m_matchingStepIndex + 1;
+				return;
+			}
+			OpenRepeat openRepeat;
+			openRepeat.m_repeatStepIndex = (int)( &step - m_steps.data() );
+			openRepeat.m_numRepeatsLeft = step.m_count - 1;
+			m_openRepeats.push_back( openRepeat );
+			return;
+		}
+		case SCRIPT_STEP_END_REPEAT:
+		{
+			OpenRepeat& openRepeat = m_openRepeats.back();
+			if( openRepeat.m_numRepeatsLeft > 0 )
+			{
+				openRepeat.m_numRepeatsLeft--;
+				m_nextStepIndex = openRepeat.m_repeatStepIndex + 1;
+				return;
+			}
+			m_openRepeats.pop_back();
+			return;
+		}
+		case SCRIPT_STEP_STATS_BEGIN:
+		{
+			m_sections[step.m_count].m_isOpen = true;
+			return;
+		}
+		case SCRIPT_STEP_STATS_END:
+		{
+			m_sections[step.m_count].m_isOpen = false;
+			return;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+bool CommandScript::WriteReport( std::string const& reportFilePath ) const
+{
+	std::string report = Stringf( "Script %s\nCommands run %i, failed %i, total %.3f s\n\n", m_scriptFilePath.c_str(), m_numCommandsRun, m_numFailedCommands, m_totalSeconds );
+	report += Stringf( "%-24s %8s %9s %9s %9s %9s %9s %9s\n", "section", "frames", "avg ms", "min ms", "p50 ms", "p95 ms", "p99 ms", "max ms" );
+
+	std::vector<float> sortedMilliseconds;
+	for( FrameTimeSection const& section : m_sections )
+	{
+		sortedMilliseconds = section.m_frameMilliseconds;
+		std::sort( sortedMilliseconds.begin(), sortedMilliseconds.end() );
+		double totalMilliseconds = 0.0;
+		for( float milliseconds : sortedMilliseconds )
+		{
+			totalMilliseconds += (double)milliseconds;
+		}
+
+		int numFrames = (int)sortedMilliseconds.size();
+		report += Stringf( "%-24s %8i %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n", section.m_name.c_str(), numFrames,
+			numFrames > 0 ? totalMilliseconds / (double)numFrames : 0.0,
+			numFrames > 0 ? sortedMilliseconds.front() : 0.f,
+			GetPercentileMilliseconds( sortedMilliseconds, 0.50f ),
+			GetPercentileMilliseconds( sortedMilliseconds, 0.95f ),
+			GetPercentileMilliseconds( sortedMilliseconds, 0.99f ),
+			numFrames > 0 ? sortedMilliseconds.back() : 0.f );
+	}
+
+	return FileWrite( reportFilePath, report );
+}
+
+//------------------------------------------------------------------------
+static float s_benchmarkParsingSum = 0.f;
+
+// same shape as an exported mesh, positions/uvs/normals then triangles indexing them
+static std::string MakeBenchmarkOBJText( int numVertices )
+{
+	std::string objText;
+	objText.reserve( (size_t)numVertices * 120 );
+	for( int vertIndex = 0; vertIndex < numVertices; vertIndex++ )
+	{
+		float t = (float)vertIndex * 0.001f;
+		objText += Stringf( "v %f %f %f\n", t, -t * 2.f, t * 3.f );
+		objText += Stringf( "vt %f %f\n", t, 1.f - t );
+		objText += Stringf( "vn %f %f %f\n", 0.f, 1.f, -0.f );
+	}
+	for( int faceIndex = 0; faceIndex + 3 <= numVertices; faceIndex += 3 )
+	{
+		objText += Stringf( "f %i/%i/%i %i/%i/%i %i/%i/%i\n", faceIndex + 1, faceIndex + 1, faceIndex + 1,
+			faceIndex + 2, faceIndex + 2, faceIndex + 2, faceIndex + 3, faceIndex + 3, faceIndex + 3 );
+	}
+	return objText;
+}
+
+// how the loader used to read a mesh, a string per line and per token
+static void ParseOBJTextWithStrings( const std::string& objText )
+{
+	Strings lines = SplitStringOnDelimiter( objText, '\n' );
+	for( const std::string& line : lines )
+	{
+		Strings tokens = SplitStringOnDelimiterWithoutEmpty( line, ' ' );
+		if( tokens.empty() )
+		{
+			continue;
+		}
+
+		if( tokens[0] == "f" )
+		{
+			for( size_t tokenIndex = 1; tokenIndex < tokens.size(); tokenIndex++ )
+			{
+				Strings indexes = SplitStringOnDelimiter( tokens[tokenIndex], '/' );
+				for( const std::string& index : indexes )
+				{
+					s_benchmarkParsingSum += (float)atoi( index.c_str() );
+				}
+			}
+		}
+		else
+		{
+			for( size_t tokenIndex = 1; tokenIndex < tokens.size(); tokenIndex++ )
+			{
+				s_benchmarkParsingSum += std::stof( tokens[tokenIndex] );
+			}
+		}
+	}
+}
+
+static void ParseOBJTextWithViews( const std::string& objText )
+{
+	TextLineReader lineReader( objText.data(), objText.size() );
+	TextSpan line;
+	while( lineReader.ReadLine( line ) )
+	{
+		TextTokenReader tokenReader( line );
+		TextSpan keyword;
+		if( !tokenReader.ReadToken( keyword ) )
+		{
+			continue;
+		}
+
+		TextSpan token;
+		bool isFace = keyword.Equals( "f" );
+		while( tokenReader.ReadToken( token ) )
+		{
+			if( isFace )
+			{
+				for( std::string_view index : SplitStringView( token.ToView(), '/' ) )
+				{
+					int value = 0;
+					Parse( &value, index );
+					s_benchmarkParsingSum += (float)value;
+				}
+			}
+			else
+			{
+				s_benchmarkParsingSum += token.ToFloat();
+			}
+		}
+	}
+}
+
+// pulls every key=value out of the line and reads the values the way a command would
+static void ParseCommandWithStrings( const std::string& command )
+{
+	Strings tokens = SplitStringOnDelimiter( command, ' ' );
+	for( size_t tokenIndex = 1; tokenIndex < tokens.size(); tokenIndex++ )
+	{
+		Strings keyValue = SplitStringOnDelimiter( tokens[tokenIndex], '=' );
+		if( keyValue.size() == 2 )
+		{
+			Strings numbers = SplitStringOnDelimiter( keyValue[1], ',' );
+			for( const std::string& number : numbers )
+			{
+				s_benchmarkParsingSum += (float)atof( number.c_str() );
+			}
+		}
+	}
+}
+
+static void ParseCommandWithViews( const std::string& command )
+{
+	bool isName = true;
+	for( std::string_view token : SplitStringView( command, ' ' ) )
+	{
+		size_t equalIndex = token.find( '=' );
+		if( isName || equalIndex == std::string_view::npos )
+		{
+			isName = false;
+			continue;
+		}
+
+		for( std::string_view number : SplitStringView( token.substr( equalIndex + 1 ), ',' ) )
+		{
+			float value = 0.f;
+			Parse( &value, number );
+			s_benchmarkParsingSum += value;
+		}
+	}
+}
+
+template <typename CALLABLE>
+static double TimeParsing( CALLABLE const& work )
+{
+	double startSeconds = GetCurrentTimeSeconds();
+	work();
+	return GetCurrentTimeSeconds() - startSeconds;
+}
+
+COMMAND( benchmark_parsing, "Compare string splitting and stof against string_view and from_chars, on a generated OBJ and on console commands. e.g. benchmark_parsing vertices=200000 commands=200000", "vertices,commands" )
+{
+	int numVertices = args.GetValue( "vertices", 200000 );
+	int numCommands = args.GetValue( "commands", 200000 );
+	s_benchmarkParsingSum = 0.f;
+
+	std::string objText = MakeBenchmarkOBJText( numVertices );
+	double objStringSeconds = TimeParsing( [&objText]() { ParseOBJTextWithStrings( objText ); } );
+	double objViewSeconds = TimeParsing( [&objText]() { ParseOBJTextWithViews( objText ); } );
+	double objMegabytes = (double)objText.size() / ( 1024.0 * 1024.0 );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "obj %.1f MB: strings %8.2f ms (%6.1f MB/s), views %8.2f ms (%6.1f MB/s)",
+		objMegabytes, objStringSeconds * 1000.0, objMegabytes / objStringSeconds, objViewSeconds * 1000.0, objMegabytes / objViewSeconds ) );
+
+	const std::string command = "spawn_actor name=Megumin position=12.5,-3.25,0 color=255,128,64,255 scale=1.5 delay=0.25";
+	double commandStringSeconds = TimeParsing( [&command, numCommands]()
+	{
+		for( int commandIndex = 0; commandIndex < numCommands; commandIndex++ )
+		{
+			ParseCommandWithStrings( command );
+		}
+	} );
+	double commandViewSeconds = TimeParsing( [&command, numCommands]()
+	{
+		for( int commandIndex = 0; commandIndex < numCommands; commandIndex++ )
+		{
+			ParseCommandWithViews( command );
+		}
+	} );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%i commands: strings %8.2f ms (%6.0f ns each), views %8.2f ms (%6.0f ns each)",
+		numCommands, commandStringSeconds * 1000.0, commandStringSeconds * 1.0e9 / numCommands, commandViewSeconds * 1000.0, commandViewSeconds * 1.0e9 / numCommands ) );
+}
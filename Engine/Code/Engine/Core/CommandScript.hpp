@@ -0,0 +1,83 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Runs a text file of console commands for automated and benchmark runs, one command per line:
+//
+//	# comment
+//	enter_map name="First Trial"
+//	wait frames=120				or wait seconds=2.5
+//	repeat count=1000			repeats everything up to the matching end, repeats can nest
+//		restart_map
+//		wait frames=2
+//	end
+//	stats_begin name=restarts	frame times from here to the matching stats_end go in the report
+//	stats_end
+//
+// anything else is fired through EventSystem::FireEventWithValue, so profile_capture or
+// profile_write can save profiler output along the way
+//------------------------------------------------------------------------
+class CommandScript
+{
+public:
+	bool	LoadFromFile( std::string const& scriptFilePath );		// false (and logged) if it can't be read or a line is malformed
+	void	Update( double frameSeconds );						// main thread, once a frame; runs commands until the next wait
+	bool	IsFinished() const				{ return m_nextStepIndex >= (int)m_steps.size(); }
+	int		GetNumFailedCommands() const	{ return m_numFailedCommands; }
+
+	bool	WriteReport( std::string const& reportFilePath ) const;	// frame time stats for the whole run and each section
+
+private:
+	enum eScriptStepType
+	{
+		SCRIPT_STEP_COMMAND,
+		SCRIPT_STEP_WAIT_FRAMES,
+		SCRIPT_STEP_WAIT_SECONDS,
+		SCRIPT_STEP_REPEAT,
+		SCRIPT_STEP_END_REPEAT,
+		SCRIPT_STEP_STATS_BEGIN,
+		SCRIPT_STEP_STATS_END,
+	};
+
+	struct ScriptStep
+	{
+		eScriptStepType	m_type = SCRIPT_STEP_COMMAND;
+		std::string		m_text;							// the command, or the stats section name
+		int				m_lineNumber = 0;
+		int				m_count = 0;					// frames to wait, or times to repeat
+		double			m_seconds = 0.0;
+		int				m_matchingStepIndex = -1;		// repeat <-> end, stats_begin <-> stats_end
+	};
+
+	struct OpenRepeat
+	{
+		int		m_repeatStepIndex = 0;
+		int		m_numRepeatsLeft = 0;
+	};
+
+	struct FrameTimeSection
+	{
+		std::string			m_name;
+		std::vector<float>	m_frameMilliseconds;
+		bool				m_isOpen = false;
+	};
+
+	bool	ParseLine( std::string_view line, int lineNumber, std::vector<int>& openBlockIndices );
+	void	RunStep( ScriptStep const& step );
+
+private:
+	std::string						m_scriptFilePath;
+	std::vector<ScriptStep>			m_steps;
+	int								m_nextStepIndex = 0;
+	std::vector<OpenRepeat>			m_openRepeats;
+
+	int								m_waitFramesLeft = 0;
+	double							m_waitSecondsLeft = 0.0;
+
+	int								m_numFailedCommands = 0;
+	int								m_numCommandsRun = 0;
+	double							m_totalSeconds = 0.0;
+	std::vector<FrameTimeSection>	m_sections;				// [0] is the whole run
+};
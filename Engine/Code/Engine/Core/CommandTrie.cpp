@@ -0,0 +1,93 @@
+#include "Engine/Core/CommandTrie.hpp"
+#include <algorithm>
+
+//------------------------------------------------------------------------
+void CommandTrie::Build( std::vector<std::string> commandNames )
+{
+	std::sort( commandNames.begin(), commandNames.end() );
+	commandNames.erase( std::unique( commandNames.begin(), commandNames.end() ), commandNames.end() );
+	m_sortedNames = commandNames;
+
+	m_nodes.clear();
+	m_nodes.emplace_back();
+	m_nodes[0].m_endNameIndex = (int)m_sortedNames.size();
+
+	for( int nameIndex = 0; nameIndex < (int)m_sortedNames.size(); nameIndex++ )
+	{
+		int nodeIndex = 0;
+		for( char character : m_sortedNames[nameIndex] )
+		{
+			int childIndex = FindChild( nodeIndex, character );
+			if( childIndex < 0 )
+			{
+				childIndex = AddChild( nodeIndex, character, nameIndex );
+			}
+
+			// sorted input, so a node's names always end at the one being added
+			m_nodes[childIndex].m_endNameIndex = nameIndex + 1;
+			nodeIndex = childIndex;
+		}
+		m_nodes[nodeIndex].m_isNameEnd = true;
+	}
+}
+
+void CommandTrie::Clear()
+{
+	m_nodes.clear();
+	m_sortedNames.clear();
+}
+
+//------------------------------------------------------------------------
+void CommandTrie::FindCompletions( std::string_view prefix, std::vector<std::string>& out_completions ) const
+{
+	if( m_nodes.empty() )
+	{
+		return;
+	}
+
+	int nodeIndex = 0;
+	for( char character : prefix )
+	{
+		nodeIndex = FindChild( nodeIndex, character );
+		if( nodeIndex < 0 )
+		{
+			return;
+		}
+	}
+
+	// an exact match sorts ahead of everything it prefixes
+	const CommandTrieNode& node = m_nodes[nodeIndex];
+	int firstNameIndex = node.m_isNameEnd ? node.m_firstNameIndex + 1 : node.m_firstNameIndex;
+	for( int nameIndex = firstNameIndex; nameIndex < node.m_endNameIndex; nameIndex++ )
+	{
+		out_completions.push_back( m_sortedNames[nameIndex] );
+	}
+}
+
+//------------------------------------------------------------------------
+int CommandTrie::FindChild( int nodeIndex, char character ) const
+{
+	for( int childIndex = m_nodes[nodeIndex].m_firstChild; childIndex >= 0; childIndex = m_nodes[childIndex].m_nextSibling )
+	{
+		if( m_nodes[childIndex].m_character == character )
+		{
+			return childIndex;
+		}
+	}
+	return -1;
+}
+
+int CommandTrie::AddChild( int nodeIndex, char character, int nameIndex )
+{
+	int childIndex = (int)m_nodes.size();
+	m_nodes.emplace_back();
+	CommandTrieNode& child = m_nodes.back();
+	child.m_character = character;
+	child.m_firstNameIndex = nameIndex;
+	child.m_endNameIndex = nameIndex + 1;
+
+	// pushed on the front, lookups don't care about sibling order
+	child.m_nextSibling = m_nodes[nodeIndex].m_firstChild;
+	m_nodes[nodeIndex].m_firstChild = childIndex;
+	return childIndex;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Prefix tree over command names for console autocomplete.
+// Names are inserted sorted, so every node's subtree is one contiguous run of m_sortedNames
+// and finding the completions of a prefix is a walk down the prefix, however many commands there are.
+//------------------------------------------------------------------------
+class CommandTrie
+{
+public:
+	void	Build( std::vector<std::string> commandNames );		// replaces whatever was built before, duplicates are dropped
+	void	Clear();
+
+	// appends the names that start with prefix, sorted, leaving out prefix itself
+	void	FindCompletions( std::string_view prefix, std::vector<std::string>& out_completions ) const;
+
+	int		GetNumCommands() const		{ return (int)m_sortedNames.size(); }
+
+private:
+	struct CommandTrieNode
+	{
+		char	m_character = '\0';
+		int		m_firstChild = -1;
+		int		m_nextSibling = -1;
+		int		m_firstNameIndex = 0;	// [first, end) of the names below here
+		int		m_endNameIndex = 0;
+		bool	m_isNameEnd = false;
+	};
+
+	int		FindChild( int nodeIndex, char character ) const;
+	int		AddChild( int nodeIndex, char character, int nameIndex );
+
+private:
+	std::vector<CommandTrieNode>	m_nodes;		// [0] is the root
+	std::vector<std::string>		m_sortedNames;
+};
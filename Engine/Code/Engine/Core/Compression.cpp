@@ -0,0 +1,230 @@
+#include "Engine/Core/Compression.hpp"
+#include <string.h>
+
+static constexpr size_t	LZ4_MIN_MATCH = 4;
+static constexpr size_t	LZ4_LAST_LITERALS = 5;			// the last 5 bytes are always literals
+static constexpr size_t	LZ4_MATCH_SEARCH_LIMIT = 12;	// and no match starts in the last 12
+static constexpr size_t	LZ4_MAX_OFFSET = 65535;
+static constexpr int	LZ4_HASH_BITS = 12;
+
+//------------------------------------------------------------------------
+static unsigned int ReadU32( unsigned char const* bytes )
+{
+	unsigned int value = 0;
+	memcpy( &value, bytes, sizeof( value ) );
+	return value;
+}
+
+static unsigned int HashLZ4Sequence( unsigned int sequence )
+{
+	return ( sequence * 2654435761U ) >> ( 32 - LZ4_HASH_BITS );
+}
+
+// lengths of 15 or more spill into extra bytes of 255 each plus a remainder
+static bool WriteLZ4Length( unsigned char*& out, unsigned char* outEnd, size_t length )
+{
+	while( length >= 255 )
+	{
+		if( out >= outEnd )
+		{
+			return false;
+		}
+		*out++ = 255;
+		length -= 255;
+	}
+	if( out >= outEnd )
+	{
+		return false;
+	}
+	*out++ = (unsigned char)length;
+	return true;
+}
+
+static bool ReadLZ4Length( unsigned char const*& in, unsigned char const* inEnd, size_t& length )
+{
+	unsigned char nextByte = 0;
+	do
+	{
+		if( in >= inEnd )
+		{
+			return false;
+		}
+		nextByte = *in++;
+		length += nextByte;
+	} while( nextByte == 255 );
+	return true;
+}
+
+// matchLength 0 writes the closing literals-only sequence
+static bool WriteLZ4Sequence( unsigned char*& out, unsigned char* outEnd, unsigned char const* literals, size_t numLiterals, size_t offset, size_t matchLength )
+{
+	if( out >= outEnd )
+	{
+		return false;
+	}
+	unsigned char* token = out++;
+
+	size_t literalCode = numLiterals < 15 ? numLiterals : 15;
+	if( numLiterals >= 15 && !WriteLZ4Length( out, outEnd, numLiterals - 15 ) )
+	{
+		return false;
+	}
+	if( (size_t)( outEnd - out ) < numLiterals )
+	{
+		return false;
+	}
+	memcpy( out, literals, numLiterals );
+	out += numLiterals;
+
+	size_t matchCode = 0;
+	if( matchLength > 0 )
+	{
+		if( outEnd - out < 2 )
+		{
+			return false;
+		}
+		*out++ = (unsigned char)( offset & 0xFF );
+		*out++ = (unsigned char)( offset >> 8 );
+
+		size_t extraLength = matchLength - LZ4_MIN_MATCH;
+		matchCode = extraLength < 15 ? extraLength : 15;
+		if( extraLength >= 15 && !WriteLZ4Length( out, outEnd, extraLength - 15 ) )
+		{
+			return false;
+		}
+	}
+
+	*token = (unsigned char)( ( literalCode << 4 ) | matchCode );
+	return true;
+}
+
+//------------------------------------------------------------------------
+size_t GetLZ4CompressBound( size_t sourceSize )
+{
+	return sourceSize + sourceSize / 255 + 16;
+}
+
+size_t CompressLZ4( void const* source, size_t sourceSize, void* destination, size_t destinationCapacity )
+{
+	unsigned char const* sourceBytes = static_cast<unsigned char const*>( source );
+	unsigned char* out = static_cast<unsigned char*>( destination );
+	unsigned char* outEnd = out + destinationCapacity;
+	size_t anchor = 0;
+
+	// greedy single probe hash match, good enough for an offline packer
+	if( sourceSize > LZ4_MATCH_SEARCH_LIMIT )
+	{
+		int hashTable[1 << LZ4_HASH_BITS];
+		for( int hashIndex = 0; hashIndex < ( 1 << LZ4_HASH_BITS ); hashIndex++ )
+		{
+			hashTable[hashIndex] = -1;
+		}
+
+		size_t matchStartLimit = sourceSize - LZ4_MATCH_SEARCH_LIMIT;
+		size_t matchEndLimit = sourceSize - LZ4_LAST_LITERALS;
+		size_t position = 0;
+		while( position < matchStartLimit )
+		{
+			unsigned int sequence = ReadU32( sourceBytes + position );
+			unsigned int hash = HashLZ4Sequence( sequence );
+			int candidate = hashTable[hash];
+			hashTable[hash] = (int)position;
+			if( candidate < 0 || position - (size_t)candidate > LZ4_MAX_OFFSET || ReadU32( sourceBytes + candidate ) != sequence )
+			{
+				position++;
+				continue;
+			}
+
+			size_t matchLength = LZ4_MIN_MATCH;
+			while( position + matchLength < matchEndLimit && sourceBytes[candidate + matchLength] == sourceBytes[position + matchLength] )
+			{
+				matchLength++;
+			}
+
+			if( !WriteLZ4Sequence( out, outEnd, sourceBytes + anchor, position - anchor, position - (size_t)candidate, matchLength ) )
+			{
+				return 0;
+			}
+			position += matchLength;
+			anchor = position;
+		}
+	}
+
+	if( !WriteLZ4Sequence( out, outEnd, sourceBytes + anchor, sourceSize - anchor, 0, 0 ) )
+	{
+		return 0;
+	}
+	return (size_t)( out - static_cast<unsigned char*>( destination ) );
+}
+
+bool DecompressLZ4( void const* source, size_t sourceSize, void* destination, size_t destinationSize )
+{
+	unsigned char const* in = static_cast<unsigned char const*>( source );
+	unsigned char const* inEnd = in + sourceSize;
+	unsigned char* outStart = static_cast<unsigned char*>( destination );
+	unsigned char* out = outStart;
+	unsigned char* outEnd = out + destinationSize;
+
+	while( in < inEnd )
+	{
+		unsigned int token = *in++;
+
+		size_t numLiterals = token >> 4;
+		if( numLiterals == 15 && !ReadLZ4Length( in, inEnd, numLiterals ) )
+		{
+			return false;
+		}
+		if( (size_t)( inEnd - in ) < numLiterals || (size_t)( outEnd - out ) < numLiterals )
+		{
+			return false;
+		}
+		memcpy( out, in, numLiterals );
+		in += numLiterals;
+		out += numLiterals;
+
+		// the last sequence is literals only
+		if( in >= inEnd )
+		{
+			break;
+		}
+
+		if( inEnd - in < 2 )
+		{
+			return false;
+		}
+		size_t offset = (size_t)in[0] | ( (size_t)in[1] << 8 );
+		in += 2;
+		if( offset == 0 || offset > (size_t)( out - outStart ) )
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if( matchLength == 15 && !ReadLZ4Length( in, inEnd, matchLength ) )
+		{
+			return false;
+		}
+		matchLength += LZ4_MIN_MATCH;
+		if( (size_t)( outEnd - out ) < matchLength )
+		{
+			return false;
+		}
+
+		// overlapping matches repeat the last offset bytes, so they have to go forward a byte at a time
+		unsigned char const* match = out - offset;
+		if( offset >= matchLength )
+		{
+			memcpy( out, match, matchLength );
+			out += matchLength;
+		}
+		else
+		{
+			for( size_t byteIndex = 0; byteIndex < matchLength; byteIndex++ )
+			{
+				*out++ = *match++;
+			}
+		}
+	}
+
+	return out == outEnd;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <stddef.h>
+
+//------------------------------------------------------------------------
+// LZ4 block format (no frame header), compatible with the reference lz4 library.
+// Decompression is a straight copy loop, fast enough to run at load time.
+//------------------------------------------------------------------------
+size_t	GetLZ4CompressBound( size_t sourceSize );
+
+// returns the compressed size, 0 if it doesn't fit in destinationCapacity
+size_t	CompressLZ4( void const* source, size_t sourceSize, void* destination, size_t destinationCapacity );
+
+// destinationSize must be the exact decompressed size; false on malformed input
+bool	DecompressLZ4( void const* source, size_t sourceSize, void* destination, size_t destinationSize );
@@ -0,0 +1,106 @@
+#include "Engine/Core/ConsoleLineBuffer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <string.h>
+
+//------------------------------------------------------------------------
+ConsoleLineBuffer::ConsoleLineBuffer( int maxLines, size_t arenaSize )
+	:m_lines( maxLines > 0 ? maxLines : 1 ),
+	m_arenaSize( arenaSize > 2 ? arenaSize : 2 )
+{
+	m_arena = new char[m_arenaSize];
+}
+
+ConsoleLineBuffer::~ConsoleLineBuffer()
+{
+	delete[] m_arena;
+	m_arena = nullptr;
+}
+
+//------------------------------------------------------------------------
+void ConsoleLineBuffer::AddLine( const Rgba8& color, std::string_view text )
+{
+	// capped at half so wrapping to the front can never run into what's left at the back
+	size_t maxLength = m_arenaSize / 2 - 1;
+	size_t length = text.size() < maxLength ? text.size() : maxLength;
+	size_t footprint = length + 1;
+
+	if( m_numLines == GetMaxLines() )
+	{
+		RemoveOldestLine();
+	}
+
+	size_t lineOffset = m_writeOffset;
+	if( lineOffset + footprint > m_arenaSize )
+	{
+		// lines still sitting in the tail being skipped are the oldest ones
+		size_t skippedTailOffset = m_writeOffset;
+		while( m_numLines > 0 && GetOldestLine().m_offset >= skippedTailOffset )
+		{
+			RemoveOldestLine();
+		}
+		lineOffset = 0;
+	}
+
+	// then the oldest lines in the way, which are always the next ones after the write offset
+	while( m_numLines > 0 )
+	{
+		const ConsoleLine& oldestLine = GetOldestLine();
+		bool isOverlapping = oldestLine.m_offset < lineOffset + footprint && oldestLine.m_offset + oldestLine.m_length + 1 > lineOffset;
+		if( !isOverlapping )
+		{
+			break;
+		}
+		RemoveOldestLine();
+	}
+	if( m_numLines == 0 )
+	{
+		lineOffset = 0;
+	}
+
+	memcpy( &m_arena[lineOffset], text.data(), length );
+	m_arena[lineOffset + length] = '\0';
+
+	int newLineIndex = ( m_oldestLineIndex + m_numLines ) % GetMaxLines();
+	ConsoleLine& newLine = m_lines[newLineIndex];
+	newLine.m_color = color;
+	newLine.m_offset = lineOffset;
+	newLine.m_length = length;
+	m_numLines++;
+
+	m_writeOffset = lineOffset + footprint;
+}
+
+void ConsoleLineBuffer::Clear()
+{
+	m_oldestLineIndex = 0;
+	m_numLines = 0;
+	m_writeOffset = 0;
+}
+
+//------------------------------------------------------------------------
+std::string_view ConsoleLineBuffer::GetLineText( int lineIndex ) const
+{
+	const ConsoleLine& line = GetLine( lineIndex );
+	return std::string_view( &m_arena[line.m_offset], line.m_length );
+}
+
+const Rgba8& ConsoleLineBuffer::GetLineColor( int lineIndex ) const
+{
+	return GetLine( lineIndex ).m_color;
+}
+
+const ConsoleLineBuffer::ConsoleLine& ConsoleLineBuffer::GetLine( int lineIndex ) const
+{
+	GUARANTEE_OR_DIE( lineIndex >= 0 && lineIndex < m_numLines, "ConsoleLineBuffer line index out of range" );
+	return m_lines[( m_oldestLineIndex + lineIndex ) % GetMaxLines()];
+}
+
+void ConsoleLineBuffer::RemoveOldestLine()
+{
+	m_oldestLineIndex = ( m_oldestLineIndex + 1 ) % GetMaxLines();
+	m_numLines--;
+	if( m_numLines == 0 )
+	{
+		m_writeOffset = 0;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include <stddef.h>
+#include <string_view>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Fixed size scrollback: a ring of line records whose text lives in one character arena.
+// Adding a line past either limit drops the oldest lines, nothing is allocated after construction.
+// Each line's text is contiguous and null terminated inside the arena; a line that doesn't fit
+// before the end of the arena starts over at the front and the leftover tail is skipped.
+//------------------------------------------------------------------------
+class ConsoleLineBuffer
+{
+public:
+	ConsoleLineBuffer( int maxLines, size_t arenaSize );
+	~ConsoleLineBuffer();
+
+	ConsoleLineBuffer( const ConsoleLineBuffer& copyFrom ) = delete;
+	ConsoleLineBuffer& operator=( const ConsoleLineBuffer& copyFrom ) = delete;
+
+	void				AddLine( const Rgba8& color, std::string_view text );		// text longer than half the arena is cut short
+	void				Clear();
+
+	int					GetNumLines() const					{ return m_numLines; }
+	int					GetMaxLines() const					{ return (int)m_lines.size(); }
+	size_t				GetArenaSize() const				{ return m_arenaSize; }
+	std::string_view	GetLineText( int lineIndex ) const;		// 0 is the oldest line still kept
+	const Rgba8&		GetLineColor( int lineIndex ) const;
+
+private:
+	struct ConsoleLine
+	{
+		Rgba8	m_color;
+		size_t	m_offset = 0;		// into the arena
+		size_t	m_length = 0;		// not counting the terminator
+	};
+
+	ConsoleLine&		GetOldestLine()						{ return m_lines[m_oldestLineIndex]; }
+	const ConsoleLine&	GetLine( int lineIndex ) const;
+	void				RemoveOldestLine();
+
+private:
+	std::vector<ConsoleLine>	m_lines;
+	int							m_oldestLineIndex = 0;
+	int							m_numLines = 0;
+
+	char*						m_arena = nullptr;
+	size_t						m_arenaSize = 0;
+	size_t						m_writeOffset = 0;		// where the next line's text goes if it fits
+};
@@ -0,0 +1,144 @@
+#include "Engine/Core/DefinitionCache.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+constexpr unsigned int DEFINITION_CACHE_MAGIC = 0x46454444;		// "DDEF"
+constexpr const char* DEFINITION_CACHE_FOLDER = "Data/Cache";
+
+struct DefinitionCacheHeader
+{
+	unsigned int		m_magic = DEFINITION_CACHE_MAGIC;
+	unsigned int		m_formatVersion = 0;
+	unsigned long long	m_sourceHash = 0;
+	unsigned long long	m_payloadSize = 0;
+};
+static_assert( sizeof( DefinitionCacheHeader ) == 24, "definition cache header layout changed" );
+
+STATIC std::atomic<int> DefinitionCache::s_numLoaded( 0 );
+STATIC std::atomic<int> DefinitionCache::s_numRebuilt( 0 );
+
+//------------------------------------------------------------------------
+// 64-bit FNV-1a, carried on from a previous hash
+//------------------------------------------------------------------------
+static unsigned long long HashBytes( const void* data, size_t size, unsigned long long hash )
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>( data );
+	for( size_t byteIndex = 0; byteIndex < size; byteIndex++ )
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//------------------------------------------------------------------------
+DefinitionCache::DefinitionCache( const std::string& cacheName, unsigned int formatVersion )
+	:m_cachePath( Stringf( "%s/%s.defcache", DEFINITION_CACHE_FOLDER, cacheName.c_str() ) ),
+	m_formatVersion( formatVersion ),
+	m_sourceHash( 14695981039346656037ULL ),
+	m_writer( m_payload )
+{
+}
+
+DefinitionCache::~DefinitionCache()
+{
+	delete m_parser;
+	m_parser = nullptr;
+}
+
+//------------------------------------------------------------------------
+void DefinitionCache::AddSourceFile( const std::string& filePath )
+{
+	// the path too, so renaming or reordering sources also misses
+	m_sourceHash = HashBytes( filePath.c_str(), filePath.size() + 1, m_sourceHash );
+
+	FileView sourceFile( filePath );
+	unsigned long long sourceSize = sourceFile.GetSize();
+	m_sourceHash = HashBytes( &sourceSize, sizeof( sourceSize ), m_sourceHash );
+	m_sourceHash = HashBytes( sourceFile.GetData(), sourceFile.GetSize(), m_sourceHash );
+}
+
+void DefinitionCache::AddSourceValue( const std::string& value )
+{
+	m_sourceHash = HashBytes( value.c_str(), value.size() + 1, m_sourceHash );
+}
+
+//------------------------------------------------------------------------
+bool DefinitionCache::Load()
+{
+	// a packed cache goes stale once the loose XML is edited, and the rebuilt one is written loose
+	bool isUpToDate = m_file.Open( m_cachePath ) && IsOpenFileUpToDate();
+	if( !isUpToDate && m_file.IsArchived() )
+	{
+		isUpToDate = m_file.OpenLoose( m_cachePath ) && IsOpenFileUpToDate();
+	}
+	if( !isUpToDate )
+	{
+		m_file.Close();
+		return false;
+	}
+
+	delete m_parser;
+	m_parser = new BufferParser( m_file.GetData() + sizeof( DefinitionCacheHeader ), m_file.GetSize() - sizeof( DefinitionCacheHeader ) );
+	s_numLoaded++;
+	return true;
+}
+
+bool DefinitionCache::IsOpenFileUpToDate() const
+{
+	if( m_file.GetSize() < sizeof( DefinitionCacheHeader ) )
+	{
+		return false;
+	}
+
+	DefinitionCacheHeader header;
+	memcpy( &header, m_file.GetData(), sizeof( header ) );
+	return header.m_magic == DEFINITION_CACHE_MAGIC
+		&& header.m_formatVersion == m_formatVersion
+		&& header.m_sourceHash == m_sourceHash
+		&& header.m_payloadSize == m_file.GetSize() - sizeof( header );		// catches a save that got cut short
+}
+
+BufferParser& DefinitionCache::GetParser()
+{
+	GUARANTEE_OR_DIE( m_parser != nullptr, Stringf( "%s was never loaded", m_cachePath.c_str() ) );
+	return *m_parser;
+}
+
+//------------------------------------------------------------------------
+bool DefinitionCache::Save()
+{
+	s_numRebuilt++;
+
+#ifdef _WIN32
+	_mkdir( DEFINITION_CACHE_FOLDER );
+#endif
+
+	// the cache can't stay mapped while it's overwritten
+	m_file.Close();
+
+	FILE* fp = nullptr;
+	fopen_s( &fp, m_cachePath.c_str(), "wb" );
+	if( fp == nullptr )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "WARNING: couldn't write %s", m_cachePath.c_str() ) );
+		return false;
+	}
+
+	DefinitionCacheHeader header;
+	header.m_formatVersion = m_formatVersion;
+	header.m_sourceHash = m_sourceHash;
+	header.m_payloadSize = m_payload.size();
+	bool isWritten = fwrite( &header, sizeof( header ), 1, fp ) == 1;
+	if( isWritten && !m_payload.empty() )
+	{
+		isWritten = fwrite( m_payload.data(), 1, m_payload.size(), fp ) == m_payload.size();
+	}
+	fclose( fp );
+	return isWritten;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/FileView.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Definitions parsed out of XML once, saved as a flat binary blob in Data/Cache/.
+// The blob is keyed by a hash of every source file's path and bytes plus a format version,
+// so editing the XML or changing what gets written just falls back to XML and rewrites it.
+//
+//	DefinitionCache cache( "ActorDefs", ACTOR_DEFS_CACHE_VERSION );
+//	cache.AddSourceFile( path );
+//	if( cache.Load() )	-> build everything from cache.GetParser()
+//	else				-> parse the XML, append it all to cache.GetWriter(), cache.Save()
+//------------------------------------------------------------------------
+class DefinitionCache
+{
+public:
+	DefinitionCache( const std::string& cacheName, unsigned int formatVersion );
+	~DefinitionCache();
+
+	DefinitionCache( const DefinitionCache& copyFrom ) = delete;
+	DefinitionCache& operator=( const DefinitionCache& copyFrom ) = delete;
+
+	void			AddSourceFile( const std::string& filePath );	// order matters, a missing file hashes as empty
+	void			AddSourceValue( const std::string& value );		// anything else the parse depended on, like a config value
+	bool			Load();		// true if the blob was written from these exact sources by this format version
+	bool			Save();		// writes whatever was appended to the writer
+
+	BufferParser&	GetParser();
+	BufferWriter&	GetWriter()		{ return m_writer; }
+
+public:
+	static std::atomic<int> s_numLoaded;	// caches that were up to date this run
+	static std::atomic<int> s_numRebuilt;	// caches parsed from XML and saved again
+
+private:
+	bool			IsOpenFileUpToDate() const;
+
+private:
+	std::string					m_cachePath;
+	unsigned int				m_formatVersion = 0;
+	unsigned long long			m_sourceHash = 0;
+
+	FileView					m_file;
+	BufferParser*				m_parser = nullptr;
+	std::vector<unsigned char>	m_payload;
+	BufferWriter				m_writer;
+};
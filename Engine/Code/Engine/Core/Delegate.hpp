@@ -1,21 +1,154 @@
+#pragma once
+#include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <functional>
 
+// callables up to this size (free functions, methods, small lambdas) are stored without allocating
+constexpr size_t DELEGATE_INLINE_BYTES = 32;
+
+//------------------------------------------------------------------------
+// Type erased void( ARGS... ) callable with an inline small buffer, falls back to the heap for big captures
+//------------------------------------------------------------------------
 template <typename ...ARGS>
+class DelegateCallable
+{
+public:
+	DelegateCallable() {}
+	DelegateCallable( DelegateCallable const& copyFrom ) = delete;
+	DelegateCallable& operator=( DelegateCallable const& copyFrom ) = delete;
+
+	//------------------------------------------------------------------------
+	template <typename CALLABLE>
+	explicit DelegateCallable( CALLABLE const& callable )
+	{
+		Construct<CALLABLE>( callable, IsInline<CALLABLE>() );
+		m_invoke = &TypedOps<CALLABLE>::Invoke;
+		m_ops = GetOps<CALLABLE>();
+	}
 
+	//------------------------------------------------------------------------
+	DelegateCallable( DelegateCallable&& moveFrom ) noexcept
+	{
+		*this = std::move( moveFrom );
+	}
+
+	//------------------------------------------------------------------------
+	DelegateCallable& operator=( DelegateCallable&& moveFrom ) noexcept
+	{
+		if( this != &moveFrom )
+		{
+			Reset();
+			if( moveFrom.m_ops != nullptr )
+			{
+				moveFrom.m_ops->m_move( &m_storage, &moveFrom.m_storage );
+				m_invoke = moveFrom.m_invoke;
+				m_ops = moveFrom.m_ops;
+				moveFrom.m_invoke = nullptr;
+				moveFrom.m_ops = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	~DelegateCallable() { Reset(); }
+
+	//------------------------------------------------------------------------
+	void Reset()
+	{
+		if( m_ops != nullptr )
+		{
+			m_ops->m_destroy( &m_storage );
+			m_invoke = nullptr;
+			m_ops = nullptr;
+		}
+	}
+
+	void operator()( ARGS const& ...args ) { m_invoke( &m_storage, args... ); }
+
+private:
+	using InvokeFunc = void (*)( void* storage, ARGS const& ...args );
+
+	struct Ops
+	{
+		void (*m_move)( void* destStorage, void* srcStorage );		// leaves srcStorage destroyed
+		void (*m_destroy)( void* storage );
+	};
+
+	template <typename CALLABLE>
+	using IsInline = std::integral_constant<bool, sizeof( CALLABLE ) <= DELEGATE_INLINE_BYTES && alignof( CALLABLE ) <= alignof( void* ) && std::is_nothrow_move_constructible<CALLABLE>::value>;
+
+	//------------------------------------------------------------------------
+	template <typename CALLABLE>
+	static CALLABLE* Get( void* storage, std::true_type )	{ return static_cast<CALLABLE*>( storage ); }
+	template <typename CALLABLE>
+	static CALLABLE* Get( void* storage, std::false_type )	{ return *static_cast<CALLABLE**>( storage ); }
+
+	template <typename CALLABLE>
+	void Construct( CALLABLE const& callable, std::true_type )	{ new( &m_storage ) CALLABLE( callable ); }
+	template <typename CALLABLE>
+	void Construct( CALLABLE const& callable, std::false_type )	{ *reinterpret_cast<CALLABLE**>( &m_storage ) = new CALLABLE( callable ); }
+
+	template <typename CALLABLE>
+	static void Move( void* destStorage, void* srcStorage, std::true_type )
+	{
+		CALLABLE* src = Get<CALLABLE>( srcStorage, std::true_type() );
+		new( destStorage ) CALLABLE( std::move( *src ) );
+		src->~CALLABLE();
+	}
+	template <typename CALLABLE>
+	static void Move( void* destStorage, void* srcStorage, std::false_type )
+	{
+		*static_cast<CALLABLE**>( destStorage ) = *static_cast<CALLABLE**>( srcStorage );
+	}
+
+	template <typename CALLABLE>
+	static void Destroy( void* storage, std::true_type )	{ Get<CALLABLE>( storage, std::true_type() )->~CALLABLE(); }
+	template <typename CALLABLE>
+	static void Destroy( void* storage, std::false_type )	{ delete Get<CALLABLE>( storage, std::false_type() ); }
+
+	//------------------------------------------------------------------------
+	template <typename CALLABLE>
+	struct TypedOps
+	{
+		static void Invoke( void* storage, ARGS const& ...args )	{ ( *Get<CALLABLE>( storage, IsInline<CALLABLE>() ) )( args... ); }
+		static void Move( void* destStorage, void* srcStorage )	{ DelegateCallable::Move<CALLABLE>( destStorage, srcStorage, IsInline<CALLABLE>() ); }
+		static void Destroy( void* storage )						{ DelegateCallable::Destroy<CALLABLE>( storage, IsInline<CALLABLE>() ); }
+	};
+
+	template <typename CALLABLE>
+	static Ops const* GetOps()
+	{
+		static Ops const s_ops = { &TypedOps<CALLABLE>::Move, &TypedOps<CALLABLE>::Destroy };
+		return &s_ops;
+	}
+
+private:
+	InvokeFunc m_invoke = nullptr;			// kept out of Ops so a call is a single indirect jump
+	Ops const* m_ops = nullptr;
+	typename std::aligned_storage<DELEGATE_INLINE_BYTES, alignof( void* )>::type m_storage;
+};
+
+//------------------------------------------------------------------------
+// Multicast delegate. Subscribing or unsubscribing from inside a callback is safe: removals are
+// skipped for the rest of the dispatch and additions are held back until the outermost Invoke returns.
+//------------------------------------------------------------------------
+template <typename ...ARGS>
 class Delegate
 {
 public:
-	using function_t = std::function<void( ARGS... )>;
+	using callable_t = DelegateCallable<ARGS...>;
 	using c_callback_t = void (*)(ARGS...);
 
-	struct sub_t // subscription_t 
+	struct sub_t // subscription_t
 	{
 		void const* obj_id      = nullptr;
 		void const* func_id     = nullptr;
-		function_t callable;
+		callable_t callable;
+		bool is_removed         = false;
 
-		inline bool operator==( sub_t const& other ) const { return (obj_id == other.obj_id) && (func_id == other.func_id); }
+		inline bool Matches( void const* objID, void const* funcID ) const { return !is_removed && (obj_id == objID) && (func_id == funcID); }
 	};
 
 public:
@@ -23,19 +156,16 @@ public:
 	void Subscribe( c_callback_t const& cb )
 	{
 		sub_t sub;
-		sub.func_id = cb;  // cb = &cb = &&cb = *cb = **cb = ***cb = ...
-		sub.callable = cb;
+		sub.func_id = (void const*)cb;  // cb = &cb = &&cb = *cb = **cb = ***cb = ...
+		sub.callable = callable_t( cb );
 
-		Subscribe( sub );
+		Subscribe( std::move( sub ) );
 	}
 
 	//------------------------------------------------------------------------
 	void Unsubscribe( c_callback_t const& cb )
 	{
-		sub_t sub;
-		sub.func_id = cb;
-
-		Unsubscribe( sub );
+		Unsubscribe( nullptr, (void const*)cb );
 	}
 
 	//------------------------------------------------------------------------
@@ -46,55 +176,152 @@ public:
 		sub.obj_id = obj;
 		sub.func_id = *(void const**)&mcb;
 
-		// std::bind
 		// capture list
-		sub.callable = [ = ]( ARGS ...args ) { (obj->*mcb)(args...); };
+		sub.callable = callable_t( [ = ]( ARGS const& ...args ) { (obj->*mcb)(args...); } );
 
-		Subscribe( sub );
+		Subscribe( std::move( sub ) );
 	}
 
 	//------------------------------------------------------------------------
 	template <typename OBJ_TYPE>
 	void UnsubscribeMethod( OBJ_TYPE* obj, void (OBJ_TYPE::* mcb)(ARGS...) )
+	{
+		Unsubscribe( obj, *(void const**)&mcb );
+	}
+
+	//------------------------------------------------------------------------
+	// lambdas have no stable id, remove them with UnsubscribeObject( obj )
+	template <typename CALLABLE>
+	void SubscribeCallable( void const* obj, CALLABLE const& callable )
 	{
 		sub_t sub;
 		sub.obj_id = obj;
-		sub.func_id = *(void const**)&mcb;
+		sub.callable = callable_t( callable );
+
+		Subscribe( std::move( sub ) );
+	}
 
-		Unsubscribe( sub );
+	//------------------------------------------------------------------------
+	// removes every subscription made with this object
+	void UnsubscribeObject( void const* obj )
+	{
+		for( sub_t& sub : m_subscriptions ) {
+			if( !sub.is_removed && sub.obj_id == obj ) {
+				MarkRemoved( sub );
+			}
+		}
+		for( size_t i = m_pendingSubscriptions.size(); i > 0; --i ) {
+			if( m_pendingSubscriptions[i - 1].obj_id == obj ) {
+				m_pendingSubscriptions.erase( m_pendingSubscriptions.begin() + ( i - 1 ) );
+			}
+		}
+		CompactRemoved();
 	}
 
-	// void unsubscribe_object( void const* obj_ptr ); 
-	// void unsubscribe_all(); 
+	//------------------------------------------------------------------------
+	void UnsubscribeAll()
+	{
+		for( sub_t& sub : m_subscriptions ) {
+			if( !sub.is_removed ) {
+				MarkRemoved( sub );
+			}
+		}
+		m_pendingSubscriptions.clear();
+		CompactRemoved();
+	}
 
 	//------------------------------------------------------------------------
 	// int args, int args
 	void Invoke( ARGS const& ...args )
 	{
-		for( sub_t& sub : m_subscriptions ) {
-			sub.callable( args... );
+		++m_dispatchDepth;
+
+		// additions go to m_pendingSubscriptions, so the storage does not move under us
+		size_t numSubs = m_subscriptions.size();
+		for( size_t subIndex = 0; subIndex < numSubs; ++subIndex ) {
+			sub_t& sub = m_subscriptions[subIndex];
+			if( !sub.is_removed ) {
+				sub.callable( args... );
+			}
+		}
+
+		--m_dispatchDepth;
+		if( m_dispatchDepth == 0 ) {
+			CompactRemoved();
+			if( !m_pendingSubscriptions.empty() ) {
+				for( sub_t& sub : m_pendingSubscriptions ) {
+					m_subscriptions.push_back( std::move( sub ) );
+				}
+				m_pendingSubscriptions.clear();
+			}
 		}
 	}
 
 	void operator() ( ARGS const& ...args ) { Invoke( args... ); }
 
+	int GetNumSubscriptions() const { return (int)( m_subscriptions.size() + m_pendingSubscriptions.size() ) - m_numRemoved; }
+
 private:
 	//------------------------------------------------------------------------
-	void Subscribe( sub_t const& sub )
+	void Subscribe( sub_t&& sub )
 	{
-		m_subscriptions.push_back( sub );
+		if( m_dispatchDepth > 0 ) {
+			m_pendingSubscriptions.push_back( std::move( sub ) );
+		}
+		else {
+			m_subscriptions.push_back( std::move( sub ) );
+		}
 	}
 
 	//------------------------------------------------------------------------
-	void Unsubscribe( sub_t const& sub )
+	void Unsubscribe( void const* objID, void const* funcID )
 	{
-		for( uint i = 0; i < m_subscriptions.size(); ++i ) {
-			if( m_subscriptions[i] == sub ) {
-				m_subscriptions.erase( m_subscriptions.begin() + i );
+		for( sub_t& sub : m_subscriptions ) {
+			if( sub.Matches( objID, funcID ) ) {
+				MarkRemoved( sub );
+				CompactRemoved();
+				return;
+			}
+		}
+		for( size_t i = 0; i < m_pendingSubscriptions.size(); ++i ) {
+			if( m_pendingSubscriptions[i].Matches( objID, funcID ) ) {
+				m_pendingSubscriptions.erase( m_pendingSubscriptions.begin() + i );
 				return;
 			}
 		}
 	}
 
+	//------------------------------------------------------------------------
+	void MarkRemoved( sub_t& sub )
+	{
+		sub.is_removed = true;
+		++m_numRemoved;
+	}
+
+	//------------------------------------------------------------------------
+	// only erases once no Invoke is walking the list
+	void CompactRemoved()
+	{
+		if( m_dispatchDepth > 0 || m_numRemoved == 0 ) {
+			return;
+		}
+
+		size_t writeIndex = 0;
+		for( size_t readIndex = 0; readIndex < m_subscriptions.size(); ++readIndex ) {
+			if( !m_subscriptions[readIndex].is_removed ) {
+				if( writeIndex != readIndex ) {
+					m_subscriptions[writeIndex] = std::move( m_subscriptions[readIndex] );
+				}
+				++writeIndex;
+			}
+		}
+		m_subscriptions.erase( m_subscriptions.begin() + writeIndex, m_subscriptions.end() );
+		m_numRemoved = 0;
+	}
+
+private:
 	std::vector<sub_t> m_subscriptions;
-};
\ No newline at end of file
+	std::vector<sub_t> m_pendingSubscriptions;
+	int m_dispatchDepth = 0;
+	int m_numRemoved = 0;
+};
@@ -3,6 +3,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
@@ -16,7 +17,12 @@ extern DevConsole* g_theConsole;
 extern EventSystem* g_theEventSystem;
 extern InputSystem* g_theInput;
 
+// a long session keeps the last few thousand rows and never allocates for them
+static constexpr int DEV_CONSOLE_MAX_HISTORY_LINES = 4096;
+static constexpr size_t DEV_CONSOLE_HISTORY_ARENA_SIZE = 256 * 1024;
+
 DevConsole::DevConsole()
+	:m_lineHistory( DEV_CONSOLE_MAX_HISTORY_LINES, DEV_CONSOLE_HISTORY_ARENA_SIZE )
 {
 }
 
@@ -37,7 +43,7 @@ void DevConsole::Update( float deltaSeconds )
 
 	if ( g_theInput->GetMouseWheelScrollAmount() > 0.f )
 	{
-		if ( (int)m_coloredLineHistory.size() - m_scollingRow - 1 > 0 )
+		if ( m_lineHistory.GetNumLines() - (int)m_scollingRow - 1 > 0 )
 		{
 			m_scollingRow++;
 		}
@@ -116,27 +122,32 @@ void DevConsole::PrintString( const Rgba8& textColor, const std::string& devCons
 	if ( devConsolePrintString.size() == 0 )
 		return;
 
+	// the history is only touched on the main thread, workers hand their line over
+	if( g_theJobSystem != nullptr && g_theJobSystem->IsWorkerThread() )
+	{
+		g_theJobSystem->Run( [this, textColor, devConsolePrintString]() { PrintString( textColor, devConsolePrintString ); }, nullptr, nullptr, JOB_AFFINITY_MAIN_THREAD );
+		return;
+	}
+
+	AddHistoryLines( textColor, devConsolePrintString );
+}
+
+void DevConsole::AddHistoryLines( const Rgba8& textColor, std::string_view text )
+{
 	float cameraWidth = m_camera->m_outputSize.x;
-	float strWidth = g_theFont->GetDimensionsForText2D( 1.f, devConsolePrintString ).x;
+	float strWidth = g_theFont->GetDimensionsForText2D( 1.f, text ).x;
 	if ( cameraWidth >= strWidth )
 	{
-		ColoredLine newLine( textColor, devConsolePrintString );
-		m_coloredLineHistory.push_back( newLine );
+		m_lineHistory.AddLine( textColor, text );
+		return;
 	}
-	else
-	{
-		std::string remainingStr = devConsolePrintString;
-		while( (int) remainingStr.size() > m_maxTextLengthPerLine )
-		{
-			std::string line = remainingStr.substr( 0, m_maxTextLengthPerLine );
-			ColoredLine newLine( textColor, line );
-			m_coloredLineHistory.push_back( newLine );
 
-			remainingStr = remainingStr.substr( m_maxTextLengthPerLine, remainingStr.size() - 1 );
-		}
-		ColoredLine newLine( textColor, remainingStr );
-		m_coloredLineHistory.push_back( newLine );
+	while( (int) text.size() > m_maxTextLengthPerLine )
+	{
+		m_lineHistory.AddLine( textColor, text.substr( 0, m_maxTextLengthPerLine ) );
+		text.remove_prefix( m_maxTextLengthPerLine );
 	}
+	m_lineHistory.AddLine( textColor, text );
 }
 
 void DevConsole::Error( const std::string& printString )
@@ -171,21 +182,30 @@ void DevConsole::Render( RenderContext& renderer, const Camera& camera, float li
 	renderer.BindTexture( nullptr );
 	renderer.DrawAABB2D( inputBox, Rgba8::BLACK );
 
+	// only the rows that fit above the input line get verts, however long the history is
 	float linePositionY = camera.GetOrthoBottomLeft().y + lineHeight;
 	float maxHeight = camera.GetOrthoTopRight().y;
-	std::vector<Vertex_PCU> textVerts;
-	if ( (int)m_coloredLineHistory.size() > 0 )
+	int numVisibleRows = (int)ceilf( ( maxHeight - linePositionY ) / lineHeight );
+	int newestVisibleIndex = m_lineHistory.GetNumLines() - (int)m_scollingRow - 1;
+	int oldestVisibleIndex = newestVisibleIndex - numVisibleRows + 1;
+	oldestVisibleIndex < 0 ? oldestVisibleIndex = 0 : true;
+
+	FrameVector<Vertex_PCU> textVerts;
+	int numVisibleChars = 0;
+	for( int index = newestVisibleIndex; index >= oldestVisibleIndex; index-- )
 	{
-		for( int index = (int)m_coloredLineHistory.size() - m_scollingRow - 1; index >= 0; index-- )
-		{
-			if( linePositionY >= maxHeight )
-				break;
+		numVisibleChars += 2 + (int)m_lineHistory.GetLineText( index ).size();
+	}
+	textVerts.reserve( (size_t)( numVisibleChars + (int)m_currentInput.size() ) * 6 );
 
-			std::string historyLine = m_coloredLineHistory[index].text;
-			historyLine.insert( 0, "- " );
-			font->AddVertsForText2D( textVerts, Vec2( camera.GetOrthoBottomLeft().x, linePositionY ), lineHeight, historyLine, m_coloredLineHistory[index].color );
-			linePositionY += lineHeight;
-		}
+	float bulletWidth = font->GetDimensionsForText2D( lineHeight, "- " ).x;
+	for( int index = newestVisibleIndex; index >= oldestVisibleIndex; index-- )
+	{
+		const Rgba8& lineColor = m_lineHistory.GetLineColor( index );
+		Vec2 lineMins = Vec2( camera.GetOrthoBottomLeft().x, linePositionY );
+		font->AddVertsForText2D( textVerts, lineMins, lineHeight, "- ", lineColor );
+		font->AddVertsForText2D( textVerts, lineMins + Vec2( bulletWidth, 0.f ), lineHeight, m_lineHistory.GetLineText( index ), lineColor );
+		linePositionY += lineHeight;
 	}
 	// print sensitive string
 	if( (int) m_sensitiveStrList.size() != 0 && !IsSelectingInputText() )
@@ -204,7 +224,7 @@ void DevConsole::Render( RenderContext& renderer, const Camera& camera, float li
 	{
 		const float boxHeight = lineHeight * 1.5f;
 		linePositionY = camera.GetOrthoBottomLeft().y + lineHeight + boxHeight * ((int) m_sensitiveStrList.size() - 1);
-		std::vector<Vertex_PCU> sensitiveTextVerts;
+		FrameVector<Vertex_PCU> sensitiveTextVerts;
 		float boxWidth = 10.f;
 
 		// set box width
@@ -263,7 +283,7 @@ void DevConsole::Render( RenderContext& renderer, const Camera& camera, float li
 		renderer.DrawAABB2D( selectedBox, Rgba8::YELLOW );
 
 		std::string selectStr;
-		std::vector<Vertex_PCU> selectedTextVerts;
+		FrameVector<Vertex_PCU> selectedTextVerts;
 		if( selectPosA.x > selectPosB.x )
 		{
 			selectStr = m_currentInput.substr( selectIdxB, selectIdxA - selectIdxB );
@@ -368,8 +388,8 @@ bool DevConsole::SendCommand( const std::string& command )
 	if ( (int) command.size() == 0 )
 		return false;
 
-	Strings commandLine = SplitStringOnDelimiter( command, ' ' );
-	if ( (int) commandLine.size() > 0 && g_theEventSystem->IsDevConsoleVisible( commandLine[0] ) )
+	std::string_view commandName = *SplitStringView( command, ' ' ).begin();
+	if ( g_theEventSystem->IsDevConsoleVisible( commandName ) )
 	{
 		PrintString( Rgba8::WHITE, command );
 		g_theEventSystem->FireEventWithValue( command );
@@ -387,16 +407,20 @@ void DevConsole::UpdateSensitiveList()
 	if ( (int) m_currentInput.size() == 0 )
 		return;
 
-	std::vector<EventSubsciption*> eventList = g_theEventSystem->GetEventForDevConsole();
-	for( int i = 0; i < (int) eventList.size(); i++ )
+	// commands are registered statically, so the index only goes stale if the count moves
+	int numCommands = g_theEventSystem->GetNumDevConsoleCommands();
+	if ( numCommands != m_numIndexedCommands )
 	{
-		EventSubsciption& eventSub = *eventList[i];
-
-		if ( eventSub.m_eventName.find( m_currentInput ) == 0 && eventSub.m_eventName != m_currentInput )
+		std::vector<std::string> commandNames;
+		for( EventSubsciption* eventSub : g_theEventSystem->GetEventForDevConsole() )
 		{
-			m_sensitiveStrList.push_back( eventSub.m_eventName );
+			commandNames.push_back( eventSub->m_eventName );
 		}
+		m_commandTrie.Build( commandNames );
+		m_numIndexedCommands = numCommands;
 	}
+
+	m_commandTrie.FindCompletions( m_currentInput, m_sensitiveStrList );
 }
 
 void DevConsole::ProcessInput()
@@ -1,8 +1,11 @@
 #pragma once
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/ConsoleLineBuffer.hpp"
+#include "Engine/Core/CommandTrie.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 
 class RenderContext;
@@ -11,13 +14,6 @@ class Camera;
 class SpriteAnimDefinition;
 class Clock;
 
-struct ColoredLine
-{
-	ColoredLine( const Rgba8& initialColor, const std::string& initialText ):color( initialColor ), text( initialText ) {};
-	Rgba8 color;
-	std::string text;
-};
-
 class DevConsole
 {
 public:
@@ -45,6 +41,7 @@ public:
 private:
 	int GetCarrotPosition() const;
 	bool SendCommand( const std::string& command );
+	void AddHistoryLines( const Rgba8& textColor, std::string_view text );
 	void UpdateSensitiveList();
 	void ProcessInput();
 	void DeleteSelectedInputText();
@@ -58,7 +55,7 @@ public:
 
 private:
 	bool m_open = false;
-	std::vector<ColoredLine> m_coloredLineHistory;
+	ConsoleLineBuffer m_lineHistory;		// fixed size, the oldest lines drop off
 	Rgba8 m_defaultBackgroundColor = Rgba8::BLACK;
 
 	std::string m_currentInput;
@@ -67,6 +64,8 @@ private:
 	int m_carrotPosition = 0;
 	int m_carrotSelectedPosition = 0;
 
+	CommandTrie m_commandTrie;
+	int m_numIndexedCommands = -1;
 	std::vector<std::string> m_sensitiveStrList;
 	unsigned int m_sensitiveSelectIdx = 0;
 	unsigned int m_scollingRow = 0;
@@ -14,8 +14,11 @@
 
 typedef unsigned int uint;
 
+class JobSystem;
+
 extern DevConsole* g_theConsole;
 extern EventSystem* g_theEventSystem;
+extern JobSystem* g_theJobSystem;
 extern NamedStrings g_gameConfigBlackboard;
 
 const Vec2 ALIGN_CENTERED		= Vec2( 0.5f, 0.5f );
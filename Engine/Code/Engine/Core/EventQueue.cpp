@@ -0,0 +1,258 @@
+#include "Engine/Core/EventQueue.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <new>
+
+static unsigned long long constexpr FREE_LIST_INDEX_MASK = 0xffffffffull;
+static int constexpr FREE_LIST_END = -1;
+
+//------------------------------------------------------------------------
+static unsigned long long PackFreeListHead( int slotIndex, unsigned long long tag )
+{
+	return ( tag << 32 ) | ( (unsigned long long)(unsigned int)slotIndex );
+}
+
+EventPayloadArena::EventPayloadArena( int capacity )
+	:m_capacity( capacity )
+{
+	m_slots = static_cast<NamedProperties*>( ::operator new( sizeof( NamedProperties ) * (size_t)capacity ) );
+	m_nextFreeIndex.reset( new std::atomic<int>[capacity] );
+	for( int i = 0; i < capacity; i++ )
+	{
+		m_nextFreeIndex[i].store( i + 1 < capacity ? i + 1 : FREE_LIST_END, std::memory_order_relaxed );
+	}
+	m_freeListHead.store( PackFreeListHead( capacity > 0 ? 0 : FREE_LIST_END, 0 ) );
+}
+
+EventPayloadArena::~EventPayloadArena()
+{
+	// payloads still in flight are owned by their queue and released before this
+	::operator delete( m_slots );
+	m_slots = nullptr;
+}
+
+NamedProperties* EventPayloadArena::Acquire( const NamedProperties& args )
+{
+	int slotIndex = PopFreeIndex();
+	if( slotIndex == FREE_LIST_END )
+	{
+		return new NamedProperties( args );
+	}
+	return new( &m_slots[slotIndex] ) NamedProperties( args );
+}
+
+void EventPayloadArena::Release( NamedProperties* payload )
+{
+	if( payload == nullptr )
+	{
+		return;
+	}
+
+	if( !IsInArena( payload ) )
+	{
+		delete payload;
+		return;
+	}
+
+	payload->~NamedProperties();
+	PushFreeIndex( (int)( payload - m_slots ) );
+}
+
+int EventPayloadArena::PopFreeIndex()
+{
+	unsigned long long head = m_freeListHead.load( std::memory_order_acquire );
+	while( true )
+	{
+		int slotIndex = (int)(unsigned int)( head & FREE_LIST_INDEX_MASK );
+		if( slotIndex == FREE_LIST_END )
+		{
+			return FREE_LIST_END;
+		}
+
+		int nextIndex = m_nextFreeIndex[slotIndex].load( std::memory_order_relaxed );
+		unsigned long long newHead = PackFreeListHead( nextIndex, ( head >> 32 ) + 1 );
+		if( m_freeListHead.compare_exchange_weak( head, newHead, std::memory_order_acq_rel, std::memory_order_acquire ) )
+		{
+			return slotIndex;
+		}
+	}
+}
+
+void EventPayloadArena::PushFreeIndex( int slotIndex )
+{
+	unsigned long long head = m_freeListHead.load( std::memory_order_acquire );
+	while( true )
+	{
+		m_nextFreeIndex[slotIndex].store( (int)(unsigned int)( head & FREE_LIST_INDEX_MASK ), std::memory_order_relaxed );
+		unsigned long long newHead = PackFreeListHead( slotIndex, ( head >> 32 ) + 1 );
+		if( m_freeListHead.compare_exchange_weak( head, newHead, std::memory_order_acq_rel, std::memory_order_acquire ) )
+		{
+			return;
+		}
+	}
+}
+
+bool EventPayloadArena::IsInArena( const NamedProperties* payload ) const
+{
+	return payload >= m_slots && payload < m_slots + m_capacity;
+}
+
+//------------------------------------------------------------------------
+MPSCEventRing::MPSCEventRing( int capacity )
+{
+	GUARANTEE_OR_DIE( capacity > 0 && ( capacity & ( capacity - 1 ) ) == 0, "MPSCEventRing capacity must be a power of two" );
+	m_cells.reset( new Cell[capacity] );
+	m_mask = (size_t)capacity - 1;
+	for( size_t i = 0; i < (size_t)capacity; i++ )
+	{
+		m_cells[i].m_sequence.store( i, std::memory_order_relaxed );
+	}
+	m_enqueuePosition.store( 0, std::memory_order_relaxed );
+}
+
+bool MPSCEventRing::Push( const QueuedEvent& queuedEvent )
+{
+	size_t position = m_enqueuePosition.load( std::memory_order_relaxed );
+	Cell* cell = nullptr;
+	while( true )
+	{
+		cell = &m_cells[position & m_mask];
+		size_t sequence = cell->m_sequence.load( std::memory_order_acquire );
+		ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)position;
+		if( diff == 0 )
+		{
+			if( m_enqueuePosition.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+			{
+				break;
+			}
+		}
+		else if( diff < 0 )
+		{
+			// full, consumer has not caught up
+			return false;
+		}
+		else
+		{
+			position = m_enqueuePosition.load( std::memory_order_relaxed );
+		}
+	}
+
+	cell->m_event = queuedEvent;
+	cell->m_sequence.store( position + 1, std::memory_order_release );
+	return true;
+}
+
+bool MPSCEventRing::Pop( QueuedEvent& out_queuedEvent )
+{
+	Cell& cell = m_cells[m_dequeuePosition & m_mask];
+	size_t sequence = cell.m_sequence.load( std::memory_order_acquire );
+	if( sequence != m_dequeuePosition + 1 )
+	{
+		// empty, or a producer has claimed the cell but not published yet
+		return false;
+	}
+
+	out_queuedEvent = cell.m_event;
+	cell.m_sequence.store( m_dequeuePosition + m_mask + 1, std::memory_order_release );
+	++m_dequeuePosition;
+	return true;
+}
+
+//------------------------------------------------------------------------
+EventQueue::EventQueue( int capacityPerPriority, int payloadCapacity )
+	:m_payloadArena( payloadCapacity )
+{
+	for( int priority = 0; priority < NUM_EVENT_PRIORITIES; priority++ )
+	{
+		m_rings[priority] = new MPSCEventRing( capacityPerPriority );
+	}
+	m_numDropped.store( 0 );
+}
+
+EventQueue::~EventQueue()
+{
+	CollectPending();
+	for( int priority = 0; priority < NUM_EVENT_PRIORITIES; priority++ )
+	{
+		while( HasPending( (eEventPriority)priority ) )
+		{
+			ReleasePayload( PopPending( (eEventPriority)priority ).m_args );
+		}
+		delete m_rings[priority];
+		m_rings[priority] = nullptr;
+	}
+}
+
+bool EventQueue::Push( EventID eventID, const NamedProperties* args, eEventPriority priority )
+{
+	QueuedEvent queuedEvent;
+	queuedEvent.m_eventID = eventID;
+	if( args )
+	{
+		queuedEvent.m_args = m_payloadArena.Acquire( *args );
+	}
+
+	if( !m_rings[priority]->Push( queuedEvent ) )
+	{
+		m_payloadArena.Release( queuedEvent.m_args );
+		m_numDropped.fetch_add( 1, std::memory_order_relaxed );
+		return false;
+	}
+	return true;
+}
+
+void EventQueue::CollectPending()
+{
+	for( int priority = 0; priority < NUM_EVENT_PRIORITIES; priority++ )
+	{
+		std::vector<QueuedEvent>& pending = m_pending[priority];
+		size_t& head = m_pendingHead[priority];
+		if( head == pending.size() )
+		{
+			pending.clear();
+			head = 0;
+		}
+		else if( head > pending.size() / 2 )
+		{
+			pending.erase( pending.begin(), pending.begin() + head );
+			head = 0;
+		}
+
+		QueuedEvent queuedEvent;
+		while( m_rings[priority]->Pop( queuedEvent ) )
+		{
+			pending.push_back( queuedEvent );
+		}
+	}
+}
+
+bool EventQueue::HasPending( eEventPriority priority ) const
+{
+	return m_pendingHead[priority] < m_pending[priority].size();
+}
+
+QueuedEvent EventQueue::PopPending( eEventPriority priority )
+{
+	QueuedEvent queuedEvent = m_pending[priority][m_pendingHead[priority]];
+	++m_pendingHead[priority];
+	return queuedEvent;
+}
+
+void EventQueue::ReleasePayload( NamedProperties* payload )
+{
+	m_payloadArena.Release( payload );
+}
+
+int EventQueue::ConsumeDroppedCount()
+{
+	return m_numDropped.exchange( 0, std::memory_order_relaxed );
+}
+
+int EventQueue::GetNumPending() const
+{
+	int numPending = 0;
+	for( int priority = 0; priority < NUM_EVENT_PRIORITIES; priority++ )
+	{
+		numPending += (int)( m_pending[priority].size() - m_pendingHead[priority] );
+	}
+	return numPending;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "Engine/Core/NamedProperties.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+typedef unsigned int EventID;
+
+enum eEventPriority
+{
+	EVENT_PRIORITY_HIGH,		// always dispatched, ignores the per-frame budget
+	EVENT_PRIORITY_NORMAL,
+	EVENT_PRIORITY_LOW,
+
+	NUM_EVENT_PRIORITIES
+};
+
+struct QueuedEvent
+{
+	EventID m_eventID = 0;
+	NamedProperties* m_args = nullptr;		// nullptr means fire with each subscriber's own input values
+};
+
+//------------------------------------------------------------------------
+// Fixed pool of NamedProperties slots handed out through a lock-free free list.
+// Falls back to the heap once every slot is in use.
+//------------------------------------------------------------------------
+class EventPayloadArena
+{
+public:
+	EventPayloadArena( int capacity );
+	~EventPayloadArena();
+
+	NamedProperties* Acquire( const NamedProperties& args );		// any thread
+	void Release( NamedProperties* payload );						// any thread
+
+private:
+	int PopFreeIndex();
+	void PushFreeIndex( int slotIndex );
+	bool IsInArena( const NamedProperties* payload ) const;
+
+private:
+	int m_capacity = 0;
+	NamedProperties* m_slots = nullptr;								// raw storage, constructed on Acquire
+	std::unique_ptr<std::atomic<int>[]> m_nextFreeIndex;
+	std::atomic<unsigned long long> m_freeListHead;					// low 32 bits index, high 32 bits ABA tag
+};
+
+//------------------------------------------------------------------------
+// Bounded multi-producer single-consumer ring (per-cell sequence numbers)
+//------------------------------------------------------------------------
+class MPSCEventRing
+{
+public:
+	MPSCEventRing( int capacity );
+
+	bool Push( const QueuedEvent& queuedEvent );					// any thread
+	bool Pop( QueuedEvent& out_queuedEvent );						// consumer thread only
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> m_sequence;
+		QueuedEvent m_event;
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	size_t m_mask = 0;
+	std::atomic<size_t> m_enqueuePosition;
+	char m_cacheLinePadding[64];										// keep producer and consumer cursors off the same line
+	size_t m_dequeuePosition = 0;
+};
+
+//------------------------------------------------------------------------
+class EventQueue
+{
+public:
+	EventQueue( int capacityPerPriority, int payloadCapacity );
+	~EventQueue();
+
+	bool Push( EventID eventID, const NamedProperties* args, eEventPriority priority );		// any thread
+
+	// main thread only
+	void CollectPending();
+	bool HasPending( eEventPriority priority ) const;
+	QueuedEvent PopPending( eEventPriority priority );
+	void ReleasePayload( NamedProperties* payload );
+	int ConsumeDroppedCount();
+	int GetNumPending() const;
+
+private:
+	MPSCEventRing* m_rings[NUM_EVENT_PRIORITIES] = {};
+	EventPayloadArena m_payloadArena;
+	std::atomic<int> m_numDropped;
+
+	// events pulled off the rings but held back by the frame budget, oldest first
+	std::vector<QueuedEvent> m_pending[NUM_EVENT_PRIORITIES];
+	size_t m_pendingHead[NUM_EVENT_PRIORITIES] = {};
+};
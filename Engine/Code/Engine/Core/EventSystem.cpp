@@ -1,118 +1,399 @@
 #include "EventSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include <functional>
 
 static uint constexpr MAX_REGISTERED_EVENTS( 128 );
 static EventSubsciption* g_registrarList[MAX_REGISTERED_EVENTS];
 static uint g_registrarCount = 0;
 
+static int constexpr INITIAL_SUBSCRIPTION_TABLE_SIZE = 256;
+static int constexpr QUEUED_EVENT_CAPACITY_PER_PRIORITY = 4096;
+static int constexpr QUEUED_EVENT_PAYLOAD_CAPACITY = 1024;
+
 EventSubsciption::EventSubsciption( std::string eventName, std::string eventDescription, EventCallbackFunction callbackFunc, const std::string& inputValue )
 	:m_eventName( eventName ),
 	m_eventDescription( eventDescription ),
-	m_callbackFunc( callbackFunc )
+	m_callbackFunc( callbackFunc ),
+	m_eventID( InternStringID( eventName ) ),
+	m_isDevConsoleCommand( true )
 {
+	GUARANTEE_OR_DIE( g_registrarCount < MAX_REGISTERED_EVENTS, "Too many COMMANDs registered, raise MAX_REGISTERED_EVENTS" );
 	m_inputValue.PopulateForEventCommand( inputValue );
 	g_registrarList[g_registrarCount] = this;
 	++g_registrarCount;
 }
 
+EventSubsciption::EventSubsciption( std::string eventName, std::string eventDescription, EventCallbackFunction callbackFunc )
+	:m_eventName( eventName ),
+	m_eventDescription( eventDescription ),
+	m_callbackFunc( callbackFunc ),
+	m_eventID( InternStringID( eventName ) )
+{
+}
+
+EventSubsciption::~EventSubsciption()
+{
+	if( !m_isDevConsoleCommand )
+	{
+		return;
+	}
+
+	for( uint i = 0; i < g_registrarCount; i++ )
+	{
+		if( g_registrarList[i] == this )
+		{
+			g_registrarList[i] = g_registrarList[g_registrarCount - 1];
+			--g_registrarCount;
+			break;
+		}
+	}
+}
+
 EventSystem::EventSystem()
 {
+	m_queuedEvents = new EventQueue( QUEUED_EVENT_CAPACITY_PER_PRIORITY, QUEUED_EVENT_PAYLOAD_CAPACITY );
+	m_subscriptionTable.resize( INITIAL_SUBSCRIPTION_TABLE_SIZE );
 	for ( uint i = 0; i < g_registrarCount; i++ )
 	{
-		m_eventSubscriptions.push_back( g_registrarList[i] );
+		AddSubscription( g_registrarList[i] );
 	}
 }
 
 EventSystem::~EventSystem()
 {
+	delete m_queuedEvents;
+	m_queuedEvents = nullptr;
 }
 
 void EventSystem::SubscriberToEvent( const std::string& eventName, std::string eventDescription, EventCallbackFunction eventCallBackFunction )
 {
-	m_eventSubscriptions.push_back( new EventSubsciption( eventName, eventDescription, eventCallBackFunction, "" ) );
+	AddSubscription( new EventSubsciption( eventName, eventDescription, eventCallBackFunction ) );
 }
 
 void EventSystem::FireEvent( const std::string& eventName )
 {
-	for ( int eventIndex = 0;eventIndex < (int) m_eventSubscriptions.size();eventIndex++ )
+	FireEvent( HashStringID( eventName ) );
+}
+
+void EventSystem::FireEvent( const std::string& eventName, NamedProperties& args )
+{
+	FireEvent( HashStringID( eventName ), args );
+}
+
+void EventSystem::FireEvent( EventID eventID )
+{
+	EventSubscriptionSlot* slot = FindSlot( eventID );
+	if( slot == nullptr )
+	{
+		return;
+	}
+
+	// index based and refetching the slot, callbacks may subscribe and grow the table
+	BeginDispatch();
+	size_t tableSize = m_subscriptionTable.size();
+	for( int subIndex = 0; subIndex < (int)slot->m_subscribers.size(); subIndex++ )
 	{
-		if ( eventName == m_eventSubscriptions[eventIndex]->m_eventName )
+		EventSubsciption* sub = slot->m_subscribers[subIndex];
+		if( sub->m_isRemoved )
 		{
-			m_eventSubscriptions[eventIndex]->m_callbackFunc( m_eventSubscriptions[eventIndex]->m_inputValue );
-			break;
+			continue;
+		}
+		sub->m_callbackFunc( sub->m_inputValue );
+
+		if( tableSize != m_subscriptionTable.size() )
+		{
+			tableSize = m_subscriptionTable.size();
+			slot = FindSlot( eventID );
 		}
 	}
+	EndDispatch();
 }
 
-void EventSystem::FireEvent( const std::string& eventName, NamedProperties& args )
+void EventSystem::FireEvent( EventID eventID, NamedProperties& args )
 {
-	for( int eventIndex = 0; eventIndex < (int)m_eventSubscriptions.size(); eventIndex++ )
+	EventSubscriptionSlot* slot = FindSlot( eventID );
+	if( slot == nullptr )
+	{
+		return;
+	}
+
+	BeginDispatch();
+	size_t tableSize = m_subscriptionTable.size();
+	for( int subIndex = 0; subIndex < (int)slot->m_subscribers.size(); subIndex++ )
 	{
-		if( eventName == m_eventSubscriptions[eventIndex]->m_eventName )
+		EventSubsciption* sub = slot->m_subscribers[subIndex];
+		if( sub->m_isRemoved )
 		{
-			m_eventSubscriptions[eventIndex]->m_callbackFunc( args );
-			break;
+			continue;
+		}
+		sub->m_callbackFunc( args );
+
+		if( tableSize != m_subscriptionTable.size() )
+		{
+			tableSize = m_subscriptionTable.size();
+			slot = FindSlot( eventID );
 		}
 	}
+	EndDispatch();
 }
 
 void EventSystem::FireEventWithValue( const std::string& commandWithValue )
 {
-	Strings commandLine = SplitStringOnDelimiter( commandWithValue, ' ' );
+	if ( (int) commandWithValue.size() == 0 )
+	{
+		return;
+	}
+
+	// command layout is "name key=value key=value", parsed once and shared by every subscriber
+	size_t nameEnd = commandWithValue.find( ' ' );
+	if( nameEnd == std::string::npos )
+	{
+		nameEnd = commandWithValue.size();
+	}
+	std::string_view commandView( commandWithValue );
+	EventID eventID = HashStringID( commandView.substr( 0, nameEnd ) );
+	EventSubscriptionSlot* slot = FindSlot( eventID );
+	if( slot == nullptr )
+	{
+		return;
+	}
 
-	if ( (int) commandWithValue.size() > 0 )
+	// views into the command line, only copied out for the subscribers that take them
+	std::vector<std::pair<std::string_view, std::string_view>> commandValues;
+	size_t tokenStart = nameEnd + 1;
+	while( tokenStart < commandWithValue.size() )
 	{
-		EventSubsciption* eventSub = nullptr;
-		std::string eventName = commandLine[0];
-		for( int eventIndex = 0; eventIndex < (int)m_eventSubscriptions.size(); eventIndex++ )
+		size_t tokenEnd = commandWithValue.find( ' ', tokenStart );
+		if( tokenEnd == std::string::npos )
+		{
+			tokenEnd = commandWithValue.size();
+		}
+
+		size_t equalIndex = commandWithValue.find( '=', tokenStart );
+		if( equalIndex < tokenEnd )
 		{
-			if( eventName == m_eventSubscriptions[eventIndex]->m_eventName )
+			// key="a value with spaces"
+			size_t valueStart = equalIndex + 1;
+			size_t valueEnd = tokenEnd;
+			if( valueStart < commandWithValue.size() && commandWithValue[valueStart] == '"' )
 			{
-				eventSub = m_eventSubscriptions[eventIndex];
-				break;
+				size_t closingQuote = commandWithValue.find( '"', valueStart + 1 );
+				valueStart++;
+				valueEnd = closingQuote != std::string::npos ? closingQuote : commandWithValue.size();
+				tokenEnd = valueEnd < commandWithValue.size() ? valueEnd + 1 : valueEnd;
 			}
+			commandValues.emplace_back( commandView.substr( tokenStart, equalIndex - tokenStart ), commandView.substr( valueStart, valueEnd - valueStart ) );
 		}
+		tokenStart = tokenEnd + 1;
+	}
 
-		if ( eventSub != nullptr )
+	// a key is only an error if no subscriber takes it, reported once after the dispatch
+	std::vector<bool> isValueTaken( commandValues.size(), false );
+	BeginDispatch();
+	size_t tableSize = m_subscriptionTable.size();
+	for( int subIndex = 0; subIndex < (int)slot->m_subscribers.size(); subIndex++ )
+	{
+		EventSubsciption* eventSub = slot->m_subscribers[subIndex];
+		if( eventSub->m_isRemoved )
 		{
-			eventSub->m_inputValue.ResetValue();
-			for ( int i = 1; i < (int) commandLine.size(); i++ )
+			continue;
+		}
+
+		eventSub->m_inputValue.ResetValue();
+		for( size_t valueIndex = 0; valueIndex < commandValues.size(); valueIndex++ )
+		{
+			const std::pair<std::string_view, std::string_view>& commandVal = commandValues[valueIndex];
+			if ( eventSub->m_inputValue.HasValue( commandVal.first ) )
 			{
-				Strings commandVal = SplitStringOnDelimiter( commandLine[i], '=' );
-				if ( (int) commandVal.size() > 1 )
+				eventSub->m_inputValue.SetValue( commandVal.first, std::string( commandVal.second ) );
+				isValueTaken[valueIndex] = true;
+			}
+		}
+
+		eventSub->m_callbackFunc( eventSub->m_inputValue );
+
+		if( tableSize != m_subscriptionTable.size() )
+		{
+			tableSize = m_subscriptionTable.size();
+			slot = FindSlot( eventID );
+		}
+	}
+	EndDispatch();
+
+	for( size_t valueIndex = 0; valueIndex < commandValues.size(); valueIndex++ )
+	{
+		if( !isValueTaken[valueIndex] )
+		{
+			std::string_view key = commandValues[valueIndex].first;
+			g_theConsole->PrintString( Rgba8::RED, Stringf( "No such value : %.*s", (int)key.size(), key.data() ) );
+		}
+	}
+}
+
+bool EventSystem::QueueEvent( const std::string& eventName, eEventPriority priority )
+{
+	return QueueEvent( HashStringID( eventName ), priority );
+}
+
+bool EventSystem::QueueEvent( EventID eventID, eEventPriority priority )
+{
+	return m_queuedEvents->Push( eventID, nullptr, priority );
+}
+
+bool EventSystem::QueueEvent( EventID eventID, const NamedProperties& args, eEventPriority priority )
+{
+	return m_queuedEvents->Push( eventID, &args, priority );
+}
+
+void EventSystem::DispatchQueuedEvents()
+{
+	// only what was queued before this point is collected, events queued by callbacks wait for next frame
+	m_queuedEvents->CollectPending();
+
+	int numDropped = m_queuedEvents->ConsumeDroppedCount();
+	if( numDropped > 0 && g_theConsole )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "WARNING: %i queued events dropped, event queue is full", numDropped ) );
+	}
+
+	double startSeconds = GetCurrentTimeSeconds();
+	int numDispatched = 0;
+	for( int priorityIndex = 0; priorityIndex < NUM_EVENT_PRIORITIES; priorityIndex++ )
+	{
+		eEventPriority priority = (eEventPriority)priorityIndex;
+		while( m_queuedEvents->HasPending( priority ) )
+		{
+			if( priority != EVENT_PRIORITY_HIGH )
+			{
+				bool isOverBudget = numDispatched >= m_maxQueuedEventsPerFrame || GetCurrentTimeSeconds() - startSeconds >= m_maxQueuedEventSecondsPerFrame;
+				if( isOverBudget )
 				{
-					if ( eventSub->m_inputValue.HasValue( commandVal[0] ) )
-					{
-						eventSub->m_inputValue.SetValue( commandVal[0], commandVal[1].c_str() );
-					}
-					else
-					{
-						g_theConsole->PrintString( Rgba8::RED, Stringf("No such value : %s", commandVal[0].c_str()) );
-					}
+					// leftovers keep their order and go first next frame
+					return;
 				}
 			}
-			
-			eventSub->m_callbackFunc( eventSub->m_inputValue );
+
+			QueuedEvent queuedEvent = m_queuedEvents->PopPending( priority );
+			if( queuedEvent.m_args )
+			{
+				FireEvent( queuedEvent.m_eventID, *queuedEvent.m_args );
+			}
+			else
+			{
+				FireEvent( queuedEvent.m_eventID );
+			}
+			m_queuedEvents->ReleasePayload( queuedEvent.m_args );
+			++numDispatched;
 		}
 	}
 }
 
+void EventSystem::SetQueuedEventBudget( int maxEventsPerFrame, double maxSecondsPerFrame )
+{
+	m_maxQueuedEventsPerFrame = maxEventsPerFrame;
+	m_maxQueuedEventSecondsPerFrame = maxSecondsPerFrame;
+}
+
+int EventSystem::GetNumQueuedEvents() const
+{
+	return m_queuedEvents->GetNumPending();
+}
+
 void EventSystem::Unsubscriber( const std::string& eventName )
 {
-	for( int eventIndex = 0; eventIndex < (int)m_eventSubscriptions.size(); eventIndex++ )
+	EventSubscriptionSlot* slot = FindSlot( HashStringID( eventName ) );
+	if( slot == nullptr )
+	{
+		return;
+	}
+
+	// back to front, so a removal that happens right away doesn't shift what's left to visit
+	for( int subIndex = (int)slot->m_subscribers.size() - 1; subIndex >= 0; subIndex-- )
+	{
+		RemoveSubscription( *slot, subIndex );
+	}
+	// the slot itself stays claimed so linear probing never needs tombstones
+}
+
+void EventSystem::Unsubscriber( const std::string& eventName, EventCallbackFunction eventCallBackFunction )
+{
+	EventSubscriptionSlot* slot = FindSlot( HashStringID( eventName ) );
+	if( slot == nullptr )
+	{
+		return;
+	}
+
+	for( int subIndex = 0; subIndex < (int)slot->m_subscribers.size(); subIndex++ )
 	{
-		if( eventName == m_eventSubscriptions[eventIndex]->m_eventName )
+		EventSubsciption* sub = slot->m_subscribers[subIndex];
+		if( !sub->m_isRemoved && sub->m_callbackFunc == eventCallBackFunction )
 		{
-			delete m_eventSubscriptions[eventIndex];
-			m_eventSubscriptions[eventIndex] = nullptr;
+			RemoveSubscription( *slot, subIndex );
+			return;
+		}
+	}
+}
 
-			uint lastIndex = (uint)m_eventSubscriptions.size() - 1;
-			m_eventSubscriptions[eventIndex] = m_eventSubscriptions[lastIndex];
-			m_eventSubscriptions.pop_back();
-			--eventIndex;
-			break;
+void EventSystem::RemoveSubscription( EventSubscriptionSlot& slot, int subIndex )
+{
+	EventSubsciption* sub = slot.m_subscribers[subIndex];
+	if( sub->m_isRemoved )
+	{
+		return;
+	}
+
+	if( m_dispatchDepth > 0 )
+	{
+		sub->m_isRemoved = true;
+		m_slotsWithRemovals.push_back( slot.m_eventID );
+		return;
+	}
+
+	if( !sub->m_isDevConsoleCommand )
+	{
+		delete sub;
+	}
+	// erase rather than swap, multicast order must stay stable
+	slot.m_subscribers.erase( slot.m_subscribers.begin() + subIndex );
+}
+
+void EventSystem::EndDispatch()
+{
+	--m_dispatchDepth;
+	if( m_dispatchDepth > 0 || m_slotsWithRemovals.empty() )
+	{
+		return;
+	}
+
+	for( EventID eventID : m_slotsWithRemovals )
+	{
+		EventSubscriptionSlot* slot = FindSlot( eventID );
+		std::vector<EventSubsciption*>& subscribers = slot->m_subscribers;
+		int numKept = 0;
+		for( EventSubsciption* sub : subscribers )
+		{
+			if( !sub->m_isRemoved )
+			{
+				subscribers[numKept++] = sub;
+			}
+			else if( sub->m_isDevConsoleCommand )
+			{
+				sub->m_isRemoved = false;
+			}
+			else
+			{
+				delete sub;
+			}
 		}
+		subscribers.resize( numKept );
 	}
+	m_slotsWithRemovals.clear();
+}
+
+int EventSystem::GetNumDevConsoleCommands() const
+{
+	return (int)g_registrarCount;
 }
 
 std::vector<EventSubsciption*> EventSystem::GetEventForDevConsole() const
@@ -128,15 +409,246 @@ std::vector<EventSubsciption*> EventSystem::GetEventForDevConsole() const
 	return eventList;
 }
 
-bool EventSystem::IsDevConsoleVisible( const std::string& command )
+bool EventSystem::IsDevConsoleVisible( std::string_view command )
 {
-	for( uint i = 0; i < g_registrarCount; i++ )
+	EventSubscriptionSlot* slot = FindSlot( HashStringID( command ) );
+	if( slot == nullptr )
 	{
-		EventSubsciption& eventSub = *g_registrarList[i];
-		if ( eventSub.m_eventName == command )
+		return false;
+	}
+
+	for( EventSubsciption* sub : slot->m_subscribers )
+	{
+		if( sub->m_isDevConsoleCommand && !sub->m_isRemoved )
 		{
 			return true;
 		}
 	}
 	return false;
 }
+
+int EventSystem::GetNumSubscribers( EventID eventID ) const
+{
+	EventSubscriptionSlot* slot = FindSlot( eventID );
+	if( slot == nullptr )
+	{
+		return 0;
+	}
+
+	int numSubscribers = 0;
+	for( EventSubsciption* sub : slot->m_subscribers )
+	{
+		numSubscribers += sub->m_isRemoved ? 0 : 1;
+	}
+	return numSubscribers;
+}
+
+void EventSystem::AddSubscription( EventSubsciption* subscription )
+{
+	EventSubscriptionSlot& slot = FindOrCreateSlot( subscription->m_eventID, subscription->m_eventName );
+	slot.m_subscribers.push_back( subscription );
+}
+
+EventSubscriptionSlot* EventSystem::FindSlot( EventID eventID ) const
+{
+	uint mask = (uint)m_subscriptionTable.size() - 1;
+	uint slotIndex = eventID & mask;
+	while( true )
+	{
+		const EventSubscriptionSlot& slot = m_subscriptionTable[slotIndex];
+		if( slot.m_eventID == eventID )
+		{
+			return const_cast<EventSubscriptionSlot*>( &slot );
+		}
+		if( slot.m_eventID == INVALID_EVENT_ID )
+		{
+			return nullptr;
+		}
+		slotIndex = ( slotIndex + 1 ) & mask;
+	}
+}
+
+EventSubscriptionSlot& EventSystem::FindOrCreateSlot( EventID eventID, const std::string& eventName )
+{
+	GUARANTEE_OR_DIE( eventID != INVALID_EVENT_ID, Stringf( "Event name \"%s\" hashes to the invalid event id", eventName.c_str() ) );
+
+	// keep load factor under 1/2 so probe chains stay short
+	if( ( m_numUsedSlots + 1 ) * 2 > (int)m_subscriptionTable.size() )
+	{
+		GrowSubscriptionTable();
+	}
+
+	uint mask = (uint)m_subscriptionTable.size() - 1;
+	uint slotIndex = eventID & mask;
+	while( true )
+	{
+		EventSubscriptionSlot& slot = m_subscriptionTable[slotIndex];
+		if( slot.m_eventID == eventID )
+		{
+			GUARANTEE_OR_DIE( slot.m_eventName == eventName, Stringf( "Event name hash collision: \"%s\" and \"%s\"", slot.m_eventName.c_str(), eventName.c_str() ) );
+			return slot;
+		}
+		if( slot.m_eventID == INVALID_EVENT_ID )
+		{
+			slot.m_eventID = eventID;
+			slot.m_eventName = eventName;
+			++m_numUsedSlots;
+			return slot;
+		}
+		slotIndex = ( slotIndex + 1 ) & mask;
+	}
+}
+
+void EventSystem::GrowSubscriptionTable()
+{
+	std::vector<EventSubscriptionSlot> oldTable;
+	oldTable.swap( m_subscriptionTable );
+	m_subscriptionTable.resize( oldTable.size() * 2 );
+
+	uint mask = (uint)m_subscriptionTable.size() - 1;
+	for( EventSubscriptionSlot& oldSlot : oldTable )
+	{
+		if( oldSlot.m_eventID == INVALID_EVENT_ID )
+		{
+			continue;
+		}
+
+		uint slotIndex = oldSlot.m_eventID & mask;
+		while( m_subscriptionTable[slotIndex].m_eventID != INVALID_EVENT_ID )
+		{
+			slotIndex = ( slotIndex + 1 ) & mask;
+		}
+		m_subscriptionTable[slotIndex] = std::move( oldSlot );
+	}
+}
+
+//------------------------------------------------------------------------
+static int s_benchmarkEventHits = 0;
+
+static void BenchmarkEventCallback( NamedProperties& args )
+{
+	UNUSED( args );
+	++s_benchmarkEventHits;
+}
+
+COMMAND( benchmark_events, "Measure event fires per second. e.g. benchmark_events events=500 fires=1000000", "events,fires" )
+{
+	int numEvents = args.GetValue( "events", 500 );
+	int numFires = args.GetValue( "fires", 1000000 );
+	numEvents < 1 ? numEvents = 1 : true;
+
+	Strings eventNames;
+	for( int i = 0; i < numEvents; i++ )
+	{
+		eventNames.push_back( Stringf( "benchmark_event_%i", i ) );
+		g_theEventSystem->SubscriberToEvent( eventNames[i], "", BenchmarkEventCallback );
+	}
+	// one multicast event with several listeners, fired alongside the single listener ones
+	for( int i = 0; i < 4; i++ )
+	{
+		g_theEventSystem->SubscriberToEvent( eventNames[0], "", BenchmarkEventCallback );
+	}
+
+	std::vector<EventID> eventIDs;
+	for( const std::string& name : eventNames )
+	{
+		eventIDs.push_back( HashStringID( name ) );
+	}
+
+	s_benchmarkEventHits = 0;
+	double startSeconds = GetCurrentTimeSeconds();
+	for( int i = 0; i < numFires; i++ )
+	{
+		g_theEventSystem->FireEvent( eventIDs[i % numEvents] );
+	}
+	double idSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	startSeconds = GetCurrentTimeSeconds();
+	for( int i = 0; i < numFires; i++ )
+	{
+		g_theEventSystem->FireEvent( eventNames[i % numEvents] );
+	}
+	double nameSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	for( const std::string& name : eventNames )
+	{
+		g_theEventSystem->Unsubscriber( name );
+	}
+
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%i events, %i fires, %i callbacks", numEvents, numFires, s_benchmarkEventHits ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  by id   : %.0f fires/sec", (double)numFires / idSeconds ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  by name : %.0f fires/sec", (double)numFires / nameSeconds ) );
+}
+
+//------------------------------------------------------------------------
+static float s_benchmarkDelegateSum = 0.f;
+
+static void BenchmarkDelegateCallback( float deltaSeconds )
+{
+	s_benchmarkDelegateSum += deltaSeconds;
+}
+
+struct BenchmarkDelegateListener
+{
+	void OnFixedUpdate( float deltaSeconds ) { m_sum += deltaSeconds; }
+	float m_sum = 0.f;
+};
+
+//------------------------------------------------------------------------
+// half free functions, half methods, the mix Physics2D::OnFixedUpdate sees
+static void BenchmarkDelegate( int numSubscribers, int numCallbacks )
+{
+	std::vector<BenchmarkDelegateListener> listeners( numSubscribers );
+	Delegate<float> delegate;
+	std::vector<std::function<void( float )>> functions;
+	void (BenchmarkDelegateListener::* method)( float ) = &BenchmarkDelegateListener::OnFixedUpdate;
+	for( int subIndex = 0; subIndex < numSubscribers; subIndex++ )
+	{
+		if( subIndex % 2 == 0 )
+		{
+			delegate.Subscribe( BenchmarkDelegateCallback );
+			functions.push_back( BenchmarkDelegateCallback );
+		}
+		else
+		{
+			BenchmarkDelegateListener* listener = &listeners[subIndex];
+			delegate.SubscribeMethod( listener, method );
+			functions.push_back( [=]( float deltaSeconds ) { (listener->*method)( deltaSeconds ); } );
+		}
+	}
+
+	int numInvokes = numCallbacks / numSubscribers;
+	numInvokes < 1 ? numInvokes = 1 : true;
+
+	double startSeconds = GetCurrentTimeSeconds();
+	for( int invokeIndex = 0; invokeIndex < numInvokes; invokeIndex++ )
+	{
+		delegate.Invoke( 0.01f );
+	}
+	double delegateSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	// std::function list as the baseline Delegate used to be built on
+	startSeconds = GetCurrentTimeSeconds();
+	for( int invokeIndex = 0; invokeIndex < numInvokes; invokeIndex++ )
+	{
+		for( std::function<void( float )>& function : functions )
+		{
+			function( 0.01f );
+		}
+	}
+	double functionSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	double numCalls = (double)numInvokes * (double)numSubscribers;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%4i subs: %12.0f invokes/sec, %6.2f ns/callback (std::function %6.2f ns/callback)",
+		numSubscribers, (double)numInvokes / delegateSeconds, delegateSeconds * 1.0e9 / numCalls, functionSeconds * 1.0e9 / numCalls ) );
+}
+
+COMMAND( benchmark_delegate, "Measure Delegate invoke throughput with 1, 10 and 1000 subscribers. e.g. benchmark_delegate callbacks=10000000", "callbacks" )
+{
+	int numCallbacks = args.GetValue( "callbacks", 10000000 );
+
+	s_benchmarkDelegateSum = 0.f;
+	BenchmarkDelegate( 1, numCallbacks );
+	BenchmarkDelegate( 10, numCallbacks );
+	BenchmarkDelegate( 1000, numCallbacks );
+}
@@ -1,18 +1,33 @@
 #pragma once
 #include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/EventQueue.hpp"
+#include "Engine/Core/StringID.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 
 typedef unsigned int EntityID;
+typedef StringID EventID;			// an event's id is just its interned name
 typedef void(*EventCallbackFunction)( NamedProperties& args );                // static void some_method_impl( NamedStrings& args )
 
+constexpr EventID INVALID_EVENT_ID = INVALID_STRING_ID;
+
+// e.g. FireEvent( EVENT_ID( "quit" ) ), hashed at compile time
+#define EVENT_ID( literalName ) STRING_ID( literalName )
+
 struct EventSubsciption
 {
 	EventSubsciption( std::string eventName, std::string eventDescription, EventCallbackFunction callbackFunc, const std::string& inputValue );
+	EventSubsciption( std::string eventName, std::string eventDescription, EventCallbackFunction callbackFunc );
+	~EventSubsciption();
+
 	std::string m_eventName;
 	std::string m_eventDescription;
 	NamedProperties m_inputValue;
 	EventCallbackFunction m_callbackFunc = nullptr;
+	EventID m_eventID = INVALID_EVENT_ID;
+	bool m_isDevConsoleCommand = false;
+	bool m_isRemoved = false;		// unsubscribed mid dispatch, skipped until the dispatch unwinds
 };
 
 #define COMMAND( name, description, inputVal ) \
@@ -20,6 +35,15 @@ struct EventSubsciption
    static EventSubsciption name##_register( #name, description, name##_impl, inputVal ); \
    static void name##_impl( NamedProperties& args )
 
+//------------------------------------------------------------------------
+// One open-addressed slot per event name; subscribers are kept in subscription order
+struct EventSubscriptionSlot
+{
+	EventID m_eventID = INVALID_EVENT_ID;
+	std::string m_eventName;
+	std::vector<EventSubsciption*> m_subscribers;
+};
+
 class EventSystem
 {
 public:
@@ -28,13 +52,45 @@ public:
 	void SubscriberToEvent( const std::string& eventName, std::string eventDescription, EventCallbackFunction eventCallBackFunction );
 	void FireEvent( const std::string& eventName );
 	void FireEvent( const std::string& eventName, NamedProperties& args );
-	void FireEventWithValue( const std::string& commandWithValue );
+	void FireEvent( EventID eventID );
+	void FireEvent( EventID eventID, NamedProperties& args );
+	void FireEventWithValue( const std::string& commandWithValue );		// "name key=value key=\"value with spaces\""
+
+	// deferred, safe to call from any thread; fired by DispatchQueuedEvents on the main thread
+	bool QueueEvent( const std::string& eventName, eEventPriority priority = EVENT_PRIORITY_NORMAL );
+	bool QueueEvent( EventID eventID, eEventPriority priority = EVENT_PRIORITY_NORMAL );
+	bool QueueEvent( EventID eventID, const NamedProperties& args, eEventPriority priority = EVENT_PRIORITY_NORMAL );
+	void DispatchQueuedEvents();
+	void SetQueuedEventBudget( int maxEventsPerFrame, double maxSecondsPerFrame );
+	int GetNumQueuedEvents() const;
 
 	void Unsubscriber( const std::string& eventName );
+	void Unsubscriber( const std::string& eventName, EventCallbackFunction eventCallBackFunction );
 
 	std::vector<EventSubsciption*> GetEventForDevConsole() const;
-	bool IsDevConsoleVisible( const std::string& command );
+	int GetNumDevConsoleCommands() const;
+	bool IsDevConsoleVisible( std::string_view command );
+	int GetNumSubscribers( EventID eventID ) const;
 
-public:
-	std::vector<EventSubsciption*> m_eventSubscriptions;
-};
\ No newline at end of file
+private:
+	void AddSubscription( EventSubsciption* subscription );
+	EventSubscriptionSlot* FindSlot( EventID eventID ) const;
+	EventSubscriptionSlot& FindOrCreateSlot( EventID eventID, const std::string& eventName );
+	void GrowSubscriptionTable();
+
+	// a callback may subscribe or unsubscribe while an event is dispatching; removals are only
+	// marked until the outermost dispatch returns, so the subscriber lists never shift underneath it
+	void BeginDispatch()	{ ++m_dispatchDepth; }
+	void EndDispatch();
+	void RemoveSubscription( EventSubscriptionSlot& slot, int subIndex );
+
+private:
+	std::vector<EventSubscriptionSlot> m_subscriptionTable;		// size is always a power of two
+	int m_numUsedSlots = 0;
+	int m_dispatchDepth = 0;
+	std::vector<EventID> m_slotsWithRemovals;
+
+	EventQueue* m_queuedEvents = nullptr;
+	int m_maxQueuedEventsPerFrame = 256;
+	double m_maxQueuedEventSecondsPerFrame = 0.002;
+};
@@ -1,32 +1,46 @@
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/FileView.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include <io.h>
 
 std::string FileRend( std::string const& filename )
 {
-	std::string name = std::string( filename );
-	FILE* fp = nullptr;
-	fopen_s( &fp, name.c_str(), "r" );
-	if( fp == nullptr )
+	FileView file( filename );
+	if( !file.IsOpen() )
 	{
 		return "";
 	}
 
-	// get the size of the file
-	fseek( fp, 0, SEEK_END );
-	long file_size = ftell( fp );
+	// keep the old text mode behaviour of reading \r\n as \n
+	std::string contents;
+	contents.reserve( file.GetSize() );
+	char const* data = file.GetData();
+	size_t size = file.GetSize();
+	for( size_t charIndex = 0; charIndex < size; charIndex++ )
+	{
+		if( data[charIndex] != '\r' || charIndex + 1 >= size || data[charIndex + 1] != '\n' )
+		{
+			contents.push_back( data[charIndex] );
+		}
+	}
 
-	char* buffer = new char[file_size + 1];
-	if( nullptr != buffer )
+	return contents;
+}
+
+bool FileWrite( std::string const& filename, std::string const& contents )
+{
+	FILE* fp = nullptr;
+	fopen_s( &fp, filename.c_str(), "wb" );
+	if( fp == nullptr )
 	{
-		fseek( fp, 0, SEEK_SET );
-		size_t bytes_read = fread( buffer, 1, (size_t)file_size, fp );
-		buffer[bytes_read] = NULL;
+		return false;
 	}
-	fclose( fp );
 
-	return buffer;
+	size_t bytesWritten = fwrite( contents.data(), 1, contents.size(), fp );
+	fclose( fp );
+	return bytesWritten == contents.size();
 }
 
 Strings GetFileNamesInFolder( const std::string& folderPath, const char* filePattern )
@@ -44,6 +58,7 @@ Strings GetFileNamesInFolder( const std::string& folderPath, const char* filePat
 		int errorCode = _findnext( searchHandle, &fileInfo );
 		if ( errorCode != 0 )
 		{
+			_findclose( searchHandle );
 			break;
 		}
 	}
@@ -51,6 +66,8 @@ Strings GetFileNamesInFolder( const std::string& folderPath, const char* filePat
 	ERROR_AND_DIE( Stringf( "Not yet implemented for platform!" ) );
 #endif
 
+	// packed files show up as if they were still loose
+	AppendArchivedFileNamesInFolder( folderPath, filePattern, fileNamesInFolder );
 	return fileNamesInFolder;
 }
 
@@ -4,7 +4,7 @@
 
 typedef std::vector< std::string > Strings;
 
-//void* FileRendToNewBuffer( std::string const& filename, size_t *out_size = nullptr );
 std::string FileRend( std::string const& filename);
+bool FileWrite( std::string const& filename, std::string const& contents );
 Strings GetFileNamesInFolder( const std::string& folderPath, const char* filePattern );
 std::string GetFileBaseName( std::string const& filename );
\ No newline at end of file
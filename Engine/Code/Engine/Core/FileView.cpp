@@ -0,0 +1,285 @@
+#include "Engine/Core/FileView.hpp"
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/Compression.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <stdlib.h>
+#include <string.h>
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------
+FileView::FileView( std::string const& filename )
+{
+	Open( filename );
+}
+
+FileView::~FileView()
+{
+	Close();
+}
+
+bool FileView::Open( std::string const& filename )
+{
+	if( GetNumMountedAssetArchives() > 0 && OpenArchived( filename ) )
+	{
+		return true;
+	}
+	return OpenLoose( filename );
+}
+
+bool FileView::OpenArchived( std::string const& filename )
+{
+	Close();
+
+	ArchivedFile archivedFile;
+	if( !FindArchivedFile( filename, archivedFile ) )
+	{
+		return false;
+	}
+
+	if( archivedFile.m_isCompressed )
+	{
+		m_ownedData = new char[archivedFile.m_size > 0 ? archivedFile.m_size : 1];
+		if( !DecompressLZ4( archivedFile.m_data, archivedFile.m_storedSize, m_ownedData, archivedFile.m_size ) )
+		{
+			Close();
+			return false;
+		}
+		m_data = m_ownedData;
+	}
+	else
+	{
+		m_data = archivedFile.m_data;
+	}
+	m_size = archivedFile.m_size;
+	m_isArchived = true;
+	m_isOpen = true;
+	return true;
+}
+
+bool FileView::OpenLoose( std::string const& filename )
+{
+	Close();
+
+#if defined( _WIN32 )
+	HANDLE file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+	if( file == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx( file, &fileSize ) )
+	{
+		CloseHandle( file );
+		return false;
+	}
+	m_fileHandle = file;
+	m_isOpen = true;
+
+	// an empty file can't be mapped, and doesn't need to be
+	if( fileSize.QuadPart == 0 )
+	{
+		return true;
+	}
+
+	m_mappingHandle = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	void* view = m_mappingHandle != nullptr ? MapViewOfFile( m_mappingHandle, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+	if( view == nullptr )
+	{
+		Close();
+		return false;
+	}
+	m_data = static_cast<char const*>( view );
+	m_size = (size_t)fileSize.QuadPart;
+	m_isMapped = true;
+#else
+	int file = open( filename.c_str(), O_RDONLY );
+	if( file < 0 )
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if( fstat( file, &fileStat ) != 0 )
+	{
+		close( file );
+		return false;
+	}
+	m_isOpen = true;
+
+	if( fileStat.st_size > 0 )
+	{
+		void* view = mmap( nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+		if( view == MAP_FAILED )
+		{
+			close( file );
+			m_isOpen = false;
+			return false;
+		}
+		m_data = static_cast<char const*>( view );
+		m_size = (size_t)fileStat.st_size;
+		m_isMapped = true;
+	}
+
+	// the mapping keeps the file alive on its own
+	close( file );
+#endif
+
+	return true;
+}
+
+void FileView::Close()
+{
+#if defined( _WIN32 )
+	if( m_isMapped )
+	{
+		UnmapViewOfFile( m_data );
+	}
+	if( m_mappingHandle != nullptr )
+	{
+		CloseHandle( m_mappingHandle );
+	}
+	if( m_fileHandle != nullptr )
+	{
+		CloseHandle( m_fileHandle );
+	}
+#else
+	if( m_isMapped )
+	{
+		munmap( const_cast<char*>( m_data ), m_size );
+	}
+#endif
+	delete[] m_ownedData;
+
+	m_data = "";
+	m_ownedData = nullptr;
+	m_isArchived = false;
+	m_isMapped = false;
+	m_size = 0;
+	m_isOpen = false;
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+}
+
+//------------------------------------------------------------------------
+bool TextSpan::Equals( char const* text ) const
+{
+	size_t textLength = strlen( text );
+	return textLength == GetLength() && memcmp( m_begin, text, textLength ) == 0;
+}
+
+bool TextSpan::StartsWith( char const* prefix ) const
+{
+	size_t prefixLength = strlen( prefix );
+	return prefixLength <= GetLength() && memcmp( m_begin, prefix, prefixLength ) == 0;
+}
+
+// the span isn't null terminated (a mapped file may end right at a page boundary), from_chars doesn't need it to be
+int TextSpan::ToInt( int defaultValue ) const
+{
+	int value = defaultValue;
+	Parse( &value, ToView() );
+	return value;
+}
+
+float TextSpan::ToFloat( float defaultValue ) const
+{
+	float value = defaultValue;
+	Parse( &value, ToView() );
+	return value;
+}
+
+//------------------------------------------------------------------------
+TextLineReader::TextLineReader( char const* data, size_t size )
+	:m_current( data ),
+	m_end( data + size )
+{
+}
+
+TextLineReader::TextLineReader( FileView const& file )
+	:TextLineReader( file.GetData(), file.GetSize() )
+{
+}
+
+bool TextLineReader::ReadLine( TextSpan& out_line )
+{
+	if( m_current >= m_end )
+	{
+		return false;
+	}
+
+	char const* lineEnd = static_cast<char const*>( memchr( m_current, '\n', (size_t)( m_end - m_current ) ) );
+	char const* nextLine = lineEnd != nullptr ? lineEnd + 1 : m_end;
+	lineEnd = lineEnd != nullptr ? lineEnd : m_end;
+	if( lineEnd > m_current && lineEnd[-1] == '\r' )
+	{
+		lineEnd--;
+	}
+
+	out_line = TextSpan( m_current, lineEnd );
+	m_current = nextLine;
+	m_lineNumber++;
+	return true;
+}
+
+//------------------------------------------------------------------------
+TextTokenReader::TextTokenReader( TextSpan const& text, char const* delimiters, bool keepEmptyTokens )
+	:m_current( text.m_begin ),
+	m_end( text.m_end ),
+	m_delimiters( delimiters ),
+	m_keepEmptyTokens( keepEmptyTokens )
+{
+}
+
+bool TextTokenReader::ReadToken( TextSpan& out_token )
+{
+	if( m_keepEmptyTokens )
+	{
+		if( m_isDone )
+		{
+			return false;
+		}
+	}
+	else
+	{
+		while( m_current < m_end && IsDelimiter( *m_current ) )
+		{
+			m_current++;
+		}
+		if( m_current >= m_end )
+		{
+			return false;
+		}
+	}
+
+	char const* tokenBegin = m_current;
+	while( m_current < m_end && !IsDelimiter( *m_current ) )
+	{
+		m_current++;
+	}
+	out_token = TextSpan( tokenBegin, m_current );
+
+	// step over the delimiter, running off the end means that was the last token
+	if( m_current < m_end )
+	{
+		m_current++;
+	}
+	else
+	{
+		m_isDone = true;
+	}
+	return true;
+}
+
+bool TextTokenReader::IsDelimiter( char c ) const
+{
+	return strchr( m_delimiters, c ) != nullptr && c != '\0';
+}
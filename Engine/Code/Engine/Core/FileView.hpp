@@ -0,0 +1,107 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <string_view>
+
+//------------------------------------------------------------------------
+// Read-only memory mapped view of a whole file. The bytes come straight from the OS file
+// cache and nothing is copied until it gets parsed. The data is NOT null terminated.
+// Files in a mounted asset archive (see AssetArchive.hpp) are served from the archive,
+// only compressed entries get their own buffer.
+//------------------------------------------------------------------------
+class FileView
+{
+public:
+	FileView() {}
+	explicit FileView( std::string const& filename );
+	~FileView();
+
+	FileView( FileView const& copyFrom ) = delete;
+	FileView& operator=( FileView const& copyFrom ) = delete;
+
+	bool Open( std::string const& filename );		// closes whatever was open, false if the file can't be read
+	bool OpenLoose( std::string const& filename );	// skips the mounted archives
+	void Close();
+
+	bool		IsOpen() const		{ return m_isOpen; }
+	bool		IsArchived() const	{ return m_isArchived; }
+	bool		IsPersistent() const	{ return m_isArchived && m_ownedData == nullptr; }	// data outlives the view, until the archive is unmounted
+	char const*	GetData() const		{ return m_data; }
+	size_t		GetSize() const		{ return m_size; }
+
+private:
+	bool OpenArchived( std::string const& filename );
+
+private:
+	char const* m_data = "";
+	size_t m_size = 0;
+	bool m_isOpen = false;
+	bool m_isArchived = false;
+	bool m_isMapped = false;
+	char* m_ownedData = nullptr;
+
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+};
+
+//------------------------------------------------------------------------
+// Non-owning [begin, end) range of characters, usually pointing into a FileView
+//------------------------------------------------------------------------
+struct TextSpan
+{
+	TextSpan() {}
+	TextSpan( char const* begin, char const* end ) : m_begin( begin ), m_end( end ) {}
+
+	size_t		GetLength() const						{ return (size_t)( m_end - m_begin ); }
+	bool		IsEmpty() const							{ return m_begin == m_end; }
+	bool		Equals( char const* text ) const;
+	bool		StartsWith( char const* prefix ) const;
+	std::string	ToString() const						{ return std::string( m_begin, m_end ); }
+	std::string_view ToView() const						{ return std::string_view( m_begin, GetLength() ); }
+
+	int			ToInt( int defaultValue = 0 ) const;		// defaultValue if it doesn't start with a number
+	float		ToFloat( float defaultValue = 0.f ) const;
+
+public:
+	char const* m_begin = nullptr;
+	char const* m_end = nullptr;
+};
+
+//------------------------------------------------------------------------
+// Walks text a line at a time without copying. Handles \n and \r\n endings.
+//------------------------------------------------------------------------
+class TextLineReader
+{
+public:
+	TextLineReader( char const* data, size_t size );
+	explicit TextLineReader( FileView const& file );
+
+	bool	ReadLine( TextSpan& out_line );		// false once the text runs out
+	int		GetLineNumber() const { return m_lineNumber; }		// 1 based, of the line last read
+
+private:
+	char const* m_current = nullptr;
+	char const* m_end = nullptr;
+	int m_lineNumber = 0;
+};
+
+//------------------------------------------------------------------------
+// Splits a span on any of the delimiter characters without copying
+//------------------------------------------------------------------------
+class TextTokenReader
+{
+public:
+	TextTokenReader( TextSpan const& text, char const* delimiters = " \t", bool keepEmptyTokens = false );
+
+	bool	ReadToken( TextSpan& out_token );		// false once the span runs out
+
+private:
+	bool	IsDelimiter( char c ) const;
+
+private:
+	char const* m_current = nullptr;
+	char const* m_end = nullptr;
+	char const* m_delimiters = nullptr;
+	bool m_keepEmptyTokens = false;
+	bool m_isDone = false;
+};
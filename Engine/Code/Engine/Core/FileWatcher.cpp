@@ -0,0 +1,309 @@
+#include "Engine/Core/FileWatcher.hpp"
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/Time.hpp"
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#if defined( __linux__ )
+#include <sys/inotify.h>
+#endif
+#endif
+
+//------------------------------------------------------------------------
+// how long ago a file was written, from its OS write time
+static double GetSecondsSinceWrite( unsigned long long writeTime )
+{
+#if defined( _WIN32 )
+	FILETIME now;
+	GetSystemTimeAsFileTime( &now );
+	unsigned long long nowTime = ( (unsigned long long)now.dwHighDateTime << 32 ) | now.dwLowDateTime;
+	return nowTime > writeTime ? (double)( nowTime - writeTime ) * 1.0e-7 : 0.0;
+#else
+	timespec now;
+	clock_gettime( CLOCK_REALTIME, &now );
+	unsigned long long nowTime = (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+	return nowTime > writeTime ? (double)( nowTime - writeTime ) * 1.0e-9 : 0.0;
+#endif
+}
+
+//------------------------------------------------------------------------
+FileWatcher::FileWatcher()
+{
+#if defined( __linux__ )
+	m_notifyFile = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+	for( WatchedFolder* folder : m_folders )
+	{
+#if defined( _WIN32 )
+		if( folder->m_changeHandle != nullptr )
+		{
+			FindCloseChangeNotification( folder->m_changeHandle );
+		}
+#endif
+		delete folder;
+	}
+	m_folders.clear();
+
+#if !defined( _WIN32 )
+	if( m_notifyFile >= 0 )
+	{
+		close( m_notifyFile );
+	}
+#endif
+}
+
+//------------------------------------------------------------------------
+void FileWatcher::AddFolder( std::string const& folderPath, char const* filePattern )
+{
+	WatchedFolder* folder = new WatchedFolder();
+	folder->m_path = folderPath;
+	folder->m_pattern = filePattern ? filePattern : "*";
+	m_folders.push_back( folder );
+
+	StartNotifications( *folder );
+
+	std::vector<FileChange> ignoredChanges;
+	double nowSeconds = GetCurrentTimeSeconds();
+	ScanFolder( *folder, true, nowSeconds, ignoredChanges );
+	folder->m_nextScanSeconds = folder->m_isPolled ? nowSeconds + m_pollSeconds : 0.0;
+}
+
+int FileWatcher::GetNumPolledFolders() const
+{
+	int numPolledFolders = 0;
+	for( WatchedFolder const* folder : m_folders )
+	{
+		numPolledFolders += folder->m_isPolled ? 1 : 0;
+	}
+	return numPolledFolders;
+}
+
+//------------------------------------------------------------------------
+void FileWatcher::GetChangedFiles( std::vector<FileChange>& out_changes )
+{
+	ReadNotifications();
+
+	double nowSeconds = GetCurrentTimeSeconds();
+	for( WatchedFolder* folder : m_folders )
+	{
+		bool isScanDue = folder->m_nextScanSeconds > 0.0 && nowSeconds >= folder->m_nextScanSeconds;
+		if( !folder->m_isDirty && !isScanDue )
+		{
+			continue;
+		}
+
+		folder->m_isDirty = false;
+		bool isSettling = ScanFolder( *folder, false, nowSeconds, out_changes );
+		if( isSettling )
+		{
+			folder->m_nextScanSeconds = nowSeconds + m_settleSeconds;
+		}
+		else
+		{
+			folder->m_nextScanSeconds = folder->m_isPolled ? nowSeconds + m_pollSeconds : 0.0;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+void FileWatcher::StartNotifications( WatchedFolder& folder )
+{
+#if defined( _WIN32 )
+	HANDLE changeHandle = FindFirstChangeNotificationA( folder.m_path.c_str(), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE );
+	folder.m_changeHandle = changeHandle != INVALID_HANDLE_VALUE ? changeHandle : nullptr;
+	folder.m_isPolled = folder.m_changeHandle == nullptr;
+#elif defined( __linux__ )
+	if( m_notifyFile >= 0 )
+	{
+		folder.m_watchDescriptor = inotify_add_watch( m_notifyFile, folder.m_path.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO );
+	}
+	folder.m_isPolled = folder.m_watchDescriptor < 0;
+#else
+	folder.m_isPolled = true;
+#endif
+}
+
+void FileWatcher::ReadNotifications()
+{
+#if defined( _WIN32 )
+	for( WatchedFolder* folder : m_folders )
+	{
+		if( folder->m_changeHandle == nullptr || WaitForSingleObject( folder->m_changeHandle, 0 ) != WAIT_OBJECT_0 )
+		{
+			continue;
+		}
+
+		folder->m_isDirty = true;
+		if( !FindNextChangeNotification( folder->m_changeHandle ) )
+		{
+			FindCloseChangeNotification( folder->m_changeHandle );
+			folder->m_changeHandle = nullptr;
+			folder->m_isPolled = true;
+		}
+	}
+#elif defined( __linux__ )
+	if( m_notifyFile < 0 )
+	{
+		return;
+	}
+
+	// only which folder matters, the rescan works out what happened to which file
+	alignas( inotify_event ) char events[4096];
+	for( ssize_t numBytes = read( m_notifyFile, events, sizeof( events ) ); numBytes > 0; numBytes = read( m_notifyFile, events, sizeof( events ) ) )
+	{
+		for( char const* eventBytes = events; eventBytes < events + numBytes; )
+		{
+			inotify_event const* event = reinterpret_cast<inotify_event const*>( eventBytes );
+			eventBytes += sizeof( inotify_event ) + event->len;
+			for( WatchedFolder* folder : m_folders )
+			{
+				bool isOverflow = ( event->mask & IN_Q_OVERFLOW ) != 0;
+				if( !isOverflow && folder->m_watchDescriptor != event->wd )
+				{
+					continue;
+				}
+
+				folder->m_isDirty = true;
+				if( ( event->mask & IN_IGNORED ) != 0 )
+				{
+					folder->m_watchDescriptor = -1;
+					folder->m_isPolled = true;
+				}
+			}
+		}
+	}
+#endif
+}
+
+//------------------------------------------------------------------------
+bool FileWatcher::ScanFolder( WatchedFolder& folder, bool isFirstScan, double nowSeconds, std::vector<FileChange>& out_changes )
+{
+	for( WatchedFile& file : folder.m_files )
+	{
+		file.m_isSeen = false;
+	}
+
+	// a handful of files per folder, a linear search is fine
+	auto noteFile = [&]( char const* fileName, unsigned long long writeTime, unsigned long long size )
+	{
+		WatchedFile* watchedFile = nullptr;
+		for( WatchedFile& file : folder.m_files )
+		{
+			if( file.m_name == fileName )
+			{
+				watchedFile = &file;
+				break;
+			}
+		}
+		if( watchedFile == nullptr )
+		{
+			folder.m_files.emplace_back();
+			watchedFile = &folder.m_files.back();
+			watchedFile->m_name = fileName;
+			watchedFile->m_writeTime = writeTime;
+			watchedFile->m_size = size;
+			watchedFile->m_isPending = !isFirstScan;
+			watchedFile->m_writtenSeconds = nowSeconds - GetSecondsSinceWrite( writeTime );
+			watchedFile->m_lastChangeSeconds = nowSeconds;
+		}
+		else if( watchedFile->m_writeTime != writeTime || watchedFile->m_size != size )
+		{
+			watchedFile->m_writtenSeconds = nowSeconds - GetSecondsSinceWrite( writeTime );
+			watchedFile->m_writeTime = writeTime;
+			watchedFile->m_size = size;
+			watchedFile->m_isPending = true;
+			watchedFile->m_lastChangeSeconds = nowSeconds;
+		}
+		watchedFile->m_isSeen = true;
+	};
+
+#if defined( _WIN32 )
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle = FindFirstFileA( ( folder.m_path + "/" + folder.m_pattern ).c_str(), &findData );
+	if( findHandle != INVALID_HANDLE_VALUE )
+	{
+		do
+		{
+			if( ( findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == 0 )
+			{
+				unsigned long long writeTime = ( (unsigned long long)findData.ftLastWriteTime.dwHighDateTime << 32 ) | findData.ftLastWriteTime.dwLowDateTime;
+				unsigned long long size = ( (unsigned long long)findData.nFileSizeHigh << 32 ) | findData.nFileSizeLow;
+				noteFile( findData.cFileName, writeTime, size );
+			}
+		} while( FindNextFileA( findHandle, &findData ) );
+		FindClose( findHandle );
+	}
+#else
+	DIR* directory = opendir( folder.m_path.c_str() );
+	if( directory != nullptr )
+	{
+		for( dirent* entry = readdir( directory ); entry != nullptr; entry = readdir( directory ) )
+		{
+			struct stat fileStat;
+			std::string filePath = folder.m_path + "/" + entry->d_name;
+			if( stat( filePath.c_str(), &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) && DoesFileNameMatchPattern( entry->d_name, folder.m_pattern.c_str() ) )
+			{
+				unsigned long long writeTime = (unsigned long long)fileStat.st_mtim.tv_sec * 1000000000ULL + (unsigned long long)fileStat.st_mtim.tv_nsec;
+				noteFile( entry->d_name, writeTime, (unsigned long long)fileStat.st_size );
+			}
+		}
+		closedir( directory );
+	}
+#endif
+
+	bool isSettling = false;
+	for( size_t fileIndex = 0; fileIndex < folder.m_files.size(); )
+	{
+		WatchedFile& file = folder.m_files[fileIndex];
+		if( !file.m_isSeen )
+		{
+			// editors that save by delete + rename leave a gap, so a file only counts as removed once it stays gone
+			if( !file.m_isPending )
+			{
+				file.m_isPending = true;
+				file.m_lastChangeSeconds = nowSeconds;
+			}
+			if( nowSeconds - file.m_lastChangeSeconds < m_settleSeconds )
+			{
+				isSettling = true;
+				fileIndex++;
+				continue;
+			}
+
+			FileChange change;
+			change.m_filePath = folder.m_path + "/" + file.m_name;
+			change.m_writtenSeconds = nowSeconds;
+			change.m_wasRemoved = true;
+			out_changes.push_back( change );
+			folder.m_files.erase( folder.m_files.begin() + fileIndex );
+			continue;
+		}
+
+		if( file.m_isPending )
+		{
+			if( nowSeconds - file.m_lastChangeSeconds >= m_settleSeconds )
+			{
+				FileChange change;
+				change.m_filePath = folder.m_path + "/" + file.m_name;
+				change.m_writtenSeconds = file.m_writtenSeconds;
+				out_changes.push_back( change );
+				file.m_isPending = false;
+			}
+			else
+			{
+				isSettling = true;
+			}
+		}
+		fileIndex++;
+	}
+	return isSettling;
+}
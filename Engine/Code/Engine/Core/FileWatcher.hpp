@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Reports files in a set of folders that were written, added or removed. Each folder asks the OS
+// for change notifications (a change handle on Windows, inotify elsewhere) and is only rescanned
+// once one arrives; a folder the OS won't watch is rescanned every m_pollSeconds instead.
+//
+// a written file is reported once it has stopped changing for m_settleSeconds, editors
+// often save in more than one write
+//------------------------------------------------------------------------
+struct FileChange
+{
+	std::string	m_filePath;					// folder path + "/" + file name
+	double		m_writtenSeconds = 0.0;		// GetCurrentTimeSeconds() clock, estimated from the file's write time
+	bool		m_wasRemoved = false;
+};
+
+class FileWatcher
+{
+public:
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatcher( FileWatcher const& copyFrom ) = delete;
+	FileWatcher& operator=( FileWatcher const& copyFrom ) = delete;
+
+	void	AddFolder( std::string const& folderPath, char const* filePattern );	// not recursive, files already there aren't reported
+	void	GetChangedFiles( std::vector<FileChange>& out_changes );				// main thread, once a frame
+
+	int		GetNumFolders() const			{ return (int)m_folders.size(); }
+	int		GetNumPolledFolders() const;	// folders without OS notifications
+
+public:
+	double	m_settleSeconds = 0.1;
+	double	m_pollSeconds = 0.5;
+
+private:
+	struct WatchedFile
+	{
+		std::string			m_name;
+		unsigned long long	m_writeTime = 0;		// 100ns ticks since 1601 on Windows, ns since 1970 elsewhere
+		unsigned long long	m_size = 0;
+		double				m_writtenSeconds = 0.0;
+		double				m_lastChangeSeconds = 0.0;
+		bool				m_isPending = false;
+		bool				m_isSeen = false;
+	};
+
+	struct WatchedFolder
+	{
+		std::string					m_path;
+		std::string					m_pattern;
+		void*						m_changeHandle = nullptr;	// Windows
+		int							m_watchDescriptor = -1;		// inotify
+		bool						m_isPolled = false;
+		bool						m_isDirty = false;			// the OS said something changed since the last scan
+		double						m_nextScanSeconds = 0.0;	// 0 waits for a notification
+		std::vector<WatchedFile>	m_files;
+	};
+
+	void	StartNotifications( WatchedFolder& folder );
+	void	ReadNotifications();
+	bool	ScanFolder( WatchedFolder& folder, bool isFirstScan, double nowSeconds, std::vector<FileChange>& out_changes );	// true while a file is still settling
+
+private:
+	std::vector<WatchedFolder*>	m_folders;
+	int							m_notifyFile = -1;		// the inotify instance
+};
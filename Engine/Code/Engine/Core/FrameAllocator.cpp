@@ -0,0 +1,150 @@
+#include "Engine/Core/FrameAllocator.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <atomic>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr size_t FRAME_ARENA_MIN_BLOCK_BYTES = 256 * 1024;
+
+static std::atomic<unsigned int> s_frameArenaFrameIndex( 0 );
+
+//------------------------------------------------------------------------
+struct FrameArenaBlock
+{
+	FrameArenaBlock* m_previous = nullptr;	// blocks this frame filled before this one
+	size_t m_capacity = 0;
+	size_t m_used = 0;
+	size_t m_padding = 0;
+
+	unsigned char* GetData() { return reinterpret_cast<unsigned char*>( this + 1 ); }
+};
+static_assert( sizeof( FrameArenaBlock ) % 16 == 0, "block data must start 16 byte aligned" );
+
+struct FrameArena
+{
+	FrameArenaBlock* m_currentBlock = nullptr;
+	unsigned int m_frameIndex = 0;
+	size_t m_bytesUsed = 0;
+
+	void Reset( unsigned int frameIndex );
+	void* Allocate( size_t numBytes, size_t alignment );
+	void FreeBlocks();
+};
+
+//------------------------------------------------------------------------
+static FrameArenaBlock* CreateFrameArenaBlock( size_t capacity, FrameArenaBlock* previous )
+{
+	// straight from malloc, the arena is what lets per-frame code skip operator new
+	void* memory = malloc( sizeof( FrameArenaBlock ) + capacity );
+	GUARANTEE_OR_DIE( memory != nullptr, "Out of memory for the frame arena" );
+
+	FrameArenaBlock* block = new( memory ) FrameArenaBlock();
+	block->m_previous = previous;
+	block->m_capacity = capacity;
+	return block;
+}
+
+void FrameArena::Reset( unsigned int frameIndex )
+{
+	m_frameIndex = frameIndex;
+	m_bytesUsed = 0;
+	if( m_currentBlock == nullptr )
+	{
+		return;
+	}
+
+	// if last time needed several blocks, replace them with one that fits all of it
+	if( m_currentBlock->m_previous != nullptr )
+	{
+		size_t totalCapacity = 0;
+		for( FrameArenaBlock* block = m_currentBlock; block != nullptr; block = block->m_previous )
+		{
+			totalCapacity += block->m_capacity;
+		}
+		FreeBlocks();
+		m_currentBlock = CreateFrameArenaBlock( totalCapacity, nullptr );
+		return;
+	}
+
+#if defined( _DEBUG )
+	// make stale frame memory obvious
+	memset( m_currentBlock->GetData(), 0xFA, m_currentBlock->m_used );
+#endif
+	m_currentBlock->m_used = 0;
+}
+
+void* FrameArena::Allocate( size_t numBytes, size_t alignment )
+{
+	if( m_currentBlock != nullptr )
+	{
+		uintptr_t dataAddress = reinterpret_cast<uintptr_t>( m_currentBlock->GetData() );
+		uintptr_t alignedAddress = ( dataAddress + m_currentBlock->m_used + alignment - 1 ) & ~( (uintptr_t)alignment - 1 );
+		size_t alignedOffset = (size_t)( alignedAddress - dataAddress );
+		if( alignedOffset + numBytes <= m_currentBlock->m_capacity )
+		{
+			m_currentBlock->m_used = alignedOffset + numBytes;
+			m_bytesUsed += numBytes;
+			return m_currentBlock->GetData() + alignedOffset;
+		}
+	}
+
+	// block data starts 16 byte aligned, so only larger alignments need slack
+	size_t capacity = numBytes + ( alignment > 16 ? alignment : 0 );
+	capacity = capacity > FRAME_ARENA_MIN_BLOCK_BYTES ? capacity : FRAME_ARENA_MIN_BLOCK_BYTES;
+	m_currentBlock = CreateFrameArenaBlock( capacity, m_currentBlock );
+	return Allocate( numBytes, alignment );
+}
+
+void FrameArena::FreeBlocks()
+{
+	while( m_currentBlock != nullptr )
+	{
+		FrameArenaBlock* previous = m_currentBlock->m_previous;
+		free( m_currentBlock );
+		m_currentBlock = previous;
+	}
+}
+
+//------------------------------------------------------------------------
+struct FrameArenaPair
+{
+	~FrameArenaPair()
+	{
+		m_arenas[0].FreeBlocks();
+		m_arenas[1].FreeBlocks();
+	}
+
+	FrameArena& GetCurrentArena()
+	{
+		unsigned int frameIndex = s_frameArenaFrameIndex.load( std::memory_order_relaxed );
+		FrameArena& arena = m_arenas[frameIndex & 1];
+		if( arena.m_frameIndex != frameIndex )
+		{
+			arena.Reset( frameIndex );
+		}
+		return arena;
+	}
+
+	FrameArena m_arenas[2];
+};
+
+static thread_local FrameArenaPair t_frameArenas;
+
+//------------------------------------------------------------------------
+void FrameArenaBeginFrame()
+{
+	s_frameArenaFrameIndex.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void* FrameArenaAllocate( size_t numBytes, size_t alignment )
+{
+	GUARANTEE_OR_DIE( alignment != 0 && ( alignment & ( alignment - 1 ) ) == 0, "Frame arena alignment must be a power of two" );
+	return t_frameArenas.GetCurrentArena().Allocate( numBytes > 0 ? numBytes : 1, alignment );
+}
+
+size_t GetFrameArenaBytesUsed()
+{
+	return t_frameArenas.GetCurrentArena().m_bytesUsed;
+}
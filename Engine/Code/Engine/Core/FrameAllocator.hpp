@@ -0,0 +1,41 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Thread-local bump allocator for transient per-frame data.
+// Every thread owns two arenas and alternates between them each frame, so memory allocated
+// during frame N stays valid until the end of frame N+1 and is reused after that.
+// Nothing is freed individually; never keep frame memory in an object that outlives that.
+// Job threads flip on their next allocation after a frame starts, so a job should not hold
+// frame memory across more than one frame boundary.
+//------------------------------------------------------------------------
+void	FrameArenaBeginFrame();										// main thread, App::BeginFrame
+void*	FrameArenaAllocate( size_t numBytes, size_t alignment = 16 );	// any thread
+size_t	GetFrameArenaBytesUsed();										// this thread, current frame
+
+//------------------------------------------------------------------------
+template <typename T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	FrameAllocator() = default;
+	template <typename U>
+	FrameAllocator( FrameAllocator<U> const& copyFrom ) { (void)copyFrom; }
+
+	T* allocate( size_t count )					{ return static_cast<T*>( FrameArenaAllocate( count * sizeof( T ), alignof( T ) ) ); }
+	void deallocate( T* ptr, size_t count )		{ (void)ptr; (void)count; }	// reclaimed when the arena flips back
+};
+
+template <typename T, typename U>
+bool operator==( FrameAllocator<T> const&, FrameAllocator<U> const& )	{ return true; }
+template <typename T, typename U>
+bool operator!=( FrameAllocator<T> const&, FrameAllocator<U> const& )	{ return false; }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+typedef FrameVector<std::string> FrameStrings;
@@ -1,12 +1,85 @@
 #include "Image.hpp"
-#include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/FileView.hpp"
+#include "Engine/Core/ImageUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
 
 #include "ThirdParty/stb/stb_image.h"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
-#include "Engine/Core/EngineCommon.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#include <intrin.h>
+#include <tmmintrin.h>
+#define IMAGE_USE_SSSE3
+#endif
+
+//------------------------------------------------------------------------
+#if defined( IMAGE_USE_SSSE3 )
+static bool IsSSSE3Supported()
+{
+	int cpuInfo[4] = {};
+	__cpuid( cpuInfo, 1 );
+	return ( cpuInfo[2] & ( 1 << 9 ) ) != 0;
+}
+
+static const bool s_isSSSE3Supported = IsSSSE3Supported();
+#endif
+
+// numTexels RGB triples to RGBA with alpha 255
+static void ExpandRGBToRGBA( const unsigned char* rgb, unsigned char* rgba, int numTexels )
+{
+	int texelIndex = 0;
+#if defined( IMAGE_USE_SSSE3 )
+	if( s_isSSSE3Supported )
+	{
+		// 16 texels from three loads, so nothing past the end of the row gets read
+		const __m128i spreadRGB = _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+		const __m128i opaqueAlpha = _mm_set1_epi32( (int)0xFF000000 );
+		for( ; texelIndex + 16 <= numTexels; texelIndex += 16 )
+		{
+			const __m128i* source = reinterpret_cast<const __m128i*>( rgb + texelIndex * 3 );
+			__m128i* destination = reinterpret_cast<__m128i*>( rgba + texelIndex * 4 );
+			__m128i bytes0 = _mm_loadu_si128( source );
+			__m128i bytes1 = _mm_loadu_si128( source + 1 );
+			__m128i bytes2 = _mm_loadu_si128( source + 2 );
+
+			_mm_storeu_si128( destination, _mm_or_si128( _mm_shuffle_epi8( bytes0, spreadRGB ), opaqueAlpha ) );
+			_mm_storeu_si128( destination + 1, _mm_or_si128( _mm_shuffle_epi8( _mm_alignr_epi8( bytes1, bytes0, 12 ), spreadRGB ), opaqueAlpha ) );
+			_mm_storeu_si128( destination + 2, _mm_or_si128( _mm_shuffle_epi8( _mm_alignr_epi8( bytes2, bytes1, 8 ), spreadRGB ), opaqueAlpha ) );
+			_mm_storeu_si128( destination + 3, _mm_or_si128( _mm_shuffle_epi8( _mm_srli_si128( bytes2, 4 ), spreadRGB ), opaqueAlpha ) );
+		}
+	}
+#endif
 
+	for( ; texelIndex < numTexels; texelIndex++ )
+	{
+		rgba[texelIndex * 4 + 0] = rgb[texelIndex * 3 + 0];
+		rgba[texelIndex * 4 + 1] = rgb[texelIndex * 3 + 1];
+		rgba[texelIndex * 4 + 2] = rgb[texelIndex * 3 + 2];
+		rgba[texelIndex * 4 + 3] = 255;
+	}
+}
+
+static void FlipRowsInPlace( unsigned char* texels, int rowSize, int numRows )
+{
+	unsigned char* swapRow = static_cast<unsigned char*>( malloc( rowSize ) );
+	for( int rowIndex = 0; rowIndex < numRows / 2; rowIndex++ )
+	{
+		unsigned char* topRow = texels + (size_t)rowIndex * rowSize;
+		unsigned char* bottomRow = texels + (size_t)( numRows - 1 - rowIndex ) * rowSize;
+		memcpy( swapRow, topRow, rowSize );
+		memcpy( topRow, bottomRow, rowSize );
+		memcpy( bottomRow, swapRow, rowSize );
+	}
+	free( swapRow );
+}
+
+//------------------------------------------------------------------------
 Image::Image( const char* imageFilePath, bool isFlipVertically )
 	:m_imageFilePath( imageFilePath )
 {
@@ -15,92 +88,62 @@ Image::Image( const char* imageFilePath, bool isFlipVertically )
 	int numComponents = 0; // This will be filled in for us to indicate how many color components the image had (e.g. 3=RGB=24bit, 4=RGBA=32bit)
 	int numComponentsRequested = 0; // don't care; we support 3 (24-bit RGB) or 4 (32-bit RGBA)
 
-	// Load (and decompress) the image RGB(A) bytes from a file on disk into a memory buffer (array of bytes)
-	if ( isFlipVertically )
-	{
-		stbi_set_flip_vertically_on_load( 1 );
-	}
-	else
-	{
-		stbi_set_flip_vertically_on_load( 0 );
-	}
-	unsigned char* imageData = stbi_load( imageFilePath, &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
+	// Decode unflipped, the flip is folded into the copy below. stb's flip flag is global
+	// and images are decoded on several threads at once.
+	FileView imageFile( imageFilePath );
+	unsigned char* imageData = stbi_load_from_memory( reinterpret_cast<unsigned char const*>( imageFile.GetData() ), (int)imageFile.GetSize(), &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
 
 	// Check if the load was successful
 	GUARANTEE_OR_DIE( imageData, Stringf( "Failed to load image \"%s\"", imageFilePath ) );
-	GUARANTEE_OR_DIE( numComponents == 4 || numComponents == 3 && imageTexelSizeX > 0 && imageTexelSizeY > 0, Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)", imageFilePath, numComponents, imageTexelSizeX, imageTexelSizeY ) );
+	GUARANTEE_OR_DIE( ( numComponents == 4 || numComponents == 3 ) && imageTexelSizeX > 0 && imageTexelSizeY > 0, Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)", imageFilePath, numComponents, imageTexelSizeX, imageTexelSizeY ) );
+	m_dimensions = IntVec2( imageTexelSizeX, imageTexelSizeY );
 
-	unsigned int bytePerPixel = numComponents;
-	int size = imageTexelSizeY * imageTexelSizeX;
-	std::vector<unsigned char> c( imageData, imageData+size );
-	for ( int index = 0; index < size; index++ )
+	if( numComponents == 4 )
 	{
-		Rgba8 color = Rgba8();
-		unsigned char* pixelOffset = imageData + (index * bytePerPixel);
-		color.r = pixelOffset[0];
-		color.g = pixelOffset[1];
-		color.b = pixelOffset[2];
-
-		if( numComponents == 4 )
+		// already RGBA8, keep stb's buffer
+		if( isFlipVertically )
 		{
-			color.a = pixelOffset[3];
+			FlipRowsInPlace( imageData, imageTexelSizeX * 4, imageTexelSizeY );
 		}
-
-		m_rgbaTexels.push_back( color );
+		m_texels = reinterpret_cast<Rgba8*>( imageData );
+		return;
 	}
-	m_dimensions = IntVec2( imageTexelSizeX, imageTexelSizeY );
 
+	m_texels = static_cast<Rgba8*>( malloc( (size_t)imageTexelSizeX * imageTexelSizeY * sizeof( Rgba8 ) ) );
+	unsigned char* texelBytes = reinterpret_cast<unsigned char*>( m_texels );
+	for( int rowIndex = 0; rowIndex < imageTexelSizeY; rowIndex++ )
+	{
+		int sourceRowIndex = isFlipVertically ? imageTexelSizeY - 1 - rowIndex : rowIndex;
+		ExpandRGBToRGBA( imageData + (size_t)sourceRowIndex * imageTexelSizeX * 3, texelBytes + (size_t)rowIndex * imageTexelSizeX * 4, imageTexelSizeX );
+	}
 	stbi_image_free( imageData );
 }
 
-Image::Image( const Image& copyFrom, int numRotations )
+Image::Image( const IntVec2& dimensions, const Rgba8& fillColor )
+	: m_dimensions( dimensions )
 {
-	m_imageFilePath = copyFrom.m_imageFilePath;
-
-	// 90 degrees
-	if ( numRotations == 1 )
+	m_texels = static_cast<Rgba8*>( malloc( (size_t)GetNumTexels() * sizeof( Rgba8 ) ) );
+	for( int texelIndex = 0; texelIndex < GetNumTexels(); texelIndex++ )
 	{
-		for ( int xIndex = 0; xIndex < copyFrom.m_dimensions.x; xIndex++ )
-		{
-			for( int yIndex = copyFrom.m_dimensions.y - 1; yIndex >= 0; yIndex-- )
-			{
-				m_rgbaTexels.push_back( copyFrom.GetTexelColor( xIndex, yIndex ) );
-			}
-		}
-		m_dimensions = IntVec2( copyFrom.m_dimensions.y, copyFrom.m_dimensions.x );
-	}
-	// 180 degrees
-	else if ( numRotations == 2 )
-	{
-		m_dimensions = copyFrom.m_dimensions;
-		for( int yIndex = m_dimensions.y - 1; yIndex >= 0; yIndex-- )
-		{
-			for( int xIndex = m_dimensions.x - 1; xIndex >= 0; xIndex-- )
-			{
-				m_rgbaTexels.push_back( copyFrom.GetTexelColor( xIndex, yIndex ) );
-			}
-		}
-	}
-	// 270 degrees
-	else if( numRotations == 3 )
-	{
-		for( int xIndex = copyFrom.m_dimensions.x - 1; xIndex >= 0; xIndex-- )
-		{
-			for( int yIndex = 0; yIndex < copyFrom.m_dimensions.y; yIndex++ )
-			{
-				m_rgbaTexels.push_back( copyFrom.GetTexelColor( xIndex, yIndex ) );
-			}
-		}
-		m_dimensions = IntVec2( copyFrom.m_dimensions.y, copyFrom.m_dimensions.x );
-	}
-	// 0 degree
-	else
-	{
-		m_dimensions = copyFrom.m_dimensions;
-		m_rgbaTexels = copyFrom.m_rgbaTexels;
+		m_texels[texelIndex] = fillColor;
 	}
 }
 
+Image::Image( const Image& copyFrom, int numRotations )
+	: m_imageFilePath( copyFrom.m_imageFilePath )
+{
+	numRotations = ( ( numRotations % 4 ) + 4 ) % 4;
+	m_dimensions = ( numRotations % 2 == 0 ) ? copyFrom.m_dimensions : IntVec2( copyFrom.m_dimensions.y, copyFrom.m_dimensions.x );
+	m_texels = static_cast<Rgba8*>( malloc( (size_t)copyFrom.GetNumTexels() * sizeof( Rgba8 ) ) );
+	RotateTexels( copyFrom.m_texels, copyFrom.m_dimensions, m_texels, numRotations );
+}
+
+Image::~Image()
+{
+	free( m_texels );
+	m_texels = nullptr;
+}
+
 const std::string& Image::GetImageFilePath() const
 {
 	return m_imageFilePath;
@@ -113,47 +156,140 @@ IntVec2 Image::GetDimensions() const
 
 Rgba8 Image::GetTexelColor( int texelIndex ) const
 {
-	return m_rgbaTexels[texelIndex];
+	return m_texels[texelIndex];
 }
 
 Rgba8 Image::GetTexelColor( int texelX, int texelY ) const
 {
 	int index = texelX + ( m_dimensions.x * texelY );
-	return m_rgbaTexels[index];
+	return m_texels[index];
 }
 
 Rgba8 Image::GetTexelColor( const IntVec2& texelCoords ) const
 {
 	int index = texelCoords.x + (m_dimensions.x * texelCoords.y);
-	return m_rgbaTexels[index];
+	return m_texels[index];
 }
 
-unsigned char* Image::GetTexelsBuffer()
+void Image::SetTexelColor( int texelX, int texelY, const Rgba8& newColor )
 {
-	const int size = (int) m_rgbaTexels.size();
-	unsigned int bytePerPixel = 4;
-	unsigned char* texels = new unsigned char[size * bytePerPixel];
-	for ( int i = 0; i < size; ++i )
+	int index = texelX + ( m_dimensions.x * texelY );
+	m_texels[index] = newColor;
+}
+
+void Image::SetTexelColor( const IntVec2& texelCoords, const Rgba8& newColor )
+{
+	int index = texelCoords.x + (m_dimensions.x * texelCoords.y);
+	m_texels[index] = newColor;
+}
+
+//------------------------------------------------------------------------
+void LoadImagesInParallel( const std::vector<std::string>& imageFilePaths, std::vector<Image*>& out_images, bool isFlipVertically )
+{
+	out_images.assign( imageFilePaths.size(), nullptr );
+	Image** images = out_images.data();
+	auto decodeImages = [&imageFilePaths, images, isFlipVertically]( int beginIndex, int endIndex )
+	{
+		for( int imageIndex = beginIndex; imageIndex < endIndex; imageIndex++ )
+		{
+			images[imageIndex] = new Image( imageFilePaths[imageIndex].c_str(), isFlipVertically );
+		}
+	};
+
+	// one image per job, sizes vary too much for bigger chunks to balance
+	if( g_theJobSystem != nullptr )
 	{
-		Rgba8 color = m_rgbaTexels[i];
-		unsigned char* pixelOffset = texels + (i * bytePerPixel);
-		pixelOffset[0] = color.r;
-		pixelOffset[1] = color.g;
-		pixelOffset[2] = color.b;
-		pixelOffset[3] = color.a;
+		g_theJobSystem->ParallelFor( 0, (int)imageFilePaths.size(), 1, decodeImages );
 	}
+	else
+	{
+		decodeImages( 0, (int)imageFilePaths.size() );
+	}
+}
 
-	return texels;
+//------------------------------------------------------------------------
+static void AppendImageFilePathsInFolder( const std::string& folderPath, std::vector<std::string>& out_imageFilePaths )
+{
+	Strings fileNames = GetFileNamesInFolder( folderPath, "*.png" );
+	for( const std::string& fileName : fileNames )
+	{
+		out_imageFilePaths.push_back( folderPath + "/" + fileName );
+	}
 }
 
-void Image::SetTexelColor( int texelX, int texelY, const Rgba8& newColor )
+// what Image used to do: decode, then push_back a texel at a time
+static size_t LoadImageLegacy( const std::string& imageFilePath )
 {
-	int index = texelX + ( m_dimensions.x * texelY );
-	m_rgbaTexels[index] = newColor;
+	int imageTexelSizeX = 0;
+	int imageTexelSizeY = 0;
+	int numComponents = 0;
+	stbi_set_flip_vertically_on_load( 1 );
+	unsigned char* imageData = stbi_load( imageFilePath.c_str(), &imageTexelSizeX, &imageTexelSizeY, &numComponents, 0 );
+	stbi_set_flip_vertically_on_load( 0 );
+	if( imageData == nullptr )
+	{
+		return 0;
+	}
+
+	std::vector<Rgba8> texels;
+	for( int texelIndex = 0; texelIndex < imageTexelSizeX * imageTexelSizeY; texelIndex++ )
+	{
+		unsigned char* pixelOffset = imageData + texelIndex * numComponents;
+		texels.push_back( Rgba8( pixelOffset[0], pixelOffset[1], pixelOffset[2], numComponents == 4 ? pixelOffset[3] : 255 ) );
+	}
+	stbi_image_free( imageData );
+	return texels.size();
 }
 
-void Image::SetTexelColor( const IntVec2& texelCoords, const Rgba8& newColor )
+COMMAND( benchmark_images, "Time loading every png under Data/Images the old way, with Image, and with the parallel batch loader. e.g. benchmark_images runs=3", "runs" )
 {
-	int index = texelCoords.x + (m_dimensions.x * texelCoords.y);
-	m_rgbaTexels[index] = newColor;
+	int numRuns = args.GetValue( "runs", 3 );
+	numRuns < 1 ? numRuns = 1 : true;
+
+	std::vector<std::string> imageFilePaths;
+	AppendImageFilePathsInFolder( "Data/Images", imageFilePaths );
+	AppendImageFilePathsInFolder( "Data/Images/UI", imageFilePaths );
+	AppendImageFilePathsInFolder( "Data/Images/Cutscenes", imageFilePaths );
+
+	// best of numRuns, the first run also pays for the file cache
+	double bestLegacySeconds = 1.0e9;
+	double bestSerialSeconds = 1.0e9;
+	double bestParallelSeconds = 1.0e9;
+	size_t numTexels = 0;
+	for( int runIndex = 0; runIndex < numRuns; runIndex++ )
+	{
+		double startSeconds = GetCurrentTimeSeconds();
+		numTexels = 0;
+		for( const std::string& imageFilePath : imageFilePaths )
+		{
+			numTexels += LoadImageLegacy( imageFilePath );
+		}
+		double legacySeconds = GetCurrentTimeSeconds() - startSeconds;
+
+		startSeconds = GetCurrentTimeSeconds();
+		for( const std::string& imageFilePath : imageFilePaths )
+		{
+			Image image( imageFilePath.c_str() );
+		}
+		double serialSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+		startSeconds = GetCurrentTimeSeconds();
+		std::vector<Image*> images;
+		LoadImagesInParallel( imageFilePaths, images );
+		double parallelSeconds = GetCurrentTimeSeconds() - startSeconds;
+		for( Image* image : images )
+		{
+			delete image;
+		}
+
+		bestLegacySeconds = legacySeconds < bestLegacySeconds ? legacySeconds : bestLegacySeconds;
+		bestSerialSeconds = serialSeconds < bestSerialSeconds ? serialSeconds : bestSerialSeconds;
+		bestParallelSeconds = parallelSeconds < bestParallelSeconds ? parallelSeconds : bestParallelSeconds;
+	}
+
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%i images, %.1f Mtexels", (int)imageFilePaths.size(), numTexels / 1.0e6 ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  per texel push_back: %8.2f ms", bestLegacySeconds * 1000.0 ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  Image:               %8.2f ms", bestSerialSeconds * 1000.0 ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  LoadImagesInParallel:%8.2f ms (%i workers)", bestParallelSeconds * 1000.0,
+		g_theJobSystem != nullptr ? g_theJobSystem->GetNumWorkers() : 0 ) );
 }
@@ -4,25 +4,43 @@
 #include <string>
 #include <vector>
 
+//------------------------------------------------------------------------
+// RGBA8 texels in one tightly packed buffer, row 0 first. RGBA files keep the buffer stb decoded
+// into, RGB files are expanded straight into it, so loading never repacks per texel.
+//------------------------------------------------------------------------
 class Image
 {
 public:
 	Image( const char* imageFilePath, bool isFlipVertically = true );
+	Image( const IntVec2& dimensions, const Rgba8& fillColor );
 	// Rotation : 0 = 0 degree, 1 = 90 degrees, 2 = 180 degrees, 3 = 270 degrees
 	Image( const Image& copyFrom, int numRotations = 0 );
+	~Image();
+
+	Image& operator=( const Image& copyFrom ) = delete;
 
 	const std::string&	GetImageFilePath() const;
 	IntVec2				GetDimensions() const;
+	int					GetNumTexels() const		{ return m_dimensions.x * m_dimensions.y; }
 	Rgba8				GetTexelColor( int texelIndex ) const;
 	Rgba8				GetTexelColor( int texelX, int texelY ) const;
 	Rgba8				GetTexelColor( const IntVec2& texelCoords ) const;
-	unsigned char*		GetTexelsBuffer();
+	const Rgba8*		GetTexels() const			{ return m_texels; }
+	Rgba8*				GetTexels()					{ return m_texels; }
+	const unsigned char* GetTexelsBuffer() const	{ return reinterpret_cast<const unsigned char*>( m_texels ); }		// 4 bytes per texel, no copy
 
 	void				SetTexelColor( int texelX, int texelY, const Rgba8& newColor );
 	void				SetTexelColor( const IntVec2& texelCoords, const Rgba8& newColor );
+	void				SetImageFilePath( const std::string& imageFilePath )	{ m_imageFilePath = imageFilePath; }
 
 private:
 	std::string					m_imageFilePath;
 	IntVec2						m_dimensions = IntVec2( 0, 0 );
-	std::vector< Rgba8 >		m_rgbaTexels;
+	Rgba8*						m_texels = nullptr;		// malloc'd, since stb hands back malloc'd buffers
 };
+
+//------------------------------------------------------------------------
+// Decodes every file on the job system; out_images matches imageFilePaths. Any thread may call
+// this while others decode, stb's global flip flag is never used.
+//------------------------------------------------------------------------
+void LoadImagesInParallel( const std::vector<std::string>& imageFilePaths, std::vector<Image*>& out_images, bool isFlipVertically = true );
@@ -0,0 +1,339 @@
+#include "Engine/Core/ImageAtlas.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <algorithm>
+#include <limits.h>
+
+constexpr int CELLS_PER_COPY_JOB = 16;
+
+//------------------------------------------------------------------------
+ImageAtlas::ImageAtlas( int padding, int extrusion, int maxDimension )
+	:m_padding( padding > 0 ? padding : 0 ),
+	m_extrusion( extrusion > 0 ? extrusion : 0 ),
+	m_maxDimension( maxDimension )
+{
+}
+
+ImageAtlas::~ImageAtlas()
+{
+	delete m_atlasImage;
+	m_atlasImage = nullptr;
+}
+
+//------------------------------------------------------------------------
+void ImageAtlas::AddImage( const Image& image, const IntVec2& cellLayout )
+{
+	IntVec2 dimensions = image.GetDimensions();
+	GUARANTEE_OR_DIE( cellLayout.x > 0 && cellLayout.y > 0, Stringf( "ImageAtlas: bad cell layout for %s", image.GetImageFilePath().c_str() ) );
+	GUARANTEE_OR_DIE( cellLayout.x <= dimensions.x && cellLayout.y <= dimensions.y, Stringf( "ImageAtlas: %s is smaller than its cell layout", image.GetImageFilePath().c_str() ) );
+
+	ImageAtlasEntry entry;
+	entry.m_name = image.GetImageFilePath();
+	entry.m_sourceDimensions = dimensions;
+	entry.m_cellLayout = cellLayout;
+	entry.m_cells.resize( (size_t)cellLayout.x * cellLayout.y );
+
+	int entryIndex = (int)m_entries.size();
+	for( int cellIndex = 0; cellIndex < (int)entry.m_cells.size(); cellIndex++ )
+	{
+		// rows count down from the top like SpriteSheet, texel rows count up from v = 0
+		int cellX = cellIndex % cellLayout.x;
+		int cellYFromTop = cellIndex / cellLayout.x;
+		int minX = cellX * dimensions.x / cellLayout.x;
+		int maxX = ( cellX + 1 ) * dimensions.x / cellLayout.x;
+		int minY = dimensions.y - ( cellYFromTop + 1 ) * dimensions.y / cellLayout.y;
+		int maxY = dimensions.y - cellYFromTop * dimensions.y / cellLayout.y;
+
+		entry.m_cells[cellIndex].m_sourceUVs = AABB2( (float)minX / (float)dimensions.x, (float)minY / (float)dimensions.y,
+			(float)maxX / (float)dimensions.x, (float)maxY / (float)dimensions.y );
+
+		PendingCell pending;
+		pending.m_image = &image;
+		pending.m_entryIndex = entryIndex;
+		pending.m_cellIndex = cellIndex;
+		pending.m_sourceTexels.m_x = minX;
+		pending.m_sourceTexels.m_y = minY;
+		pending.m_sourceTexels.m_width = maxX - minX;
+		pending.m_sourceTexels.m_height = maxY - minY;
+		pending.m_placement.m_width = pending.m_sourceTexels.m_width + 2 * m_extrusion + m_padding;
+		pending.m_placement.m_height = pending.m_sourceTexels.m_height + 2 * m_extrusion + m_padding;
+		m_pendingCells.push_back( pending );
+	}
+	m_entries.push_back( entry );
+}
+
+//------------------------------------------------------------------------
+bool ImageAtlas::Pack()
+{
+	delete m_atlasImage;
+	m_atlasImage = nullptr;
+	if( m_pendingCells.empty() )
+	{
+		return false;
+	}
+
+	// big cells first, MaxRects does far better placing the awkward ones while there's room
+	std::stable_sort( m_pendingCells.begin(), m_pendingCells.end(), []( const PendingCell& a, const PendingCell& b )
+	{
+		int aLongSide = std::max( a.m_placement.m_width, a.m_placement.m_height );
+		int bLongSide = std::max( b.m_placement.m_width, b.m_placement.m_height );
+		if( aLongSide != bLongSide )
+		{
+			return aLongSide > bLongSide;
+		}
+		return std::min( a.m_placement.m_width, a.m_placement.m_height ) > std::min( b.m_placement.m_width, b.m_placement.m_height );
+	} );
+
+	int64_t totalArea = 0;
+	int widestCell = 0;
+	int tallestCell = 0;
+	for( const PendingCell& cell : m_pendingCells )
+	{
+		totalArea += (int64_t)cell.m_placement.m_width * cell.m_placement.m_height;
+		widestCell = std::max( widestCell, cell.m_placement.m_width );
+		tallestCell = std::max( tallestCell, cell.m_placement.m_height );
+	}
+
+	// smallest power of two box that could hold everything, growing the short side each time it doesn't
+	IntVec2 atlasDimensions( 1, 1 );
+	while( atlasDimensions.x < widestCell + m_padding )
+	{
+		atlasDimensions.x *= 2;
+	}
+	while( atlasDimensions.y < tallestCell + m_padding )
+	{
+		atlasDimensions.y *= 2;
+	}
+	while( (int64_t)atlasDimensions.x * atlasDimensions.y < totalArea )
+	{
+		atlasDimensions.x <= atlasDimensions.y ? atlasDimensions.x *= 2 : atlasDimensions.y *= 2;
+	}
+
+	while( atlasDimensions.x <= m_maxDimension && atlasDimensions.y <= m_maxDimension )
+	{
+		if( TryPackInto( atlasDimensions ) )
+		{
+			m_atlasImage = new Image( atlasDimensions, Rgba8( 0, 0, 0, 0 ) );
+			m_atlasImage->SetImageFilePath( "ImageAtlas" );
+			CopyCellsIntoAtlas();
+			return true;
+		}
+		atlasDimensions.x <= atlasDimensions.y ? atlasDimensions.x *= 2 : atlasDimensions.y *= 2;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+const ImageAtlasEntry* ImageAtlas::FindEntry( const std::string& name ) const
+{
+	for( const ImageAtlasEntry& entry : m_entries )
+	{
+		if( entry.m_name == name )
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+float ImageAtlas::GetPackedFraction() const
+{
+	if( m_atlasImage == nullptr )
+	{
+		return 0.f;
+	}
+
+	int64_t cellArea = 0;
+	for( const PendingCell& cell : m_pendingCells )
+	{
+		cellArea += (int64_t)cell.m_sourceTexels.m_width * cell.m_sourceTexels.m_height;
+	}
+	return (float)( (double)cellArea / (double)m_atlasImage->GetNumTexels() );
+}
+
+//------------------------------------------------------------------------
+// MaxRects: keep every maximal free rectangle (they overlap), put each cell in the one it
+// leaves the least short-side slack in, then split whatever it overlapped and drop any free
+// rectangle that ended up inside another
+//------------------------------------------------------------------------
+bool ImageAtlas::TryPackInto( const IntVec2& atlasDimensions )
+{
+	// cells carry their trailing padding, so only the leading edge needs a gap
+	std::vector<PackRect> freeRects;
+	PackRect wholeAtlas;
+	wholeAtlas.m_x = m_padding;
+	wholeAtlas.m_y = m_padding;
+	wholeAtlas.m_width = atlasDimensions.x - m_padding;
+	wholeAtlas.m_height = atlasDimensions.y - m_padding;
+	freeRects.push_back( wholeAtlas );
+
+	std::vector<PackRect> splitRects;
+	for( PendingCell& cell : m_pendingCells )
+	{
+		int width = cell.m_placement.m_width;
+		int height = cell.m_placement.m_height;
+
+		int bestFreeIndex = -1;
+		int bestShortSlack = INT_MAX;
+		int bestLongSlack = INT_MAX;
+		for( int freeIndex = 0; freeIndex < (int)freeRects.size(); freeIndex++ )
+		{
+			const PackRect& freeRect = freeRects[freeIndex];
+			if( freeRect.m_width < width || freeRect.m_height < height )
+			{
+				continue;
+			}
+
+			int slackX = freeRect.m_width - width;
+			int slackY = freeRect.m_height - height;
+			int shortSlack = std::min( slackX, slackY );
+			int longSlack = std::max( slackX, slackY );
+			if( shortSlack < bestShortSlack || ( shortSlack == bestShortSlack && longSlack < bestLongSlack ) )
+			{
+				bestFreeIndex = freeIndex;
+				bestShortSlack = shortSlack;
+				bestLongSlack = longSlack;
+			}
+		}
+		if( bestFreeIndex < 0 )
+		{
+			return false;
+		}
+
+		PackRect placed;
+		placed.m_x = freeRects[bestFreeIndex].m_x;
+		placed.m_y = freeRects[bestFreeIndex].m_y;
+		placed.m_width = width;
+		placed.m_height = height;
+		cell.m_placement = placed;
+
+		// split every free rectangle the cell overlaps into the up to four bands around it
+		splitRects.clear();
+		for( int freeIndex = 0; freeIndex < (int)freeRects.size(); )
+		{
+			PackRect freeRect = freeRects[freeIndex];
+			bool isOverlapping = placed.m_x < freeRect.m_x + freeRect.m_width && freeRect.m_x < placed.m_x + placed.m_width
+				&& placed.m_y < freeRect.m_y + freeRect.m_height && freeRect.m_y < placed.m_y + placed.m_height;
+			if( !isOverlapping )
+			{
+				freeIndex++;
+				continue;
+			}
+
+			if( placed.m_x > freeRect.m_x )
+			{
+				PackRect left = freeRect;
+				left.m_width = placed.m_x - freeRect.m_x;
+				splitRects.push_back( left );
+			}
+			if( placed.m_x + placed.m_width < freeRect.m_x + freeRect.m_width )
+			{
+				PackRect right = freeRect;
+				right.m_x = placed.m_x + placed.m_width;
+				right.m_width = freeRect.m_x + freeRect.m_width - right.m_x;
+				splitRects.push_back( right );
+			}
+			if( placed.m_y > freeRect.m_y )
+			{
+				PackRect below = freeRect;
+				below.m_height = placed.m_y - freeRect.m_y;
+				splitRects.push_back( below );
+			}
+			if( placed.m_y + placed.m_height < freeRect.m_y + freeRect.m_height )
+			{
+				PackRect above = freeRect;
+				above.m_y = placed.m_y + placed.m_height;
+				above.m_height = freeRect.m_y + freeRect.m_height - above.m_y;
+				splitRects.push_back( above );
+			}
+
+			freeRects[freeIndex] = freeRects.back();
+			freeRects.pop_back();
+		}
+		freeRects.insert( freeRects.end(), splitRects.begin(), splitRects.end() );
+
+		// only the new pieces can be redundant, or make an old one redundant
+		int firstSplitIndex = (int)freeRects.size() - (int)splitRects.size();
+		for( int splitIndex = (int)freeRects.size() - 1; splitIndex >= firstSplitIndex; splitIndex-- )
+		{
+			PackRect split = freeRects[splitIndex];		// a copy, erasing below shifts it
+			for( int otherIndex = (int)freeRects.size() - 1; otherIndex >= 0; otherIndex-- )
+			{
+				if( otherIndex == splitIndex )
+				{
+					continue;
+				}
+
+				const PackRect& other = freeRects[otherIndex];
+				bool isSplitInOther = split.m_x >= other.m_x && split.m_y >= other.m_y
+					&& split.m_x + split.m_width <= other.m_x + other.m_width && split.m_y + split.m_height <= other.m_y + other.m_height;
+				if( isSplitInOther )
+				{
+					freeRects.erase( freeRects.begin() + splitIndex );
+					break;
+				}
+
+				bool isOtherInSplit = other.m_x >= split.m_x && other.m_y >= split.m_y
+					&& other.m_x + other.m_width <= split.m_x + split.m_width && other.m_y + other.m_height <= split.m_y + split.m_height;
+				if( isOtherInSplit && otherIndex < firstSplitIndex )
+				{
+					freeRects.erase( freeRects.begin() + otherIndex );
+					firstSplitIndex--;
+					splitIndex--;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+// Every cell owns its own footprint, so cells are copied on the job system with no locking
+//------------------------------------------------------------------------
+void ImageAtlas::CopyCellsIntoAtlas()
+{
+	IntVec2 atlasDimensions = m_atlasImage->GetDimensions();
+	Rgba8* atlasTexels = m_atlasImage->GetTexels();
+	int extrusion = m_extrusion;
+
+	auto copyCells = [this, atlasTexels, atlasDimensions, extrusion]( int cellBegin, int cellEnd )
+	{
+		for( int pendingIndex = cellBegin; pendingIndex < cellEnd; pendingIndex++ )
+		{
+			const PendingCell& cell = m_pendingCells[pendingIndex];
+			const Rgba8* sourceTexels = cell.m_image->GetTexels();
+			int sourceWidth = cell.m_image->GetDimensions().x;
+			const PackRect& source = cell.m_sourceTexels;
+			int innerX = cell.m_placement.m_x + extrusion;
+			int innerY = cell.m_placement.m_y + extrusion;
+
+			// edge rows repeat below and above, edge texels repeat left and right
+			for( int rowOffset = -extrusion; rowOffset < source.m_height + extrusion; rowOffset++ )
+			{
+				int sourceRow = source.m_y + std::min( std::max( rowOffset, 0 ), source.m_height - 1 );
+				const Rgba8* sourceRowTexels = sourceTexels + (size_t)sourceRow * sourceWidth + source.m_x;
+				Rgba8* atlasRowTexels = atlasTexels + (size_t)( innerY + rowOffset ) * atlasDimensions.x + innerX;
+
+				std::copy_n( sourceRowTexels, source.m_width, atlasRowTexels );
+				for( int extrudeIndex = 1; extrudeIndex <= extrusion; extrudeIndex++ )
+				{
+					atlasRowTexels[-extrudeIndex] = sourceRowTexels[0];
+					atlasRowTexels[source.m_width - 1 + extrudeIndex] = sourceRowTexels[source.m_width - 1];
+				}
+			}
+
+			AABB2& atlasUVs = m_entries[cell.m_entryIndex].m_cells[cell.m_cellIndex].m_atlasUVs;
+			atlasUVs = AABB2( (float)innerX / (float)atlasDimensions.x, (float)innerY / (float)atlasDimensions.y,
+				(float)( innerX + source.m_width ) / (float)atlasDimensions.x, (float)( innerY + source.m_height ) / (float)atlasDimensions.y );
+		}
+	};
+
+	if( g_theJobSystem != nullptr )
+	{
+		g_theJobSystem->ParallelFor( 0, (int)m_pendingCells.size(), CELLS_PER_COPY_JOB, copyCells );
+	}
+	else
+	{
+		copyCells( 0, (int)m_pendingCells.size() );
+	}
+}
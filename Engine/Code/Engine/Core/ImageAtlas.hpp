@@ -0,0 +1,78 @@
+#pragma once
+#include "Engine/Core/Image.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Where one sprite-sheet cell (or a whole image, as a 1x1 sheet) ended up in the atlas.
+// Both rects are in uv space, v up like everywhere else in the engine.
+//------------------------------------------------------------------------
+struct ImageAtlasCell
+{
+	AABB2 m_sourceUVs;		// the cell within its own image
+	AABB2 m_atlasUVs;		// the same texels within the atlas, padding and extrusion excluded
+};
+
+struct ImageAtlasEntry
+{
+	std::string					m_name;				// the image's file path
+	IntVec2						m_sourceDimensions = IntVec2( 0, 0 );
+	IntVec2						m_cellLayout = IntVec2( 1, 1 );
+	std::vector<ImageAtlasCell>	m_cells;			// row major from the top left, same order as SpriteSheet
+};
+
+//------------------------------------------------------------------------
+// Packs images, or every cell of a sprite sheet separately, into one atlas with MaxRects
+// (best short side fit). Each cell gets its edge texels copied outward m_extrusion times so
+// bilinear filtering never reads a neighbour, then m_padding clear texels before the next one.
+// Cells that don't divide evenly into texels are rounded down the same way everywhere.
+//------------------------------------------------------------------------
+class ImageAtlas
+{
+public:
+	explicit ImageAtlas( int padding = 1, int extrusion = 1, int maxDimension = 8192 );
+	~ImageAtlas();
+
+	ImageAtlas( const ImageAtlas& copyFrom ) = delete;
+	ImageAtlas& operator=( const ImageAtlas& copyFrom ) = delete;
+
+	void	AddImage( const Image& image, const IntVec2& cellLayout = IntVec2( 1, 1 ) );	// only referenced, must live until Pack
+	bool	Pack();				// false if it doesn't fit in maxDimension squared
+
+	const Image*					GetAtlasImage() const	{ return m_atlasImage; }
+	Image*							GetAtlasImage()			{ return m_atlasImage; }
+	const std::vector<ImageAtlasEntry>& GetEntries() const	{ return m_entries; }
+	const ImageAtlasEntry*			FindEntry( const std::string& name ) const;
+	float							GetPackedFraction() const;		// texels covered by cells over atlas texels
+
+private:
+	struct PackRect
+	{
+		int m_x = 0;
+		int m_y = 0;
+		int m_width = 0;
+		int m_height = 0;
+	};
+
+	struct PendingCell
+	{
+		const Image*	m_image = nullptr;
+		int				m_entryIndex = 0;
+		int				m_cellIndex = 0;
+		PackRect		m_sourceTexels;
+		PackRect		m_placement;		// whole footprint, extrusion and trailing padding included
+	};
+
+	bool	TryPackInto( const IntVec2& atlasDimensions );
+	void	CopyCellsIntoAtlas();
+
+private:
+	int m_padding = 1;
+	int m_extrusion = 1;
+	int m_maxDimension = 8192;
+
+	std::vector<ImageAtlasEntry>	m_entries;
+	std::vector<PendingCell>		m_pendingCells;
+	Image*							m_atlasImage = nullptr;
+};
@@ -0,0 +1,642 @@
+#include "Engine/Core/ImageUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
+#include <math.h>
+#include <string.h>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#include <emmintrin.h>
+#define IMAGE_UTILS_USE_SSE2
+#endif
+
+constexpr float IMAGE_PI = 3.14159265f;
+constexpr int ROTATE_TILE_SIZE = 32;				// 32x32 texels of source and destination, 8KB, both fit in L1
+constexpr int MIN_TEXELS_PER_JOB = 16 * 1024;
+
+//------------------------------------------------------------------------
+// One texel as four floats, an SSE register where there is one
+//------------------------------------------------------------------------
+#if defined( IMAGE_UTILS_USE_SSE2 )
+typedef __m128 Texel4f;
+
+static inline Texel4f MakeTexel4f( float r, float g, float b, float a )		{ return _mm_setr_ps( r, g, b, a ); }
+static inline Texel4f ZeroTexel4f()											{ return _mm_setzero_ps(); }
+static inline Texel4f AddTexel4f( Texel4f a, Texel4f b )					{ return _mm_add_ps( a, b ); }
+static inline Texel4f MultiplyTexel4f( Texel4f a, Texel4f b )				{ return _mm_mul_ps( a, b ); }
+static inline Texel4f ScaleTexel4f( Texel4f a, float scale )				{ return _mm_mul_ps( a, _mm_set1_ps( scale ) ); }
+static inline Texel4f LoadTexel4f( const float* floats )					{ return _mm_loadu_ps( floats ); }
+static inline void StoreTexel4f( float* out_floats, Texel4f texel )			{ _mm_storeu_ps( out_floats, texel ); }
+
+static inline Texel4f LoadTexel4f( const Rgba8& texel )
+{
+	int packed = 0;
+	memcpy( &packed, &texel.r, sizeof( packed ) );
+	__m128i zero = _mm_setzero_si128();
+	__m128i channels = _mm_unpacklo_epi16( _mm_unpacklo_epi8( _mm_cvtsi32_si128( packed ), zero ), zero );
+	return _mm_cvtepi32_ps( channels );
+}
+
+// rounds to nearest and saturates to 0-255, so filter overshoot is clamped for free
+static inline void StoreTexel4f( Rgba8& out_texel, Texel4f texel )
+{
+	__m128i channels = _mm_cvtps_epi32( texel );
+	channels = _mm_packs_epi32( channels, channels );
+	channels = _mm_packus_epi16( channels, channels );
+	int packed = _mm_cvtsi128_si32( channels );
+	memcpy( &out_texel.r, &packed, sizeof( packed ) );
+}
+#else
+struct Texel4f
+{
+	float m_channels[4];
+};
+
+static inline Texel4f MakeTexel4f( float r, float g, float b, float a )		{ Texel4f texel = { { r, g, b, a } }; return texel; }
+static inline Texel4f ZeroTexel4f()											{ return MakeTexel4f( 0.f, 0.f, 0.f, 0.f ); }
+static inline Texel4f LoadTexel4f( const float* floats )					{ return MakeTexel4f( floats[0], floats[1], floats[2], floats[3] ); }
+static inline void StoreTexel4f( float* out_floats, Texel4f texel )			{ memcpy( out_floats, texel.m_channels, sizeof( texel.m_channels ) ); }
+static inline Texel4f LoadTexel4f( const Rgba8& texel )					{ return MakeTexel4f( texel.r, texel.g, texel.b, texel.a ); }
+
+static inline Texel4f AddTexel4f( Texel4f a, Texel4f b )
+{
+	return MakeTexel4f( a.m_channels[0] + b.m_channels[0], a.m_channels[1] + b.m_channels[1], a.m_channels[2] + b.m_channels[2], a.m_channels[3] + b.m_channels[3] );
+}
+
+static inline Texel4f MultiplyTexel4f( Texel4f a, Texel4f b )
+{
+	return MakeTexel4f( a.m_channels[0] * b.m_channels[0], a.m_channels[1] * b.m_channels[1], a.m_channels[2] * b.m_channels[2], a.m_channels[3] * b.m_channels[3] );
+}
+
+static inline Texel4f ScaleTexel4f( Texel4f a, float scale )
+{
+	return MakeTexel4f( a.m_channels[0] * scale, a.m_channels[1] * scale, a.m_channels[2] * scale, a.m_channels[3] * scale );
+}
+
+static inline unsigned char SaturateChannel( float channel )
+{
+	channel = channel < 0.f ? 0.f : ( channel > 255.f ? 255.f : channel );
+	return (unsigned char)( channel + 0.5f );
+}
+
+static inline void StoreTexel4f( Rgba8& out_texel, Texel4f texel )
+{
+	out_texel.r = SaturateChannel( texel.m_channels[0] );
+	out_texel.g = SaturateChannel( texel.m_channels[1] );
+	out_texel.b = SaturateChannel( texel.m_channels[2] );
+	out_texel.a = SaturateChannel( texel.m_channels[3] );
+}
+#endif
+
+//------------------------------------------------------------------------
+// work( rowBegin, rowEnd ), split over the job system in chunks big enough to be worth a job
+template <typename CALLABLE>
+static void ParallelForRows( int numRows, int texelsPerRow, CALLABLE const& work )
+{
+	int rowsPerJob = 1 + MIN_TEXELS_PER_JOB / ( texelsPerRow > 0 ? texelsPerRow : 1 );
+	if( g_theJobSystem != nullptr )
+	{
+		g_theJobSystem->ParallelFor( 0, numRows, rowsPerJob, work );
+	}
+	else
+	{
+		work( 0, numRows );
+	}
+}
+
+//------------------------------------------------------------------------
+// Separable resampling: weights for every destination texel along one axis
+//------------------------------------------------------------------------
+struct ResampleTaps
+{
+	int m_maxTaps = 0;
+	std::vector<int> m_firstSource;		// per destination texel
+	std::vector<int> m_numTaps;
+	std::vector<float> m_weights;		// m_maxTaps per destination texel, sum to 1
+};
+
+static float GetFilterRadius( eImageFilter filter )
+{
+	return filter == IMAGE_FILTER_BOX ? 0.5f : 3.f;
+}
+
+static float EvaluateFilter( eImageFilter filter, float x )
+{
+	if( filter == IMAGE_FILTER_BOX )
+	{
+		return ( x >= -0.5f && x < 0.5f ) ? 1.f : 0.f;
+	}
+
+	// lanczos3: sinc( x ) * sinc( x / 3 )
+	x = fabsf( x );
+	if( x < 1.0e-5f )
+	{
+		return 1.f;
+	}
+	if( x >= 3.f )
+	{
+		return 0.f;
+	}
+	float piX = IMAGE_PI * x;
+	return 3.f * sinf( piX ) * sinf( piX / 3.f ) / ( piX * piX );
+}
+
+static void ComputeResampleTaps( int sourceSize, int destinationSize, eImageFilter filter, ResampleTaps& out_taps )
+{
+	// shrinking widens the filter to cover every source texel that lands in a destination texel
+	float scale = (float)destinationSize / (float)sourceSize;
+	float filterScale = scale < 1.f ? 1.f / scale : 1.f;
+	float support = GetFilterRadius( filter ) * filterScale;
+
+	out_taps.m_maxTaps = (int)ceilf( support * 2.f ) + 2;
+	out_taps.m_firstSource.assign( destinationSize, 0 );
+	out_taps.m_numTaps.assign( destinationSize, 0 );
+	out_taps.m_weights.assign( (size_t)destinationSize * out_taps.m_maxTaps, 0.f );
+
+	for( int destinationIndex = 0; destinationIndex < destinationSize; destinationIndex++ )
+	{
+		float center = ( (float)destinationIndex + 0.5f ) / scale;
+		int firstSource = (int)floorf( center - support );
+		int lastSource = (int)ceilf( center + support );
+		firstSource = firstSource < 0 ? 0 : firstSource;
+		lastSource = lastSource > sourceSize - 1 ? sourceSize - 1 : lastSource;
+
+		float* weights = &out_taps.m_weights[(size_t)destinationIndex * out_taps.m_maxTaps];
+		float totalWeight = 0.f;
+		for( int sourceIndex = firstSource; sourceIndex <= lastSource; sourceIndex++ )
+		{
+			float weight = EvaluateFilter( filter, ( (float)sourceIndex + 0.5f - center ) / filterScale );
+			weights[sourceIndex - firstSource] = weight;
+			totalWeight += weight;
+		}
+
+		// nothing under the filter (can only happen right at an edge), fall back to nearest
+		if( totalWeight <= 0.f )
+		{
+			int nearestSource = (int)center;
+			firstSource = nearestSource > sourceSize - 1 ? sourceSize - 1 : nearestSource;
+			lastSource = firstSource;
+			weights[0] = 1.f;
+			totalWeight = 1.f;
+		}
+
+		out_taps.m_firstSource[destinationIndex] = firstSource;
+		out_taps.m_numTaps[destinationIndex] = lastSource - firstSource + 1;
+		for( int tapIndex = 0; tapIndex <= lastSource - firstSource; tapIndex++ )
+		{
+			weights[tapIndex] /= totalWeight;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+Image* CreateResizedImage( const Image& image, const IntVec2& newDimensions, eImageFilter filter )
+{
+	IntVec2 sourceDimensions = image.GetDimensions();
+	int sourceWidth = sourceDimensions.x;
+	int sourceHeight = sourceDimensions.y;
+	int width = newDimensions.x > 0 ? newDimensions.x : 1;
+	int height = newDimensions.y > 0 ? newDimensions.y : 1;
+
+	ResampleTaps columnTaps;
+	ResampleTaps rowTaps;
+	ComputeResampleTaps( sourceWidth, width, filter, columnTaps );
+	ComputeResampleTaps( sourceHeight, height, filter, rowTaps );
+
+	// horizontal pass into a float buffer the new width and the old height, then vertical
+	std::vector<float> stretchedRows( (size_t)width * sourceHeight * 4 );
+	float* stretchedTexels = stretchedRows.data();
+	const Rgba8* sourceTexels = image.GetTexels();
+	ParallelForRows( sourceHeight, width, [&columnTaps, sourceTexels, stretchedTexels, sourceWidth, width]( int rowBegin, int rowEnd )
+	{
+		for( int rowIndex = rowBegin; rowIndex < rowEnd; rowIndex++ )
+		{
+			const Rgba8* sourceRow = sourceTexels + (size_t)rowIndex * sourceWidth;
+			float* stretchedRow = stretchedTexels + (size_t)rowIndex * width * 4;
+			for( int columnIndex = 0; columnIndex < width; columnIndex++ )
+			{
+				const Rgba8* tapTexels = sourceRow + columnTaps.m_firstSource[columnIndex];
+				const float* weights = &columnTaps.m_weights[(size_t)columnIndex * columnTaps.m_maxTaps];
+				Texel4f sum = ZeroTexel4f();
+				for( int tapIndex = 0; tapIndex < columnTaps.m_numTaps[columnIndex]; tapIndex++ )
+				{
+					sum = AddTexel4f( sum, ScaleTexel4f( LoadTexel4f( tapTexels[tapIndex] ), weights[tapIndex] ) );
+				}
+				StoreTexel4f( stretchedRow + columnIndex * 4, sum );
+			}
+		}
+	} );
+
+	// the vertical pass walks whole rows tap by tap, so reads stay sequential instead of striding down columns
+	Image* resizedImage = new Image( IntVec2( width, height ), Rgba8( 0, 0, 0, 0 ) );
+	Rgba8* resizedTexels = resizedImage->GetTexels();
+	ParallelForRows( height, width, [&rowTaps, stretchedTexels, resizedTexels, width]( int rowBegin, int rowEnd )
+	{
+		std::vector<float> rowSums( (size_t)width * 4 );
+		for( int rowIndex = rowBegin; rowIndex < rowEnd; rowIndex++ )
+		{
+			memset( rowSums.data(), 0, rowSums.size() * sizeof( float ) );
+			const float* weights = &rowTaps.m_weights[(size_t)rowIndex * rowTaps.m_maxTaps];
+			for( int tapIndex = 0; tapIndex < rowTaps.m_numTaps[rowIndex]; tapIndex++ )
+			{
+				const float* tapRow = stretchedTexels + (size_t)( rowTaps.m_firstSource[rowIndex] + tapIndex ) * width * 4;
+				Texel4f weight = MakeTexel4f( weights[tapIndex], weights[tapIndex], weights[tapIndex], weights[tapIndex] );
+				for( int columnIndex = 0; columnIndex < width; columnIndex++ )
+				{
+					float* rowSum = &rowSums[(size_t)columnIndex * 4];
+					StoreTexel4f( rowSum, AddTexel4f( LoadTexel4f( rowSum ), MultiplyTexel4f( LoadTexel4f( tapRow + columnIndex * 4 ), weight ) ) );
+				}
+			}
+
+			Rgba8* resizedRow = resizedTexels + (size_t)rowIndex * width;
+			for( int columnIndex = 0; columnIndex < width; columnIndex++ )
+			{
+				StoreTexel4f( resizedRow[columnIndex], LoadTexel4f( &rowSums[(size_t)columnIndex * 4] ) );
+			}
+		}
+	} );
+
+	return resizedImage;
+}
+
+Image* CreateHalfSizeImage( const Image& image )
+{
+	IntVec2 sourceDimensions = image.GetDimensions();
+	int sourceWidth = sourceDimensions.x;
+	int sourceHeight = sourceDimensions.y;
+	int width = sourceWidth > 1 ? sourceWidth / 2 : 1;
+	int height = sourceHeight > 1 ? sourceHeight / 2 : 1;
+
+	Image* halfImage = new Image( IntVec2( width, height ), Rgba8( 0, 0, 0, 0 ) );
+	const Rgba8* sourceTexels = image.GetTexels();
+	Rgba8* halfTexels = halfImage->GetTexels();
+	ParallelForRows( height, width, [sourceTexels, halfTexels, sourceWidth, sourceHeight, width]( int rowBegin, int rowEnd )
+	{
+		for( int rowIndex = rowBegin; rowIndex < rowEnd; rowIndex++ )
+		{
+			// a 1 texel wide or tall source averages with itself
+			const Rgba8* sourceRow0 = sourceTexels + (size_t)( rowIndex * 2 ) * sourceWidth;
+			const Rgba8* sourceRow1 = sourceTexels + (size_t)( rowIndex * 2 + 1 < sourceHeight ? rowIndex * 2 + 1 : rowIndex * 2 ) * sourceWidth;
+			int nextColumnOffset = sourceWidth > 1 ? 1 : 0;
+			Rgba8* halfRow = halfTexels + (size_t)rowIndex * width;
+			for( int columnIndex = 0; columnIndex < width; columnIndex++ )
+			{
+				int sourceColumn = columnIndex * 2;
+				Texel4f sum = AddTexel4f( LoadTexel4f( sourceRow0[sourceColumn] ), LoadTexel4f( sourceRow0[sourceColumn + nextColumnOffset] ) );
+				sum = AddTexel4f( sum, AddTexel4f( LoadTexel4f( sourceRow1[sourceColumn] ), LoadTexel4f( sourceRow1[sourceColumn + nextColumnOffset] ) ) );
+				StoreTexel4f( halfRow[columnIndex], ScaleTexel4f( sum, 0.25f ) );
+			}
+		}
+	} );
+
+	return halfImage;
+}
+
+void GenerateMipChain( const Image& image, std::vector<Image*>& out_mipLevels )
+{
+	const Image* previousLevel = &image;
+	while( previousLevel->GetDimensions().x > 1 || previousLevel->GetDimensions().y > 1 )
+	{
+		Image* mipLevel = CreateHalfSizeImage( *previousLevel );
+		out_mipLevels.push_back( mipLevel );
+		previousLevel = mipLevel;
+	}
+}
+
+//------------------------------------------------------------------------
+void FlipImageVertically( Image& image )
+{
+	IntVec2 dimensions = image.GetDimensions();
+	Rgba8* texels = image.GetTexels();
+	int width = dimensions.x;
+	int height = dimensions.y;
+	ParallelForRows( height / 2, width, [texels, width, height]( int rowBegin, int rowEnd )
+	{
+		for( int rowIndex = rowBegin; rowIndex < rowEnd; rowIndex++ )
+		{
+			Rgba8* topRow = texels + (size_t)rowIndex * width;
+			Rgba8* bottomRow = texels + (size_t)( height - 1 - rowIndex ) * width;
+			for( int columnIndex = 0; columnIndex < width; columnIndex++ )
+			{
+				Rgba8 swapTexel = topRow[columnIndex];
+				topRow[columnIndex] = bottomRow[columnIndex];
+				bottomRow[columnIndex] = swapTexel;
+			}
+		}
+	} );
+}
+
+void FlipImageHorizontally( Image& image )
+{
+	IntVec2 dimensions = image.GetDimensions();
+	Rgba8* texels = image.GetTexels();
+	int width = dimensions.x;
+	ParallelForRows( dimensions.y, width, [texels, width]( int rowBegin, int rowEnd )
+	{
+		for( int rowIndex = rowBegin; rowIndex < rowEnd; rowIndex++ )
+		{
+			Rgba8* row = texels + (size_t)rowIndex * width;
+			for( int columnIndex = 0; columnIndex < width / 2; columnIndex++ )
+			{
+				Rgba8 swapTexel = row[columnIndex];
+				row[columnIndex] = row[width - 1 - columnIndex];
+				row[width - 1 - columnIndex] = swapTexel;
+			}
+		}
+	} );
+}
+
+//------------------------------------------------------------------------
+void PremultiplyAlpha( Image& image )
+{
+	Rgba8* texels = image.GetTexels();
+	int width = image.GetDimensions().x;
+	ParallelForRows( image.GetDimensions().y, width, [texels, width]( int rowBegin, int rowEnd )
+	{
+		for( int texelIndex = rowBegin * width; texelIndex < rowEnd * width; texelIndex++ )
+		{
+			float alpha = (float)texels[texelIndex].a * ( 1.f / 255.f );
+			StoreTexel4f( texels[texelIndex], MultiplyTexel4f( LoadTexel4f( texels[texelIndex] ), MakeTexel4f( alpha, alpha, alpha, 1.f ) ) );
+		}
+	} );
+}
+
+void UnpremultiplyAlpha( Image& image )
+{
+	Rgba8* texels = image.GetTexels();
+	int width = image.GetDimensions().x;
+	ParallelForRows( image.GetDimensions().y, width, [texels, width]( int rowBegin, int rowEnd )
+	{
+		for( int texelIndex = rowBegin * width; texelIndex < rowEnd * width; texelIndex++ )
+		{
+			unsigned char alpha = texels[texelIndex].a;
+			float inverseAlpha = alpha > 0 ? 255.f / (float)alpha : 1.f;
+			StoreTexel4f( texels[texelIndex], MultiplyTexel4f( LoadTexel4f( texels[texelIndex] ), MakeTexel4f( inverseAlpha, inverseAlpha, inverseAlpha, 1.f ) ) );
+		}
+	} );
+}
+
+//------------------------------------------------------------------------
+// Byte to byte tables; lookups don't vectorize without gathers, the rows still go wide
+struct SRGBTables
+{
+	SRGBTables()
+	{
+		for( int value = 0; value < 256; value++ )
+		{
+			float channel = (float)value / 255.f;
+			float linear = channel <= 0.04045f ? channel / 12.92f : powf( ( channel + 0.055f ) / 1.055f, 2.4f );
+			float srgb = channel <= 0.0031308f ? channel * 12.92f : 1.055f * powf( channel, 1.f / 2.4f ) - 0.055f;
+			m_srgbToLinear[value] = (unsigned char)( linear * 255.f + 0.5f );
+			m_linearToSRGB[value] = (unsigned char)( srgb * 255.f + 0.5f );
+		}
+	}
+
+	unsigned char m_srgbToLinear[256];
+	unsigned char m_linearToSRGB[256];
+};
+
+static const SRGBTables& GetSRGBTables()
+{
+	static SRGBTables s_tables;
+	return s_tables;
+}
+
+static void ApplyChannelTable( Image& image, const unsigned char* table )
+{
+	Rgba8* texels = image.GetTexels();
+	int width = image.GetDimensions().x;
+	ParallelForRows( image.GetDimensions().y, width, [texels, width, table]( int rowBegin, int rowEnd )
+	{
+		for( int texelIndex = rowBegin * width; texelIndex < rowEnd * width; texelIndex++ )
+		{
+			Rgba8& texel = texels[texelIndex];
+			texel.r = table[texel.r];
+			texel.g = table[texel.g];
+			texel.b = table[texel.b];
+		}
+	} );
+}
+
+void ConvertSRGBToLinear( Image& image )
+{
+	ApplyChannelTable( image, GetSRGBTables().m_srgbToLinear );
+}
+
+void ConvertLinearToSRGB( Image& image )
+{
+	ApplyChannelTable( image, GetSRGBTables().m_linearToSRGB );
+}
+
+//------------------------------------------------------------------------
+void BleedAlphaEdges( Image& image, int maxDistance )
+{
+	IntVec2 dimensions = image.GetDimensions();
+	int width = dimensions.x;
+	int height = dimensions.y;
+	Rgba8* texels = image.GetTexels();
+
+	// each pass only reads texels filled by earlier passes and only writes ones that weren't,
+	// so rows can run in parallel without stepping on each other
+	std::vector<unsigned char> wasFilled( (size_t)width * height );
+	for( int texelIndex = 0; texelIndex < width * height; texelIndex++ )
+	{
+		wasFilled[texelIndex] = texels[texelIndex].a > 0 ? 1 : 0;
+	}
+	std::vector<unsigned char> isFilled = wasFilled;
+	std::vector<unsigned char> didRowChange( height );
+
+	for( int passIndex = 0; passIndex < maxDistance; passIndex++ )
+	{
+		const unsigned char* previousFilled = wasFilled.data();
+		unsigned char* nextFilled = isFilled.data();
+		unsigned char* rowChanges = didRowChange.data();
+		ParallelForRows( height, width, [texels, previousFilled, nextFilled, rowChanges, width, height]( int rowBegin, int rowEnd )
+		{
+			for( int rowIndex = rowBegin; rowIndex < rowEnd; rowIndex++ )
+			{
+				rowChanges[rowIndex] = 0;
+				for( int columnIndex = 0; columnIndex < width; columnIndex++ )
+				{
+					int texelIndex = rowIndex * width + columnIndex;
+					if( previousFilled[texelIndex] )
+					{
+						continue;
+					}
+
+					int sumR = 0;
+					int sumG = 0;
+					int sumB = 0;
+					int numNeighbors = 0;
+					for( int neighborY = rowIndex - 1; neighborY <= rowIndex + 1; neighborY++ )
+					{
+						for( int neighborX = columnIndex - 1; neighborX <= columnIndex + 1; neighborX++ )
+						{
+							if( neighborX < 0 || neighborY < 0 || neighborX >= width || neighborY >= height || !previousFilled[neighborY * width + neighborX] )
+							{
+								continue;
+							}
+							const Rgba8& neighbor = texels[neighborY * width + neighborX];
+							sumR += neighbor.r;
+							sumG += neighbor.g;
+							sumB += neighbor.b;
+							numNeighbors++;
+						}
+					}
+
+					if( numNeighbors > 0 )
+					{
+						texels[texelIndex].r = (unsigned char)( ( sumR + numNeighbors / 2 ) / numNeighbors );
+						texels[texelIndex].g = (unsigned char)( ( sumG + numNeighbors / 2 ) / numNeighbors );
+						texels[texelIndex].b = (unsigned char)( ( sumB + numNeighbors / 2 ) / numNeighbors );
+						nextFilled[texelIndex] = 1;
+						rowChanges[rowIndex] = 1;
+					}
+				}
+			}
+		} );
+
+		bool didChange = false;
+		for( int rowIndex = 0; rowIndex < height && !didChange; rowIndex++ )
+		{
+			didChange = didRowChange[rowIndex] != 0;
+		}
+		if( !didChange )
+		{
+			break;
+		}
+		wasFilled = isFilled;
+	}
+}
+
+//------------------------------------------------------------------------
+void RotateTexels( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination, int numQuarterTurns )
+{
+	int width = sourceDimensions.x;
+	int height = sourceDimensions.y;
+	numQuarterTurns = ( ( numQuarterTurns % 4 ) + 4 ) % 4;
+
+	// destination index = base + x * xStride + y * yStride for source texel (x, y)
+	int base = 0;
+	int xStride = 1;
+	int yStride = width;
+	if( numQuarterTurns == 1 )
+	{
+		base = height - 1;
+		xStride = height;
+		yStride = -1;
+	}
+	else if( numQuarterTurns == 2 )
+	{
+		base = ( height - 1 ) * width + ( width - 1 );
+		xStride = -1;
+		yStride = -width;
+	}
+	else if( numQuarterTurns == 3 )
+	{
+		base = ( width - 1 ) * height;
+		xStride = -height;
+		yStride = 1;
+	}
+
+	// walk 32x32 tiles so the column-order side of the copy doesn't thrash the cache
+	int numTileRows = ( height + ROTATE_TILE_SIZE - 1 ) / ROTATE_TILE_SIZE;
+	ParallelForRows( numTileRows, width * ROTATE_TILE_SIZE, [=]( int tileRowBegin, int tileRowEnd )
+	{
+		for( int tileRow = tileRowBegin; tileRow < tileRowEnd; tileRow++ )
+		{
+			int tileBeginY = tileRow * ROTATE_TILE_SIZE;
+			int tileEndY = tileBeginY + ROTATE_TILE_SIZE < height ? tileBeginY + ROTATE_TILE_SIZE : height;
+			for( int tileBeginX = 0; tileBeginX < width; tileBeginX += ROTATE_TILE_SIZE )
+			{
+				int tileEndX = tileBeginX + ROTATE_TILE_SIZE < width ? tileBeginX + ROTATE_TILE_SIZE : width;
+				for( int y = tileBeginY; y < tileEndY; y++ )
+				{
+					const Rgba8* sourceRow = source + (size_t)y * width;
+					int destinationIndex = base + tileBeginX * xStride + y * yStride;
+					for( int x = tileBeginX; x < tileEndX; x++ )
+					{
+						destination[destinationIndex] = sourceRow[x];
+						destinationIndex += xStride;
+					}
+				}
+			}
+		}
+	} );
+}
+
+//------------------------------------------------------------------------
+template <typename CALLABLE>
+static double TimeBestOf( int numRuns, CALLABLE const& work )
+{
+	double bestSeconds = 1.0e9;
+	for( int runIndex = 0; runIndex < numRuns; runIndex++ )
+	{
+		double startSeconds = GetCurrentTimeSeconds();
+		work();
+		double seconds = GetCurrentTimeSeconds() - startSeconds;
+		bestSeconds = seconds < bestSeconds ? seconds : bestSeconds;
+	}
+	return bestSeconds;
+}
+
+static void PrintKernelTime( const char* kernelName, double seconds, int numTexels )
+{
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  %-24s %8.2f ms %8.1f Mtexels/s", kernelName, seconds * 1000.0, numTexels / seconds * 1.0e-6 ) );
+}
+
+static void BenchmarkImageKernels( const char* imageFilePath, int numRuns )
+{
+	Image image( imageFilePath );
+	IntVec2 dimensions = image.GetDimensions();
+	int numTexels = image.GetNumTexels();
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%s (%ix%i)", imageFilePath, dimensions.x, dimensions.y ) );
+
+	// what rotation used to cost, a texel at a time through the accessors
+	PrintKernelTime( "rotate 90, per texel", TimeBestOf( numRuns, [&image, dimensions]()
+	{
+		Image rotated( dimensions, Rgba8() );
+		for( int x = 0; x < dimensions.x; x++ )
+		{
+			for( int y = dimensions.y - 1; y >= 0; y-- )
+			{
+				int rotatedIndex = x * dimensions.y + ( dimensions.y - 1 - y );
+				rotated.GetTexels()[rotatedIndex] = image.GetTexelColor( x, y );
+			}
+		}
+	} ), numTexels );
+	PrintKernelTime( "rotate 90", TimeBestOf( numRuns, [&image]() { Image rotated( image, 1 ); } ), numTexels );
+
+	Image scratch( image );
+	PrintKernelTime( "flip horizontal", TimeBestOf( numRuns, [&scratch]() { FlipImageHorizontally( scratch ); } ), numTexels );
+	PrintKernelTime( "flip vertical", TimeBestOf( numRuns, [&scratch]() { FlipImageVertically( scratch ); } ), numTexels );
+	PrintKernelTime( "premultiply", TimeBestOf( numRuns, [&scratch]() { PremultiplyAlpha( scratch ); } ), numTexels );
+	PrintKernelTime( "unpremultiply", TimeBestOf( numRuns, [&scratch]() { UnpremultiplyAlpha( scratch ); } ), numTexels );
+	PrintKernelTime( "srgb to linear", TimeBestOf( numRuns, [&scratch]() { ConvertSRGBToLinear( scratch ); } ), numTexels );
+	PrintKernelTime( "alpha bleed 4", TimeBestOf( numRuns, [&scratch]() { BleedAlphaEdges( scratch, 4 ); } ), numTexels );
+
+	IntVec2 halfDimensions( dimensions.x / 2 > 0 ? dimensions.x / 2 : 1, dimensions.y / 2 > 0 ? dimensions.y / 2 : 1 );
+	PrintKernelTime( "half size 2x2 box", TimeBestOf( numRuns, [&image]() { delete CreateHalfSizeImage( image ); } ), numTexels );
+	PrintKernelTime( "resize 1/2 box", TimeBestOf( numRuns, [&image, halfDimensions]() { delete CreateResizedImage( image, halfDimensions, IMAGE_FILTER_BOX ); } ), numTexels );
+	PrintKernelTime( "resize 1/2 lanczos3", TimeBestOf( numRuns, [&image, halfDimensions]() { delete CreateResizedImage( image, halfDimensions, IMAGE_FILTER_LANCZOS3 ); } ), numTexels );
+	PrintKernelTime( "mip chain", TimeBestOf( numRuns, [&image]()
+	{
+		std::vector<Image*> mipLevels;
+		GenerateMipChain( image, mipLevels );
+		for( Image* mipLevel : mipLevels )
+		{
+			delete mipLevel;
+		}
+	} ), numTexels );
+}
+
+COMMAND( benchmark_image_kernels, "Time every image kernel on the game's sprite sheets, best of a few runs. e.g. benchmark_image_kernels runs=5", "runs" )
+{
+	int numRuns = args.GetValue( "runs", 5 );
+	numRuns < 1 ? numRuns = 1 : true;
+
+	BenchmarkImageKernels( "Data/Images/Terrain_32x32.png", numRuns );
+	BenchmarkImageKernels( "Data/Images/Megumin.png", numRuns );
+	BenchmarkImageKernels( "Data/Images/mainUIexport_oUI_4x2.png", numRuns );
+	BenchmarkImageKernels( "Data/Images/UI/success_spritesheet_2x8.png", numRuns );
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Engine/Core/Image.hpp"
+#include <vector>
+
+enum eImageFilter
+{
+	IMAGE_FILTER_BOX,			// area average when shrinking, nearest when growing
+	IMAGE_FILTER_LANCZOS3,		// sharper, rings a little on hard edges
+};
+
+//------------------------------------------------------------------------
+// CPU image kernels for load or bake time, no GPU needed. Rows are split across the job system
+// when there is one. Filtering assumes premultiplied alpha, so premultiply sprites with soft
+// edges first or bleed their edges (BleedAlphaEdges) before resizing.
+//------------------------------------------------------------------------
+Image*	CreateResizedImage( const Image& image, const IntVec2& newDimensions, eImageFilter filter = IMAGE_FILTER_LANCZOS3 );
+Image*	CreateHalfSizeImage( const Image& image );									// 2x2 box, an odd last row or column is dropped
+void	GenerateMipChain( const Image& image, std::vector<Image*>& out_mipLevels );	// appends every level below image down to 1x1, caller deletes them
+
+void	FlipImageVertically( Image& image );
+void	FlipImageHorizontally( Image& image );
+
+void	PremultiplyAlpha( Image& image );
+void	UnpremultiplyAlpha( Image& image );							// fully transparent texels are left as they are
+void	ConvertSRGBToLinear( Image& image );						// rgb only, alpha is linear either way; 8 bits loses dark detail
+void	ConvertLinearToSRGB( Image& image );
+
+// Gives fully transparent texels the average rgb of their visible neighbours, growing out
+// maxDistance texels, so filtering and mips don't drag black halos in around sprites
+void	BleedAlphaEdges( Image& image, int maxDistance = 4 );
+
+// Quarter turns, same convention as Image's rotating copy. Blocked so both
+// sides stay in cache; destination is sourceDimensions with x and y swapped for odd turns.
+void	RotateTexels( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination, int numQuarterTurns );
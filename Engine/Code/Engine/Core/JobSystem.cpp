@@ -0,0 +1,577 @@
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/Time.hpp"
+#include <chrono>
+#include <math.h>
+
+static constexpr int MAIN_THREAD_INDEX = 0;
+static constexpr int NOT_A_JOB_THREAD = -1;
+static constexpr int FREE_JOB_END = -1;
+static constexpr unsigned long long FREE_JOB_INDEX_MASK = 0xffffffffull;
+static constexpr int IDLE_SPINS_BEFORE_SLEEP = 64;
+
+static thread_local int t_jobThreadIndex = NOT_A_JOB_THREAD;
+
+//------------------------------------------------------------------------
+static unsigned long long PackFreeJobHead( int jobIndex, unsigned long long tag )
+{
+	return ( tag << 32 ) | ( (unsigned long long)(unsigned int)jobIndex );
+}
+
+//------------------------------------------------------------------------
+WorkStealingDeque::WorkStealingDeque( int capacity )
+{
+	GUARANTEE_OR_DIE( capacity > 0 && ( capacity & ( capacity - 1 ) ) == 0, "WorkStealingDeque capacity must be a power of two" );
+	m_jobs.reset( new std::atomic<Job*>[capacity] );
+	for( int i = 0; i < capacity; i++ )
+	{
+		m_jobs[i].store( nullptr, std::memory_order_relaxed );
+	}
+	m_mask = (long long)capacity - 1;
+	m_top.store( 0, std::memory_order_relaxed );
+	m_bottom.store( 0, std::memory_order_relaxed );
+}
+
+bool WorkStealingDeque::Push( Job* job )
+{
+	long long bottom = m_bottom.load( std::memory_order_relaxed );
+	long long top = m_top.load( std::memory_order_acquire );
+	if( bottom - top > m_mask )
+	{
+		return false;
+	}
+
+	m_jobs[bottom & m_mask].store( job, std::memory_order_relaxed );
+	m_bottom.store( bottom + 1, std::memory_order_release );		// publishes the job to thieves
+	return true;
+}
+
+Job* WorkStealingDeque::Take()
+{
+	long long bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+	m_bottom.store( bottom, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	long long top = m_top.load( std::memory_order_relaxed );
+
+	if( top > bottom )
+	{
+		// empty
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	Job* job = m_jobs[bottom & m_mask].load( std::memory_order_relaxed );
+	if( top == bottom )
+	{
+		// last one, race the thieves for it
+		if( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+		{
+			job = nullptr;
+		}
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+	}
+	return job;
+}
+
+Job* WorkStealingDeque::Steal()
+{
+	long long top = m_top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	long long bottom = m_bottom.load( std::memory_order_acquire );
+	if( top >= bottom )
+	{
+		return nullptr;
+	}
+
+	Job* job = m_jobs[top & m_mask].load( std::memory_order_relaxed );
+	if( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+	{
+		return nullptr;
+	}
+	return job;
+}
+
+//------------------------------------------------------------------------
+JobSystem::JobSystem()
+{
+	m_isRunning.store( false );
+	m_numInjectedJobs.store( 0 );
+	m_numSleeping.store( 0 );
+
+	m_jobPool = new Job[JOB_POOL_CAPACITY];
+	m_nextFreeJob.reset( new std::atomic<int>[JOB_POOL_CAPACITY] );
+	for( int i = 0; i < JOB_POOL_CAPACITY; i++ )
+	{
+		m_nextFreeJob[i].store( i + 1 < JOB_POOL_CAPACITY ? i + 1 : FREE_JOB_END, std::memory_order_relaxed );
+	}
+	m_freeJobHead.store( PackFreeJobHead( 0, 0 ) );
+}
+
+JobSystem::~JobSystem()
+{
+	Shutdown();
+	delete[] m_jobPool;
+	m_jobPool = nullptr;
+}
+
+void JobSystem::Startup( int numWorkers )
+{
+	if( numWorkers < 0 )
+	{
+		int numHardwareThreads = (int)std::thread::hardware_concurrency();
+		numWorkers = numHardwareThreads > 1 ? numHardwareThreads - 1 : 1;
+	}
+
+	m_numWorkers = numWorkers;
+	m_numThreads = numWorkers + 1;
+	m_threads = new ThreadState[m_numThreads];
+	for( int threadIndex = 0; threadIndex < m_numThreads; threadIndex++ )
+	{
+		m_threads[threadIndex].m_randomSeed = 0x9e3779b9u * (unsigned int)( threadIndex + 1 );
+	}
+
+	t_jobThreadIndex = MAIN_THREAD_INDEX;
+	m_isRunning.store( true );
+	for( int threadIndex = 1; threadIndex < m_numThreads; threadIndex++ )
+	{
+		m_threads[threadIndex].m_thread = std::thread( &JobSystem::WorkerMain, this, threadIndex );
+	}
+}
+
+void JobSystem::Shutdown()
+{
+	if( m_threads == nullptr )
+	{
+		return;
+	}
+
+	m_isRunning.store( false );
+	{
+		std::lock_guard<std::mutex> lock( m_sleepMutex );
+		m_sleepCondition.notify_all();
+	}
+	for( int threadIndex = 1; threadIndex < m_numThreads; threadIndex++ )
+	{
+		m_threads[threadIndex].m_thread.join();
+	}
+
+	// whatever never ran is dropped
+	for( int threadIndex = 0; threadIndex < m_numThreads; threadIndex++ )
+	{
+		while( Job* job = m_threads[threadIndex].m_deque.Steal() )
+		{
+			FreeJob( job );
+		}
+	}
+	for( Job* job : m_injectedJobs )
+	{
+		FreeJob( job );
+	}
+	m_injectedJobs.clear();
+	for( Job* job : m_mainThreadJobs )
+	{
+		FreeJob( job );
+	}
+	m_mainThreadJobs.clear();
+
+	delete[] m_threads;
+	m_threads = nullptr;
+	m_numWorkers = 0;
+	m_numThreads = 0;
+	t_jobThreadIndex = NOT_A_JOB_THREAD;
+}
+
+//------------------------------------------------------------------------
+void JobSystem::WaitFor( JobCounter& counter )
+{
+	bool isMainThread = IsMainThread();
+	while( !counter.IsDone() )
+	{
+		if( isMainThread )
+		{
+			RunMainThreadJobs();
+		}
+		if( !RunOneJob() )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::RunMainThreadJobs()
+{
+	std::vector<Job*> mainThreadJobs;
+	{
+		std::lock_guard<std::mutex> lock( m_mainThreadJobsMutex );
+		if( m_mainThreadJobs.empty() )
+		{
+			return;
+		}
+		mainThreadJobs.swap( m_mainThreadJobs );
+	}
+
+	for( Job* job : mainThreadJobs )
+	{
+		Execute( job );
+	}
+}
+
+bool JobSystem::IsMainThread() const
+{
+	return t_jobThreadIndex == MAIN_THREAD_INDEX;
+}
+
+bool JobSystem::IsWorkerThread() const
+{
+	return t_jobThreadIndex != MAIN_THREAD_INDEX && t_jobThreadIndex != NOT_A_JOB_THREAD;
+}
+
+JobSystemStats JobSystem::GetStats() const
+{
+	JobSystemStats stats;
+	stats.m_numThreads = m_numThreads;
+	for( int threadIndex = 0; threadIndex < m_numThreads; threadIndex++ )
+	{
+		ThreadState const& thread = m_threads[threadIndex];
+		stats.m_numJobsRun.push_back( thread.m_numJobsRun.load( std::memory_order_relaxed ) );
+		stats.m_numStealAttempts += thread.m_numStealAttempts.load( std::memory_order_relaxed );
+		stats.m_numSteals += thread.m_numSteals.load( std::memory_order_relaxed );
+	}
+	return stats;
+}
+
+void JobSystem::ResetStats()
+{
+	for( int threadIndex = 0; threadIndex < m_numThreads; threadIndex++ )
+	{
+		m_threads[threadIndex].m_numJobsRun.store( 0, std::memory_order_relaxed );
+		m_threads[threadIndex].m_numStealAttempts.store( 0, std::memory_order_relaxed );
+		m_threads[threadIndex].m_numSteals.store( 0, std::memory_order_relaxed );
+	}
+}
+
+//------------------------------------------------------------------------
+Job* JobSystem::AllocateJob()
+{
+	unsigned long long head = m_freeJobHead.load( std::memory_order_acquire );
+	while( true )
+	{
+		int jobIndex = (int)(unsigned int)( head & FREE_JOB_INDEX_MASK );
+		if( jobIndex == FREE_JOB_END )
+		{
+			return new Job();
+		}
+
+		int nextIndex = m_nextFreeJob[jobIndex].load( std::memory_order_relaxed );
+		unsigned long long newHead = PackFreeJobHead( nextIndex, ( head >> 32 ) + 1 );
+		if( m_freeJobHead.compare_exchange_weak( head, newHead, std::memory_order_acq_rel, std::memory_order_acquire ) )
+		{
+			return &m_jobPool[jobIndex];
+		}
+	}
+}
+
+void JobSystem::FreeJob( Job* job )
+{
+	job->m_work.Reset();
+	job->m_counter = nullptr;
+	job->m_affinity = JOB_AFFINITY_ANY;
+
+	if( job < m_jobPool || job >= m_jobPool + JOB_POOL_CAPACITY )
+	{
+		delete job;
+		return;
+	}
+
+	int jobIndex = (int)( job - m_jobPool );
+	unsigned long long head = m_freeJobHead.load( std::memory_order_acquire );
+	while( true )
+	{
+		m_nextFreeJob[jobIndex].store( (int)(unsigned int)( head & FREE_JOB_INDEX_MASK ), std::memory_order_relaxed );
+		unsigned long long newHead = PackFreeJobHead( jobIndex, ( head >> 32 ) + 1 );
+		if( m_freeJobHead.compare_exchange_weak( head, newHead, std::memory_order_acq_rel, std::memory_order_acquire ) )
+		{
+			return;
+		}
+	}
+}
+
+void JobSystem::Schedule( Job* job, JobCounter* dependency )
+{
+	if( dependency != nullptr && !dependency->IsDone() )
+	{
+		// flag and park under the lock, the job that takes the count to zero sees the flag and takes the lock after us
+		std::lock_guard<std::mutex> lock( dependency->m_waitingJobsMutex );
+		int value = dependency->m_value.load( std::memory_order_acquire );
+		while( ( value & JobCounter::COUNT_MASK ) != 0 )
+		{
+			if( dependency->m_value.compare_exchange_weak( value, value | JobCounter::HAS_WAITING_JOBS_BIT, std::memory_order_acq_rel, std::memory_order_acquire ) )
+			{
+				dependency->m_waitingJobs.push_back( job );
+				return;
+			}
+		}
+	}
+
+	Enqueue( job );
+}
+
+void JobSystem::Enqueue( Job* job )
+{
+	if( job->m_affinity == JOB_AFFINITY_MAIN_THREAD || m_threads == nullptr )
+	{
+		std::lock_guard<std::mutex> lock( m_mainThreadJobsMutex );
+		m_mainThreadJobs.push_back( job );
+		return;
+	}
+
+	int threadIndex = t_jobThreadIndex;
+	if( threadIndex == NOT_A_JOB_THREAD )
+	{
+		std::lock_guard<std::mutex> lock( m_injectedJobsMutex );
+		m_injectedJobs.push_back( job );
+		m_numInjectedJobs.fetch_add( 1, std::memory_order_release );
+	}
+	else if( !m_threads[threadIndex].m_deque.Push( job ) )
+	{
+		// deque is full, nobody is short of work
+		Execute( job );
+		return;
+	}
+
+	if( m_numSleeping.load( std::memory_order_acquire ) > 0 )
+	{
+		std::lock_guard<std::mutex> lock( m_sleepMutex );
+		m_sleepCondition.notify_one();
+	}
+}
+
+void JobSystem::Execute( Job* job )
+{
+	job->m_work();
+
+	int threadIndex = t_jobThreadIndex;
+	if( threadIndex != NOT_A_JOB_THREAD && m_threads != nullptr )
+	{
+		m_threads[threadIndex].m_numJobsRun.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	JobCounter* counter = job->m_counter;
+	FreeJob( job );
+	if( counter != nullptr )
+	{
+		// without parked jobs this is the last touch of the counter, its owner may free it right after
+		int previousValue = counter->m_value.fetch_sub( 1, std::memory_order_acq_rel );
+		if( previousValue == ( 1 | JobCounter::HAS_WAITING_JOBS_BIT ) )
+		{
+			ReleaseWaitingJobs( counter );
+		}
+	}
+}
+
+void JobSystem::ReleaseWaitingJobs( JobCounter* counter )
+{
+	std::vector<Job*> waitingJobs;
+	{
+		std::lock_guard<std::mutex> lock( counter->m_waitingJobsMutex );
+		waitingJobs.swap( counter->m_waitingJobs );
+	}
+	// IsDone() turns true here, so nothing below may touch the counter
+	counter->m_value.fetch_and( ~JobCounter::HAS_WAITING_JOBS_BIT, std::memory_order_acq_rel );
+
+	for( Job* job : waitingJobs )
+	{
+		Enqueue( job );
+	}
+}
+
+//------------------------------------------------------------------------
+Job* JobSystem::FindJob( int threadIndex )
+{
+	if( threadIndex != NOT_A_JOB_THREAD )
+	{
+		if( Job* job = m_threads[threadIndex].m_deque.Take() )
+		{
+			return job;
+		}
+	}
+
+	if( m_numInjectedJobs.load( std::memory_order_acquire ) > 0 )
+	{
+		std::lock_guard<std::mutex> lock( m_injectedJobsMutex );
+		if( !m_injectedJobs.empty() )
+		{
+			Job* job = m_injectedJobs.back();
+			m_injectedJobs.pop_back();
+			m_numInjectedJobs.fetch_sub( 1, std::memory_order_release );
+			return job;
+		}
+	}
+
+	return StealJob( threadIndex );
+}
+
+Job* JobSystem::StealJob( int threadIndex )
+{
+	if( m_numThreads < 2 )
+	{
+		return nullptr;
+	}
+
+	// start at a random victim so thieves spread out
+	unsigned int seed = threadIndex != NOT_A_JOB_THREAD ? m_threads[threadIndex].m_randomSeed : (unsigned int)std::hash<std::thread::id>()( std::this_thread::get_id() );
+	seed = seed * 1664525u + 1013904223u;
+	if( threadIndex != NOT_A_JOB_THREAD )
+	{
+		m_threads[threadIndex].m_randomSeed = seed;
+	}
+
+	int firstVictim = (int)( ( seed >> 8 ) % (unsigned int)m_numThreads );
+	for( int victimOffset = 0; victimOffset < m_numThreads; victimOffset++ )
+	{
+		int victimIndex = ( firstVictim + victimOffset ) % m_numThreads;
+		if( victimIndex == threadIndex )
+		{
+			continue;
+		}
+
+		Job* job = m_threads[victimIndex].m_deque.Steal();
+		if( threadIndex != NOT_A_JOB_THREAD )
+		{
+			m_threads[threadIndex].m_numStealAttempts.fetch_add( 1, std::memory_order_relaxed );
+			if( job != nullptr )
+			{
+				m_threads[threadIndex].m_numSteals.fetch_add( 1, std::memory_order_relaxed );
+			}
+		}
+		if( job != nullptr )
+		{
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+bool JobSystem::RunOneJob()
+{
+	if( m_threads == nullptr )
+	{
+		return false;
+	}
+
+	Job* job = FindJob( t_jobThreadIndex );
+	if( job == nullptr )
+	{
+		return false;
+	}
+
+	Execute( job );
+	return true;
+}
+
+void JobSystem::WorkerMain( int threadIndex )
+{
+	t_jobThreadIndex = threadIndex;
+	ProfilerSetThreadName( Stringf( "Job Worker %i", threadIndex ) );
+	LoggerSetThreadName( Stringf( "Job Worker %i", threadIndex ) );
+
+	int numIdleSpins = 0;
+	while( m_isRunning.load( std::memory_order_acquire ) )
+	{
+		if( RunOneJob() )
+		{
+			numIdleSpins = 0;
+			continue;
+		}
+
+		if( ++numIdleSpins < IDLE_SPINS_BEFORE_SLEEP )
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock( m_sleepMutex );
+		m_numSleeping.fetch_add( 1, std::memory_order_acq_rel );
+		m_sleepCondition.wait_for( lock, std::chrono::milliseconds( 1 ) );
+		m_numSleeping.fetch_sub( 1, std::memory_order_acq_rel );
+		numIdleSpins = 0;
+	}
+}
+
+//------------------------------------------------------------------------
+// Benchmarks
+//------------------------------------------------------------------------
+static void PrintJobStats( JobSystemStats const& stats )
+{
+	std::string jobsPerThread;
+	for( int threadIndex = 0; threadIndex < stats.m_numThreads; threadIndex++ )
+	{
+		jobsPerThread += Stringf( "%i ", stats.m_numJobsRun[threadIndex] );
+	}
+	float stealRate = stats.m_numStealAttempts > 0 ? 100.f * (float)stats.m_numSteals / (float)stats.m_numStealAttempts : 0.f;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  jobs per thread (main first): %s", jobsPerThread.c_str() ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  steals: %i of %i attempts (%.1f%%)", stats.m_numSteals, stats.m_numStealAttempts, stealRate ) );
+}
+
+COMMAND( benchmark_jobs, "Measure job spawn overhead, fan-out/fan-in and steal rate. e.g. benchmark_jobs jobs=100000 items=4000000 grain=4096", "jobs,items,grain" )
+{
+	int numJobs = args.GetValue( "jobs", 100000 );
+	int numItems = args.GetValue( "items", 4000000 );
+	int grainSize = args.GetValue( "grain", 4096 );
+
+	JobSystem* jobSystem = g_theJobSystem;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%i workers + main thread", jobSystem->GetNumWorkers() ) );
+
+	// spawn overhead: empty jobs on one counter
+	std::atomic<int> numRan( 0 );
+	jobSystem->ResetStats();
+	JobCounter spawnCounter;
+	double startSeconds = GetCurrentTimeSeconds();
+	for( int jobIndex = 0; jobIndex < numJobs; jobIndex++ )
+	{
+		jobSystem->Run( [&numRan]() { numRan.fetch_add( 1, std::memory_order_relaxed ); }, &spawnCounter );
+	}
+	double spawnSeconds = GetCurrentTimeSeconds() - startSeconds;
+	jobSystem->WaitFor( spawnCounter );
+	double totalSeconds = GetCurrentTimeSeconds() - startSeconds;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "spawn: %i jobs, %.1f ns/spawn, %.1f ns/job spawn to done", numRan.load(), spawnSeconds * 1.0e9 / numJobs, totalSeconds * 1.0e9 / numJobs ) );
+	PrintJobStats( jobSystem->GetStats() );
+
+	// fan-out/fan-in: ParallelFor against the same loop on one thread
+	std::vector<float> items( numItems );
+	startSeconds = GetCurrentTimeSeconds();
+	for( int itemIndex = 0; itemIndex < numItems; itemIndex++ )
+	{
+		items[itemIndex] = sqrtf( (float)itemIndex ) * sinf( (float)itemIndex );
+	}
+	double serialSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	jobSystem->ResetStats();
+	startSeconds = GetCurrentTimeSeconds();
+	jobSystem->ParallelFor( 0, numItems, grainSize, [&items]( int rangeBegin, int rangeEnd )
+	{
+		for( int itemIndex = rangeBegin; itemIndex < rangeEnd; itemIndex++ )
+		{
+			items[itemIndex] = sqrtf( (float)itemIndex ) * sinf( (float)itemIndex );
+		}
+	} );
+	double parallelSeconds = GetCurrentTimeSeconds() - startSeconds;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "fan-out/in: %i items, grain %i, serial %.2f ms, parallel %.2f ms (%.2fx)", numItems, grainSize, serialSeconds * 1000.0, parallelSeconds * 1000.0, serialSeconds / parallelSeconds ) );
+	PrintJobStats( jobSystem->GetStats() );
+
+	// dependency chain: each stage waits on the previous stage's counter
+	JobCounter stageCounters[4];
+	startSeconds = GetCurrentTimeSeconds();
+	for( int stageIndex = 0; stageIndex < 4; stageIndex++ )
+	{
+		JobCounter* dependency = stageIndex > 0 ? &stageCounters[stageIndex - 1] : nullptr;
+		for( int jobIndex = 0; jobIndex < 64; jobIndex++ )
+		{
+			jobSystem->Run( [&numRan]() { numRan.fetch_add( 1, std::memory_order_relaxed ); }, &stageCounters[stageIndex], dependency );
+		}
+	}
+	jobSystem->WaitFor( stageCounters[3] );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "dependencies: 4 stages x 64 jobs in %.3f ms", ( GetCurrentTimeSeconds() - startSeconds ) * 1000.0 ) );
+}
@@ -0,0 +1,216 @@
+#pragma once
+#include "Engine/Core/Delegate.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+struct Job;
+
+typedef DelegateCallable<> JobFunction;
+
+enum eJobAffinity
+{
+	JOB_AFFINITY_ANY,
+	JOB_AFFINITY_MAIN_THREAD,		// renderer and other main-thread-only calls, run from RunMainThreadJobs
+
+	NUM_JOB_AFFINITIES
+};
+
+//------------------------------------------------------------------------
+// Counts unfinished jobs; jobs that depend on it are held here until it reaches zero.
+// Safe to destroy as soon as IsDone() returns true.
+//------------------------------------------------------------------------
+class JobCounter
+{
+	friend class JobSystem;
+
+public:
+	JobCounter() { m_value.store( 0 ); }
+	JobCounter( JobCounter const& copyFrom ) = delete;
+
+	bool IsDone() const		{ return m_value.load( std::memory_order_acquire ) == 0; }
+	int GetValue() const	{ return m_value.load( std::memory_order_acquire ) & COUNT_MASK; }
+
+private:
+	// set while dependent jobs are parked here, cleared only once they have been handed off
+	static constexpr int HAS_WAITING_JOBS_BIT = 1 << 30;
+	static constexpr int COUNT_MASK = HAS_WAITING_JOBS_BIT - 1;
+
+	std::atomic<int> m_value;
+	std::mutex m_waitingJobsMutex;
+	std::vector<Job*> m_waitingJobs;
+};
+
+//------------------------------------------------------------------------
+struct Job
+{
+	JobFunction m_work;
+	JobCounter* m_counter = nullptr;
+	eJobAffinity m_affinity = JOB_AFFINITY_ANY;
+};
+
+//------------------------------------------------------------------------
+// Chase-Lev deque: the owning thread pushes and takes at the bottom, other threads steal from the top.
+// Fixed capacity, Push fails when full.
+//------------------------------------------------------------------------
+class WorkStealingDeque
+{
+public:
+	WorkStealingDeque( int capacity );
+
+	bool Push( Job* job );				// owner thread only
+	Job* Take();						// owner thread only, newest first
+	Job* Steal();						// any thread, oldest first; nullptr when empty or it lost a race
+
+private:
+	std::unique_ptr<std::atomic<Job*>[]> m_jobs;
+	long long m_mask = 0;
+	std::atomic<long long> m_top;
+	char m_cacheLinePadding[64];		// keep thieves and the owner off the same line
+	std::atomic<long long> m_bottom;
+};
+
+//------------------------------------------------------------------------
+struct JobSystemStats
+{
+	int m_numThreads = 0;
+	std::vector<int> m_numJobsRun;		// per thread, index 0 is the main thread
+	int m_numStealAttempts = 0;
+	int m_numSteals = 0;
+};
+
+//------------------------------------------------------------------------
+// Fixed worker pool with one work-stealing deque per thread. The main thread is thread 0 and
+// helps run jobs while it waits.
+//------------------------------------------------------------------------
+class JobSystem
+{
+public:
+	JobSystem();
+	~JobSystem();
+
+	void Startup( int numWorkers = -1 );			// -1 sizes the pool to the hardware, leaving a core for the main thread
+	void Shutdown();
+
+	// counter (optional) is incremented now and decremented when the job finishes;
+	// a job with a dependency does not start until that counter reaches zero
+	template <typename CALLABLE>
+	void Run( CALLABLE const& work, JobCounter* counter = nullptr, JobCounter* dependency = nullptr, eJobAffinity affinity = JOB_AFFINITY_ANY );
+
+	// work( rangeBegin, rangeEnd ) is called on chunks of at most grainSize indices; blocks until all chunks finish
+	template <typename CALLABLE>
+	void ParallelFor( int beginIndex, int endIndex, int grainSize, CALLABLE const& work );
+
+	void WaitFor( JobCounter& counter );			// runs other jobs while waiting
+	void RunMainThreadJobs();						// main thread, once a frame
+
+	int GetNumWorkers() const						{ return m_numWorkers; }
+	bool IsMainThread() const;
+	bool IsWorkerThread() const;					// one of the pool's own threads, not the main thread
+	JobSystemStats GetStats() const;
+	void ResetStats();
+
+private:
+	struct ThreadState
+	{
+		ThreadState() : m_deque( DEQUE_CAPACITY ) { m_numJobsRun.store( 0 ); m_numStealAttempts.store( 0 ); m_numSteals.store( 0 ); }
+
+		WorkStealingDeque m_deque;
+		std::thread m_thread;
+		std::atomic<int> m_numJobsRun;
+		std::atomic<int> m_numStealAttempts;
+		std::atomic<int> m_numSteals;
+		unsigned int m_randomSeed = 0;
+		char m_cacheLinePadding[64];
+	};
+
+	Job* AllocateJob();
+	void FreeJob( Job* job );
+	void Schedule( Job* job, JobCounter* dependency );
+	void Enqueue( Job* job );
+	void Execute( Job* job );
+	void ReleaseWaitingJobs( JobCounter* counter );
+
+	Job* FindJob( int threadIndex );
+	Job* StealJob( int threadIndex );
+	bool RunOneJob();
+	void WorkerMain( int threadIndex );
+
+private:
+	static constexpr int DEQUE_CAPACITY = 4096;
+	static constexpr int JOB_POOL_CAPACITY = 8192;
+
+	int m_numWorkers = 0;
+	int m_numThreads = 0;
+	ThreadState* m_threads = nullptr;
+	std::atomic<bool> m_isRunning;
+
+	// jobs posted from threads that are not part of the pool
+	std::mutex m_injectedJobsMutex;
+	std::vector<Job*> m_injectedJobs;
+	std::atomic<int> m_numInjectedJobs;
+
+	std::mutex m_mainThreadJobsMutex;
+	std::vector<Job*> m_mainThreadJobs;
+
+	// idle workers sleep here; wait_for timeout covers a wake that races with going to sleep
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+	std::atomic<int> m_numSleeping;
+
+	// fixed pool of jobs behind a lock-free free list, falls back to the heap
+	Job* m_jobPool = nullptr;
+	std::unique_ptr<std::atomic<int>[]> m_nextFreeJob;
+	std::atomic<unsigned long long> m_freeJobHead;		// low 32 bits index, high 32 bits ABA tag
+};
+
+//------------------------------------------------------------------------
+template <typename CALLABLE>
+void JobSystem::Run( CALLABLE const& work, JobCounter* counter, JobCounter* dependency, eJobAffinity affinity )
+{
+	Job* job = AllocateJob();
+	job->m_work = JobFunction( work );
+	job->m_counter = counter;
+	job->m_affinity = affinity;
+	if( counter != nullptr )
+	{
+		counter->m_value.fetch_add( 1, std::memory_order_acq_rel );
+	}
+
+	Schedule( job, dependency );
+}
+
+//------------------------------------------------------------------------
+template <typename CALLABLE>
+void JobSystem::ParallelFor( int beginIndex, int endIndex, int grainSize, CALLABLE const& work )
+{
+	if( endIndex <= beginIndex )
+	{
+		return;
+	}
+	grainSize < 1 ? grainSize = 1 : true;
+
+	// too small to split, or nobody to share with
+	if( endIndex - beginIndex <= grainSize || m_numWorkers == 0 )
+	{
+		work( beginIndex, endIndex );
+		return;
+	}
+
+	JobCounter counter;
+	CALLABLE const* workPtr = &work;
+	for( int rangeBegin = beginIndex + grainSize; rangeBegin < endIndex; rangeBegin += grainSize )
+	{
+		int rangeEnd = rangeBegin + grainSize < endIndex ? rangeBegin + grainSize : endIndex;
+		Run( [workPtr, rangeBegin, rangeEnd]() { ( *workPtr )( rangeBegin, rangeEnd ); }, &counter );
+	}
+
+	// the calling thread takes the first chunk itself
+	work( beginIndex, beginIndex + grainSize );
+	WaitFor( counter );
+}
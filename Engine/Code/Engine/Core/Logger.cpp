@@ -0,0 +1,913 @@
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+static constexpr unsigned int LOG_RING_CAPACITY = 1 << 11;			// records per thread, 512 KB
+static constexpr unsigned int LOG_RING_MASK = LOG_RING_CAPACITY - 1;
+static constexpr int LOG_WRITER_INTERVAL_MS = 10;
+static constexpr size_t LOG_FILE_MAX_BYTES = 8 * 1024 * 1024;
+static constexpr int LOG_FILE_NUM_BACKUPS = 3;						// Game.log.1 is the newest
+static constexpr int LOG_CONSOLE_MAX_PENDING_LINES = 1024;			// between two LoggerEndFrame calls
+static constexpr int MAX_MUTED_LOG_CHANNELS = 32;
+
+//------------------------------------------------------------------------
+// Single producer (the owning thread), single consumer (the writer thread)
+struct LoggerThreadBuffer
+{
+	LogRecord* m_records = nullptr;
+	std::atomic<unsigned int> m_writeIndex;
+	char m_cacheLinePadding[64];
+	std::atomic<unsigned int> m_readIndex;
+	std::atomic<int> m_numDropped;
+
+	int m_numDroppedReported = 0;		// writer thread only
+	std::string m_threadName;			// written under LoggerState::m_threadsMutex
+};
+
+struct PendingLogLine
+{
+	unsigned long long m_ticks = 0;
+	eLogLevel m_level = LOG_LEVEL_INFO;
+	size_t m_offset = 0;				// into LoggerState::m_pendingText
+	size_t m_length = 0;
+	size_t m_consoleOffset = 0;			// the console leaves off the time and thread
+};
+
+struct ConsoleLogLine
+{
+	Rgba8 m_color;
+	std::string m_text;
+};
+
+struct LoggerState
+{
+	std::mutex m_threadsMutex;
+	std::vector<LoggerThreadBuffer*> m_threads;
+
+	std::thread m_writerThread;
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	std::condition_variable m_passFinishedCondition;
+	bool m_isStopping = false;						// these four under m_wakeMutex
+	bool m_isFlushRequested = false;
+	unsigned long long m_numPassesStarted = 0;
+	unsigned long long m_numPassesFinished = 0;
+
+	// writer thread only
+	std::string m_filePath;
+	FILE* m_file = nullptr;
+	size_t m_fileSize = 0;
+	unsigned long long m_startTicks = 0;
+	std::vector<LoggerThreadBuffer*> m_drainThreads;
+	std::vector<std::string> m_drainThreadNames;
+	std::vector<PendingLogLine> m_pendingLines;
+	std::string m_pendingText;
+	std::vector<ConsoleLogLine> m_pendingConsoleLines;
+
+	std::mutex m_consoleMutex;
+	std::vector<ConsoleLogLine> m_consoleLines;
+	int m_numConsoleLinesDropped = 0;				// under m_consoleMutex
+
+	std::atomic<unsigned long long> m_numRecordsWritten;
+	std::atomic<unsigned long long> m_numBytesWritten;
+	std::atomic<int> m_numRotations;
+};
+
+static std::atomic<LoggerState*> s_logger( nullptr );
+static thread_local LoggerThreadBuffer* t_loggerBuffer = nullptr;
+static thread_local LoggerState* t_loggerBufferOwner = nullptr;
+
+// filters outlive the logger so they can be set before startup; only changed from the main thread
+static std::atomic<int> s_minLogLevel( LOG_LEVEL_INFO );
+static std::atomic<int> s_consoleMinLogLevel( LOG_LEVEL_WARNING );
+static std::atomic<StringID> s_mutedChannels[MAX_MUTED_LOG_CHANNELS];
+static std::atomic<int> s_numMutedChannels( 0 );
+
+static char const* const LOG_LEVEL_NAMES[NUM_LOG_LEVELS] = { "Verbose", "Info", "Warning", "Error" };
+
+//------------------------------------------------------------------------
+static LoggerThreadBuffer* GetThreadBuffer()
+{
+	LoggerState* logger = s_logger.load( std::memory_order_acquire );
+	if( logger == nullptr )
+	{
+		return nullptr;
+	}
+	if( t_loggerBuffer != nullptr && t_loggerBufferOwner == logger )
+	{
+		return t_loggerBuffer;
+	}
+
+	LoggerThreadBuffer* buffer = new LoggerThreadBuffer();
+	buffer->m_records = new LogRecord[LOG_RING_CAPACITY];
+	buffer->m_writeIndex.store( 0 );
+	buffer->m_readIndex.store( 0 );
+	buffer->m_numDropped.store( 0 );
+	{
+		std::lock_guard<std::mutex> lock( logger->m_threadsMutex );
+		buffer->m_threadName = Stringf( "Thread %i", (int)logger->m_threads.size() );
+		logger->m_threads.push_back( buffer );
+	}
+
+	t_loggerBuffer = buffer;
+	t_loggerBufferOwner = logger;
+	return buffer;
+}
+
+//------------------------------------------------------------------------
+void LogRecord::AppendInteger( eLogArgType type, unsigned long long value )
+{
+	if( m_payloadSize + sizeof( value ) > LOG_RECORD_PAYLOAD_SIZE )
+	{
+		m_argTypes[m_numArgs++] = LOG_ARG_MISSING;
+		return;
+	}
+
+	memcpy( &m_payload[m_payloadSize], &value, sizeof( value ) );
+	m_payloadSize += (unsigned short)sizeof( value );
+	m_argTypes[m_numArgs++] = type;
+}
+
+void LogRecord::AppendDouble( double value )
+{
+	unsigned long long bits = 0;
+	memcpy( &bits, &value, sizeof( value ) );
+	AppendInteger( LOG_ARG_DOUBLE, bits );
+}
+
+void LogRecord::AppendString( std::string_view text )
+{
+	// a length byte and a terminator around as much of the text as fits
+	int room = LOG_RECORD_PAYLOAD_SIZE - m_payloadSize - 2;
+	if( room < 0 )
+	{
+		m_argTypes[m_numArgs++] = LOG_ARG_MISSING;
+		return;
+	}
+
+	size_t length = text.size() < (size_t)room ? text.size() : (size_t)room;
+	m_payload[m_payloadSize] = (unsigned char)length;
+	memcpy( &m_payload[m_payloadSize + 1], text.data(), length );
+	m_payload[m_payloadSize + 1 + length] = '\0';
+	m_payloadSize += (unsigned short)( length + 2 );
+	m_argTypes[m_numArgs++] = LOG_ARG_STRING;
+}
+
+//------------------------------------------------------------------------
+LogRecord* LoggerBeginRecord()
+{
+	LoggerThreadBuffer* buffer = GetThreadBuffer();
+	if( buffer == nullptr )
+	{
+		return nullptr;
+	}
+
+	unsigned int writeIndex = buffer->m_writeIndex.load( std::memory_order_relaxed );
+	unsigned int readIndex = buffer->m_readIndex.load( std::memory_order_acquire );
+	if( writeIndex - readIndex >= LOG_RING_CAPACITY )
+	{
+		buffer->m_numDropped.fetch_add( 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	LogRecord* record = &buffer->m_records[writeIndex & LOG_RING_MASK];
+	record->m_ticks = GetCurrentTimeTicks();
+	return record;
+}
+
+void LoggerCommitRecord()
+{
+	// only reached after LoggerBeginRecord handed out a record on this thread
+	LoggerThreadBuffer* buffer = t_loggerBuffer;
+	unsigned int writeIndex = buffer->m_writeIndex.load( std::memory_order_relaxed );
+	buffer->m_writeIndex.store( writeIndex + 1, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------
+bool IsLogEnabled( StringID channelID, eLogLevel level )
+{
+	if( (int)level < s_minLogLevel.load( std::memory_order_relaxed ) )
+	{
+		return false;
+	}
+
+	int numMutedChannels = s_numMutedChannels.load( std::memory_order_acquire );
+	for( int channelIndex = 0; channelIndex < numMutedChannels; channelIndex++ )
+	{
+		if( s_mutedChannels[channelIndex].load( std::memory_order_relaxed ) == channelID )
+		{
+			return false;
+		}
+	}
+	return s_logger.load( std::memory_order_relaxed ) != nullptr;
+}
+
+void LoggerSetMinLevel( eLogLevel level )
+{
+	s_minLogLevel.store( (int)level, std::memory_order_relaxed );
+}
+
+void LoggerSetConsoleMinLevel( eLogLevel level )
+{
+	s_consoleMinLogLevel.store( (int)level, std::memory_order_relaxed );
+}
+
+void LoggerSetChannelEnabled( std::string_view channel, bool isEnabled )
+{
+	StringID channelID = HashStringID( channel );
+	int numMutedChannels = s_numMutedChannels.load( std::memory_order_relaxed );
+	for( int channelIndex = 0; channelIndex < numMutedChannels; channelIndex++ )
+	{
+		if( s_mutedChannels[channelIndex].load( std::memory_order_relaxed ) != channelID )
+		{
+			continue;
+		}
+		if( !isEnabled )
+		{
+			return;
+		}
+
+		// a thread checking right now may still see it muted, which is fine for a filter
+		s_mutedChannels[channelIndex].store( s_mutedChannels[numMutedChannels - 1].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+		s_numMutedChannels.store( numMutedChannels - 1, std::memory_order_release );
+		return;
+	}
+
+	if( isEnabled )
+	{
+		return;
+	}
+	GUARANTEE_OR_DIE( numMutedChannels < MAX_MUTED_LOG_CHANNELS, "Too many muted log channels" );
+	s_mutedChannels[numMutedChannels].store( channelID, std::memory_order_relaxed );
+	s_numMutedChannels.store( numMutedChannels + 1, std::memory_order_release );
+}
+
+char const* GetLogLevelName( eLogLevel level )
+{
+	return level < NUM_LOG_LEVELS ? LOG_LEVEL_NAMES[level] : "Unknown";
+}
+
+bool ParseLogLevel( eLogLevel* out_level, std::string_view text )
+{
+	for( int levelIndex = 0; levelIndex < NUM_LOG_LEVELS; levelIndex++ )
+	{
+		std::string_view levelName = LOG_LEVEL_NAMES[levelIndex];
+		if( levelName.size() != text.size() )
+		{
+			continue;
+		}
+
+		bool isMatch = true;
+		for( size_t charIndex = 0; charIndex < text.size() && isMatch; charIndex++ )
+		{
+			isMatch = tolower( (unsigned char)levelName[charIndex] ) == tolower( (unsigned char)text[charIndex] );
+		}
+		if( isMatch )
+		{
+			*out_level = (eLogLevel)levelIndex;
+			return true;
+		}
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+// Walks a record's arguments in the order LogMessage appended them
+class LogArgReader
+{
+public:
+	explicit LogArgReader( LogRecord const& record ) : m_record( record ) {}
+
+	bool ReadNext( eLogArgType* out_type, unsigned long long* out_bits, char const** out_text )
+	{
+		if( m_argIndex >= m_record.m_numArgs )
+		{
+			return false;
+		}
+
+		*out_type = m_record.m_argTypes[m_argIndex++];
+		if( *out_type == LOG_ARG_STRING )
+		{
+			*out_text = (char const*)&m_record.m_payload[m_payloadOffset + 1];
+			m_payloadOffset += m_record.m_payload[m_payloadOffset] + 2;
+		}
+		else if( *out_type != LOG_ARG_MISSING )
+		{
+			memcpy( out_bits, &m_record.m_payload[m_payloadOffset], sizeof( *out_bits ) );
+			m_payloadOffset += (int)sizeof( *out_bits );
+		}
+		return true;
+	}
+
+private:
+	LogRecord const& m_record;
+	int m_argIndex = 0;
+	int m_payloadOffset = 0;
+};
+
+static double GetLogArgAsDouble( eLogArgType type, unsigned long long bits )
+{
+	if( type == LOG_ARG_DOUBLE )
+	{
+		double value = 0.0;
+		memcpy( &value, &bits, sizeof( value ) );
+		return value;
+	}
+	return type == LOG_ARG_SIGNED ? (double)(long long)bits : (double)bits;
+}
+
+static unsigned long long GetLogArgAsInteger( eLogArgType type, unsigned long long bits )
+{
+	return type == LOG_ARG_DOUBLE ? (unsigned long long)(long long)GetLogArgAsDouble( type, bits ) : bits;
+}
+
+// printf for one record, whose arguments were widened to 64 bits and strings when they were captured
+static void AppendFormattedRecord( std::string& out_text, LogRecord const& record )
+{
+	LogArgReader argReader( record );
+	char const* format = record.m_format;
+	while( *format != '\0' )
+	{
+		char const* percent = strchr( format, '%' );
+		if( percent == nullptr )
+		{
+			out_text.append( format );
+			return;
+		}
+		out_text.append( format, percent - format );
+		if( percent[1] == '%' )
+		{
+			out_text.push_back( '%' );
+			format = percent + 2;
+			continue;
+		}
+
+		// %[flags][width][.precision][length]conversion, rebuilt without the length
+		char spec[32];
+		int specLength = 0;
+		spec[specLength++] = '%';
+		char const* specEnd = percent + 1;
+		bool isSpecTooLong = false;
+		auto copySpecChars = [&]( char const* chars )
+		{
+			while( *specEnd != '\0' && strchr( chars, *specEnd ) != nullptr )
+			{
+				if( specLength >= (int)sizeof( spec ) - 4 )
+				{
+					isSpecTooLong = true;
+					return;
+				}
+				spec[specLength++] = *specEnd++;
+			}
+		};
+		auto copySpecStar = [&]()
+		{
+			if( *specEnd != '*' )
+			{
+				copySpecChars( "0123456789" );
+				return;
+			}
+			++specEnd;
+			eLogArgType type = LOG_ARG_MISSING;
+			unsigned long long bits = 0;
+			char const* text = nullptr;
+			int value = argReader.ReadNext( &type, &bits, &text ) && type != LOG_ARG_STRING && type != LOG_ARG_MISSING ? (int)GetLogArgAsInteger( type, bits ) : 0;
+			int written = snprintf( &spec[specLength], sizeof( spec ) - 4 - specLength, "%i", value );
+			if( written < 0 || specLength + written >= (int)sizeof( spec ) - 4 )
+			{
+				isSpecTooLong = true;
+				return;
+			}
+			specLength += written;
+		};
+
+		copySpecChars( "-+ #0" );
+		copySpecStar();
+		if( *specEnd == '.' )
+		{
+			spec[specLength++] = *specEnd++;
+			copySpecStar();
+		}
+		while( *specEnd != '\0' && strchr( "hlLzjtqI", *specEnd ) != nullptr )
+		{
+			++specEnd;
+			if( specEnd[-1] == 'I' )
+			{
+				while( *specEnd >= '0' && *specEnd <= '9' )
+				{
+					++specEnd;
+				}
+			}
+		}
+
+		char conversion = *specEnd;
+		if( conversion == '\0' || isSpecTooLong )
+		{
+			out_text.append( percent );
+			return;
+		}
+		format = specEnd + 1;
+
+		eLogArgType type = LOG_ARG_MISSING;
+		unsigned long long bits = 0;
+		char const* text = nullptr;
+		if( !argReader.ReadNext( &type, &bits, &text ) || type == LOG_ARG_MISSING )
+		{
+			out_text.append( "<?>" );
+			continue;
+		}
+
+		char formatted[512];
+		int numChars = -1;
+		switch( conversion )
+		{
+			case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+			{
+				if( type == LOG_ARG_STRING )
+				{
+					out_text.append( text );
+					continue;
+				}
+				spec[specLength++] = 'l';
+				spec[specLength++] = 'l';
+				spec[specLength++] = conversion;
+				spec[specLength] = '\0';
+				numChars = snprintf( formatted, sizeof( formatted ), spec, GetLogArgAsInteger( type, bits ) );
+				break;
+			}
+			case 'c':
+			{
+				spec[specLength++] = conversion;
+				spec[specLength] = '\0';
+				numChars = snprintf( formatted, sizeof( formatted ), spec, type == LOG_ARG_STRING ? (int)text[0] : (int)GetLogArgAsInteger( type, bits ) );
+				break;
+			}
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+			{
+				if( type == LOG_ARG_STRING )
+				{
+					out_text.append( text );
+					continue;
+				}
+				spec[specLength++] = conversion;
+				spec[specLength] = '\0';
+				numChars = snprintf( formatted, sizeof( formatted ), spec, GetLogArgAsDouble( type, bits ) );
+				break;
+			}
+			case 'p':
+			{
+				spec[specLength++] = conversion;
+				spec[specLength] = '\0';
+				numChars = snprintf( formatted, sizeof( formatted ), spec, type == LOG_ARG_STRING ? (void const*)text : (void const*)(size_t)bits );
+				break;
+			}
+			case 's':
+			{
+				char number[32];
+				if( type == LOG_ARG_DOUBLE )
+				{
+					snprintf( number, sizeof( number ), "%g", GetLogArgAsDouble( type, bits ) );
+					text = number;
+				}
+				else if( type != LOG_ARG_STRING )
+				{
+					snprintf( number, sizeof( number ), type == LOG_ARG_SIGNED ? "%lld" : "%llu", bits );
+					text = number;
+				}
+				spec[specLength++] = conversion;
+				spec[specLength] = '\0';
+				numChars = snprintf( formatted, sizeof( formatted ), spec, text );
+				break;
+			}
+			default:
+			{
+				out_text.append( percent, format - percent );
+				continue;
+			}
+		}
+
+		if( numChars > 0 )
+		{
+			out_text.append( formatted, numChars < (int)sizeof( formatted ) ? numChars : sizeof( formatted ) - 1 );
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+static void OpenLogFile( LoggerState* logger )
+{
+	// the previous session's log becomes Game.log.1 and so on
+	std::string oldestBackupPath = Stringf( "%s.%i", logger->m_filePath.c_str(), LOG_FILE_NUM_BACKUPS );
+	remove( oldestBackupPath.c_str() );
+	for( int backupIndex = LOG_FILE_NUM_BACKUPS - 1; backupIndex >= 1; backupIndex-- )
+	{
+		std::string fromPath = Stringf( "%s.%i", logger->m_filePath.c_str(), backupIndex );
+		std::string toPath = Stringf( "%s.%i", logger->m_filePath.c_str(), backupIndex + 1 );
+		rename( fromPath.c_str(), toPath.c_str() );
+	}
+	rename( logger->m_filePath.c_str(), Stringf( "%s.1", logger->m_filePath.c_str() ).c_str() );
+
+	fopen_s( &logger->m_file, logger->m_filePath.c_str(), "wb" );
+	logger->m_fileSize = 0;
+}
+
+static void WriteToLogFile( LoggerState* logger, char const* text, size_t length )
+{
+	if( logger->m_file == nullptr )
+	{
+		return;
+	}
+
+	fwrite( text, 1, length, logger->m_file );
+	logger->m_fileSize += length;
+	logger->m_numBytesWritten.fetch_add( length, std::memory_order_relaxed );
+	if( logger->m_fileSize >= LOG_FILE_MAX_BYTES )
+	{
+		fclose( logger->m_file );
+		logger->m_file = nullptr;
+		OpenLogFile( logger );
+		logger->m_numRotations.fetch_add( 1, std::memory_order_relaxed );
+	}
+}
+
+static Rgba8 GetLogLevelColor( eLogLevel level )
+{
+	switch( level )
+	{
+		case LOG_LEVEL_VERBOSE:	return Rgba8( 160, 160, 160 );
+		case LOG_LEVEL_WARNING:	return Rgba8::YELLOW;
+		case LOG_LEVEL_ERROR:	return Rgba8::RED;
+		default:				return Rgba8::WHITE;
+	}
+}
+
+static void AddPendingLine( LoggerState* logger, unsigned long long ticks, eLogLevel level, char const* threadName, char const* channel )
+{
+	PendingLogLine line;
+	line.m_ticks = ticks;
+	line.m_level = level;
+	line.m_offset = logger->m_pendingText.size();
+
+	double seconds = (double)( ticks - logger->m_startTicks ) * GetSecondsPerTimeTick();
+	char prefix[128];
+	int prefixLength = snprintf( prefix, sizeof( prefix ), "[%10.4f] %-7s [%s] ", seconds, GetLogLevelName( level ), threadName );
+	logger->m_pendingText.append( prefix, prefixLength > 0 && prefixLength < (int)sizeof( prefix ) ? prefixLength : 0 );
+
+	line.m_consoleOffset = logger->m_pendingText.size();
+	logger->m_pendingText.push_back( '[' );
+	logger->m_pendingText.append( channel );
+	logger->m_pendingText.append( "] " );
+	logger->m_pendingLines.push_back( line );
+}
+
+static void EndPendingLine( LoggerState* logger )
+{
+	PendingLogLine& line = logger->m_pendingLines.back();
+	logger->m_pendingText.push_back( '\n' );
+	line.m_length = logger->m_pendingText.size() - line.m_offset;
+}
+
+static void DrainLogBuffers( LoggerState* logger )
+{
+	logger->m_drainThreads.clear();
+	logger->m_drainThreadNames.clear();
+	{
+		std::lock_guard<std::mutex> lock( logger->m_threadsMutex );
+		for( LoggerThreadBuffer* buffer : logger->m_threads )
+		{
+			logger->m_drainThreads.push_back( buffer );
+			logger->m_drainThreadNames.push_back( buffer->m_threadName );
+		}
+	}
+
+	logger->m_pendingLines.clear();
+	logger->m_pendingText.clear();
+	for( int threadIndex = 0; threadIndex < (int)logger->m_drainThreads.size(); threadIndex++ )
+	{
+		LoggerThreadBuffer* buffer = logger->m_drainThreads[threadIndex];
+		char const* threadName = logger->m_drainThreadNames[threadIndex].c_str();
+
+		unsigned int readIndex = buffer->m_readIndex.load( std::memory_order_relaxed );
+		unsigned int writeIndex = buffer->m_writeIndex.load( std::memory_order_acquire );
+		for( ; readIndex != writeIndex; ++readIndex )
+		{
+			LogRecord const& record = buffer->m_records[readIndex & LOG_RING_MASK];
+			AddPendingLine( logger, record.m_ticks, record.m_level, threadName, record.m_channel );
+			AppendFormattedRecord( logger->m_pendingText, record );
+			EndPendingLine( logger );
+		}
+		buffer->m_readIndex.store( writeIndex, std::memory_order_release );
+
+		int numDropped = buffer->m_numDropped.load( std::memory_order_relaxed );
+		if( numDropped != buffer->m_numDroppedReported )
+		{
+			AddPendingLine( logger, GetCurrentTimeTicks(), LOG_LEVEL_WARNING, threadName, "Logger" );
+			logger->m_pendingText.append( Stringf( "%i records dropped, the thread's log ring was full", numDropped - buffer->m_numDroppedReported ) );
+			EndPendingLine( logger );
+			buffer->m_numDroppedReported = numDropped;
+		}
+	}
+
+	if( logger->m_pendingLines.empty() )
+	{
+		return;
+	}
+
+	// each thread's records are in order already, this interleaves the threads
+	std::stable_sort( logger->m_pendingLines.begin(), logger->m_pendingLines.end(), []( PendingLogLine const& a, PendingLogLine const& b ) { return a.m_ticks < b.m_ticks; } );
+
+	eLogLevel consoleMinLevel = (eLogLevel)s_consoleMinLogLevel.load( std::memory_order_relaxed );
+	logger->m_pendingConsoleLines.clear();
+	for( PendingLogLine const& line : logger->m_pendingLines )
+	{
+		WriteToLogFile( logger, &logger->m_pendingText[line.m_offset], line.m_length );
+		if( line.m_level >= consoleMinLevel )
+		{
+			size_t consoleLength = line.m_offset + line.m_length - 1 - line.m_consoleOffset;
+			ConsoleLogLine consoleLine;
+			consoleLine.m_color = GetLogLevelColor( line.m_level );
+			consoleLine.m_text.assign( &logger->m_pendingText[line.m_consoleOffset], consoleLength );
+			logger->m_pendingConsoleLines.push_back( consoleLine );
+		}
+	}
+	if( logger->m_file != nullptr )
+	{
+		fflush( logger->m_file );
+	}
+	logger->m_numRecordsWritten.fetch_add( logger->m_pendingLines.size(), std::memory_order_relaxed );
+
+	if( !logger->m_pendingConsoleLines.empty() )
+	{
+		std::lock_guard<std::mutex> lock( logger->m_consoleMutex );
+		for( ConsoleLogLine& consoleLine : logger->m_pendingConsoleLines )
+		{
+			if( (int)logger->m_consoleLines.size() >= LOG_CONSOLE_MAX_PENDING_LINES )
+			{
+				++logger->m_numConsoleLinesDropped;
+				continue;
+			}
+			logger->m_consoleLines.push_back( std::move( consoleLine ) );
+		}
+	}
+}
+
+static void LoggerWriterMain( LoggerState* logger )
+{
+	OpenLogFile( logger );
+
+	bool isStopping = false;
+	while( !isStopping )
+	{
+		{
+			std::unique_lock<std::mutex> lock( logger->m_wakeMutex );
+			logger->m_wakeCondition.wait_for( lock, std::chrono::milliseconds( LOG_WRITER_INTERVAL_MS ), [logger]() { return logger->m_isStopping || logger->m_isFlushRequested; } );
+			isStopping = logger->m_isStopping;
+			logger->m_isFlushRequested = false;
+			++logger->m_numPassesStarted;
+		}
+
+		DrainLogBuffers( logger );
+
+		{
+			std::lock_guard<std::mutex> lock( logger->m_wakeMutex );
+			++logger->m_numPassesFinished;
+		}
+		logger->m_passFinishedCondition.notify_all();
+	}
+
+	if( logger->m_file != nullptr )
+	{
+		fclose( logger->m_file );
+		logger->m_file = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------
+void LoggerStartup( std::string const& logFilePath )
+{
+	GUARANTEE_OR_DIE( s_logger.load() == nullptr, "LoggerStartup called twice" );
+
+	LoggerState* logger = new LoggerState();
+	logger->m_filePath = logFilePath;
+	logger->m_startTicks = GetCurrentTimeTicks();
+	logger->m_numRecordsWritten.store( 0 );
+	logger->m_numBytesWritten.store( 0 );
+	logger->m_numRotations.store( 0 );
+
+#ifdef _WIN32
+	size_t folderEnd = logFilePath.find_last_of( "/\\" );
+	if( folderEnd != std::string::npos )
+	{
+		_mkdir( logFilePath.substr( 0, folderEnd ).c_str() );
+	}
+#endif
+
+	logger->m_writerThread = std::thread( LoggerWriterMain, logger );
+	s_logger.store( logger, std::memory_order_release );
+	LoggerSetThreadName( "Main" );
+}
+
+void LoggerShutdown()
+{
+	// every thread that logs must be done by now (JobSystem shuts down first)
+	LoggerState* logger = s_logger.exchange( nullptr );
+	if( logger == nullptr )
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( logger->m_wakeMutex );
+		logger->m_isStopping = true;
+	}
+	logger->m_wakeCondition.notify_one();
+	logger->m_writerThread.join();
+
+	for( LoggerThreadBuffer* buffer : logger->m_threads )
+	{
+		delete[] buffer->m_records;
+		delete buffer;
+	}
+	delete logger;
+}
+
+void LoggerEndFrame()
+{
+	LoggerState* logger = s_logger.load( std::memory_order_acquire );
+	if( logger == nullptr || g_theConsole == nullptr )
+	{
+		return;
+	}
+
+	std::vector<ConsoleLogLine> consoleLines;
+	int numConsoleLinesDropped = 0;
+	{
+		std::lock_guard<std::mutex> lock( logger->m_consoleMutex );
+		consoleLines.swap( logger->m_consoleLines );
+		numConsoleLinesDropped = logger->m_numConsoleLinesDropped;
+		logger->m_numConsoleLinesDropped = 0;
+	}
+
+	for( ConsoleLogLine const& consoleLine : consoleLines )
+	{
+		g_theConsole->PrintString( consoleLine.m_color, consoleLine.m_text );
+	}
+	if( numConsoleLinesDropped > 0 )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "[Logger] %i lines left out of the console this frame, see %s", numConsoleLinesDropped, logger->m_filePath.c_str() ) );
+	}
+}
+
+void LoggerFlush()
+{
+	LoggerState* logger = s_logger.load( std::memory_order_acquire );
+	if( logger == nullptr )
+	{
+		return;
+	}
+
+	// the pass after the one that may be running already sees everything logged before this
+	std::unique_lock<std::mutex> lock( logger->m_wakeMutex );
+	unsigned long long flushPass = logger->m_numPassesStarted + 1;
+	logger->m_isFlushRequested = true;
+	logger->m_wakeCondition.notify_one();
+	logger->m_passFinishedCondition.wait( lock, [logger, flushPass]() { return logger->m_numPassesFinished >= flushPass; } );
+}
+
+void LoggerSetThreadName( std::string const& threadName )
+{
+	LoggerThreadBuffer* buffer = GetThreadBuffer();
+	if( buffer == nullptr )
+	{
+		return;
+	}
+
+	LoggerState* logger = s_logger.load( std::memory_order_acquire );
+	std::lock_guard<std::mutex> lock( logger->m_threadsMutex );
+	buffer->m_threadName = threadName;
+}
+
+//------------------------------------------------------------------------
+COMMAND( log_level, "Set the lowest level that gets logged, and the lowest that also shows in the console. e.g. log_level level=verbose console=warning", "level,console" )
+{
+	eLogLevel level = LOG_LEVEL_INFO;
+	std::string levelText = args.GetValue( "level", "" );
+	if( levelText != "" )
+	{
+		if( !ParseLogLevel( &level, levelText ) )
+		{
+			g_theConsole->PrintString( Rgba8::RED, Stringf( "Unknown log level \"%s\", expected verbose, info, warning or error", levelText.c_str() ) );
+			return;
+		}
+		LoggerSetMinLevel( level );
+	}
+
+	std::string consoleText = args.GetValue( "console", "" );
+	if( consoleText != "" )
+	{
+		if( !ParseLogLevel( &level, consoleText ) )
+		{
+			g_theConsole->PrintString( Rgba8::RED, Stringf( "Unknown log level \"%s\", expected verbose, info, warning or error", consoleText.c_str() ) );
+			return;
+		}
+		LoggerSetConsoleMinLevel( level );
+	}
+
+	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Logging %s and up, console shows %s and up",
+		GetLogLevelName( (eLogLevel)s_minLogLevel.load() ), GetLogLevelName( (eLogLevel)s_consoleMinLogLevel.load() ) ) );
+}
+
+COMMAND( log_channel, "Mute or unmute a log channel. e.g. log_channel name=Jobs enabled=false", "name,enabled" )
+{
+	std::string channel = args.GetValue( "name", "" );
+	bool isEnabled = args.GetValue( "enabled", true );
+	if( channel == "" )
+	{
+		g_theConsole->PrintString( Rgba8::RED, "log_channel needs a name" );
+		return;
+	}
+
+	LoggerSetChannelEnabled( channel, isEnabled );
+	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Log channel %s %s (%i muted)", channel.c_str(), isEnabled ? "enabled" : "muted", s_numMutedChannels.load() ) );
+}
+
+COMMAND( log_stats, "Print how much the logger has written and dropped", "" )
+{
+	UNUSED( args );
+	LoggerState* logger = s_logger.load( std::memory_order_acquire );
+	if( logger == nullptr )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, "The logger isn't running" );
+		return;
+	}
+
+	LoggerFlush();
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%s: %llu records, %.2f MB written, %i rotations",
+		logger->m_filePath.c_str(), logger->m_numRecordsWritten.load(), (double)logger->m_numBytesWritten.load() / ( 1024.0 * 1024.0 ), logger->m_numRotations.load() ) );
+
+	std::lock_guard<std::mutex> lock( logger->m_threadsMutex );
+	for( LoggerThreadBuffer* buffer : logger->m_threads )
+	{
+		g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  %-16s %6i dropped", buffer->m_threadName.c_str(), buffer->m_numDropped.load() ) );
+	}
+}
+
+//------------------------------------------------------------------------
+COMMAND( benchmark_logging, "Time LOG calls on this thread against formatting with Stringf. e.g. benchmark_logging count=100000", "count" )
+{
+	int numMessages = args.GetValue( "count", 100000 );
+	if( s_logger.load() == nullptr || !IsLogEnabled( STRING_ID( "Benchmark" ), LOG_LEVEL_INFO ) )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, "Info logging on the Benchmark channel is off" );
+		return;
+	}
+
+	// half a ring at a time so the writer keeps up and nothing is dropped
+	const int batchSize = (int)LOG_RING_CAPACITY / 2;
+	unsigned long long logTicks = 0;
+	for( int messageIndex = 0; messageIndex < numMessages; messageIndex += batchSize )
+	{
+		LoggerFlush();
+		int batchEnd = std::min( messageIndex + batchSize, numMessages );
+		unsigned long long startTicks = GetCurrentTimeTicks();
+		for( int batchIndex = messageIndex; batchIndex < batchEnd; batchIndex++ )
+		{
+			LOG_INFO( "Benchmark", "actor %i moved to (%.2f, %.2f) in %s", batchIndex, (float)batchIndex * 0.5f, -(float)batchIndex, "Map01" );
+		}
+		logTicks += GetCurrentTimeTicks() - startTicks;
+	}
+	LoggerFlush();
+
+	// verbose is filtered out unless someone turned it on
+	bool isVerboseFiltered = !IsLogEnabled( STRING_ID( "Benchmark" ), LOG_LEVEL_VERBOSE );
+	unsigned long long startTicks = GetCurrentTimeTicks();
+	for( int messageIndex = 0; messageIndex < numMessages && isVerboseFiltered; messageIndex++ )
+	{
+		LOG_VERBOSE( "Benchmark", "actor %i moved to (%.2f, %.2f) in %s", messageIndex, (float)messageIndex * 0.5f, -(float)messageIndex, "Map01" );
+	}
+	unsigned long long filteredTicks = GetCurrentTimeTicks() - startTicks;
+
+	size_t formattedSize = 0;
+	startTicks = GetCurrentTimeTicks();
+	for( int messageIndex = 0; messageIndex < numMessages; messageIndex++ )
+	{
+		formattedSize += Stringf( "actor %i moved to (%.2f, %.2f) in %s", messageIndex, (float)messageIndex * 0.5f, -(float)messageIndex, "Map01" ).size();
+	}
+	unsigned long long stringfTicks = GetCurrentTimeTicks() - startTicks;
+
+	double nanosecondsPerTick = GetSecondsPerTimeTick() * 1.0e9;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%i messages: LOG_INFO %6.1f ns each, filtered out %6.1f ns each, Stringf %6.1f ns each (%zu chars)",
+		numMessages, (double)logTicks * nanosecondsPerTick / numMessages, (double)filteredTicks * nanosecondsPerTick / numMessages, (double)stringfTicks * nanosecondsPerTick / numMessages, formattedSize ) );
+}
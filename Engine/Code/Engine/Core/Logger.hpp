@@ -0,0 +1,148 @@
+#pragma once
+#include "Engine/Core/StringID.hpp"
+#include <stddef.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//------------------------------------------------------------------------
+// Asynchronous logger. LOG_INFO( "Jobs", "worker %i took %.2f ms", index, ms ) copies the format
+// pointer and the arguments into a lock-free ring owned by the calling thread; a writer thread
+// does the printf formatting later and sends the text to a rotating file and the dev console.
+//
+// formats and channel names must outlive the logger, string literals are expected.
+// string arguments are copied and share LOG_RECORD_PAYLOAD_SIZE bytes with the other arguments,
+// a record that doesn't fit in its thread's ring is dropped and counted
+//------------------------------------------------------------------------
+enum eLogLevel : unsigned char
+{
+	LOG_LEVEL_VERBOSE,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_ERROR,
+	NUM_LOG_LEVELS
+};
+
+enum eLogArgType : unsigned char
+{
+	LOG_ARG_SIGNED,
+	LOG_ARG_UNSIGNED,
+	LOG_ARG_DOUBLE,
+	LOG_ARG_POINTER,
+	LOG_ARG_STRING,		// length byte, text, terminator, all in the payload
+	LOG_ARG_MISSING,	// ran out of payload
+};
+
+constexpr int LOG_MAX_ARGS = 12;
+constexpr int LOG_RECORD_SIZE = 256;
+
+// the pointers are 4 bytes on Win32, so the payload gets whatever the header leaves
+struct LogRecordHeader
+{
+	char const*			m_format = nullptr;
+	char const*			m_channel = nullptr;
+	unsigned long long	m_ticks = 0;
+	eLogLevel			m_level = LOG_LEVEL_INFO;
+	unsigned char		m_numArgs = 0;
+	unsigned short		m_payloadSize = 0;
+	eLogArgType			m_argTypes[LOG_MAX_ARGS];
+};
+
+constexpr int LOG_RECORD_HEADER_SIZE = (int)sizeof( LogRecordHeader );
+constexpr int LOG_RECORD_PAYLOAD_SIZE = LOG_RECORD_SIZE - LOG_RECORD_HEADER_SIZE;
+
+struct LogRecord : public LogRecordHeader
+{
+	unsigned char		m_payload[LOG_RECORD_PAYLOAD_SIZE];
+
+	void AppendInteger( eLogArgType type, unsigned long long value );
+	void AppendDouble( double value );
+	void AppendString( std::string_view text );
+};
+static_assert( sizeof( LogRecord ) == LOG_RECORD_SIZE, "LogRecord picked up padding, check the header's alignment" );
+
+//------------------------------------------------------------------------
+void LoggerStartup( std::string const& logFilePath = "Logs/Game.log" );
+void LoggerShutdown();										// writes out everything still queued
+void LoggerEndFrame();										// main thread, prints the console sink's lines
+void LoggerFlush();											// blocks until what this thread logged so far is written
+void LoggerSetThreadName( std::string const& threadName );	// any thread, shown on each line
+
+bool IsLogEnabled( StringID channelID, eLogLevel level );
+void LoggerSetMinLevel( eLogLevel level );					// file and console
+void LoggerSetConsoleMinLevel( eLogLevel level );			// console only, on top of the min level
+void LoggerSetChannelEnabled( std::string_view channel, bool isEnabled );
+char const* GetLogLevelName( eLogLevel level );
+bool ParseLogLevel( eLogLevel* out_level, std::string_view text );
+
+LogRecord* LoggerBeginRecord();								// nullptr when the logger is down or this thread's ring is full
+void LoggerCommitRecord();
+
+//------------------------------------------------------------------------
+template<typename T>
+inline void AppendLogArg( LogRecord& record, T const& arg )
+{
+	typedef std::decay_t<T> ArgType;
+	if constexpr( std::is_same_v<ArgType, bool> )
+	{
+		record.AppendString( arg ? "true" : "false" );
+	}
+	else if constexpr( std::is_floating_point_v<ArgType> )
+	{
+		record.AppendDouble( (double)arg );
+	}
+	else if constexpr( std::is_enum_v<ArgType> )
+	{
+		AppendLogArg( record, (std::underlying_type_t<ArgType>)arg );
+	}
+	else if constexpr( std::is_integral_v<ArgType> && std::is_signed_v<ArgType> )
+	{
+		record.AppendInteger( LOG_ARG_SIGNED, (unsigned long long)(long long)arg );
+	}
+	else if constexpr( std::is_integral_v<ArgType> )
+	{
+		record.AppendInteger( LOG_ARG_UNSIGNED, (unsigned long long)arg );
+	}
+	else if constexpr( std::is_same_v<ArgType, char*> || std::is_same_v<ArgType, char const*> )
+	{
+		record.AppendString( arg != nullptr ? std::string_view( arg ) : std::string_view( "(null)" ) );
+	}
+	else if constexpr( std::is_convertible_v<T const&, std::string_view> )
+	{
+		record.AppendString( std::string_view( arg ) );
+	}
+	else if constexpr( std::is_pointer_v<ArgType> )
+	{
+		record.AppendInteger( LOG_ARG_POINTER, (unsigned long long)(size_t)(void const*)arg );
+	}
+	else
+	{
+		static_assert( std::is_pointer_v<ArgType>, "LOG arguments must be numbers, enums, pointers or strings" );
+	}
+}
+
+template<typename... Args>
+void LogMessage( char const* channel, eLogLevel level, char const* format, Args const&... args )
+{
+	static_assert( sizeof...( Args ) <= LOG_MAX_ARGS, "too many LOG arguments" );
+	LogRecord* record = LoggerBeginRecord();
+	if( record == nullptr )
+	{
+		return;
+	}
+
+	record->m_format = format;
+	record->m_channel = channel;
+	record->m_level = level;
+	record->m_numArgs = 0;
+	record->m_payloadSize = 0;
+	( AppendLogArg( *record, args ), ... );
+	LoggerCommitRecord();
+}
+
+// arguments aren't evaluated when the channel or level is filtered out
+#define LOG( channel, level, ... ) do { if( IsLogEnabled( STRING_ID( channel ), level ) ) { LogMessage( channel, level, __VA_ARGS__ ); } } while( 0 )
+#define LOG_VERBOSE( channel, ... )	LOG( channel, LOG_LEVEL_VERBOSE, __VA_ARGS__ )
+#define LOG_INFO( channel, ... )	LOG( channel, LOG_LEVEL_INFO, __VA_ARGS__ )
+#define LOG_WARNING( channel, ... )	LOG( channel, LOG_LEVEL_WARNING, __VA_ARGS__ )
+#define LOG_ERROR( channel, ... )	LOG( channel, LOG_LEVEL_ERROR, __VA_ARGS__ )
@@ -0,0 +1,481 @@
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <DbgHelp.h>
+#pragma comment( lib, "dbghelp.lib" )
+
+static char const* const s_memoryTagNames[NUM_MEMORY_TAGS] = { "Untagged", "Physics", "Render", "Particles", "Game", "Definitions" };
+static thread_local eMemoryTag t_currentMemoryTag = MEMORY_TAG_UNTAGGED;
+
+//------------------------------------------------------------------------
+char const* GetMemoryTagName( eMemoryTag tag )
+{
+	return tag < NUM_MEMORY_TAGS ? s_memoryTagNames[tag] : "Unknown";
+}
+
+eMemoryTag GetCurrentMemoryTag()
+{
+	return t_currentMemoryTag;
+}
+
+eMemoryTag SetCurrentMemoryTag( eMemoryTag tag )
+{
+	eMemoryTag previousTag = t_currentMemoryTag;
+	t_currentMemoryTag = tag;
+	return previousTag;
+}
+
+#if defined( ENGINE_MEMORY_TRACKING )
+
+//------------------------------------------------------------------------
+// Everything below runs inside operator new, so it only touches static storage
+// and never allocates while holding s_trackerLock
+//------------------------------------------------------------------------
+static constexpr int MEMORY_CALL_STACK_DEPTH = 4;
+static constexpr int MEMORY_CALL_SITE_CAPACITY = 4096;		// power of two, slot 0 collects everything past capacity
+
+// 32 bytes on x64, padded up from 20 on Win32
+struct alignas( 16 ) MemoryAllocationHeader
+{
+	MemoryAllocationHeader* m_prev;
+	MemoryAllocationHeader* m_next;
+	size_t m_size;
+	int m_frameIndex;
+	unsigned short m_callSiteIndex;
+	eMemoryTag m_tag;
+};
+static_assert( sizeof( MemoryAllocationHeader ) % 16 == 0, "allocations must keep 16 byte alignment" );
+
+struct MemoryCallSite
+{
+	unsigned int m_hash;
+	void* m_frames[MEMORY_CALL_STACK_DEPTH];
+	eMemoryTag m_tag;
+	unsigned long long m_totalAllocations;
+	unsigned long long m_totalBytes;
+	size_t m_liveAllocations;
+	size_t m_liveBytes;
+};
+
+struct MemoryTrackerState
+{
+	MemoryAllocationHeader* m_liveAllocations;		// most recent first
+	MemoryTagStats m_tagStats[NUM_MEMORY_TAGS];
+	unsigned long long m_previousFrameAllocations[NUM_MEMORY_TAGS];
+	unsigned long long m_previousFrameBytes[NUM_MEMORY_TAGS];
+	MemoryCallSite m_callSites[MEMORY_CALL_SITE_CAPACITY];
+	int m_numCallSites;
+	int m_frameIndex;
+	int m_leakBaselineFrameIndex;
+};
+
+// zero initialized before any constructor runs, so allocations during static init are tracked too
+static MemoryTrackerState s_tracker;
+static std::atomic_flag s_trackerLock = ATOMIC_FLAG_INIT;
+
+// report scratch, main thread only
+static MemoryCallSite s_reportCallSites[MEMORY_CALL_SITE_CAPACITY];
+
+//------------------------------------------------------------------------
+static void LockTracker()
+{
+	while( s_trackerLock.test_and_set( std::memory_order_acquire ) )
+	{
+		std::this_thread::yield();
+	}
+}
+
+static void UnlockTracker()
+{
+	s_trackerLock.clear( std::memory_order_release );
+}
+
+static unsigned int HashCallStack( void* const* frames, int numFrames )
+{
+	// FNV-1a over the return addresses
+	unsigned int hash = 2166136261u;
+	unsigned char const* bytes = (unsigned char const*)frames;
+	for( size_t byteIndex = 0; byteIndex < (size_t)numFrames * sizeof( void* ); ++byteIndex )
+	{
+		hash = ( hash ^ bytes[byteIndex] ) * 16777619u;
+	}
+	return hash | 1;	// 0 marks an empty slot
+}
+
+// lock held
+static unsigned short FindOrAddCallSite( void* const* frames, unsigned int hash, eMemoryTag tag )
+{
+	int slotIndex = (int)( hash & ( MEMORY_CALL_SITE_CAPACITY - 1 ) );
+	for( int probe = 0; probe < MEMORY_CALL_SITE_CAPACITY; ++probe )
+	{
+		if( slotIndex == 0 )
+		{
+			slotIndex = 1;
+		}
+
+		MemoryCallSite& callSite = s_tracker.m_callSites[slotIndex];
+		if( callSite.m_hash == hash && memcmp( callSite.m_frames, frames, sizeof( callSite.m_frames ) ) == 0 )
+		{
+			return (unsigned short)slotIndex;
+		}
+		if( callSite.m_hash == 0 )
+		{
+			if( s_tracker.m_numCallSites >= MEMORY_CALL_SITE_CAPACITY * 3 / 4 )
+			{
+				break;
+			}
+
+			callSite.m_hash = hash;
+			memcpy( callSite.m_frames, frames, sizeof( callSite.m_frames ) );
+			callSite.m_tag = tag;
+			++s_tracker.m_numCallSites;
+			return (unsigned short)slotIndex;
+		}
+		slotIndex = ( slotIndex + 1 ) & ( MEMORY_CALL_SITE_CAPACITY - 1 );
+	}
+	return 0;
+}
+
+// noinline keeps the number of frames to skip fixed: this function and the operator new calling it
+static __declspec( noinline ) void* TrackedAllocate( size_t size )
+{
+	MemoryAllocationHeader* header = (MemoryAllocationHeader*)malloc( sizeof( MemoryAllocationHeader ) + size );
+	if( header == nullptr )
+	{
+		return nullptr;
+	}
+
+	void* frames[MEMORY_CALL_STACK_DEPTH] = {};
+	USHORT numFrames = CaptureStackBackTrace( 2, MEMORY_CALL_STACK_DEPTH, frames, nullptr );
+	unsigned int hash = HashCallStack( frames, numFrames );
+	eMemoryTag tag = t_currentMemoryTag;
+
+	LockTracker();
+	header->m_prev = nullptr;
+	header->m_next = s_tracker.m_liveAllocations;
+	if( s_tracker.m_liveAllocations != nullptr )
+	{
+		s_tracker.m_liveAllocations->m_prev = header;
+	}
+	s_tracker.m_liveAllocations = header;
+	header->m_size = size;
+	header->m_frameIndex = s_tracker.m_frameIndex;
+	header->m_callSiteIndex = FindOrAddCallSite( frames, hash, tag );
+	header->m_tag = tag;
+
+	MemoryTagStats& tagStats = s_tracker.m_tagStats[tag];
+	tagStats.m_liveBytes += size;
+	tagStats.m_peakBytes = tagStats.m_liveBytes > tagStats.m_peakBytes ? tagStats.m_liveBytes : tagStats.m_peakBytes;
+	++tagStats.m_liveAllocations;
+	++tagStats.m_totalAllocations;
+	tagStats.m_totalBytes += size;
+
+	MemoryCallSite& callSite = s_tracker.m_callSites[header->m_callSiteIndex];
+	++callSite.m_totalAllocations;
+	callSite.m_totalBytes += size;
+	++callSite.m_liveAllocations;
+	callSite.m_liveBytes += size;
+	UnlockTracker();
+
+	return header + 1;
+}
+
+static void TrackedFree( void* ptr )
+{
+	if( ptr == nullptr )
+	{
+		return;
+	}
+
+	MemoryAllocationHeader* header = (MemoryAllocationHeader*)ptr - 1;
+	LockTracker();
+	if( header->m_prev != nullptr )
+	{
+		header->m_prev->m_next = header->m_next;
+	}
+	else
+	{
+		s_tracker.m_liveAllocations = header->m_next;
+	}
+	if( header->m_next != nullptr )
+	{
+		header->m_next->m_prev = header->m_prev;
+	}
+
+	MemoryTagStats& tagStats = s_tracker.m_tagStats[header->m_tag];
+	tagStats.m_liveBytes -= header->m_size;
+	--tagStats.m_liveAllocations;
+
+	MemoryCallSite& callSite = s_tracker.m_callSites[header->m_callSiteIndex];
+	--callSite.m_liveAllocations;
+	callSite.m_liveBytes -= header->m_size;
+	UnlockTracker();
+
+	free( header );
+}
+
+//------------------------------------------------------------------------
+void* operator new( size_t size )
+{
+	void* ptr = TrackedAllocate( size );
+	if( ptr == nullptr )
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[]( size_t size )
+{
+	void* ptr = TrackedAllocate( size );
+	if( ptr == nullptr )
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new( size_t size, std::nothrow_t const& ) noexcept
+{
+	return TrackedAllocate( size );
+}
+
+void* operator new[]( size_t size, std::nothrow_t const& ) noexcept
+{
+	return TrackedAllocate( size );
+}
+
+void operator delete( void* ptr ) noexcept							{ TrackedFree( ptr ); }
+void operator delete[]( void* ptr ) noexcept						{ TrackedFree( ptr ); }
+void operator delete( void* ptr, size_t ) noexcept					{ TrackedFree( ptr ); }
+void operator delete[]( void* ptr, size_t ) noexcept				{ TrackedFree( ptr ); }
+void operator delete( void* ptr, std::nothrow_t const& ) noexcept	{ TrackedFree( ptr ); }
+void operator delete[]( void* ptr, std::nothrow_t const& ) noexcept	{ TrackedFree( ptr ); }
+
+//------------------------------------------------------------------------
+bool IsMemoryTrackingEnabled()
+{
+	return true;
+}
+
+void MemoryTrackerEndFrame()
+{
+	LockTracker();
+	for( int tagIndex = 0; tagIndex < NUM_MEMORY_TAGS; ++tagIndex )
+	{
+		MemoryTagStats& tagStats = s_tracker.m_tagStats[tagIndex];
+		tagStats.m_lastFrameAllocations = tagStats.m_totalAllocations - s_tracker.m_previousFrameAllocations[tagIndex];
+		tagStats.m_lastFrameBytes = tagStats.m_totalBytes - s_tracker.m_previousFrameBytes[tagIndex];
+		s_tracker.m_previousFrameAllocations[tagIndex] = tagStats.m_totalAllocations;
+		s_tracker.m_previousFrameBytes[tagIndex] = tagStats.m_totalBytes;
+	}
+	++s_tracker.m_frameIndex;
+	UnlockTracker();
+}
+
+int GetMemoryTrackerFrameIndex()
+{
+	LockTracker();
+	int frameIndex = s_tracker.m_frameIndex;
+	UnlockTracker();
+	return frameIndex;
+}
+
+MemoryTagStats GetMemoryTagStats( eMemoryTag tag )
+{
+	LockTracker();
+	MemoryTagStats tagStats = s_tracker.m_tagStats[tag];
+	UnlockTracker();
+	return tagStats;
+}
+
+void MemoryTrackerMarkLeakBaseline()
+{
+	LockTracker();
+	s_tracker.m_leakBaselineFrameIndex = s_tracker.m_frameIndex + 1;
+	UnlockTracker();
+}
+
+//------------------------------------------------------------------------
+static std::string GetCallSiteDescription( MemoryCallSite const& callSite )
+{
+	if( &callSite == &s_reportCallSites[0] )
+	{
+		return "<call site table full>";
+	}
+
+	static bool s_areSymbolsLoaded = false;
+	HANDLE process = GetCurrentProcess();
+	if( !s_areSymbolsLoaded )
+	{
+		SymSetOptions( SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES );
+		SymInitialize( process, nullptr, TRUE );
+		s_areSymbolsLoaded = true;
+	}
+
+	std::string description;
+	for( int frameIndex = 0; frameIndex < MEMORY_CALL_STACK_DEPTH && callSite.m_frames[frameIndex] != nullptr; ++frameIndex )
+	{
+		char symbolBuffer[sizeof( SYMBOL_INFO ) + 256] = {};
+		SYMBOL_INFO* symbol = (SYMBOL_INFO*)symbolBuffer;
+		symbol->SizeOfStruct = sizeof( SYMBOL_INFO );
+		symbol->MaxNameLen = 255;
+
+		DWORD64 address = (DWORD64)callSite.m_frames[frameIndex];
+		std::string frameName = SymFromAddr( process, address, nullptr, symbol ) ? std::string( symbol->Name ) : Stringf( "0x%llx", (unsigned long long)address );
+
+		IMAGEHLP_LINE64 line = {};
+		line.SizeOfStruct = sizeof( IMAGEHLP_LINE64 );
+		DWORD lineDisplacement = 0;
+		if( frameIndex == 0 && SymGetLineFromAddr64( process, address, &lineDisplacement, &line ) )
+		{
+			frameName += Stringf( " (%s:%i)", GetFileBaseName( line.FileName ).c_str(), (int)line.LineNumber );
+		}
+
+		description += frameIndex == 0 ? frameName : " <- " + frameName;
+	}
+	return description;
+}
+
+static void PrintCallSites( int numCallSites, int numTopCallSites, bool isLeakReport )
+{
+	MemoryCallSite* callSites[MEMORY_CALL_SITE_CAPACITY];
+	int numUsed = 0;
+	for( int slotIndex = 0; slotIndex < numCallSites; ++slotIndex )
+	{
+		MemoryCallSite& callSite = s_reportCallSites[slotIndex];
+		if( isLeakReport ? callSite.m_liveAllocations > 0 : callSite.m_totalAllocations > 0 )
+		{
+			callSites[numUsed++] = &callSite;
+		}
+	}
+
+	if( isLeakReport )
+	{
+		std::sort( callSites, callSites + numUsed, []( MemoryCallSite const* a, MemoryCallSite const* b ) { return a->m_liveBytes > b->m_liveBytes; } );
+	}
+	else
+	{
+		std::sort( callSites, callSites + numUsed, []( MemoryCallSite const* a, MemoryCallSite const* b ) { return a->m_totalAllocations > b->m_totalAllocations; } );
+	}
+
+	int numToPrint = numTopCallSites < numUsed ? numTopCallSites : numUsed;
+	for( int rank = 0; rank < numToPrint; ++rank )
+	{
+		MemoryCallSite const& callSite = *callSites[rank];
+		std::string text = isLeakReport
+			? Stringf( "%8i allocs %10.1f KB  %-11s ", (int)callSite.m_liveAllocations, (double)callSite.m_liveBytes / 1024.0, GetMemoryTagName( callSite.m_tag ) )
+			: Stringf( "%10llu allocs %12.1f KB  %-11s ", callSite.m_totalAllocations, (double)callSite.m_totalBytes / 1024.0, GetMemoryTagName( callSite.m_tag ) );
+		g_theConsole->PrintString( Rgba8::WHITE, text + GetCallSiteDescription( callSite ) );
+	}
+}
+
+void MemoryTrackerPrintStats( int numTopCallSites )
+{
+	MemoryTagStats tagStats[NUM_MEMORY_TAGS];
+	LockTracker();
+	memcpy( tagStats, s_tracker.m_tagStats, sizeof( tagStats ) );
+	memcpy( s_reportCallSites, s_tracker.m_callSites, sizeof( s_reportCallSites ) );
+	int numFrames = s_tracker.m_frameIndex;
+	UnlockTracker();
+
+	g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "%-11s %10s %10s %10s %12s %12s %12s", "Tag", "Live KB", "Peak KB", "Live", "Allocs/frm", "KB/frm", "Avg allocs" ) );
+	for( int tagIndex = 0; tagIndex < NUM_MEMORY_TAGS; ++tagIndex )
+	{
+		MemoryTagStats const& stats = tagStats[tagIndex];
+		g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%-11s %10.1f %10.1f %10i %12llu %12.1f %12.1f",
+			GetMemoryTagName( (eMemoryTag)tagIndex ), (double)stats.m_liveBytes / 1024.0, (double)stats.m_peakBytes / 1024.0, (int)stats.m_liveAllocations,
+			stats.m_lastFrameAllocations, (double)stats.m_lastFrameBytes / 1024.0, (double)stats.m_totalAllocations / (double)( numFrames > 0 ? numFrames : 1 ) ) );
+	}
+
+	g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "Top %i call sites by allocation count:", numTopCallSites ) );
+	PrintCallSites( MEMORY_CALL_SITE_CAPACITY, numTopCallSites, false );
+}
+
+void MemoryTrackerPrintLeakReport( int numTopCallSites )
+{
+	// regroup the live allocations from the window by call site
+	MemoryTagStats tagStats[NUM_MEMORY_TAGS];
+	LockTracker();
+	int baselineFrameIndex = s_tracker.m_leakBaselineFrameIndex;
+	int frameIndex = s_tracker.m_frameIndex;
+	for( int slotIndex = 0; slotIndex < MEMORY_CALL_SITE_CAPACITY; ++slotIndex )
+	{
+		s_reportCallSites[slotIndex] = s_tracker.m_callSites[slotIndex];
+		s_reportCallSites[slotIndex].m_liveAllocations = 0;
+		s_reportCallSites[slotIndex].m_liveBytes = 0;
+	}
+	for( MemoryAllocationHeader const* header = s_tracker.m_liveAllocations; header != nullptr; header = header->m_next )
+	{
+		if( header->m_frameIndex < baselineFrameIndex || header->m_frameIndex >= frameIndex )
+		{
+			continue;
+		}
+
+		MemoryCallSite& callSite = s_reportCallSites[header->m_callSiteIndex];
+		++callSite.m_liveAllocations;
+		callSite.m_liveBytes += header->m_size;
+		tagStats[header->m_tag].m_liveBytes += header->m_size;
+		++tagStats[header->m_tag].m_liveAllocations;
+	}
+	UnlockTracker();
+
+	g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "Allocations from frames %i to %i that are still live:", baselineFrameIndex, frameIndex - 1 ) );
+	for( int tagIndex = 0; tagIndex < NUM_MEMORY_TAGS; ++tagIndex )
+	{
+		if( tagStats[tagIndex].m_liveAllocations > 0 )
+		{
+			g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%-11s %8i allocs %10.1f KB", GetMemoryTagName( (eMemoryTag)tagIndex ), (int)tagStats[tagIndex].m_liveAllocations, (double)tagStats[tagIndex].m_liveBytes / 1024.0 ) );
+		}
+	}
+	PrintCallSites( MEMORY_CALL_SITE_CAPACITY, numTopCallSites, true );
+}
+
+#else
+
+//------------------------------------------------------------------------
+bool IsMemoryTrackingEnabled()								{ return false; }
+void MemoryTrackerEndFrame()								{}
+int GetMemoryTrackerFrameIndex()							{ return 0; }
+MemoryTagStats GetMemoryTagStats( eMemoryTag tag )			{ UNUSED( tag ); return MemoryTagStats(); }
+void MemoryTrackerMarkLeakBaseline()						{}
+
+void MemoryTrackerPrintStats( int numTopCallSites )
+{
+	UNUSED( numTopCallSites );
+	g_theConsole->PrintString( Rgba8::RED, "Memory tracking is off, define ENGINE_MEMORY_TRACKING in MemoryTracker.hpp" );
+}
+
+void MemoryTrackerPrintLeakReport( int numTopCallSites )
+{
+	MemoryTrackerPrintStats( numTopCallSites );
+}
+
+#endif
+
+//------------------------------------------------------------------------
+COMMAND( mem, "Print live/peak bytes and allocations per frame by tag, and the top call sites by count. e.g. mem top=10", "top" )
+{
+	MemoryTrackerPrintStats( args.GetValue( "top", 10 ) );
+}
+
+COMMAND( mem_mark, "Start a leak window, see mem_leaks", "" )
+{
+	UNUSED( args );
+	MemoryTrackerMarkLeakBaseline();
+	g_theConsole->PrintString( Rgba8::GREEN, "Leak window starts next frame" );
+}
+
+COMMAND( mem_leaks, "List allocations made since mem_mark (or startup) that are still live, by call site. e.g. mem_leaks top=20", "top" )
+{
+	MemoryTrackerPrintLeakReport( args.GetValue( "top", 20 ) );
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <string>
+
+//------------------------------------------------------------------------
+// Opt-in allocation tracker. Uncomment (or define in the Engine and game preprocessor settings)
+// to route every global new/delete through it; without it the tag scopes compile away and the
+// `mem` command reports that tracking is off.
+//------------------------------------------------------------------------
+//#define ENGINE_MEMORY_TRACKING
+
+enum eMemoryTag : unsigned char
+{
+	MEMORY_TAG_UNTAGGED,
+	MEMORY_TAG_PHYSICS,
+	MEMORY_TAG_RENDER,
+	MEMORY_TAG_PARTICLES,
+	MEMORY_TAG_GAME,
+	MEMORY_TAG_DEFINITIONS,
+
+	NUM_MEMORY_TAGS
+};
+
+struct MemoryTagStats
+{
+	size_t m_liveBytes = 0;
+	size_t m_peakBytes = 0;
+	size_t m_liveAllocations = 0;
+	unsigned long long m_totalAllocations = 0;
+	unsigned long long m_totalBytes = 0;
+	unsigned long long m_lastFrameAllocations = 0;
+	unsigned long long m_lastFrameBytes = 0;
+};
+
+bool			IsMemoryTrackingEnabled();
+char const*		GetMemoryTagName( eMemoryTag tag );
+eMemoryTag		GetCurrentMemoryTag();
+eMemoryTag		SetCurrentMemoryTag( eMemoryTag tag );		// this thread only, returns the previous tag
+
+void			MemoryTrackerEndFrame();						// main thread, once a frame
+int				GetMemoryTrackerFrameIndex();
+MemoryTagStats	GetMemoryTagStats( eMemoryTag tag );
+
+void			MemoryTrackerPrintStats( int numTopCallSites );
+void			MemoryTrackerMarkLeakBaseline();				// allocations from the next frame on are leak candidates
+void			MemoryTrackerPrintLeakReport( int numTopCallSites );	// still live and allocated between the baseline and this frame
+
+//------------------------------------------------------------------------
+class MemoryTagScope
+{
+public:
+	explicit MemoryTagScope( eMemoryTag tag )	{ m_previousTag = SetCurrentMemoryTag( tag ); }
+	~MemoryTagScope()							{ SetCurrentMemoryTag( m_previousTag ); }
+
+	MemoryTagScope( MemoryTagScope const& copyFrom ) = delete;
+
+private:
+	eMemoryTag m_previousTag = MEMORY_TAG_UNTAGGED;
+};
+
+#if defined( ENGINE_MEMORY_TRACKING )
+	#define MEMORY_TAG_SCOPE_CONCAT_INNER( a, b ) a##b
+	#define MEMORY_TAG_SCOPE_CONCAT( a, b ) MEMORY_TAG_SCOPE_CONCAT_INNER( a, b )
+	#define MEMORY_TAG_SCOPE( tag ) MemoryTagScope MEMORY_TAG_SCOPE_CONCAT( memoryTagScope_, __LINE__ )( tag )
+#else
+	#define MEMORY_TAG_SCOPE( tag )
+#endif
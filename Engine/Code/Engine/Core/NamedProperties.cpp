@@ -1,8 +1,113 @@
 #include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 
-bool NamedProperties::HasValue( const std::string& keyName )
+//------------------------------------------------------------------------
+PropertyKey InternPropertyKey( std::string_view keyName )
 {
-	return m_keyValuePairs.find( keyName ) != m_keyValuePairs.end();
+	return InternStringID( keyName );
+}
+
+std::string const& GetPropertyKeyName( PropertyKey key )
+{
+	return GetStringFromID( key );
+}
+
+//------------------------------------------------------------------------
+NamedProperty::NamedProperty( NamedProperty const& copyFrom )
+	:m_key( copyFrom.m_key )
+{
+	if( copyFrom.m_type != nullptr )
+	{
+		copyFrom.m_type->m_copyConstruct( &m_storage, &copyFrom.m_storage );
+		m_type = copyFrom.m_type;
+	}
+}
+
+NamedProperty& NamedProperty::operator=( NamedProperty const& copyFrom )
+{
+	if( this == &copyFrom )
+	{
+		return *this;
+	}
+
+	Reset();
+	m_key = copyFrom.m_key;
+	if( copyFrom.m_type != nullptr )
+	{
+		copyFrom.m_type->m_copyConstruct( &m_storage, &copyFrom.m_storage );
+		m_type = copyFrom.m_type;
+	}
+	return *this;
+}
+
+NamedProperty::~NamedProperty()
+{
+	Reset();
+}
+
+void NamedProperty::Reset()
+{
+	if( m_type != nullptr )
+	{
+		m_type->m_destruct( &m_storage );
+		m_type = nullptr;
+	}
+}
+
+std::string NamedProperty::GetAsString() const
+{
+	if( m_type == nullptr )
+	{
+		return "";
+	}
+	return m_type->m_getAsString( &m_storage );
+}
+
+//------------------------------------------------------------------------
+NamedProperties::NamedProperties( NamedProperties const& copyFrom )
+{
+	*this = copyFrom;
+}
+
+NamedProperties& NamedProperties::operator=( NamedProperties const& copyFrom )
+{
+	if( this == &copyFrom )
+	{
+		return *this;
+	}
+
+	Clear();
+	for( int propIndex = 0; propIndex < copyFrom.m_numProperties; propIndex++ )
+	{
+		AddProperty( INVALID_PROPERTY_KEY ) = *copyFrom.GetProperty( propIndex );
+	}
+	return *this;
+}
+
+void NamedProperties::Clear()
+{
+	for( int propIndex = 0; propIndex < NUM_INLINE_PROPERTIES; propIndex++ )
+	{
+		m_inlineProperties[propIndex].Reset();
+		m_inlineProperties[propIndex].m_key = INVALID_PROPERTY_KEY;
+	}
+	m_overflowProperties.clear();
+	m_numProperties = 0;
+}
+
+void NamedProperties::ResetValue()
+{
+	// strings already in place are cleared without giving up their buffer
+	static std::string const s_emptyString;
+	for( int propIndex = 0; propIndex < m_numProperties; propIndex++ )
+	{
+		GetProperty( propIndex )->Set<std::string>( s_emptyString );
+	}
+}
+
+bool NamedProperties::HasValue( std::string_view keyName ) const
+{
+	return FindProperty( GetPropertyKey( keyName ) ) != nullptr;
 }
 
 void NamedProperties::PopulateForEventCommand( const std::string& commandInputValue )
@@ -11,13 +116,74 @@ void NamedProperties::PopulateForEventCommand( const std::string& commandInputVa
 	{
 		return;
 	}
-	Strings stringList = SplitStringOnDelimiter( commandInputValue, ',' );
-	for( int i = 0; i < (int)stringList.size(); i++ )
+	for( std::string_view key : SplitStringView( commandInputValue, ',', false ) )
+	{
+		// console arg names are interned so they show up by name in debug output
+		SetValue( InternPropertyKey( key ), "" );
+	}
+}
+
+NamedProperty* NamedProperties::GetProperty( int propertyIndex )
+{
+	if( propertyIndex < NUM_INLINE_PROPERTIES )
+	{
+		return &m_inlineProperties[propertyIndex];
+	}
+	return &m_overflowProperties[propertyIndex - NUM_INLINE_PROPERTIES];
+}
+
+NamedProperty const* NamedProperties::GetProperty( int propertyIndex ) const
+{
+	if( propertyIndex < NUM_INLINE_PROPERTIES )
+	{
+		return &m_inlineProperties[propertyIndex];
+	}
+	return &m_overflowProperties[propertyIndex - NUM_INLINE_PROPERTIES];
+}
+
+NamedProperty* NamedProperties::FindProperty( PropertyKey key )
+{
+	return const_cast<NamedProperty*>( static_cast<NamedProperties const*>( this )->FindProperty( key ) );
+}
+
+NamedProperty const* NamedProperties::FindProperty( PropertyKey key ) const
+{
+	if( key == INVALID_PROPERTY_KEY )
 	{
-		if( (int)stringList[i].size() != 0 )
+		return nullptr;
+	}
+
+	int numInline = m_numProperties < NUM_INLINE_PROPERTIES ? m_numProperties : NUM_INLINE_PROPERTIES;
+	for( int propIndex = 0; propIndex < numInline; propIndex++ )
+	{
+		if( m_inlineProperties[propIndex].m_key == key )
 		{
-			std::string key = stringList[i];
-			SetValue( key, "" );
+			return &m_inlineProperties[propIndex];
 		}
 	}
+	for( NamedProperty const& prop : m_overflowProperties )
+	{
+		if( prop.m_key == key )
+		{
+			return &prop;
+		}
+	}
+	return nullptr;
+}
+
+NamedProperty& NamedProperties::AddProperty( PropertyKey key )
+{
+	NamedProperty* prop = nullptr;
+	if( m_numProperties < NUM_INLINE_PROPERTIES )
+	{
+		prop = &m_inlineProperties[m_numProperties];
+	}
+	else
+	{
+		m_overflowProperties.emplace_back();
+		prop = &m_overflowProperties.back();
+	}
+	++m_numProperties;
+	prop->m_key = key;
+	return *prop;
 }
@@ -1,175 +1,212 @@
 #pragma once
+#include "Engine/Core/StringID.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include <new>
 #include <string>
-#include <map>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
-class TypedPropertyBase
+// keys are the name's StringID; hashing takes no lock, so hot callers can pass names
+// or keep the key around, e.g. GetValue( STRING_ID( "deltaSeconds" ), 0.f )
+typedef StringID PropertyKey;
+constexpr PropertyKey INVALID_PROPERTY_KEY = INVALID_STRING_ID;
+
+inline PropertyKey	GetPropertyKey( std::string_view keyName )	{ return HashStringID( keyName ); }
+PropertyKey			InternPropertyKey( std::string_view keyName );	// same key, and keeps the name for GetPropertyKeyName
+std::string const&	GetPropertyKeyName( PropertyKey key );			// "" if the key was never interned
+
+//------------------------------------------------------------------------
+// values up to this size are stored inside the property itself (fits std::string in debug and release)
+constexpr size_t PROPERTY_INLINE_BYTES = 40;
+
+template <typename T>
+struct IsInlineProperty
 {
-public:
-	virtual ~TypedPropertyBase() {}
+	static constexpr bool value = sizeof( T ) <= PROPERTY_INLINE_BYTES && alignof( T ) <= alignof( double );
+};
+
+//------------------------------------------------------------------------
+// One instance per stored type, its address is the type tag
+struct PropertyType
+{
+	void		(*m_copyConstruct)( void* destStorage, void const* srcStorage );
+	void		(*m_destruct)( void* storage );
+	std::string	(*m_getAsString)( void const* storage );
+};
 
-	virtual std::string GetAsString() const = 0;
-	virtual void const* GetUniqueID() const = 0;
+//------------------------------------------------------------------------
+template <typename T, bool IS_INLINE = IsInlineProperty<T>::value>
+struct PropertyStorage
+{
+	static T*			Get( void* storage )						{ return static_cast<T*>( storage ); }
+	static T const*		Get( void const* storage )					{ return static_cast<T const*>( storage ); }
+	static void			Construct( void* storage, T const& value )	{ new( storage ) T( value ); }
+	static void			Destruct( void* storage )					{ Get( storage )->~T(); }
+};
 
-	template <typename T>
-	bool Is() const;
-	
+// large types only keep a pointer in the storage
+template <typename T>
+struct PropertyStorage<T, false>
+{
+	static T*			Get( void* storage )						{ return *static_cast<T**>( storage ); }
+	static T const*		Get( void const* storage )					{ return *static_cast<T* const*>( storage ); }
+	static void			Construct( void* storage, T const& value )	{ *static_cast<T**>( storage ) = new T( value ); }
+	static void			Destruct( void* storage )					{ delete Get( storage ); }
+};
+
+//------------------------------------------------------------------------
+template <typename T>
+struct TypedPropertyOps
+{
+	static void CopyConstruct( void* destStorage, void const* srcStorage )	{ PropertyStorage<T>::Construct( destStorage, *PropertyStorage<T>::Get( srcStorage ) ); }
+	static void Destruct( void* storage )									{ PropertyStorage<T>::Destruct( storage ); }
+	static std::string GetAsString( void const* storage )					{ return ToString( *PropertyStorage<T>::Get( storage ) ); }
+
+	static PropertyType const s_type;
 };
 
+template <typename T>
+PropertyType const TypedPropertyOps<T>::s_type = { &TypedPropertyOps<T>::CopyConstruct, &TypedPropertyOps<T>::Destruct, &TypedPropertyOps<T>::GetAsString };
+
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
-template <typename VALUE_TYPE>
-class TypedProperty : public TypedPropertyBase
+class NamedProperty
 {
 public:
-	virtual std::string GetAsString() const final { return ToString( m_value ).c_str(); }
-	virtual void const* GetUniqueID() const final { return StaticUniqueID(); }
-public:
-	// std::string m_key;
-	VALUE_TYPE m_value;
+	NamedProperty() {}
+	NamedProperty( NamedProperty const& copyFrom );
+	NamedProperty& operator=( NamedProperty const& copyFrom );
+	~NamedProperty();
 
-public:
-	static void const* const StaticUniqueID()
+	// this works WITHOUT RTTI enabled, but will not work if the value is inherited from T
+	template <typename T>
+	bool Is() const { return m_type == &TypedPropertyOps<T>::s_type; }
+
+	template <typename T>
+	T const& Get() const { return *PropertyStorage<T>::Get( &m_storage ); }
+
+	//------------------------------------------------------------------------
+	template <typename T>
+	void Set( T const& value )
 	{
-		static int s_local = 0;
-		return &s_local;
+		if( Is<T>() )
+		{
+			*PropertyStorage<T>::Get( &m_storage ) = value;
+			return;
+		}
+
+		// not the same thing, destroy and remake
+		Reset();
+		PropertyStorage<T>::Construct( &m_storage, value );
+		m_type = &TypedPropertyOps<T>::s_type;
 	}
 
+	void Reset();
+	bool IsEmpty() const			{ return m_type == nullptr; }
+	std::string GetAsString() const;
+
+public:
+	PropertyKey m_key = INVALID_PROPERTY_KEY;
+
+private:
+	PropertyType const* m_type = nullptr;
+	typename std::aligned_storage<PROPERTY_INLINE_BYTES, alignof( double )>::type m_storage;
 };
 
 //------------------------------------------------------------------------
+// Flat property bag; the first few properties live inline so small arg lists never touch the heap
 //------------------------------------------------------------------------
 class NamedProperties
 {
 public:
+	NamedProperties() {}
+	NamedProperties( NamedProperties const& copyFrom );				// deep copy, queued events carry their own copy of the args
+	NamedProperties& operator=( NamedProperties const& copyFrom );
+	~NamedProperties() {}
+
+	void Clear();
+	void ResetValue();
+
 	//------------------------------------------------------------------------
-	~NamedProperties()
+	// for everything else, there's templates!
+	template <typename T>
+	void SetValue( PropertyKey key, T const& value )
 	{
-		for( auto iter : m_keyValuePairs ) 
+		NamedProperty* prop = FindProperty( key );
+		if( prop == nullptr )
 		{
-			delete iter.second;
+			prop = &AddProperty( key );
 		}
-
-		m_keyValuePairs.clear();
+		prop->Set<T>( value );
 	}
 
-	//------------------------------------------------------------------------
-	void ResetValue()
+	template <typename T>
+	void SetValue( std::string_view keyName, T const& value )
 	{
-		for( auto iter : m_keyValuePairs )
-		{
-			SetValue( iter.first, "" );
-		}
+		SetValue<T>( GetPropertyKey( keyName ), value );
 	}
 
 	//------------------------------------------------------------------------
-	// for everything else, there's templates!
 	template <typename T>
-	void SetValue( std::string const& keyName, T const& value )
+	T GetValue( PropertyKey key, T const& defValue ) const
 	{
-		TypedPropertyBase* base = FindInMap( keyName );
-		if( base == nullptr ) 
+		NamedProperty const* prop = FindProperty( key );
+		if( prop == nullptr || prop->IsEmpty() )
 		{
-			// doesn't exist, make a new one            
-			TypedProperty<T>* prop = new TypedProperty<T>();
-			prop->m_value = value;
-			m_keyValuePairs[keyName] = prop;
+			// failed to find
+			return defValue;
 		}
-		else
+
+		if( prop->Is<T>() )
 		{
-			// it exists?
-			if( base->Is<T>() ) 
-			{
-				TypedProperty<T>* prop = (TypedProperty<T>*)base;
-				prop->m_value = value;
-			}
-			else
-			{
-				// not the same thing
-				// delete and remake
-				delete base;
-
-				// doesn't exist, make a new one            
-				TypedProperty<T>* prop = new TypedProperty<T>();
-				prop->m_value = value;
-				m_keyValuePairs[keyName] = prop;
-			}
+			return prop->Get<T>();
 		}
+
+		std::string strValue = prop->GetAsString();
+		return StringConvert( strValue.c_str(), defValue );
 	}
 
-	//------------------------------------------------------------------------
 	template <typename T>
-	T GetValue( std::string const& keyName, T const& defValue ) const
+	T GetValue( std::string_view keyName, T const& defValue ) const
 	{
-		TypedPropertyBase* base = FindInMap( keyName );
-		if( nullptr != base ) 
-		{
-			// this works WITHOUT RTTI enabled
-			// but will not work if prop is inherited from T
-			if( base->Is<T>() ) 
-			{
-				// make sure this is safe!  how....?
-				TypedProperty<T>* prop = (TypedProperty<T>*)base;
-				return prop->m_value;
-			}
-			else 
-			{
-				std::string strValue = base->GetAsString();
-				return StringConvert( strValue.c_str(), defValue );
-			}
-		}
-		else 
-		{
-			// failed to find
-			return defValue;
-		}
+		return GetValue<T>( GetPropertyKey( keyName ), defValue );
 	}
 
 	//------------------------------------------------------------------------
 	// specialized for char const
-	void SetValue( std::string const& keyname, char const* val )
+	void SetValue( PropertyKey key, char const* val )
 	{
-		SetValue<std::string>( keyname, val );
+		SetValue<std::string>( key, val );
+	}
+
+	void SetValue( std::string_view keyName, char const* val )
+	{
+		SetValue<std::string>( keyName, val );
 	}
 
 	//------------------------------------------------------------------------
-	std::string GetValue( std::string const& keyName, char const* val ) const
+	std::string GetValue( std::string_view keyName, char const* val ) const
 	{
 		return GetValue<std::string>( keyName, val );
 	}
 
-	bool HasValue( const std::string& keyName );
+	bool HasValue( std::string_view keyName ) const;
+	int GetNumProperties() const { return m_numProperties; }
 
 	void PopulateForEventCommand( const std::string& commandInputValue );
 
 private:
-	//------------------------------------------------------------------------
-	TypedPropertyBase* FindInMap( std::string const& key ) const
-	{
-		auto iter = m_keyValuePairs.find( key );
-		if( iter != m_keyValuePairs.end() ) 
-		{
-			return iter->second;
-		}
-		else 
-		{
-			return nullptr;
-		}
-	}
+	NamedProperty*			GetProperty( int propertyIndex );
+	NamedProperty const*	GetProperty( int propertyIndex ) const;
+	NamedProperty*			FindProperty( PropertyKey key );
+	NamedProperty const*	FindProperty( PropertyKey key ) const;
+	NamedProperty&			AddProperty( PropertyKey key );
 
+private:
+	static constexpr int NUM_INLINE_PROPERTIES = 4;
 
-	// this is going to be different
-	// std::map<std::string, std::string> m_keyValuePairs;
-	// std::map<std::string, void*> m_keyValuePointers;
-
-	// We need to type type in a map
-	// But we can't store the temlate argument... or can we?
-	std::map<std::string, TypedPropertyBase*> m_keyValuePairs;
+	NamedProperty m_inlineProperties[NUM_INLINE_PROPERTIES];
+	std::vector<NamedProperty> m_overflowProperties;
+	int m_numProperties = 0;
 };
-
-template<typename T>
-inline bool TypedPropertyBase::Is() const
-{
-	TypedProperty<T> type;
-	return type.GetUniqueID() == GetUniqueID();
-}
\ No newline at end of file
@@ -1,7 +1,116 @@
 #include "NamedStrings.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include <algorithm>
 #include <math.h>
 
+//------------------------------------------------------------------------
+// one bit per type in NamedStringValue::m_parsedFlags / m_validFlags
+static constexpr unsigned char PARSED_BOOL		= 1 << 0;
+static constexpr unsigned char PARSED_INT		= 1 << 1;
+static constexpr unsigned char PARSED_FLOAT		= 1 << 2;
+static constexpr unsigned char PARSED_RGBA8		= 1 << 3;
+static constexpr unsigned char PARSED_VEC2		= 1 << 4;
+static constexpr unsigned char PARSED_VEC3		= 1 << 5;
+static constexpr unsigned char PARSED_INTVEC2	= 1 << 6;
+
+//------------------------------------------------------------------------
+static int GetNumCommaSeparatedFields( const std::string& str )
+{
+	return (int)std::count( str.begin(), str.end(), ',' ) + 1;
+}
+
+// each returns false when the string would leave the default value untouched
+static bool ParseNamedString( const std::string& str, bool& out_value )
+{
+	if( str == "true" )
+	{
+		out_value = true;
+		return true;
+	}
+	else if( str == "false" )
+	{
+		out_value = false;
+		return true;
+	}
+	return false;
+}
+
+static bool ParseNamedString( const std::string& str, int& out_value )
+{
+	out_value = atoi( str.c_str() );
+	return true;
+}
+
+static bool ParseNamedString( const std::string& str, float& out_value )
+{
+	out_value = (float)atof( str.c_str() );
+	return true;
+}
+
+static bool ParseNamedString( const std::string& str, Rgba8& out_value )
+{
+	if( GetNumCommaSeparatedFields( str ) < 3 )
+	{
+		return false;
+	}
+	out_value.SetFromText( str.c_str() );
+	return true;
+}
+
+static bool ParseNamedString( const std::string& str, Vec2& out_value )
+{
+	if( GetNumCommaSeparatedFields( str ) != 2 )
+	{
+		return false;
+	}
+	out_value.SetFromText( str.c_str() );
+	return true;
+}
+
+static bool ParseNamedString( const std::string& str, Vec3& out_value )
+{
+	if( GetNumCommaSeparatedFields( str ) != 3 )
+	{
+		return false;
+	}
+	out_value.SetFromText( str.c_str() );
+	return true;
+}
+
+static bool ParseNamedString( const std::string& str, IntVec2& out_value )
+{
+	if( GetNumCommaSeparatedFields( str ) != 2 )
+	{
+		return false;
+	}
+	out_value.SetFromText( str.c_str() );
+	return true;
+}
+
+//------------------------------------------------------------------------
+template <typename T>
+T NamedStrings::GetParsedValue( NamedStringSlot slot, const T& defaultValue, T NamedStringValue::* cachedValue, unsigned char typeFlag ) const
+{
+	// the parse cache is not part of the logical value, so const lookups may fill it
+	NamedStringValue* value = const_cast<NamedStringValue*>( GetSetValue( slot ) );
+	if( value == nullptr )
+	{
+		return defaultValue;
+	}
+
+	if( ( value->m_parsedFlags & typeFlag ) == 0 )
+	{
+		if( ParseNamedString( value->m_value, value->*cachedValue ) )
+		{
+			value->m_validFlags |= typeFlag;
+		}
+		value->m_parsedFlags |= typeFlag;
+	}
+
+	return ( value->m_validFlags & typeFlag ) != 0 ? value->*cachedValue : defaultValue;
+}
+
+//------------------------------------------------------------------------
 NamedStrings::NamedStrings()
 {
 }
@@ -9,8 +118,7 @@ NamedStrings::NamedStrings()
 bool NamedStrings::PopulateFromXmlFile( const char* xmlFilePath )
 {
 	XmlDocument xmlDocument;
-	xmlDocument.LoadFile( xmlFilePath );
-	if( xmlDocument.ErrorID() != tinyxml2::XML_SUCCESS )
+	if( !LoadXmlDocumentFromFile( xmlDocument, xmlFilePath ) )
 	{
 		return false;
 	}
@@ -30,134 +138,145 @@ void NamedStrings::PopulateFromXmlElementAttributes( const XmlElement& element )
 	const XmlAttribute* attribute = element.FirstAttribute();
 	while( attribute )
 	{
-		m_keyValuePairs[attribute->Name()] = attribute->Value();
+		SetValue( attribute->Name(), attribute->Value() );
 		attribute = attribute->Next();
 	}
 }
 
 void NamedStrings::SetValue( const std::string& keyName, const std::string& newValue )
 {
-	m_keyValuePairs[keyName] = newValue;
+	NamedStringValue& value = m_values[ResolveSlot( keyName ).m_index];
+	value.m_value = newValue;
+	value.m_hasValue = true;
+	value.m_parsedFlags = 0;
+	value.m_validFlags = 0;
 }
 
-bool NamedStrings::HasValue( const std::string& keyName )
+bool NamedStrings::HasValue( const std::string& keyName ) const
 {
-	return m_keyValuePairs.find( keyName ) != m_keyValuePairs.end();
+	return GetSetValue( FindSlot( keyName ) ) != nullptr;
 }
 
 bool NamedStrings::GetValue( const std::string& keyName, bool defaultValue ) const
 {
-	bool value = defaultValue;
-	if ( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		std::string str = m_keyValuePairs.at( keyName );
-		if( str == "true" )
-		{
-			value = true;
-		}
-		else if( str == "false" )
-		{
-			value = false;
-		}
-	}
-
-	return value;
+	return GetValue( FindSlot( keyName ), defaultValue );
 }
 
 int NamedStrings::GetValue( const std::string& keyName, int defaultValue ) const
 {
-	int value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		std::string str = m_keyValuePairs.at( keyName );
-		value = atoi( &str[0] );
-	}
-
-	return value;
+	return GetValue( FindSlot( keyName ), defaultValue );
 }
 
 float NamedStrings::GetValue( const std::string& keyName, float defaultValue ) const
 {
-	float value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		std::string str = m_keyValuePairs.at( keyName );
-		value = (float) atof( &str[0] );
-	}
-
-	return value;
+	return GetValue( FindSlot( keyName ), defaultValue );
 }
 
 std::string NamedStrings::GetValue( const std::string& keyName, std::string defaultValue ) const
 {
-	std::string value = defaultValue;
-	if ( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		value = m_keyValuePairs.at( keyName );
-	}
-
-	return value;
+	const NamedStringValue* value = GetSetValue( FindSlot( keyName ) );
+	return value ? value->m_value : defaultValue;
 }
 
 std::string NamedStrings::GetValue( const std::string& keyName, const char* defaultValue ) const
 {
-	std::string value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		value = m_keyValuePairs.at( keyName );
-	}
-
-	return value;
+	return GetValue( FindSlot( keyName ), defaultValue );
 }
 
 Rgba8 NamedStrings::GetValue( const std::string& keyName, const Rgba8& defaultValue ) const
 {
-	Rgba8 value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		std::string str = m_keyValuePairs.at( keyName );
-		value.SetFromText( &str[0] );
-	}
-
-	return value;
+	return GetValue( FindSlot( keyName ), defaultValue );
 }
 
 Vec2 NamedStrings::GetValue( const std::string& keyName, const Vec2& defaultValue ) const
 {
-	Vec2 value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
-	{
-		std::string str = m_keyValuePairs.at( keyName );
-		value.SetFromText( &str[0] );
-	}
-
-	return value;
+	return GetValue( FindSlot( keyName ), defaultValue );
 }
 
 Vec3 NamedStrings::GetValue( const std::string& keyName, const Vec3& defaultValue ) const
 {
-	Vec3 value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
+	return GetValue( FindSlot( keyName ), defaultValue );
+}
+
+IntVec2 NamedStrings::GetValue( const std::string& keyName, const IntVec2& defaultValue ) const
+{
+	return GetValue( FindSlot( keyName ), defaultValue );
+}
+
+//------------------------------------------------------------------------
+NamedStringSlot NamedStrings::ResolveSlot( const std::string& keyName )
+{
+	auto iter = m_slotsByKey.find( keyName );
+	if( iter != m_slotsByKey.end() )
 	{
-		std::string str = m_keyValuePairs.at( keyName );
-		value.SetFromText( &str[0] );
+		return iter->second;
 	}
 
-	return value;
+	NamedStringSlot slot;
+	slot.m_index = (int)m_values.size();
+	m_values.emplace_back();
+	m_slotsByKey[keyName] = slot;
+	return slot;
 }
 
-IntVec2 NamedStrings::GetValue( const std::string& keyName, const IntVec2& defaultValue ) const
+bool NamedStrings::GetValue( NamedStringSlot slot, bool defaultValue ) const
 {
-	IntVec2 value = defaultValue;
-	if( m_keyValuePairs.count( keyName ) > 0 )
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_boolValue, PARSED_BOOL );
+}
+
+int NamedStrings::GetValue( NamedStringSlot slot, int defaultValue ) const
+{
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_intValue, PARSED_INT );
+}
+
+float NamedStrings::GetValue( NamedStringSlot slot, float defaultValue ) const
+{
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_floatValue, PARSED_FLOAT );
+}
+
+std::string NamedStrings::GetValue( NamedStringSlot slot, const char* defaultValue ) const
+{
+	const NamedStringValue* value = GetSetValue( slot );
+	return value ? value->m_value : std::string( defaultValue );
+}
+
+Rgba8 NamedStrings::GetValue( NamedStringSlot slot, const Rgba8& defaultValue ) const
+{
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_rgba8Value, PARSED_RGBA8 );
+}
+
+Vec2 NamedStrings::GetValue( NamedStringSlot slot, const Vec2& defaultValue ) const
+{
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_vec2Value, PARSED_VEC2 );
+}
+
+Vec3 NamedStrings::GetValue( NamedStringSlot slot, const Vec3& defaultValue ) const
+{
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_vec3Value, PARSED_VEC3 );
+}
+
+IntVec2 NamedStrings::GetValue( NamedStringSlot slot, const IntVec2& defaultValue ) const
+{
+	return GetParsedValue( slot, defaultValue, &NamedStringValue::m_intVec2Value, PARSED_INTVEC2 );
+}
+
+//------------------------------------------------------------------------
+NamedStringSlot NamedStrings::FindSlot( const std::string& keyName ) const
+{
+	auto iter = m_slotsByKey.find( keyName );
+	return iter != m_slotsByKey.end() ? iter->second : INVALID_NAMED_STRING_SLOT;
+}
+
+const NamedStringValue* NamedStrings::GetSetValue( NamedStringSlot slot ) const
+{
+	if( !slot.IsValid() || slot.m_index >= (int)m_values.size() || !m_values[slot.m_index].m_hasValue )
 	{
-		std::string str = m_keyValuePairs.at( keyName );
-		value.SetFromText( &str[0] );
+		return nullptr;
 	}
-
-	return value;
+	return &m_values[slot.m_index];
 }
 
+//------------------------------------------------------------------------
 NamedStrings NamedStrings::PopulateForEventCommand( const std::string& commandInputValue )
 {
 	NamedStrings commandInputMap;
@@ -165,13 +284,9 @@ NamedStrings NamedStrings::PopulateForEventCommand( const std::string& commandIn
 	{
 		return commandInputMap;
 	}
-	Strings stringList = SplitStringOnDelimiter( commandInputValue, ',' );
-	for ( int i = 0; i < (int) stringList.size(); i++ )
+	for ( std::string_view key : SplitStringView( commandInputValue, ',', false ) )
 	{
-		if ( (int) stringList[i].size() != 0 )
-		{
-			commandInputMap.m_keyValuePairs[stringList[i]] = "";
-		}
+		commandInputMap.SetValue( std::string( key ), "" );
 	}
 
 	return commandInputMap;
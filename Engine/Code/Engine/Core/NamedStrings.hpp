@@ -1,9 +1,43 @@
 #pragma once
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include <map>
 #include <string>
+#include <vector>
 
+// a struct rather than an int, so a slot can't be mixed up with an int key or default value
+struct NamedStringSlot
+{
+	int m_index = -1;
+
+	bool IsValid() const { return m_index >= 0; }
+};
+constexpr NamedStringSlot INVALID_NAMED_STRING_SLOT = {};
+
+//------------------------------------------------------------------------
+// Raw string plus a parsed copy for each type it has been read as; SetValue clears the cache
+struct NamedStringValue
+{
+	std::string m_value;
+	bool m_hasValue = false;
+
+	unsigned char m_parsedFlags = 0;
+	unsigned char m_validFlags = 0;
+	bool m_boolValue = false;
+	int m_intValue = 0;
+	float m_floatValue = 0.f;
+	Rgba8 m_rgba8Value;
+	Vec2 m_vec2Value;
+	Vec3 m_vec3Value;
+	IntVec2 m_intVec2Value;
+};
+
+//------------------------------------------------------------------------
+// Lookups are not thread safe, the parse cache is filled in on first read
+//------------------------------------------------------------------------
 class NamedStrings
 {
 public:
@@ -12,7 +46,7 @@ public:
 	bool			PopulateFromXmlFile( const char* xmlFilePath );
 	void			PopulateFromXmlElementAttributes( const XmlElement& element );
 	void			SetValue( const std::string& keyName, const std::string& newValue );
-	bool			HasValue( const std::string& keyName );
+	bool			HasValue( const std::string& keyName ) const;
 
 	bool			GetValue( const std::string& keyName, bool defaultValue ) const;
 	int				GetValue( const std::string& keyName, int defaultValue ) const;
@@ -26,9 +60,29 @@ public:
 	//FloatRange	GetValue( const std::string& keyName, const FloatRange& defaultValue ) const;
 	//IntRange		GetValue( const std::string& keyName, const IntRange& defaultValue ) const;
 
+	// schema mode: resolve keys to slots once at load time, then read by slot on the hot path.
+	// Slots stay valid for the life of this object; a key set later fills its existing slot.
+	NamedStringSlot	ResolveSlot( const std::string& keyName );
+	bool			GetValue( NamedStringSlot slot, bool defaultValue ) const;
+	int				GetValue( NamedStringSlot slot, int defaultValue ) const;
+	float			GetValue( NamedStringSlot slot, float defaultValue ) const;
+	std::string		GetValue( NamedStringSlot slot, const char* defaultValue ) const;
+	Rgba8			GetValue( NamedStringSlot slot, const Rgba8& defaultValue ) const;
+	Vec2			GetValue( NamedStringSlot slot, const Vec2& defaultValue ) const;
+	Vec3			GetValue( NamedStringSlot slot, const Vec3& defaultValue ) const;
+	IntVec2			GetValue( NamedStringSlot slot, const IntVec2& defaultValue ) const;
+
 	static NamedStrings	PopulateForEventCommand( const std::string& commandInputValue );
 
 private:
-	std::map< std::string, std::string >	m_keyValuePairs;
+	NamedStringSlot			FindSlot( const std::string& keyName ) const;
+	const NamedStringValue*	GetSetValue( NamedStringSlot slot ) const;
+
+	template <typename T>
+	T GetParsedValue( NamedStringSlot slot, const T& defaultValue, T NamedStringValue::* cachedValue, unsigned char typeFlag ) const;
+
+private:
+	std::map< std::string, NamedStringSlot >	m_slotsByKey;
+	std::vector< NamedStringValue >				m_values;
 
-};
\ No newline at end of file
+};
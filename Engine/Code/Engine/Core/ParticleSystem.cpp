@@ -1,20 +1,147 @@
 #include "Engine/Core/ParticleSystem.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Renderer/Transform.hpp"
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <math.h>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define PARTICLE_SYSTEM_USE_SSE2
+#endif
 
 extern RenderContext* g_theRenderer;
 
+constexpr int MIN_PARTICLE_POOL_CAPACITY = 64;
+
+//------------------------------------------------------------------------
+void ParticlePool::SetCapacity( int capacity )
+{
+	capacity = capacity > 0 ? capacity : 0;
+	size_t paddedCapacity = (size_t)( ( capacity + 3 ) & ~3 );
+	for( std::vector<float>* stream : { &m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ, &m_age, &m_maxAge, &m_scaleX, &m_scaleY } )
+	{
+		stream->resize( paddedCapacity, 0.f );
+	}
+	m_color.resize( paddedCapacity );
+	m_capacity = capacity;
+	m_numParticles = m_numParticles < capacity ? m_numParticles : capacity;
+}
+
+void ParticlePool::CopyParticle( int toIndex, int fromIndex )
+{
+	m_positionX[toIndex] = m_positionX[fromIndex];
+	m_positionY[toIndex] = m_positionY[fromIndex];
+	m_positionZ[toIndex] = m_positionZ[fromIndex];
+	m_velocityX[toIndex] = m_velocityX[fromIndex];
+	m_velocityY[toIndex] = m_velocityY[fromIndex];
+	m_velocityZ[toIndex] = m_velocityZ[fromIndex];
+	m_age[toIndex] = m_age[fromIndex];
+	m_maxAge[toIndex] = m_maxAge[fromIndex];
+	m_scaleX[toIndex] = m_scaleX[fromIndex];
+	m_scaleY[toIndex] = m_scaleY[fromIndex];
+	m_color[toIndex] = m_color[fromIndex];
+}
+
+//------------------------------------------------------------------------
+// Returns the lowest index that might be dead, m_numParticles if none are
+//------------------------------------------------------------------------
+static int IntegrateParticlesScalar( ParticlePool& pool, float deltaSeconds )
+{
+	int firstDeadIndex = pool.m_numParticles;
+	for( int particleIndex = 0; particleIndex < pool.m_numParticles; particleIndex++ )
+	{
+		pool.m_age[particleIndex] += deltaSeconds;
+		pool.m_positionX[particleIndex] += pool.m_velocityX[particleIndex] * deltaSeconds;
+		pool.m_positionY[particleIndex] += pool.m_velocityY[particleIndex] * deltaSeconds;
+		pool.m_positionZ[particleIndex] += pool.m_velocityZ[particleIndex] * deltaSeconds;
+		if( pool.m_age[particleIndex] >= pool.m_maxAge[particleIndex] && particleIndex < firstDeadIndex )
+		{
+			firstDeadIndex = particleIndex;
+		}
+	}
+	return firstDeadIndex;
+}
+
+#if defined( PARTICLE_SYSTEM_USE_SSE2 )
+// four particles a step; the padded tail gets integrated too, it's scratch
+static int IntegrateParticlesSSE2( ParticlePool& pool, float deltaSeconds )
+{
+	int firstDeadIndex = pool.m_numParticles;
+	__m128 deltaSeconds4 = _mm_set1_ps( deltaSeconds );
+	float* positionX = pool.m_positionX.data();
+	float* positionY = pool.m_positionY.data();
+	float* positionZ = pool.m_positionZ.data();
+	float const* velocityX = pool.m_velocityX.data();
+	float const* velocityY = pool.m_velocityY.data();
+	float const* velocityZ = pool.m_velocityZ.data();
+	float* age = pool.m_age.data();
+	float const* maxAge = pool.m_maxAge.data();
+	for( int particleIndex = 0; particleIndex < pool.m_numParticles; particleIndex += 4 )
+	{
+		__m128 age4 = _mm_add_ps( _mm_loadu_ps( age + particleIndex ), deltaSeconds4 );
+		_mm_storeu_ps( age + particleIndex, age4 );
+		_mm_storeu_ps( positionX + particleIndex, _mm_add_ps( _mm_loadu_ps( positionX + particleIndex ), _mm_mul_ps( _mm_loadu_ps( velocityX + particleIndex ), deltaSeconds4 ) ) );
+		_mm_storeu_ps( positionY + particleIndex, _mm_add_ps( _mm_loadu_ps( positionY + particleIndex ), _mm_mul_ps( _mm_loadu_ps( velocityY + particleIndex ), deltaSeconds4 ) ) );
+		_mm_storeu_ps( positionZ + particleIndex, _mm_add_ps( _mm_loadu_ps( positionZ + particleIndex ), _mm_mul_ps( _mm_loadu_ps( velocityZ + particleIndex ), deltaSeconds4 ) ) );
+
+		int deadMask = _mm_movemask_ps( _mm_cmpge_ps( age4, _mm_loadu_ps( maxAge + particleIndex ) ) );
+		if( deadMask != 0 && firstDeadIndex == pool.m_numParticles )
+		{
+			firstDeadIndex = particleIndex;
+		}
+	}
+	return firstDeadIndex;
+}
+#endif
+
+// back to front, so whatever gets swapped down from the end has already been checked
+static void CompactDeadParticles( ParticlePool& pool, int firstDeadIndex )
+{
+	for( int particleIndex = pool.m_numParticles - 1; particleIndex >= firstDeadIndex; particleIndex-- )
+	{
+		if( pool.m_age[particleIndex] >= pool.m_maxAge[particleIndex] )
+		{
+			pool.m_numParticles--;
+			pool.CopyParticle( particleIndex, pool.m_numParticles );
+		}
+	}
+}
+
+void UpdateParticlePool( ParticlePool& pool, float deltaSeconds )
+{
+#if defined( PARTICLE_SYSTEM_USE_SSE2 )
+	CompactDeadParticles( pool, IntegrateParticlesSSE2( pool, deltaSeconds ) );
+#else
+	CompactDeadParticles( pool, IntegrateParticlesScalar( pool, deltaSeconds ) );
+#endif
+}
+
+//------------------------------------------------------------------------
 ParticleSystem::ParticleSystem()
 {
 }
 
 ParticleSystem::~ParticleSystem()
 {
+	for( Emitter* e : m_emitters )
+	{
+		delete e->m_clock;
+		delete e;
+	}
+	m_emitters.clear();
 }
 
 void ParticleSystem::Update( float deltaSeconds )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PARTICLES );
+	PROFILE_SCOPE( "ParticleSystem::Update" );
 	for( Emitter* e : m_emitters )
 	{
 		e->Update( deltaSeconds );
@@ -23,6 +150,7 @@ void ParticleSystem::Update( float deltaSeconds )
 
 void ParticleSystem::Render() const
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PARTICLES );
 	for( Emitter* e : m_emitters )
 	{
 		e->Render();
@@ -31,6 +159,7 @@ void ParticleSystem::Render() const
 
 Emitter* ParticleSystem::CreateEmitter()
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PARTICLES );
 	Emitter* emitter = new Emitter();
 	emitter->m_clock = new Clock();
 	emitter->m_parentSystem = this;
@@ -39,55 +168,203 @@ Emitter* ParticleSystem::CreateEmitter()
 	return emitter;
 }
 
-void Emitter::Update( float deltaSeconds )
+//------------------------------------------------------------------------
+void Emitter::SetCapacity( int maxParticles, eParticleOverflowPolicy overflowPolicy )
 {
-	if ( !m_isRender )
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PARTICLES );
+	m_pool.SetCapacity( maxParticles );
+	m_overflowPolicy = overflowPolicy;
+}
+
+int Emitter::Emit( int numParticles )
+{
+	int numSpawned = ReserveParticles( numParticles );
+	SpawnParticles( numSpawned, 0.f, 0.f, 0.f );
+	return numSpawned;
+}
+
+void Emitter::AddBurst( float time, int count, int numCycles, float repeatSeconds )
+{
+	ParticleBurst burst;
+	burst.m_time = time;
+	burst.m_count = count;
+	burst.m_numCycles = repeatSeconds > 0.f ? numCycles : 1;
+	burst.m_repeatSeconds = repeatSeconds;
+	m_bursts.push_back( burst );
+}
+
+void Emitter::RestartEmission()
+{
+	m_age = 0.f;
+	m_spawnAccumulator = 0.f;
+	for( ParticleBurst& burst : m_bursts )
+	{
+		burst.m_numCyclesFired = 0;
+	}
+}
+
+void Emitter::ClearParticles()
+{
+	m_pool.m_numParticles = 0;
+}
+
+float Emitter::GetRateMultiplier( float emitterSeconds ) const
+{
+	if( m_rateCurve.empty() )
+	{
+		return 1.f;
+	}
+	if( m_rateCurveLoopSeconds > 0.f )
+	{
+		emitterSeconds = fmodf( emitterSeconds, m_rateCurveLoopSeconds );
+	}
+	if( emitterSeconds <= m_rateCurve.front().x )
+	{
+		return m_rateCurve.front().y;
+	}
+
+	for( size_t keyIndex = 1; keyIndex < m_rateCurve.size(); keyIndex++ )
 	{
-		for( int i = 0; i < (int)m_particles.size(); ++i )
+		const Vec2& key = m_rateCurve[keyIndex];
+		if( emitterSeconds < key.x )
 		{
-			delete m_particles[i];
+			const Vec2& previousKey = m_rateCurve[keyIndex - 1];
+			return RangeMap( previousKey.x, key.x, previousKey.y, key.y, emitterSeconds );
+		}
+	}
+	return m_rateCurve.back().y;
+}
 
-			uint lastIndex = (uint)m_particles.size() - 1;
-			m_particles[i] = m_particles[lastIndex];
-			m_particles.pop_back();
-			--i;
+//------------------------------------------------------------------------
+int Emitter::ReserveParticles( int numParticles )
+{
+	int numFree = m_pool.m_capacity - m_pool.m_numParticles;
+	if( numParticles > numFree && m_overflowPolicy == PARTICLE_OVERFLOW_GROW )
+	{
+		int newCapacity = m_pool.m_capacity > MIN_PARTICLE_POOL_CAPACITY / 2 ? m_pool.m_capacity * 2 : MIN_PARTICLE_POOL_CAPACITY;
+		while( newCapacity < m_pool.m_numParticles + numParticles )
+		{
+			newCapacity *= 2;
+		}
+		MEMORY_TAG_SCOPE( MEMORY_TAG_PARTICLES );
+		m_pool.SetCapacity( newCapacity );
+		numFree = m_pool.m_capacity - m_pool.m_numParticles;
+	}
+
+	int numReserved = numParticles < numFree ? numParticles : numFree;
+	m_numDroppedParticles += numParticles - numReserved;
+	return numReserved;
+}
+
+// the k-th particle was spawned firstSpawnSeconds + k * spawnStepSeconds into a frame frameSeconds long,
+// so it starts that much younger than the frame and that far along the emitter's path
+void Emitter::SpawnParticles( int numParticles, float frameSeconds, float firstSpawnSeconds, float spawnStepSeconds )
+{
+	// Emit() passes a zero length frame, those all go out at the current position
+	Vec3 frameStartPosition = m_hasPreviousPosition && frameSeconds > 0.f ? m_previousPosition : m_position;
+	float secondsToFraction = frameSeconds > 0.f ? 1.f / frameSeconds : 0.f;
+	for( int spawnIndex = 0; spawnIndex < numParticles; spawnIndex++ )
+	{
+		float spawnSeconds = firstSpawnSeconds + spawnStepSeconds * (float)spawnIndex;
+		float age = frameSeconds - spawnSeconds;
+		age = age > 0.f ? age : 0.f;
+		if( age >= m_maxAge )
+		{
+			// born and dead within a long frame
+			continue;
 		}
+
+		float fractionOfFrame = spawnSeconds * secondsToFraction;
+		Vec3 spawnPosition = frameStartPosition + ( m_position - frameStartPosition ) * fractionOfFrame;
+		SpawnParticle( m_pool.m_numParticles++, spawnPosition, age );
+	}
+	m_numSpawnedParticles += numParticles;
+}
+
+void Emitter::SpawnParticle( int particleIndex, const Vec3& spawnPosition, float age )
+{
+	RandomNumberGenerator& rng = m_parentSystem->m_rng;
+	float offsetX = rng.RollRandomFloatInRange( m_spawnOffsetMin.x, m_spawnOffsetMax.x );
+	float offsetY = rng.RollRandomFloatInRange( m_spawnOffsetMin.y, m_spawnOffsetMax.y );
+	float offsetZ = rng.RollRandomFloatInRange( m_spawnOffsetMin.z, m_spawnOffsetMax.z );
+	float orientation = rng.RollRandomFloatInRange( m_minOrientation, m_maxOrientation );
+	Vec3 velocity = Vec3( 1.f, 0.f, 0.f ).GetRotatedAboutZDegrees( orientation ) * m_velocity;
+
+	m_pool.m_positionX[particleIndex] = spawnPosition.x + offsetX + velocity.x * age;
+	m_pool.m_positionY[particleIndex] = spawnPosition.y + offsetY + velocity.y * age;
+	m_pool.m_positionZ[particleIndex] = spawnPosition.z + offsetZ + velocity.z * age;
+	m_pool.m_velocityX[particleIndex] = velocity.x;
+	m_pool.m_velocityY[particleIndex] = velocity.y;
+	m_pool.m_velocityZ[particleIndex] = velocity.z;
+	m_pool.m_age[particleIndex] = age;
+	m_pool.m_maxAge[particleIndex] = m_maxAge;
+	m_pool.m_scaleX[particleIndex] = m_scale.x;
+	m_pool.m_scaleY[particleIndex] = m_scale.y;
+	m_pool.m_color[particleIndex] = m_color;
+}
+
+//------------------------------------------------------------------------
+void Emitter::Update( float deltaSeconds )
+{
+	if ( !m_isRender )
+	{
+		ClearParticles();
 		return;
 	}
 
-	if ( !m_stopCreatingParticle )
+	// particles from earlier frames move first, new ones only age for the part of the frame they were alive
+	UpdateParticlePool( m_pool, deltaSeconds );
+	if ( !m_stopCreatingParticle && deltaSeconds > 0.f )
+	{
+		UpdateEmission( deltaSeconds );
+	}
+	else
+	{
+		// starting again shouldn't dump what was owed before stopping
+		m_spawnAccumulator = 0.f;
+	}
+	m_previousPosition = m_position;
+	m_hasPreviousPosition = true;
+}
+
+void Emitter::UpdateEmission( float deltaSeconds )
+{
+	float frameStartSeconds = m_age;
+	float frameEndSeconds = m_age + deltaSeconds;
+	m_age = frameEndSeconds;
+
+	// spawn j this frame is due when the accumulator reaches j, ( j - accumulator ) / rate in
+	if( m_interval > 0.f )
 	{
-		m_age += deltaSeconds;
-		if( m_age >= m_interval )
+		float spawnsPerSecond = 0.5f * ( GetRateMultiplier( frameStartSeconds ) + GetRateMultiplier( frameEndSeconds ) ) / m_interval;
+		if( spawnsPerSecond > 0.f )
 		{
-			m_age = 0.f;
-			Particle* p = CreateParticle();
-			float offsetX = m_parentSystem->m_rng.RollRandomFloatInRange( m_spawnOffsetMin.x, m_spawnOffsetMax.x );
-			float offsetY = m_parentSystem->m_rng.RollRandomFloatInRange( m_spawnOffsetMin.y, m_spawnOffsetMax.y );
-			float offsetZ = m_parentSystem->m_rng.RollRandomFloatInRange( m_spawnOffsetMin.z, m_spawnOffsetMax.z );
-			p->m_maxAge = m_maxAge;
-			p->m_transform.m_position = m_position + Vec3( offsetX, offsetY, offsetZ );
-			p->m_color = m_color;
-			p->m_transform.m_scale = m_scale;
-			Vec3 r = Vec3( 1.f, 0.f, 0.f );
-			float orientation = m_parentSystem->m_rng.RollRandomFloatInRange( m_minOrientation, m_maxOrientation );
-			r = r.GetRotatedAboutZDegrees( orientation ) * m_velocity;
-			p->m_velocity = r;
+			float accumulatorAtFrameStart = m_spawnAccumulator;
+			m_spawnAccumulator += spawnsPerSecond * deltaSeconds;
+			int numSpawns = (int)m_spawnAccumulator;
+			m_spawnAccumulator -= (float)numSpawns;
+
+			float spawnStepSeconds = 1.f / spawnsPerSecond;
+			int numReserved = ReserveParticles( numSpawns );
+			SpawnParticles( numReserved, deltaSeconds, ( 1.f - accumulatorAtFrameStart ) * spawnStepSeconds, spawnStepSeconds );
 		}
 	}
 
-	for( int i = 0; i < (int) m_particles.size(); ++i )
+	for( ParticleBurst& burst : m_bursts )
 	{
-		m_particles[i]->m_age += deltaSeconds;
-		m_particles[i]->m_transform.m_position += m_particles[i]->m_velocity * deltaSeconds;
-		if ( m_particles[i]->m_maxAge <= m_particles[i]->m_age )
+		while( burst.m_numCycles == 0 || burst.m_numCyclesFired < burst.m_numCycles )
 		{
-			delete m_particles[i];
+			float burstSeconds = burst.m_time + burst.m_repeatSeconds * (float)burst.m_numCyclesFired;
+			if( burstSeconds >= frameEndSeconds )
+			{
+				break;
+			}
 
-			uint lastIndex = (uint)m_particles.size() - 1;
-			m_particles[i] = m_particles[lastIndex];
-			m_particles.pop_back();
-			--i;
+			// one added after its time goes off at the start of this frame
+			float burstSecondsIntoFrame = burstSeconds > frameStartSeconds ? burstSeconds - frameStartSeconds : 0.f;
+			int numReserved = ReserveParticles( burst.m_count );
+			SpawnParticles( numReserved, deltaSeconds, burstSecondsIntoFrame, 0.f );
+			burst.m_numCyclesFired++;
 		}
 	}
 }
@@ -101,27 +378,186 @@ void Emitter::Render() const
 
 	g_theRenderer->BindShader( m_shader );
 	g_theRenderer->BindTexture( m_texture );
-	std::vector<Vertex_PCU> vertices;
-	for ( Particle* p : m_particles )
+	FrameVector<Vertex_PCU> vertices;
+	vertices.reserve( m_pool.m_numParticles * 6 );
+	for( int particleIndex = 0; particleIndex < m_pool.m_numParticles; particleIndex++ )
 	{
-		Rgba8 color = p->m_color;
+		Rgba8 color = m_pool.m_color[particleIndex];
 		if ( m_hasFadeOut )
 		{
-			float scale = 1.f - ( p->m_age / p->m_maxAge );
-			color.a = (char)((float)color.a * scale);
+			float scale = 1.f - ( m_pool.m_age[particleIndex] / m_pool.m_maxAge[particleIndex] );
+			color.a = (unsigned char)( (float)color.a * scale );
 		}
-		AABB2 bounds = AABB2( Vec2::ZERO, Vec2( 1.f, 1.f ) * p->m_transform.m_scale.GetXY() );
-		bounds.Translate( p->m_transform.m_position.GetXY() );
-		AppendQuad( vertices, Vec3( bounds.mins, 0.f ), Vec3( bounds.maxs.x, bounds.mins.y, 0.f ), 
-			Vec3( bounds.mins.x, bounds.maxs.y, 0.f ), Vec3( bounds.maxs, 0.f ), AABB2::ZERO_TO_ONE, color );
+		Vec2 mins = Vec2( m_pool.m_positionX[particleIndex], m_pool.m_positionY[particleIndex] );
+		Vec2 maxs = mins + Vec2( m_pool.m_scaleX[particleIndex], m_pool.m_scaleY[particleIndex] );
+		AppendQuad( vertices, Vec3( mins, 0.f ), Vec3( maxs.x, mins.y, 0.f ),
+			Vec3( mins.x, maxs.y, 0.f ), Vec3( maxs, 0.f ), AABB2::ZERO_TO_ONE, color );
 	}
 	g_theRenderer->DrawVertexArray( vertices );
 }
 
-Particle* Emitter::CreateParticle()
+//------------------------------------------------------------------------
+// The layout this replaced, one heap particle per spawn behind a pointer
+//------------------------------------------------------------------------
+struct LegacyParticle
+{
+	Transform m_transform;
+	Vec3 m_velocity = Vec3( 1.f, 0.f, 0.f );
+	float m_age = 0.f;
+	float m_maxAge = 1.f;
+	Rgba8 m_color = Rgba8::WHITE;
+};
+
+static void UpdateLegacyParticles( std::vector<LegacyParticle*>& particles, float deltaSeconds )
+{
+	for( int i = 0; i < (int)particles.size(); ++i )
+	{
+		particles[i]->m_age += deltaSeconds;
+		particles[i]->m_transform.m_position += particles[i]->m_velocity * deltaSeconds;
+		if( particles[i]->m_maxAge <= particles[i]->m_age )
+		{
+			delete particles[i];
+			particles[i] = particles.back();
+			particles.pop_back();
+			--i;
+		}
+	}
+}
+
+// refills to numParticles after each update, like a busy emitter in steady state
+COMMAND( benchmark_particles, "Time updating a full particle emitter, old pointer per particle layout against the pool. e.g. benchmark_particles particles=100000 frames=300", "particles,frames" )
+{
+	int numParticles = args.GetValue( "particles", 100000 );
+	int numFrames = args.GetValue( "frames", 300 );
+	numParticles < 1 ? numParticles = 1 : true;
+	numFrames < 1 ? numFrames = 1 : true;
+	constexpr float deltaSeconds = 1.f / 60.f;
+	constexpr float maxAge = 2.f;
+
+	// ages spread out at the start so a steady trickle dies every frame
+	RandomNumberGenerator rng;
+	std::vector<LegacyParticle*> legacyParticles;
+	auto refillLegacyParticles = [&]( bool isFirstFill )
+	{
+		while( (int)legacyParticles.size() < numParticles )
+		{
+			LegacyParticle* particle = new LegacyParticle();
+			particle->m_maxAge = maxAge;
+			particle->m_age = isFirstFill ? rng.RollRandomFloatInRange( 0.f, maxAge ) : 0.f;
+			particle->m_transform.m_position = Vec3( rng.RollRandomFloatInRange( 0.f, 10.f ), rng.RollRandomFloatInRange( 0.f, 10.f ), 0.f );
+			particle->m_velocity = Vec3( rng.RollRandomFloatInRange( -1.f, 1.f ), 1.f, 0.f );
+			legacyParticles.push_back( particle );
+		}
+	};
+
+	ParticlePool pool;
+	pool.SetCapacity( numParticles );
+	auto refillPool = [&]( bool isFirstFill )
+	{
+		for( ; pool.m_numParticles < numParticles; pool.m_numParticles++ )
+		{
+			int particleIndex = pool.m_numParticles;
+			pool.m_age[particleIndex] = isFirstFill ? rng.RollRandomFloatInRange( 0.f, maxAge ) : 0.f;
+			pool.m_maxAge[particleIndex] = maxAge;
+			pool.m_positionX[particleIndex] = rng.RollRandomFloatInRange( 0.f, 10.f );
+			pool.m_positionY[particleIndex] = rng.RollRandomFloatInRange( 0.f, 10.f );
+			pool.m_positionZ[particleIndex] = 0.f;
+			pool.m_velocityX[particleIndex] = rng.RollRandomFloatInRange( -1.f, 1.f );
+			pool.m_velocityY[particleIndex] = 1.f;
+			pool.m_velocityZ[particleIndex] = 0.f;
+			pool.m_scaleX[particleIndex] = 1.f;
+			pool.m_scaleY[particleIndex] = 1.f;
+			pool.m_color[particleIndex] = Rgba8::WHITE;
+		}
+	};
+
+	refillLegacyParticles( true );
+	double startSeconds = GetCurrentTimeSeconds();
+	for( int frameIndex = 0; frameIndex < numFrames; frameIndex++ )
+	{
+		UpdateLegacyParticles( legacyParticles, deltaSeconds );
+		refillLegacyParticles( false );
+	}
+	double legacySeconds = GetCurrentTimeSeconds() - startSeconds;
+	for( LegacyParticle* particle : legacyParticles )
+	{
+		delete particle;
+	}
+
+	refillPool( true );
+	startSeconds = GetCurrentTimeSeconds();
+	for( int frameIndex = 0; frameIndex < numFrames; frameIndex++ )
+	{
+		CompactDeadParticles( pool, IntegrateParticlesScalar( pool, deltaSeconds ) );
+		refillPool( false );
+	}
+	double scalarSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	pool.m_numParticles = 0;
+	refillPool( true );
+	startSeconds = GetCurrentTimeSeconds();
+	for( int frameIndex = 0; frameIndex < numFrames; frameIndex++ )
+	{
+		UpdateParticlePool( pool, deltaSeconds );
+		refillPool( false );
+	}
+	double poolSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	double framesToMilliseconds = 1000.0 / (double)numFrames;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%i particles, %i frames, update + refill per frame:", numParticles, numFrames ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  pointer per particle  %.3f ms", legacySeconds * framesToMilliseconds ) );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  pool, scalar          %.3f ms", scalarSeconds * framesToMilliseconds ) );
+#if defined( PARTICLE_SYSTEM_USE_SSE2 )
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  pool, SSE2            %.3f ms", poolSeconds * framesToMilliseconds ) );
+#else
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  pool                  %.3f ms", poolSeconds * framesToMilliseconds ) );
+#endif
+}
+
+//------------------------------------------------------------------------
+// one spawn every 5 ms like the player dust, then the cost of spawning in big and small batches
+COMMAND( benchmark_emission, "Check emitters keep their spawn rate at low frame rates and time batched spawning. e.g. benchmark_emission particles=100000", "particles" )
 {
-	Particle* p = new Particle();
-	m_particles.push_back( p );
+	int numParticles = args.GetValue( "particles", 100000 );
+	numParticles < 1 ? numParticles = 1 : true;
+	constexpr float interval = 0.005f;
+	constexpr float seconds = 10.f;
+	Clock* masterClock = Clock::GetMaster();
+	int numMasterChildClocks = masterClock != nullptr ? masterClock->GetNumChildClocks() : 0;
+
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "One spawn every %.3f s for %.0f s, %i expected:", interval, seconds, (int)( seconds / interval + 0.5f ) ) );
+	for( float framesPerSecond : { 144.f, 60.f, 30.f, 10.f } )
+	{
+		ParticleSystem particleSystem;
+		Emitter* emitter = particleSystem.CreateEmitter();
+		emitter->m_interval = interval;
+		int numFrames = (int)( seconds * framesPerSecond + 0.5f );
+		for( int frameIndex = 0; frameIndex < numFrames; frameIndex++ )
+		{
+			particleSystem.Update( 1.f / framesPerSecond );
+		}
+		g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  %3.0f fps  %i spawned, one a frame was %i", framesPerSecond, emitter->GetNumSpawnedParticles(), numFrames ) );
+	}
+
+	// the same number of particles either way, only the batch size changes
+	{
+		ParticleSystem particleSystem;
+		Emitter* emitter = particleSystem.CreateEmitter();
+		emitter->SetCapacity( numParticles, PARTICLE_OVERFLOW_DROP );
+		g_theConsole->PrintString( Rgba8::WHITE, Stringf( "Spawning %i particles:", numParticles ) );
+		for( int batchSize : { 1, 16, numParticles } )
+		{
+			emitter->ClearParticles();
+			double startSeconds = GetCurrentTimeSeconds();
+			for( int numSpawned = 0; numSpawned < numParticles; numSpawned += batchSize )
+			{
+				emitter->Emit( batchSize < numParticles - numSpawned ? batchSize : numParticles - numSpawned );
+			}
+			double spawnSeconds = GetCurrentTimeSeconds() - startSeconds;
+			g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  batches of %-7i %.3f ms, %.1f ns a particle", batchSize, spawnSeconds * 1000.0, spawnSeconds * 1.0e9 / (double)numParticles ) );
+		}
+	}
 
-	return p;
+	// the systems above are gone, the master's next tick mustn't reach their emitter clocks
+	GUARANTEE_OR_DIE( masterClock == nullptr || masterClock->GetNumChildClocks() == numMasterChildClocks, "benchmark_emission left emitter clocks on the master clock" );
 }
@@ -1,22 +1,60 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Renderer/Transform.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include <vector>
 
 class Clock;
+class ParticleSystem;
 
-struct Particle
+enum eParticleOverflowPolicy
 {
-	Transform m_transform;
-	Vec3 m_velocity = Vec3( 1.f, 0.f, 0.f );
-	float m_age = 0.f;
-	float m_maxAge = 1.f;
-	Rgba8 m_color = Rgba8::WHITE;
+	PARTICLE_OVERFLOW_GROW,		// the pool doubles, same as the old unbounded vector
+	PARTICLE_OVERFLOW_DROP,		// spawns past capacity are skipped and counted
+};
+
+//------------------------------------------------------------------------
+// An emitter's live particles as parallel arrays, [0, m_numParticles) are alive.
+// A dead particle gets the last live one copied over it, so the arrays stay packed
+// and the update walks them front to back four at a time.
+// arrays are sized to m_capacity rounded up to 4, the tail slots are scratch
+//------------------------------------------------------------------------
+struct ParticlePool
+{
+	std::vector<float>	m_positionX;
+	std::vector<float>	m_positionY;
+	std::vector<float>	m_positionZ;
+	std::vector<float>	m_velocityX;
+	std::vector<float>	m_velocityY;
+	std::vector<float>	m_velocityZ;
+	std::vector<float>	m_age;
+	std::vector<float>	m_maxAge;
+	std::vector<float>	m_scaleX;
+	std::vector<float>	m_scaleY;
+	std::vector<Rgba8>	m_color;
+	int					m_numParticles = 0;
+	int					m_capacity = 0;
+
+	void	SetCapacity( int capacity );		// keeps the first capacity particles
+	void	CopyParticle( int toIndex, int fromIndex );
+};
+
+// count particles at m_time seconds into the emitter's life, then every m_repeatSeconds
+struct ParticleBurst
+{
+	float	m_time = 0.f;
+	int		m_count = 1;
+	int		m_numCycles = 1;			// 0 repeats forever
+	float	m_repeatSeconds = 0.f;
+	int		m_numCyclesFired = 0;
 };
 
+//------------------------------------------------------------------------
+// Spawns one particle every m_interval seconds, times the rate curve, plus any bursts.
+// Spawns owed within a frame all go out in one pass, each aged and moved for the part of
+// the frame after it was spawned, so the rate doesn't depend on the frame rate
+//------------------------------------------------------------------------
 class Emitter
 {
 	friend class ParticleSystem;
@@ -39,23 +77,50 @@ public:
 	bool m_stopCreatingParticle = false;
 	Vec3 m_spawnOffsetMin = Vec3::ZERO;
 	Vec3 m_spawnOffsetMax = Vec3::ZERO;
+	std::vector<Vec2> m_rateCurve;			// ( emitter seconds, rate multiplier ) keys in time order, linear between; empty is 1
+	float m_rateCurveLoopSeconds = 0.f;		// 0 holds the last key
 
 public:
 	void Render() const;
 
+	void	SetCapacity( int maxParticles, eParticleOverflowPolicy overflowPolicy );
+	int		Emit( int numParticles );		// spawns right away, returns how many fit
+	void	AddBurst( float time, int count, int numCycles = 1, float repeatSeconds = 0.f );
+	void	RestartEmission();				// emitter time back to 0, bursts fire again
+	void	ClearParticles();
+
+	int		GetNumParticles() const			{ return m_pool.m_numParticles; }
+	int		GetCapacity() const				{ return m_pool.m_capacity; }
+	int		GetNumDroppedParticles() const	{ return m_numDroppedParticles; }
+	int		GetNumSpawnedParticles() const	{ return m_numSpawnedParticles; }
+	float	GetRateMultiplier( float emitterSeconds ) const;
+
 private:
 	void Update( float deltaSeconds );
+	void UpdateEmission( float deltaSeconds );
+	int  ReserveParticles( int numParticles );	// grows or drops by the overflow policy, returns how many fit
+	void SpawnParticles( int numParticles, float frameSeconds, float firstSpawnSeconds, float spawnStepSeconds );
+	void SpawnParticle( int particleIndex, const Vec3& spawnPosition, float age );
 
-	Particle* CreateParticle();
-	
 private:
 	ParticleSystem* m_parentSystem = nullptr;
 	Clock* m_clock = nullptr;
-	float m_age = 0.f;
-	std::vector<Particle*> m_particles;
+	float m_age = 0.f;							// emitting seconds, stops while m_stopCreatingParticle
+	float m_spawnAccumulator = 0.f;				// fraction of the next spawn already owed
+	Vec3 m_previousPosition = Vec3::ZERO;		// m_position at the last update, spawns are spread between the two
+	bool m_hasPreviousPosition = false;
+	std::vector<ParticleBurst> m_bursts;
+	int m_numSpawnedParticles = 0;
+
+	ParticlePool m_pool;
+	eParticleOverflowPolicy m_overflowPolicy = PARTICLE_OVERFLOW_GROW;
+	int m_numDroppedParticles = 0;
 
 };
 
+// ages and moves every particle in the pool, then compacts out the dead ones
+void UpdateParticlePool( ParticlePool& pool, float deltaSeconds );
+
 class ParticleSystem
 {
 	friend class Emitter;
@@ -72,4 +137,4 @@ private:
 	std::vector<Emitter*> m_emitters;
 	RandomNumberGenerator m_rng;
 
-};
\ No newline at end of file
+};
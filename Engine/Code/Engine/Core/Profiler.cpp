@@ -0,0 +1,563 @@
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+static constexpr unsigned int PROFILER_RING_CAPACITY = 1 << 16;		// events per thread between two ProfilerEndFrame calls
+static constexpr unsigned int PROFILER_RING_MASK = PROFILER_RING_CAPACITY - 1;
+
+//------------------------------------------------------------------------
+struct ProfileEvent
+{
+	char const* m_name = nullptr;		// nullptr ends the innermost open scope
+	unsigned long long m_ticks = 0;
+};
+
+struct ProfileNode
+{
+	char const* m_name = nullptr;
+	int m_parentIndex = -1;
+	std::vector<int> m_childIndices;
+
+	unsigned long long m_frameTicks = 0;
+	int m_frameCalls = 0;
+
+	// over the frames since the last reset in which this node ran
+	int m_numFrames = 0;
+	int m_numCalls = 0;
+	double m_minSeconds = 0.0;
+	double m_maxSeconds = 0.0;
+	double m_totalSeconds = 0.0;
+};
+
+struct OpenProfileScope
+{
+	int m_nodeIndex = -1;
+	unsigned long long m_beginTicks = 0;
+};
+
+struct CapturedProfileScope
+{
+	char const* m_name = nullptr;
+	int m_threadIndex = 0;
+	unsigned long long m_beginTicks = 0;
+	unsigned long long m_endTicks = 0;
+};
+
+//------------------------------------------------------------------------
+// Single producer (the owning thread), single consumer (ProfilerEndFrame)
+struct ProfilerThreadBuffer
+{
+	ProfileEvent* m_events = nullptr;
+	std::atomic<unsigned int> m_writeIndex;
+	char m_cacheLinePadding[64];
+	std::atomic<unsigned int> m_readIndex;
+	std::atomic<int> m_numDropped;
+
+	// owning thread only
+	int m_numOpenScopes = 0;
+	int m_numSuppressedScopes = 0;
+
+	// main thread only
+	int m_threadIndex = 0;
+	std::string m_threadName;					// written under ProfilerState::m_threadsMutex
+	std::vector<OpenProfileScope> m_openScopes;
+	std::vector<ProfileNode> m_nodes;
+	std::vector<int> m_rootIndices;
+};
+
+struct ProfilerState
+{
+	std::mutex m_threadsMutex;
+	std::vector<ProfilerThreadBuffer*> m_threads;
+
+	int m_numFramesInStats = 0;
+
+	int m_captureFramesRemaining = 0;
+	std::string m_captureFilePath;
+	unsigned long long m_captureStartTicks = 0;
+	std::vector<CapturedProfileScope> m_capturingScopes;
+	std::vector<CapturedProfileScope> m_capturedScopes;		// last finished capture
+	unsigned long long m_capturedStartTicks = 0;
+};
+
+static std::atomic<ProfilerState*> s_profiler( nullptr );
+static thread_local ProfilerThreadBuffer* t_profilerBuffer = nullptr;
+static thread_local ProfilerState* t_profilerBufferOwner = nullptr;
+
+//------------------------------------------------------------------------
+static ProfilerThreadBuffer* GetThreadBuffer()
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		return nullptr;
+	}
+	if( t_profilerBuffer != nullptr && t_profilerBufferOwner == profiler )
+	{
+		return t_profilerBuffer;
+	}
+
+	ProfilerThreadBuffer* buffer = new ProfilerThreadBuffer();
+	buffer->m_events = new ProfileEvent[PROFILER_RING_CAPACITY];
+	buffer->m_writeIndex.store( 0 );
+	buffer->m_readIndex.store( 0 );
+	buffer->m_numDropped.store( 0 );
+	{
+		std::lock_guard<std::mutex> lock( profiler->m_threadsMutex );
+		buffer->m_threadIndex = (int)profiler->m_threads.size();
+		buffer->m_threadName = Stringf( "Thread %i", buffer->m_threadIndex );
+		profiler->m_threads.push_back( buffer );
+	}
+
+	t_profilerBuffer = buffer;
+	t_profilerBufferOwner = profiler;
+	return buffer;
+}
+
+//------------------------------------------------------------------------
+void ProfilerStartup()
+{
+	GUARANTEE_OR_DIE( s_profiler.load() == nullptr, "ProfilerStartup called twice" );
+	s_profiler.store( new ProfilerState() );
+	ProfilerSetThreadName( "Main" );
+}
+
+void ProfilerShutdown()
+{
+	// every thread that records scopes must be done by now (JobSystem shuts down first)
+	ProfilerState* profiler = s_profiler.exchange( nullptr );
+	if( profiler == nullptr )
+	{
+		return;
+	}
+
+	for( ProfilerThreadBuffer* buffer : profiler->m_threads )
+	{
+		delete[] buffer->m_events;
+		delete buffer;
+	}
+	delete profiler;
+}
+
+void ProfilerPushScope( char const* name )
+{
+	ProfilerThreadBuffer* buffer = GetThreadBuffer();
+	if( buffer == nullptr )
+	{
+		return;
+	}
+
+	unsigned int writeIndex = buffer->m_writeIndex.load( std::memory_order_relaxed );
+	unsigned int readIndex = buffer->m_readIndex.load( std::memory_order_acquire );
+	unsigned int numFree = PROFILER_RING_CAPACITY - ( writeIndex - readIndex );
+
+	// a begin is only written with room for its own end and every end still owed,
+	// otherwise the whole subtree is skipped so the tree stays balanced
+	if( buffer->m_numSuppressedScopes > 0 || numFree < (unsigned int)buffer->m_numOpenScopes + 2 )
+	{
+		++buffer->m_numSuppressedScopes;
+		buffer->m_numDropped.fetch_add( 1, std::memory_order_relaxed );
+		return;
+	}
+
+	ProfileEvent& profileEvent = buffer->m_events[writeIndex & PROFILER_RING_MASK];
+	profileEvent.m_name = name;
+	profileEvent.m_ticks = GetCurrentTimeTicks();
+	buffer->m_writeIndex.store( writeIndex + 1, std::memory_order_release );
+	++buffer->m_numOpenScopes;
+}
+
+void ProfilerPopScope()
+{
+	ProfilerThreadBuffer* buffer = GetThreadBuffer();
+	if( buffer == nullptr )
+	{
+		return;
+	}
+	if( buffer->m_numSuppressedScopes > 0 )
+	{
+		--buffer->m_numSuppressedScopes;
+		return;
+	}
+	if( buffer->m_numOpenScopes == 0 )
+	{
+		// opened before the profiler started
+		return;
+	}
+
+	unsigned int writeIndex = buffer->m_writeIndex.load( std::memory_order_relaxed );
+	ProfileEvent& profileEvent = buffer->m_events[writeIndex & PROFILER_RING_MASK];
+	profileEvent.m_name = nullptr;
+	profileEvent.m_ticks = GetCurrentTimeTicks();
+	buffer->m_writeIndex.store( writeIndex + 1, std::memory_order_release );
+	--buffer->m_numOpenScopes;
+}
+
+void ProfilerSetThreadName( std::string const& threadName )
+{
+	ProfilerThreadBuffer* buffer = GetThreadBuffer();
+	if( buffer == nullptr )
+	{
+		return;
+	}
+
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	std::lock_guard<std::mutex> lock( profiler->m_threadsMutex );
+	buffer->m_threadName = threadName;
+}
+
+//------------------------------------------------------------------------
+static int FindOrAddChildNode( ProfilerThreadBuffer* buffer, int parentIndex, char const* name )
+{
+	std::vector<int>& siblingIndices = parentIndex < 0 ? buffer->m_rootIndices : buffer->m_nodes[parentIndex].m_childIndices;
+	for( int nodeIndex : siblingIndices )
+	{
+		// the same literal can live at different addresses in different translation units
+		char const* nodeName = buffer->m_nodes[nodeIndex].m_name;
+		if( nodeName == name || strcmp( nodeName, name ) == 0 )
+		{
+			return nodeIndex;
+		}
+	}
+
+	int nodeIndex = (int)buffer->m_nodes.size();
+	buffer->m_nodes.emplace_back();
+	buffer->m_nodes[nodeIndex].m_name = name;
+	buffer->m_nodes[nodeIndex].m_parentIndex = parentIndex;
+
+	// siblingIndices may point into m_nodes, which emplace_back can move
+	if( parentIndex < 0 )
+	{
+		buffer->m_rootIndices.push_back( nodeIndex );
+	}
+	else
+	{
+		buffer->m_nodes[parentIndex].m_childIndices.push_back( nodeIndex );
+	}
+	return nodeIndex;
+}
+
+static void DrainThreadBuffer( ProfilerState* profiler, ProfilerThreadBuffer* buffer )
+{
+	bool isCapturing = profiler->m_captureFramesRemaining > 0;
+	unsigned int readIndex = buffer->m_readIndex.load( std::memory_order_relaxed );
+	unsigned int writeIndex = buffer->m_writeIndex.load( std::memory_order_acquire );
+	for( ; readIndex != writeIndex; ++readIndex )
+	{
+		ProfileEvent const& profileEvent = buffer->m_events[readIndex & PROFILER_RING_MASK];
+		if( profileEvent.m_name != nullptr )
+		{
+			int parentIndex = buffer->m_openScopes.empty() ? -1 : buffer->m_openScopes.back().m_nodeIndex;
+			OpenProfileScope openScope;
+			openScope.m_nodeIndex = FindOrAddChildNode( buffer, parentIndex, profileEvent.m_name );
+			openScope.m_beginTicks = profileEvent.m_ticks;
+			buffer->m_openScopes.push_back( openScope );
+			continue;
+		}
+
+		if( buffer->m_openScopes.empty() )
+		{
+			continue;
+		}
+
+		OpenProfileScope openScope = buffer->m_openScopes.back();
+		buffer->m_openScopes.pop_back();
+		ProfileNode& node = buffer->m_nodes[openScope.m_nodeIndex];
+		node.m_frameTicks += profileEvent.m_ticks - openScope.m_beginTicks;
+		++node.m_frameCalls;
+
+		if( isCapturing && openScope.m_beginTicks >= profiler->m_captureStartTicks )
+		{
+			CapturedProfileScope capturedScope;
+			capturedScope.m_name = node.m_name;
+			capturedScope.m_threadIndex = buffer->m_threadIndex;
+			capturedScope.m_beginTicks = openScope.m_beginTicks;
+			capturedScope.m_endTicks = profileEvent.m_ticks;
+			profiler->m_capturingScopes.push_back( capturedScope );
+		}
+	}
+	buffer->m_readIndex.store( writeIndex, std::memory_order_release );
+
+	// fold this frame into the running stats
+	double secondsPerTick = GetSecondsPerTimeTick();
+	for( ProfileNode& node : buffer->m_nodes )
+	{
+		if( node.m_frameCalls == 0 )
+		{
+			continue;
+		}
+
+		double frameSeconds = (double)node.m_frameTicks * secondsPerTick;
+		if( node.m_numFrames == 0 || frameSeconds < node.m_minSeconds )
+		{
+			node.m_minSeconds = frameSeconds;
+		}
+		if( node.m_numFrames == 0 || frameSeconds > node.m_maxSeconds )
+		{
+			node.m_maxSeconds = frameSeconds;
+		}
+		node.m_totalSeconds += frameSeconds;
+		node.m_numCalls += node.m_frameCalls;
+		++node.m_numFrames;
+
+		node.m_frameTicks = 0;
+		node.m_frameCalls = 0;
+	}
+}
+
+void ProfilerEndFrame()
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		return;
+	}
+
+	std::vector<ProfilerThreadBuffer*> threads;
+	{
+		std::lock_guard<std::mutex> lock( profiler->m_threadsMutex );
+		threads = profiler->m_threads;
+	}
+
+	for( ProfilerThreadBuffer* buffer : threads )
+	{
+		DrainThreadBuffer( profiler, buffer );
+	}
+	++profiler->m_numFramesInStats;
+
+	if( profiler->m_captureFramesRemaining > 0 && --profiler->m_captureFramesRemaining == 0 )
+	{
+		profiler->m_capturedScopes.swap( profiler->m_capturingScopes );
+		profiler->m_capturingScopes.clear();
+		profiler->m_capturedStartTicks = profiler->m_captureStartTicks;
+
+		ProfilerPrintReport();
+		if( ProfilerExportChromeTrace( profiler->m_captureFilePath ) )
+		{
+			g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Profile trace written to %s, open it in chrome://tracing", profiler->m_captureFilePath.c_str() ) );
+		}
+		else
+		{
+			g_theConsole->PrintString( Rgba8::RED, Stringf( "Could not write profile trace to %s", profiler->m_captureFilePath.c_str() ) );
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+void ProfilerResetStats()
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock( profiler->m_threadsMutex );
+	for( ProfilerThreadBuffer* buffer : profiler->m_threads )
+	{
+		for( ProfileNode& node : buffer->m_nodes )
+		{
+			node.m_numFrames = 0;
+			node.m_numCalls = 0;
+			node.m_minSeconds = 0.0;
+			node.m_maxSeconds = 0.0;
+			node.m_totalSeconds = 0.0;
+		}
+		buffer->m_numDropped.store( 0, std::memory_order_relaxed );
+	}
+	profiler->m_numFramesInStats = 0;
+}
+
+struct ProfileReportLine
+{
+	Rgba8 m_color;
+	std::string m_text;
+};
+
+static void AddReportNodeLines( ProfilerThreadBuffer const* buffer, int nodeIndex, int depth, int numFrames, std::vector<ProfileReportLine>& out_lines )
+{
+	ProfileNode const& node = buffer->m_nodes[nodeIndex];
+	if( node.m_numFrames == 0 )
+	{
+		return;
+	}
+
+	std::string label = std::string( (size_t)depth * 2, ' ' ) + node.m_name;
+	double avgMilliseconds = node.m_totalSeconds * 1000.0 / (double)node.m_numFrames;
+	float callsPerFrame = (float)node.m_numCalls / (float)( numFrames > 0 ? numFrames : 1 );
+	out_lines.push_back( { Rgba8::WHITE, Stringf( "%-40s avg %8.3f  min %8.3f  max %8.3f ms  %6.1f calls/frame",
+		label.c_str(), avgMilliseconds, node.m_minSeconds * 1000.0, node.m_maxSeconds * 1000.0, callsPerFrame ) } );
+
+	for( int childIndex : node.m_childIndices )
+	{
+		AddReportNodeLines( buffer, childIndex, depth + 1, numFrames, out_lines );
+	}
+}
+
+static void GetReportLines( ProfilerState* profiler, std::vector<ProfileReportLine>& out_lines )
+{
+	std::lock_guard<std::mutex> lock( profiler->m_threadsMutex );
+	out_lines.push_back( { Rgba8::YELLOW, Stringf( "Profile over %i frames (inclusive times per frame the scope ran in)", profiler->m_numFramesInStats ) } );
+	for( ProfilerThreadBuffer const* buffer : profiler->m_threads )
+	{
+		if( buffer->m_rootIndices.empty() )
+		{
+			continue;
+		}
+
+		int numDropped = buffer->m_numDropped.load( std::memory_order_relaxed );
+		out_lines.push_back( { Rgba8::YELLOW, numDropped > 0 ? Stringf( "[%s] %i scopes dropped, ring was full", buffer->m_threadName.c_str(), numDropped ) : Stringf( "[%s]", buffer->m_threadName.c_str() ) } );
+		for( int rootIndex : buffer->m_rootIndices )
+		{
+			AddReportNodeLines( buffer, rootIndex, 0, profiler->m_numFramesInStats, out_lines );
+		}
+	}
+}
+
+void ProfilerPrintReport()
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		g_theConsole->PrintString( Rgba8::RED, "Profiler is not running" );
+		return;
+	}
+
+	std::vector<ProfileReportLine> reportLines;
+	GetReportLines( profiler, reportLines );
+	for( ProfileReportLine const& reportLine : reportLines )
+	{
+		g_theConsole->PrintString( reportLine.m_color, reportLine.m_text );
+	}
+}
+
+bool ProfilerWriteReport( std::string const& reportFilePath )
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		return false;
+	}
+
+	std::vector<ProfileReportLine> reportLines;
+	GetReportLines( profiler, reportLines );
+	std::string report;
+	for( ProfileReportLine const& reportLine : reportLines )
+	{
+		report += reportLine.m_text;
+		report += '\n';
+	}
+	return FileWrite( reportFilePath, report );
+}
+
+void ProfilerStartCapture( int numFrames, std::string const& traceFilePath )
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		return;
+	}
+
+	ProfilerResetStats();
+	profiler->m_captureFramesRemaining = numFrames > 0 ? numFrames : 1;
+	profiler->m_captureFilePath = traceFilePath;
+	profiler->m_captureStartTicks = GetCurrentTimeTicks();
+	profiler->m_capturingScopes.clear();
+}
+
+//------------------------------------------------------------------------
+static std::string EscapeJsonString( char const* text )
+{
+	std::string escaped;
+	for( char const* c = text; *c != '\0'; ++c )
+	{
+		if( *c == '"' || *c == '\\' )
+		{
+			escaped += '\\';
+		}
+		escaped += *c;
+	}
+	return escaped;
+}
+
+bool ProfilerExportChromeTrace( std::string const& traceFilePath )
+{
+	ProfilerState* profiler = s_profiler.load( std::memory_order_acquire );
+	if( profiler == nullptr )
+	{
+		return false;
+	}
+
+	double microsecondsPerTick = GetSecondsPerTimeTick() * 1000000.0;
+	std::string json = "{\"traceEvents\":[\n";
+	{
+		std::lock_guard<std::mutex> lock( profiler->m_threadsMutex );
+		for( ProfilerThreadBuffer const* buffer : profiler->m_threads )
+		{
+			json += Stringf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%i,\"args\":{\"name\":\"%s\"}},\n", buffer->m_threadIndex, EscapeJsonString( buffer->m_threadName.c_str() ).c_str() );
+		}
+	}
+
+	for( CapturedProfileScope const& scope : profiler->m_capturedScopes )
+	{
+		double beginMicroseconds = (double)( scope.m_beginTicks - profiler->m_capturedStartTicks ) * microsecondsPerTick;
+		double durationMicroseconds = (double)( scope.m_endTicks - scope.m_beginTicks ) * microsecondsPerTick;
+		json += Stringf( "{\"name\":\"%s\",\"cat\":\"engine\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%i},\n",
+			EscapeJsonString( scope.m_name ).c_str(), beginMicroseconds, durationMicroseconds, scope.m_threadIndex );
+	}
+
+	// drop the trailing comma
+	json.erase( json.size() - 2, 1 );
+	json += "],\"displayTimeUnit\":\"ms\"}\n";
+	return FileWrite( traceFilePath, json );
+}
+
+//------------------------------------------------------------------------
+COMMAND( profile_report, "Print the profiler call tree (avg/min/max ms) since the last reset or capture", "" )
+{
+	UNUSED( args );
+	ProfilerPrintReport();
+}
+
+COMMAND( profile_write, "Write the profiler call tree since the last reset or capture to a file. e.g. profile_write file=Logs/Profile.txt", "file" )
+{
+	std::string filePath = args.GetValue( "file", "" );
+	if( filePath == "" )
+	{
+		filePath = "Logs/Profile.txt";
+	}
+
+	if( ProfilerWriteReport( filePath ) )
+	{
+		g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Profile report written to %s", filePath.c_str() ) );
+	}
+	else
+	{
+		g_theConsole->PrintString( Rgba8::RED, Stringf( "Could not write profile report to %s", filePath.c_str() ) );
+	}
+}
+
+COMMAND( profile_reset, "Clear the profiler stats", "" )
+{
+	UNUSED( args );
+	ProfilerResetStats();
+}
+
+COMMAND( profile_capture, "Profile the next N frames, then print a report and write a Chrome trace. e.g. profile_capture frames=60 file=Data/ProfileCapture.json", "frames,file" )
+{
+	int numFrames = args.GetValue( "frames", 60 );
+	std::string filePath = args.GetValue( "file", "" );
+	if( filePath == "" )
+	{
+		filePath = "Data/ProfileCapture.json";
+	}
+
+	ProfilerStartCapture( numFrames, filePath );
+	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Capturing %i frames", numFrames > 0 ? numFrames : 1 ) );
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+
+//------------------------------------------------------------------------
+// Hierarchical frame profiler. Scopes are recorded into a lock-free ring per thread and folded
+// into a call tree on the main thread in ProfilerEndFrame.
+//
+// names must outlive the profiler, string literals are expected
+//------------------------------------------------------------------------
+void ProfilerStartup();
+void ProfilerShutdown();
+void ProfilerEndFrame();									// main thread, once a frame outside of any scope
+
+void ProfilerPushScope( char const* name );					// any thread
+void ProfilerPopScope();
+void ProfilerSetThreadName( std::string const& threadName );	// any thread, shown in reports and traces
+
+void ProfilerResetStats();
+void ProfilerPrintReport();
+bool ProfilerWriteReport( std::string const& reportFilePath );		// the same report as plain text
+void ProfilerStartCapture( int numFrames, std::string const& traceFilePath );
+bool ProfilerExportChromeTrace( std::string const& traceFilePath );	// events from the last finished capture
+
+//------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+	explicit ProfileScope( char const* name )	{ ProfilerPushScope( name ); }
+	~ProfileScope()								{ ProfilerPopScope(); }
+
+	ProfileScope( ProfileScope const& copyFrom ) = delete;
+};
+
+#define PROFILE_SCOPE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_SCOPE_CONCAT( a, b ) PROFILE_SCOPE_CONCAT_INNER( a, b )
+#define PROFILE_SCOPE( name ) ProfileScope PROFILE_SCOPE_CONCAT( profileScope_, __LINE__ )( name )
@@ -41,25 +41,7 @@ void Rgba8::ScaleAlpha( float alphaMultiplier )
 
 void Rgba8::SetFromText( const char* text )
 {
-	Strings stringList = SplitStringOnDelimiter( text, ',' );
-	if( stringList.size() >= 3 )
-	{
-		float rNum = (float) atof( stringList[0].c_str() );
-		float gNum = (float) atof( stringList[1].c_str() );
-		float bNum = (float) atof( stringList[2].c_str() );
-		r = static_cast<unsigned char>(rNum);
-		g = static_cast<unsigned char>(gNum);
-		b = static_cast<unsigned char>(bNum);
-		if( stringList.size() == 4 )
-		{
-			float aNum = (float)atof( stringList[3].c_str() );
-			a = static_cast<unsigned char>(aNum);
-		}
-		else
-		{
-			a = 255;
-		}
-	}
+	Parse( this, std::string_view( text ) );
 }
 
 bool Rgba8::operator==( const Rgba8& compare ) const
@@ -0,0 +1,64 @@
+#include "Engine/Core/StringID.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <mutex>
+
+//------------------------------------------------------------------------
+struct StringIDTable
+{
+	std::mutex m_mutex;
+	StringIDMap<std::string> m_names;		// node based, so references stay valid as it grows
+};
+
+// function static so COMMAND registrations can intern names during static init
+static StringIDTable& GetStringIDTable()
+{
+	static StringIDTable s_stringIDTable;
+	return s_stringIDTable;
+}
+
+//------------------------------------------------------------------------
+StringID InternStringID( std::string_view text )
+{
+	StringID id = HashStringID( text );
+
+	StringIDTable& table = GetStringIDTable();
+	std::lock_guard<std::mutex> lock( table.m_mutex );
+	auto found = table.m_names.find( id );
+	if( found == table.m_names.end() )
+	{
+		GUARANTEE_OR_DIE( id != INVALID_STRING_ID, Stringf( "\"%.*s\" hashes to the invalid string id", (int)text.size(), text.data() ) );
+		table.m_names.emplace( id, std::string( text ) );
+	}
+	else
+	{
+		GUARANTEE_OR_DIE( found->second == text, Stringf( "\"%.*s\" and \"%s\" hash to the same string id", (int)text.size(), text.data(), found->second.c_str() ) );
+	}
+	return id;
+}
+
+std::string const& GetStringFromID( StringID id )
+{
+	static const std::string s_unknownName;
+
+	StringIDTable& table = GetStringIDTable();
+	std::lock_guard<std::mutex> lock( table.m_mutex );
+	auto found = table.m_names.find( id );
+	return found != table.m_names.end() ? found->second : s_unknownName;
+}
+
+int GetNumInternedStrings()
+{
+	StringIDTable& table = GetStringIDTable();
+	std::lock_guard<std::mutex> lock( table.m_mutex );
+	return (int)table.m_names.size();
+}
+
+//------------------------------------------------------------------------
+COMMAND( string_id, "Print a name's string id and whether it has been interned. e.g. string_id name=Idle", "name" )
+{
+	std::string name = args.GetValue( "name", "" );
+	StringID id = HashStringID( name );
+	bool isInterned = GetStringFromID( id ) == name;
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "\"%s\" = 0x%08x, %s (%i names interned)", name.c_str(), id, isInterned ? "interned" : "never interned", GetNumInternedStrings() ) );
+}
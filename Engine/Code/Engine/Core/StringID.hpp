@@ -0,0 +1,51 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//------------------------------------------------------------------------
+// Names hashed down to 32 bits (FNV-1a) so they compare and key maps as integers.
+// Literals hash at compile time with STRING_ID( "Idle" ); runtime text goes through
+// InternStringID once where the name is defined, and HashStringID wherever it's looked up.
+//------------------------------------------------------------------------
+typedef unsigned int StringID;
+
+constexpr StringID INVALID_STRING_ID = 0;
+
+constexpr StringID HashStringID( const char* text, StringID hash = 2166136261u )
+{
+	return ( *text == '\0' ) ? hash : HashStringID( text + 1, ( hash ^ (StringID)(unsigned char)*text ) * 16777619u );
+}
+
+inline StringID HashStringID( std::string_view text )
+{
+	StringID hash = 2166136261u;
+	for( char c : text )
+	{
+		hash = ( hash ^ (StringID)(unsigned char)c ) * 16777619u;
+	}
+	return hash;
+}
+
+inline StringID HashStringID( const std::string& text ) { return HashStringID( std::string_view( text ) ); }
+
+// forces the hash to be folded at compile time, e.g. m_spriteAnims.at( STRING_ID( "Idle" ) )
+template <StringID ID>
+struct StringIDConstant { static constexpr StringID value = ID; };
+#define STRING_ID( literalText ) ( StringIDConstant<HashStringID( literalText )>::value )
+
+// safe to call from any thread; dies if two different names land on the same id
+StringID			InternStringID( std::string_view text );
+std::string const&	GetStringFromID( StringID id );		// for debug output, "" if the id was never interned
+int					GetNumInternedStrings();
+
+//------------------------------------------------------------------------
+// the id is already a hash, buckets can use it as is
+struct StringIDHasher
+{
+	size_t operator()( StringID id ) const { return (size_t)id; }
+};
+
+template <typename T>
+using StringIDMap = std::unordered_map<StringID, T, StringIDHasher>;
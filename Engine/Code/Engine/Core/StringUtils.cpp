@@ -1,4 +1,5 @@
 #include "Engine/Core/StringUtils.hpp"
+#include <charconv>
 #include <stdarg.h>
 #include <math.h>
 
@@ -51,51 +52,92 @@ const std::string Stringv( char const* format, va_list args )
 Strings SplitStringOnDelimiter( const std::string& originalString, char delimiterToSplitOn )
 {
 	Strings stringList;
-	std::string str = "";
-	for( int textIndex = 0;textIndex < originalString.size(); textIndex++ )
+	SplitStringOnDelimiter( stringList, originalString, delimiterToSplitOn, true );
+	return stringList;
+}
+
+Strings SplitStringOnDelimiterWithoutEmpty( const std::string& originalString, char delimiterToSplitOn )
+{
+	Strings stringList;
+	SplitStringOnDelimiter( stringList, originalString, delimiterToSplitOn, false );
+	return stringList;
+}
+
+template <typename STRING_ALLOCATOR>
+void SplitStringOnDelimiter( std::vector<std::string, STRING_ALLOCATOR>& out_splitStrings, const std::string& originalString, char delimiterToSplitOn, bool keepEmpty )
+{
+	size_t startIndex = 0;
+	size_t delimiterIndex = 0;
+	do
 	{
-		const char& text = originalString[textIndex];
-		if ( text == delimiterToSplitOn )
+		delimiterIndex = originalString.find( delimiterToSplitOn, startIndex );
+		size_t endIndex = delimiterIndex == std::string::npos ? originalString.size() : delimiterIndex;
+		if( keepEmpty || endIndex > startIndex )
 		{
-			stringList.push_back( str );
-			str = "";
+			out_splitStrings.emplace_back( originalString, startIndex, endIndex - startIndex );
 		}
-		else
-		{
-			str = Stringf( "%s%c", str.c_str(), text );
-		}
-	}
-	stringList.push_back( str );
+		startIndex = delimiterIndex + 1;
+	} while( delimiterIndex != std::string::npos );
+}
 
-	return stringList;
+template void SplitStringOnDelimiter( Strings& out_splitStrings, const std::string& originalString, char delimiterToSplitOn, bool keepEmpty );
+template void SplitStringOnDelimiter( FrameStrings& out_splitStrings, const std::string& originalString, char delimiterToSplitOn, bool keepEmpty );
+
+//-----------------------------------------------------------------------------------------------
+StringViewSplitter::Iterator::Iterator( StringViewSplitter const* splitter )
+	:m_splitter( splitter )
+{
+	ReadPiece( 0 );
 }
 
-Strings SplitStringOnDelimiterWithoutEmpty( const std::string& originalString, char delimiterToSplitOn )
+StringViewSplitter::Iterator& StringViewSplitter::Iterator::operator++()
 {
-	Strings stringList;
-	std::string str = "";
-	for( int textIndex = 0; textIndex < originalString.size(); textIndex++ )
+	if( m_isLastPiece )
+	{
+		m_splitter = nullptr;
+	}
+	else
+	{
+		ReadPiece( (size_t)( m_piece.data() - m_splitter->m_text.data() ) + m_piece.size() + 1 );
+	}
+	return *this;
+}
+
+void StringViewSplitter::Iterator::ReadPiece( size_t pieceStart )
+{
+	std::string_view text = m_splitter->m_text;
+	while( true )
 	{
-		const char& text = originalString[textIndex];
-		if( text == delimiterToSplitOn )
+		size_t delimiterIndex = text.find( m_splitter->m_delimiter, pieceStart );
+		size_t pieceEnd = delimiterIndex == std::string_view::npos ? text.size() : delimiterIndex;
+		m_piece = text.substr( pieceStart, pieceEnd - pieceStart );
+		m_isLastPiece = delimiterIndex == std::string_view::npos;
+		if( m_splitter->m_keepEmpty || !m_piece.empty() )
 		{
-			if ( "" != str )
-			{
-				stringList.push_back( str );
-				str = "";
-			}
+			return;
 		}
-		else
+		if( m_isLastPiece )
 		{
-			str = Stringf( "%s%c", str.c_str(), text );
+			m_splitter = nullptr;
+			return;
 		}
+		pieceStart = pieceEnd + 1;
 	}
-	if( "" != str )
+}
+
+std::string_view TrimStringView( std::string_view text )
+{
+	size_t begin = 0;
+	size_t end = text.size();
+	while( begin < end && IsWhitespace( text[begin] ) )
 	{
-		stringList.push_back( str );
+		begin++;
 	}
-
-	return stringList;
+	while( end > begin && IsWhitespace( text[end - 1] ) )
+	{
+		end--;
+	}
+	return text.substr( begin, end - begin );
 }
 
 int GetIntFromString( char const* str, int defualt )
@@ -139,28 +181,12 @@ void ToUpper( char* buffer )
 
 char const* Parse( float* out, char const* str )
 {
-	try
-	{
-		*out = std::stof( str );
-		return str;
-	}
-	catch (...)
-	{
-		return nullptr;
-	}
+	return Parse( out, std::string_view( str ) ) ? str : nullptr;
 }
 
 char const* Parse( int* out, char const* str )
 {
-	try
-	{
-		*out = std::stoi( str );
-		return str;
-	}
-	catch( ... )
-	{
-		return nullptr;
-	}
+	return Parse( out, std::string_view( str ) ) ? str : nullptr;
 }
 
 char const* Parse( char* out, char const* str )
@@ -177,65 +203,17 @@ char const* Parse( std::string* out, char const* str )
 
 char const* Parse( Rgba8* out, char const* str )
 {
-	Strings stringList = SplitStringOnDelimiter( str, ',' );
-	if( stringList.size() >= 3 )
-	{
-		int rNum = 255;
-		int gNum = 255;
-		int bNum = 255;
-		int aNum = 255;
-		Parse( &rNum, stringList[0].c_str() );
-		Parse( &gNum, stringList[1].c_str() );
-		Parse( &bNum, stringList[2].c_str() );
-		if( stringList.size() == 4 )
-		{
-			Parse( &aNum, stringList[3].c_str() );
-		}
-
-		out->r = (unsigned char)rNum;
-		out->g = (unsigned char)gNum;
-		out->b = (unsigned char)bNum;
-		out->a = (unsigned char)aNum;
-		return str;
-	}
-	return nullptr;
+	return Parse( out, std::string_view( str ) ) ? str : nullptr;
 }
 
 char const* Parse( Vec3* out, char const* str )
 {
-	Strings stringList = SplitStringOnDelimiter( str, ',' );
-	if( stringList.size() == 3 )
-	{
-		float xNum = 0.f;
-		float yNum = 0.f;
-		float zNum = 0.f;
-		Parse( &xNum, stringList[0].c_str() );
-		Parse( &yNum, stringList[1].c_str() );
-		Parse( &zNum, stringList[2].c_str() );
-
-		out->x = xNum;
-		out->y = yNum;
-		out->z = zNum;
-		return str;
-	}
-	return nullptr;
+	return Parse( out, std::string_view( str ) ) ? str : nullptr;
 }
 
 char const* Parse( IntVec2* out, char const* str )
 {
-	Strings stringList = SplitStringOnDelimiter( str, ',' );
-	if( stringList.size() == 2 )
-	{
-		int xNum = 0;
-		int yNum = 0;
-		Parse( &xNum, stringList[0].c_str() );
-		Parse( &yNum, stringList[1].c_str() );
-
-		out->x = xNum;
-		out->y = yNum;
-		return str;
-	}
-	return nullptr;
+	return Parse( out, std::string_view( str ) ) ? str : nullptr;
 }
 
 char const* Parse( bool* out, char const* str )
@@ -257,19 +235,106 @@ char const* Parse( bool* out, char const* str )
 
 char const* Parse( Vec2* out, char const* str )
 {
-	Strings stringList = SplitStringOnDelimiter( str, ',' );
-	if( stringList.size() == 2 )
+	return Parse( out, std::string_view( str ) ) ? str : nullptr;
+}
+
+//-----------------------------------------------------------------------------------------------
+// from_chars wants the number first, so skip the whitespace and a '+' it won't take
+static std::string_view GetNumberText( std::string_view text )
+{
+	text = TrimStringView( text );
+	if( !text.empty() && text[0] == '+' )
 	{
-		float xNum = 0.f;
-		float yNum = 0.f;
-		Parse( &xNum, stringList[0].c_str() );
-		Parse( &yNum, stringList[1].c_str() );
+		text.remove_prefix( 1 );
+	}
+	return text;
+}
 
-		out->x = xNum;
-		out->y = yNum;
-		return str;
+bool Parse( float* out, std::string_view text )
+{
+	text = GetNumberText( text );
+	float value = 0.f;
+	std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), value );
+	if( result.ec != std::errc() )
+	{
+		return false;
 	}
-	return nullptr;
+	*out = value;
+	return true;
+}
+
+bool Parse( int* out, std::string_view text )
+{
+	text = GetNumberText( text );
+	int value = 0;
+	std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), value );
+	if( result.ec != std::errc() )
+	{
+		return false;
+	}
+	*out = value;
+	return true;
+}
+
+// comma separated numbers into out_values, how many there were or -1 if one didn't parse or there were too many
+template <typename T>
+static int ParseCommaSeparated( T* out_values, int maxValues, std::string_view text )
+{
+	int numValues = 0;
+	for( std::string_view piece : SplitStringView( text, ',' ) )
+	{
+		if( numValues >= maxValues || !Parse( &out_values[numValues], piece ) )
+		{
+			return -1;
+		}
+		numValues++;
+	}
+	return numValues;
+}
+
+bool Parse( Vec2* out, std::string_view text )
+{
+	float values[2] = { 0.f, 0.f };
+	if( ParseCommaSeparated( values, 2, text ) != 2 )
+	{
+		return false;
+	}
+	*out = Vec2( values[0], values[1] );
+	return true;
+}
+
+bool Parse( Vec3* out, std::string_view text )
+{
+	float values[3] = { 0.f, 0.f, 0.f };
+	if( ParseCommaSeparated( values, 3, text ) != 3 )
+	{
+		return false;
+	}
+	*out = Vec3( values[0], values[1], values[2] );
+	return true;
+}
+
+bool Parse( IntVec2* out, std::string_view text )
+{
+	int values[2] = { 0, 0 };
+	if( ParseCommaSeparated( values, 2, text ) != 2 )
+	{
+		return false;
+	}
+	*out = IntVec2( values[0], values[1] );
+	return true;
+}
+
+bool Parse( Rgba8* out, std::string_view text )
+{
+	int values[4] = { 255, 255, 255, 255 };
+	int numValues = ParseCommaSeparated( values, 4, text );
+	if( numValues != 3 && numValues != 4 )
+	{
+		return false;
+	}
+	*out = Rgba8( (unsigned char)values[0], (unsigned char)values[1], (unsigned char)values[2], (unsigned char)values[3] );
+	return true;
 }
 
 std::string ToString( const float& val )
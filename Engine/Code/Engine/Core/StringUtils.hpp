@@ -3,7 +3,9 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/FrameAllocator.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 
 #define UNUSED(x) (void)(x);
@@ -19,6 +21,52 @@ const std::string Stringv( char const* format, va_list args );
 Strings SplitStringOnDelimiter( const std::string& originalString, char delimiterToSplitOn );
 Strings SplitStringOnDelimiterWithoutEmpty( const std::string& originalString, char delimiterToSplitOn );
 
+// appends to out_splitStrings, instantiated for Strings and FrameStrings
+template <typename STRING_ALLOCATOR>
+void SplitStringOnDelimiter( std::vector<std::string, STRING_ALLOCATOR>& out_splitStrings, const std::string& originalString, char delimiterToSplitOn, bool keepEmpty = true );
+
+//-----------------------------------------------------------------------------------------------
+// Walks the pieces between delimiters as views into text, nothing is copied or allocated.
+//	for( std::string_view piece : SplitStringView( "1,2,3", ',' ) )
+// Gives the same pieces as SplitStringOnDelimiter; text has to outlive the loop.
+//-----------------------------------------------------------------------------------------------
+class StringViewSplitter
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator() {}
+		explicit Iterator( StringViewSplitter const* splitter );
+
+		std::string_view	operator*() const							{ return m_piece; }
+		Iterator&			operator++();
+		bool				operator!=( Iterator const& other ) const	{ return m_splitter != other.m_splitter; }
+
+	private:
+		void ReadPiece( size_t pieceStart );
+
+	private:
+		StringViewSplitter const*	m_splitter = nullptr;		// nullptr once past the last piece
+		std::string_view			m_piece;
+		bool						m_isLastPiece = false;
+	};
+
+public:
+	StringViewSplitter( std::string_view text, char delimiter, bool keepEmpty ) : m_text( text ), m_delimiter( delimiter ), m_keepEmpty( keepEmpty ) {}
+
+	Iterator	begin() const	{ return Iterator( this ); }
+	Iterator	end() const		{ return Iterator(); }
+
+private:
+	std::string_view	m_text;
+	char				m_delimiter = ',';
+	bool				m_keepEmpty = true;
+};
+
+inline StringViewSplitter SplitStringView( std::string_view text, char delimiterToSplitOn, bool keepEmpty = true ) { return StringViewSplitter( text, delimiterToSplitOn, keepEmpty ); }
+std::string_view TrimStringView( std::string_view text );		// drops leading and trailing whitespace
+
 //-----------------------------------------------------------------------------------------------
 //                                          Char Utils
 //-----------------------------------------------------------------------------------------------
@@ -106,6 +154,15 @@ char const* Parse( IntVec2* out, char const* str );
 template <typename T>
 inline char const* Parse( T* out, char const* str ) { return nullptr; }
 
+// std::from_chars underneath, so no allocation, locale or exceptions. Whitespace around each number and a
+// leading '+' are fine, anything after a number is ignored like atof did. On false out is left alone.
+bool Parse( float* out, std::string_view text );
+bool Parse( int* out, std::string_view text );
+bool Parse( Vec2* out, std::string_view text );			// "x,y"
+bool Parse( Vec3* out, std::string_view text );			// "x,y,z"
+bool Parse( IntVec2* out, std::string_view text );		// "x,y"
+bool Parse( Rgba8* out, std::string_view text );		// "r,g,b" or "r,g,b,a"
+
 template <typename T>
 T StringConvert( char const* str, T const& defValue )
 {
@@ -32,3 +32,19 @@ double GetCurrentTimeSeconds()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+unsigned long long GetCurrentTimeTicks()
+{
+	LARGE_INTEGER currentCount;
+	QueryPerformanceCounter( &currentCount );
+	return static_cast< unsigned long long >( currentCount.QuadPart );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+double GetSecondsPerTimeTick()
+{
+	static LARGE_INTEGER initialTime;
+	static double secondsPerCount = InitializeTime( initialTime );
+	return secondsPerCount;
+}
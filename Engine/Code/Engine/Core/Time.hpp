@@ -6,4 +6,6 @@
 
 //-----------------------------------------------------------------------------------------------
 double GetCurrentTimeSeconds();
+unsigned long long GetCurrentTimeTicks();		// raw performance counter, cheap enough for per-scope profiling
+double GetSecondsPerTimeTick();
 
@@ -1,5 +1,6 @@
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Core/Clock.hpp"
+#include <math.h>
 
 Timer::Timer()
 {
@@ -12,13 +13,19 @@ Timer::Timer( Clock* clock )
 
 Timer::~Timer()
 {
+	// an invalid handle also covers the clock having been destroyed first
+	if( m_handle.IsValid() )
+	{
+		m_clock->GetTimerWheel()->ReleaseEntry( m_handle );
+	}
 }
 
 void Timer::SetSeconds( Clock* clock, double timeToWait )
 {
-	m_clock = clock;
+	SetClock( clock );
 	m_startSeconds = clock->GetTotalTime();
 	m_durationSeconds = timeToWait;
+	Schedule();
 }
 
 void Timer::SetSeconds( double timeToWait )
@@ -29,16 +36,19 @@ void Timer::SetSeconds( double timeToWait )
 	}
 	m_startSeconds = m_clock->GetTotalTime();
 	m_durationSeconds = timeToWait;
+	Schedule();
 }
 
 void Timer::Reset()
 {
 	m_startSeconds = m_clock->GetTotalTime();
+	Schedule();
 }
 
 void Timer::Stop()
 {
 	m_durationSeconds = -1.0;
+	Schedule();
 }
 
 double Timer::GetElapsedSeconds() const
@@ -61,18 +71,13 @@ double Timer::GetSecondsRemaining() const
 	return currentTime - m_startSeconds;
 }
 
-bool Timer::HasElapsed() const
-{
-	double currentTime = m_clock->GetTotalTime();
-	return (currentTime > (m_startSeconds + m_durationSeconds));
-}
-
 bool Timer::CheckAndDecrement()
 {
 	if( HasElapsed() )
 	{
 		// remove an interval of time
 		m_startSeconds += m_durationSeconds;
+		Schedule();
 		return true;
 	}
 	else
@@ -81,12 +86,40 @@ bool Timer::CheckAndDecrement()
 	}
 }
 
+int Timer::CheckAndDecrementAll()
+{
+	if( !HasElapsed() || m_durationSeconds < 0.0 )
+	{
+		return 0;
+	}
+	if( m_durationSeconds == 0.0 )
+	{
+		Reset();
+		return 1;
+	}
+
+	// skip straight past every whole interval instead of one wheel reschedule per interval
+	double currentTime = m_clock->GetTotalTime();
+	int numIntervals = (int)ceil( ( currentTime - m_startSeconds ) / m_durationSeconds ) - 1;
+	numIntervals = numIntervals < 1 ? 1 : numIntervals;
+	m_startSeconds += m_durationSeconds * (double)numIntervals;
+	Schedule();
+	while( HasElapsed() )
+	{
+		m_startSeconds += m_durationSeconds;
+		Schedule();
+		numIntervals++;
+	}
+	return numIntervals;
+}
+
 bool Timer::CheckAndReset()
 {
 	if( HasElapsed() )
 	{
 		// remove an interval of time
 		m_startSeconds = m_clock->GetTotalTime();
+		Schedule();
 		return true;
 	}
 	else
@@ -99,3 +132,44 @@ bool Timer::IsRunning() const
 {
 	return !HasElapsed();
 }
+
+void Timer::SetClock( Clock* clock )
+{
+	if( clock == m_clock )
+	{
+		return;
+	}
+	if( m_handle.IsValid() )
+	{
+		m_clock->GetTimerWheel()->ReleaseEntry( m_handle );
+		m_handle = TimerHandle();
+	}
+	m_clock = clock;
+}
+
+void Timer::Schedule()
+{
+	// Stop() on a timer that was never given a clock, there's no wheel to tell
+	if( m_clock == nullptr )
+	{
+		m_hasElapsed = true;
+		return;
+	}
+
+	TimerWheel* wheel = m_clock->GetTimerWheel();
+	if( !m_handle.IsValid() )
+	{
+		m_handle = wheel->AcquireTimerEntry( this );
+	}
+
+	if( m_durationSeconds < 0.0 )
+	{
+		wheel->UnscheduleEntry( m_handle.m_index );
+		m_hasElapsed = true;
+		return;
+	}
+
+	// the wheel sets it straight back if the deadline has already passed
+	m_hasElapsed = false;
+	wheel->ScheduleTimerEntry( m_handle, m_startSeconds + m_durationSeconds );
+}
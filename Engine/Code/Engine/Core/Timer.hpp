@@ -1,13 +1,25 @@
 #pragma once
+#include "Engine/Core/TimerWheel.hpp"
 
 class Clock;
 
+//------------------------------------------------------------------------
+// Lightweight handle onto its clock's TimerWheel. The wheel flips the elapsed flag when the
+// clock passes the deadline, so HasElapsed and the Check* calls never touch the clock.
+// Timers register their own address with the wheel, so they cannot be copied.
+//------------------------------------------------------------------------
 class Timer
 {
+	friend class TimerWheel;
+
 public:
 	Timer();
 	Timer( Clock* clock );
 	~Timer();
+
+	Timer( Timer const& copyFrom ) = delete;
+	Timer& operator=( Timer const& copyFrom ) = delete;
+
 	void SetSeconds( Clock* clock, double timeToWait );    // sets and resets timer, and clock
 	void SetSeconds( double timeToWait );                  // keeps current clock, or sets to Master if no clock has been set yet
 
@@ -18,19 +30,22 @@ public:
 	double GetElapsedSeconds() const;               // return amount of time accrued on this timer
 	double GetSecondsRemaining() const;             // returns amount of time until HasElapsed() will return true (0 or negative numbers means it has already elapsed)
 
-	bool HasElapsed() const;                        // timer has elapsed the timer
+	bool HasElapsed() const { return m_hasElapsed; }	// timer has elapsed the timer
 	bool CheckAndDecrement();                       // if has elapsed, removes one interval of time and returns true, otherwise returns false
 	int  CheckAndDecrementAll();                    // returns how many intervals have passed and removes them  
 	bool CheckAndReset();                           // if has elapsed, resets and returns true, otherwise returns false; 
 
 	bool IsRunning() const;                         // timer is accruing time
 
+private:
+	void SetClock( Clock* clock );
+	void Schedule();                                // (re)arms the wheel for m_startSeconds + m_durationSeconds
 
 private:
 	Clock* m_clock = nullptr; // clock timer is based off of
+	TimerHandle m_handle;     // entry in m_clock's wheel
 
-	int m_interval = 0;
 	double m_startSeconds    =  0.0;
 	double m_durationSeconds = -1.0;    // negative means stopped
-
-};
\ No newline at end of file
+	bool m_hasElapsed = true;           // set by the wheel
+};
@@ -0,0 +1,490 @@
+#include "Engine/Core/TimerWheel.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/Timer.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+//------------------------------------------------------------------------
+static int CountTrailingZeros( unsigned long long bits )
+{
+#if defined( _MSC_VER )
+	unsigned long index = 0;
+	_BitScanForward64( &index, bits );
+	return (int)index;
+#else
+	return __builtin_ctzll( bits );
+#endif
+}
+
+//------------------------------------------------------------------------
+TimerWheel::TimerWheel( double currentSeconds )
+{
+	for( int listIndex = 0; listIndex < NUM_LISTS; listIndex++ )
+	{
+		m_listHeads[listIndex] = -1;
+	}
+	for( int wordIndex = 0; wordIndex < OCCUPIED_WORDS; wordIndex++ )
+	{
+		m_occupiedSlots[wordIndex] = 0;
+	}
+	m_currentSeconds = currentSeconds;
+	m_currentTick = SecondsToTick( currentSeconds );
+}
+
+TimerWheel::~TimerWheel()
+{
+	// Timers that outlive their clock must not reach back into a dead wheel
+	for( Entry& entry : m_entries )
+	{
+		if( entry.m_isInUse && entry.m_owner != nullptr )
+		{
+			entry.m_owner->m_handle = TimerHandle();
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+TimerHandle TimerWheel::ScheduleCallback( double delaySeconds, TimerCallback&& callback )
+{
+	int entryIndex = AllocateEntry();
+	Entry& entry = m_entries[entryIndex];
+	entry.m_callback = std::move( callback );
+	entry.m_expireSeconds = m_currentSeconds + delaySeconds;
+
+	TimerHandle handle;
+	handle.m_index = entryIndex;
+	handle.m_generation = entry.m_generation;
+	Link( entryIndex );
+	return handle;
+}
+
+bool TimerWheel::Cancel( TimerHandle handle )
+{
+	Entry* entry = GetEntry( handle );
+	if( entry == nullptr || entry->m_owner != nullptr )
+	{
+		return false;
+	}
+	ReleaseEntry( handle );
+	return true;
+}
+
+bool TimerWheel::IsScheduled( TimerHandle handle ) const
+{
+	Entry const* entry = GetEntry( handle );
+	return entry != nullptr && entry->m_list != LIST_NONE;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::AdvanceTo( double currentSeconds )
+{
+	if( currentSeconds < m_currentSeconds )
+	{
+		Rebase( currentSeconds );
+		RunPendingCallbacks();
+		return;
+	}
+
+	m_currentSeconds = currentSeconds;
+	unsigned long long targetTick = SecondsToTick( currentSeconds );
+
+	// the current tick was only partly used up last time, so some of it may be due now
+	RelinkList( (int)( m_currentTick & SLOT_MASK ) );
+
+	while( m_currentTick < targetTick )
+	{
+		unsigned long long blockLastTick = m_currentTick | (unsigned long long)SLOT_MASK;
+		unsigned long long lastTick = targetTick < blockLastTick ? targetTick : blockLastTick;
+		int slot = FindOccupiedSlot( (int)( m_currentTick & SLOT_MASK ) + 1, (int)( lastTick & SLOT_MASK ) );
+		if( slot >= 0 )
+		{
+			m_currentTick = ( m_currentTick & ~(unsigned long long)SLOT_MASK ) | (unsigned long long)slot;
+			RelinkList( slot );
+			continue;
+		}
+
+		// nothing left in this stretch of level 0, jump to its end and pull the next one down
+		m_currentTick = lastTick;
+		if( m_currentTick < targetTick )
+		{
+			m_currentTick++;
+			Cascade();
+			RelinkList( 0 );
+		}
+	}
+
+	RunPendingCallbacks();
+}
+
+//------------------------------------------------------------------------
+TimerHandle TimerWheel::AcquireTimerEntry( Timer* owner )
+{
+	int entryIndex = AllocateEntry();
+	m_entries[entryIndex].m_owner = owner;
+
+	TimerHandle handle;
+	handle.m_index = entryIndex;
+	handle.m_generation = m_entries[entryIndex].m_generation;
+	return handle;
+}
+
+void TimerWheel::ReleaseEntry( TimerHandle handle )
+{
+	Entry* entry = GetEntry( handle );
+	if( entry == nullptr )
+	{
+		return;
+	}
+
+	UnscheduleEntry( handle.m_index );
+	entry->m_callback.Reset();
+	entry->m_owner = nullptr;
+	entry->m_list = LIST_NONE;
+	entry->m_isInUse = false;
+	entry->m_generation++;
+	entry->m_next = m_freeList;
+	m_freeList = handle.m_index;
+}
+
+void TimerWheel::ScheduleTimerEntry( TimerHandle handle, double expireSeconds )
+{
+	Entry* entry = GetEntry( handle );
+	GUARANTEE_OR_DIE( entry != nullptr, "Scheduling a timer entry that does not belong to this wheel" );
+
+	UnscheduleEntry( handle.m_index );
+	entry->m_expireSeconds = expireSeconds;
+	Link( handle.m_index );
+}
+
+void TimerWheel::UnscheduleEntry( int entryIndex )
+{
+	if( m_entries[entryIndex].m_list >= 0 )
+	{
+		Unlink( entryIndex );
+	}
+}
+
+//------------------------------------------------------------------------
+TimerWheel::Entry* TimerWheel::GetEntry( TimerHandle handle )
+{
+	if( handle.m_index < 0 || handle.m_index >= (int)m_entries.size() )
+	{
+		return nullptr;
+	}
+	Entry& entry = m_entries[handle.m_index];
+	return ( entry.m_isInUse && entry.m_generation == handle.m_generation ) ? &entry : nullptr;
+}
+
+TimerWheel::Entry const* TimerWheel::GetEntry( TimerHandle handle ) const
+{
+	return const_cast<TimerWheel*>( this )->GetEntry( handle );
+}
+
+int TimerWheel::AllocateEntry()
+{
+	int entryIndex = m_freeList;
+	if( entryIndex >= 0 )
+	{
+		m_freeList = m_entries[entryIndex].m_next;
+	}
+	else
+	{
+		entryIndex = (int)m_entries.size();
+		m_entries.emplace_back();
+	}
+
+	Entry& entry = m_entries[entryIndex];
+	entry.m_isInUse = true;
+	entry.m_list = LIST_NONE;
+	entry.m_prev = -1;
+	entry.m_next = -1;
+	return entryIndex;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::Link( int entryIndex )
+{
+	Entry& entry = m_entries[entryIndex];
+	if( entry.m_expireSeconds < m_currentSeconds )
+	{
+		Fire( entryIndex );
+		return;
+	}
+
+	unsigned long long tick = SecondsToTick( entry.m_expireSeconds );
+	tick = tick < m_currentTick ? m_currentTick : tick;
+	entry.m_expireTick = tick;
+
+	// the level is the first one where the expiry and now share all higher bits
+	unsigned long long differentBits = tick ^ m_currentTick;
+	int listIndex = LIST_FAR;
+	for( int level = 0; level < TIMER_WHEEL_LEVELS; level++ )
+	{
+		if( differentBits < ( 1ULL << ( TIMER_WHEEL_SLOT_BITS * ( level + 1 ) ) ) )
+		{
+			listIndex = level * TIMER_WHEEL_SLOTS + (int)( ( tick >> ( TIMER_WHEEL_SLOT_BITS * level ) ) & SLOT_MASK );
+			break;
+		}
+	}
+
+	int& head = m_listHeads[listIndex];
+	entry.m_prev = -1;
+	entry.m_next = head;
+	if( head >= 0 )
+	{
+		m_entries[head].m_prev = entryIndex;
+	}
+	head = entryIndex;
+	entry.m_list = listIndex;
+	m_numScheduled++;
+
+	if( listIndex < TIMER_WHEEL_SLOTS )
+	{
+		m_occupiedSlots[listIndex >> 6] |= 1ULL << ( listIndex & 63 );
+	}
+}
+
+void TimerWheel::Unlink( int entryIndex )
+{
+	Entry& entry = m_entries[entryIndex];
+	if( entry.m_prev >= 0 )
+	{
+		m_entries[entry.m_prev].m_next = entry.m_next;
+	}
+	else
+	{
+		m_listHeads[entry.m_list] = entry.m_next;
+		if( entry.m_next < 0 && entry.m_list < TIMER_WHEEL_SLOTS )
+		{
+			m_occupiedSlots[entry.m_list >> 6] &= ~( 1ULL << ( entry.m_list & 63 ) );
+		}
+	}
+	if( entry.m_next >= 0 )
+	{
+		m_entries[entry.m_next].m_prev = entry.m_prev;
+	}
+
+	entry.m_prev = -1;
+	entry.m_next = -1;
+	entry.m_list = LIST_NONE;
+	m_numScheduled--;
+}
+
+void TimerWheel::Fire( int entryIndex )
+{
+	Entry& entry = m_entries[entryIndex];
+	if( entry.m_owner != nullptr )
+	{
+		entry.m_list = LIST_NONE;
+		entry.m_owner->m_hasElapsed = true;
+		return;
+	}
+
+	TimerHandle handle;
+	handle.m_index = entryIndex;
+	handle.m_generation = entry.m_generation;
+	entry.m_list = LIST_PENDING_CALLBACK;
+	m_pendingCallbacks.push_back( handle );
+}
+
+int TimerWheel::DetachList( int listIndex )
+{
+	int head = m_listHeads[listIndex];
+	m_listHeads[listIndex] = -1;
+	if( listIndex < TIMER_WHEEL_SLOTS )
+	{
+		m_occupiedSlots[listIndex >> 6] &= ~( 1ULL << ( listIndex & 63 ) );
+	}
+	return head;
+}
+
+void TimerWheel::RelinkChain( int entryIndex )
+{
+	while( entryIndex >= 0 )
+	{
+		Entry& entry = m_entries[entryIndex];
+		int nextIndex = entry.m_next;
+		entry.m_list = LIST_NONE;
+		m_numScheduled--;
+		Link( entryIndex );
+		entryIndex = nextIndex;
+	}
+}
+
+void TimerWheel::RelinkList( int listIndex )
+{
+	if( m_listHeads[listIndex] >= 0 )
+	{
+		RelinkChain( DetachList( listIndex ) );
+	}
+}
+
+//------------------------------------------------------------------------
+// Called as level 0 wraps. Every level whose slot index wrapped with it empties its
+// new slot into the levels below, highest first so entries can drop more than one level.
+//------------------------------------------------------------------------
+void TimerWheel::Cascade()
+{
+	int numLevels = 1;
+	while( numLevels < TIMER_WHEEL_LEVELS && ( ( m_currentTick >> ( TIMER_WHEEL_SLOT_BITS * numLevels ) ) & SLOT_MASK ) == 0 )
+	{
+		numLevels++;
+	}
+
+	if( numLevels == TIMER_WHEEL_LEVELS )
+	{
+		RelinkList( LIST_FAR );
+	}
+	int topLevel = numLevels < TIMER_WHEEL_LEVELS ? numLevels : TIMER_WHEEL_LEVELS - 1;
+	for( int level = topLevel; level >= 1; level-- )
+	{
+		int slot = (int)( ( m_currentTick >> ( TIMER_WHEEL_SLOT_BITS * level ) ) & SLOT_MASK );
+		RelinkList( level * TIMER_WHEEL_SLOTS + slot );
+	}
+}
+
+int TimerWheel::FindOccupiedSlot( int fromSlot, int toSlot ) const
+{
+	int slot = fromSlot;
+	while( slot <= toSlot )
+	{
+		int wordIndex = slot >> 6;
+		unsigned long long bits = m_occupiedSlots[wordIndex] >> ( slot & 63 );
+		if( bits != 0 )
+		{
+			int foundSlot = slot + CountTrailingZeros( bits );
+			return foundSlot <= toSlot ? foundSlot : -1;
+		}
+		slot = ( wordIndex + 1 ) << 6;
+	}
+	return -1;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::Rebase( double currentSeconds )
+{
+	// gather every scheduled entry into one chain before refiling against the new time
+	int chainHead = -1;
+	for( int listIndex = 0; listIndex < NUM_LISTS; listIndex++ )
+	{
+		int entryIndex = m_listHeads[listIndex] >= 0 ? DetachList( listIndex ) : -1;
+		while( entryIndex >= 0 )
+		{
+			int nextIndex = m_entries[entryIndex].m_next;
+			m_entries[entryIndex].m_next = chainHead;
+			chainHead = entryIndex;
+			entryIndex = nextIndex;
+		}
+	}
+
+	m_currentSeconds = currentSeconds;
+	m_currentTick = SecondsToTick( currentSeconds );
+	RelinkChain( chainHead );
+}
+
+void TimerWheel::RunPendingCallbacks()
+{
+	if( m_pendingCallbacks.empty() )
+	{
+		return;
+	}
+
+	// callbacks may schedule more, those queue up for the next update
+	m_runningCallbacks.swap( m_pendingCallbacks );
+	for( TimerHandle const& handle : m_runningCallbacks )
+	{
+		Entry* entry = GetEntry( handle );
+		if( entry == nullptr || entry->m_list != LIST_PENDING_CALLBACK )
+		{
+			continue;
+		}
+
+		TimerCallback callback = std::move( entry->m_callback );
+		ReleaseEntry( handle );
+		callback();
+	}
+	m_runningCallbacks.clear();
+}
+
+unsigned long long TimerWheel::SecondsToTick( double seconds )
+{
+	return seconds > 0.0 ? (unsigned long long)( seconds * TIMER_WHEEL_TICKS_PER_SECOND ) : 0;
+}
+
+//------------------------------------------------------------------------
+struct BenchmarkRepeatingTimer
+{
+	void operator()() const
+	{
+		( *m_numFired )++;
+		m_wheel->ScheduleCallback( m_delaySeconds, TimerCallback( *this ) );
+	}
+
+	TimerWheel* m_wheel = nullptr;
+	int* m_numFired = nullptr;
+	double m_delaySeconds = 0.0;
+};
+
+//------------------------------------------------------------------------
+// repeating 0.5-5 second timers at 60 fps, against checking every timer every frame the way Timer::HasElapsed used to
+static void BenchmarkTimerWheel( int numTimers, int numFrames )
+{
+	RandomNumberGenerator rng;
+	std::vector<double> delays( numTimers );
+	for( int timerIndex = 0; timerIndex < numTimers; timerIndex++ )
+	{
+		delays[timerIndex] = (double)rng.RollRandomFloatInRange( 0.5f, 5.f );
+	}
+	double const frameSeconds = 1.0 / 60.0;
+
+	TimerWheel wheel( 0.0 );
+	int numWheelFired = 0;
+	for( int timerIndex = 0; timerIndex < numTimers; timerIndex++ )
+	{
+		BenchmarkRepeatingTimer repeatingTimer;
+		repeatingTimer.m_wheel = &wheel;
+		repeatingTimer.m_numFired = &numWheelFired;
+		repeatingTimer.m_delaySeconds = delays[timerIndex];
+		wheel.ScheduleCallback( delays[timerIndex], TimerCallback( repeatingTimer ) );
+	}
+
+	double startSeconds = GetCurrentTimeSeconds();
+	for( int frameIndex = 1; frameIndex <= numFrames; frameIndex++ )
+	{
+		wheel.AdvanceTo( frameIndex * frameSeconds );
+	}
+	double wheelSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	std::vector<double> timerStartSeconds( numTimers, 0.0 );
+	int numPolledFired = 0;
+	startSeconds = GetCurrentTimeSeconds();
+	for( int frameIndex = 1; frameIndex <= numFrames; frameIndex++ )
+	{
+		double currentSeconds = frameIndex * frameSeconds;
+		for( int timerIndex = 0; timerIndex < numTimers; timerIndex++ )
+		{
+			if( currentSeconds > timerStartSeconds[timerIndex] + delays[timerIndex] )
+			{
+				timerStartSeconds[timerIndex] += delays[timerIndex];
+				numPolledFired++;
+			}
+		}
+	}
+	double pollSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "%7i timers: wheel %9.2f us/frame (%i fired), polling %9.2f us/frame (%i fired)",
+		numTimers, wheelSeconds * 1.0e6 / numFrames, numWheelFired, pollSeconds * 1.0e6 / numFrames, numPolledFired ) );
+}
+
+COMMAND( benchmark_timers, "Compare per-frame cost of the timer wheel against polling every timer, for 1k, 10k and 100k timers. e.g. benchmark_timers frames=600", "frames" )
+{
+	int numFrames = args.GetValue( "frames", 600 );
+	numFrames < 1 ? numFrames = 1 : true;
+
+	BenchmarkTimerWheel( 1000, numFrames );
+	BenchmarkTimerWheel( 10000, numFrames );
+	BenchmarkTimerWheel( 100000, numFrames );
+}
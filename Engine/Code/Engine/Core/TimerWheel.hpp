@@ -0,0 +1,103 @@
+#pragma once
+#include "Engine/Core/Delegate.hpp"
+#include <vector>
+
+class Timer;
+
+typedef DelegateCallable<> TimerCallback;
+
+//------------------------------------------------------------------------
+struct TimerHandle
+{
+	int m_index = -1;
+	unsigned int m_generation = 0;
+
+	bool IsValid() const { return m_index >= 0; }
+};
+
+//------------------------------------------------------------------------
+// Hierarchical timing wheel, one per Clock (see Clock::GetTimerWheel), advanced by Clock::Update.
+// Scheduling and cancelling are O(1), and an update only visits the slots time moved through plus
+// whatever fires, so 10k waiting timers cost about the same per frame as 10.
+// Timers set their elapsed flag as they expire; callbacks are collected and run together at the
+// end of the update. Main thread only.
+//------------------------------------------------------------------------
+class TimerWheel
+{
+	friend class Timer;
+
+public:
+	explicit TimerWheel( double currentSeconds );
+	~TimerWheel();
+
+	TimerWheel( TimerWheel const& copyFrom ) = delete;
+
+	TimerHandle	ScheduleCallback( double delaySeconds, TimerCallback&& callback );	// one shot, the handle goes stale once it runs
+	bool		Cancel( TimerHandle handle );											// false if it already ran or was cancelled
+	bool		IsScheduled( TimerHandle handle ) const;
+
+	void		AdvanceTo( double currentSeconds );		// going backwards (Clock::Reset) re-sorts everything
+	int			GetNumScheduled() const		{ return m_numScheduled; }
+
+public:
+	static constexpr int	TIMER_WHEEL_LEVELS = 4;
+	static constexpr int	TIMER_WHEEL_SLOT_BITS = 8;
+	static constexpr int	TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_SLOT_BITS;
+	static constexpr double	TIMER_WHEEL_TICKS_PER_SECOND = 1000.0;		// levels cover 256ms, 65s, 4.6h and 49 days
+
+private:
+	static constexpr int	LIST_NONE = -1;
+	static constexpr int	LIST_PENDING_CALLBACK = -2;
+	static constexpr int	LIST_FAR = TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS;
+	static constexpr int	NUM_LISTS = LIST_FAR + 1;
+	static constexpr int	SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+	static constexpr int	OCCUPIED_WORDS = TIMER_WHEEL_SLOTS / 64;
+
+	struct Entry
+	{
+		double m_expireSeconds = 0.0;
+		unsigned long long m_expireTick = 0;
+		Timer* m_owner = nullptr;				// nullptr for callback timers
+		TimerCallback m_callback;
+		int m_prev = -1;
+		int m_next = -1;						// also links the free list
+		int m_list = LIST_NONE;
+		unsigned int m_generation = 0;
+		bool m_isInUse = false;
+	};
+
+	// Timer handles, the entry lives as long as its Timer
+	TimerHandle	AcquireTimerEntry( Timer* owner );
+	void		ReleaseEntry( TimerHandle handle );
+	void		ScheduleTimerEntry( TimerHandle handle, double expireSeconds );
+	void		UnscheduleEntry( int entryIndex );
+
+	Entry*		GetEntry( TimerHandle handle );
+	Entry const* GetEntry( TimerHandle handle ) const;
+	int			AllocateEntry();
+	void		Link( int entryIndex );				// files it by expiry, or fires it if that has already passed
+	void		Unlink( int entryIndex );
+	void		Fire( int entryIndex );
+	int			DetachList( int listIndex );		// empties a list, returns its old head
+	void		RelinkChain( int entryIndex );
+	void		RelinkList( int listIndex );
+	void		Cascade();
+	int			FindOccupiedSlot( int fromSlot, int toSlot ) const;
+	void		Rebase( double currentSeconds );
+	void		RunPendingCallbacks();
+
+	static unsigned long long SecondsToTick( double seconds );
+
+private:
+	double m_currentSeconds = 0.0;
+	unsigned long long m_currentTick = 0;
+	int m_numScheduled = 0;
+
+	std::vector<Entry> m_entries;
+	int m_freeList = -1;
+	int m_listHeads[NUM_LISTS];
+	unsigned long long m_occupiedSlots[OCCUPIED_WORDS];		// level 0 only, lets an update jump over empty slots
+
+	std::vector<TimerHandle> m_pendingCallbacks;
+	std::vector<TimerHandle> m_runningCallbacks;
+};
@@ -1,6 +1,19 @@
 #include "XmlUtils.hpp"
+#include "Engine/Core/FileView.hpp"
 #include <math.h>
 
+bool LoadXmlDocumentFromFile( XmlDocument& document, const std::string& filePath )
+{
+	FileView file( filePath );
+	if( !file.IsOpen() )
+	{
+		return false;
+	}
+
+	// tinyxml2 parses in place, so it still takes its own copy; this skips the stdio read into another buffer first
+	return document.Parse( file.GetData(), file.GetSize() ) == tinyxml2::XML_SUCCESS;
+}
+
 int ParseXmlAttribute( const XmlElement& element, const char* attributeName, int defaultValue )
 {
 	const char* attributeValueText = element.Attribute( attributeName );
@@ -13,6 +13,8 @@ typedef tinyxml2::XMLElement XmlElement;
 typedef tinyxml2::XMLDocument XmlDocument;
 typedef tinyxml2::XMLAttribute XmlAttribute;
 
+bool		LoadXmlDocumentFromFile( XmlDocument& document, const std::string& filePath );		// memory mapped; false if missing or malformed
+
 int			ParseXmlAttribute( const XmlElement& element, const char* attributeName, int defaultValue );
 char		ParseXmlAttribute( const XmlElement& element, const char* attributeName, char defaultValue );
 bool		ParseXmlAttribute( const XmlElement& element, const char* attributeName, bool defaultValue );
@@ -150,11 +150,21 @@ void AABB2::FitWithinBounds( const AABB2& bounds )
 
 void AABB2::SetFromText( const char* text )
 {
-	Strings stringList = SplitStringOnDelimiter( text, ',' );
-	if( stringList.size() == 4 )
+	// "minX,minY,maxX,maxY"
+	float values[4] = { 0.f, 0.f, 0.f, 0.f };
+	int numValues = 0;
+	for( std::string_view piece : SplitStringView( text, ',' ) )
 	{
-		maxs = Vec2( (float)atof( stringList[2].c_str() ), (float)atof( stringList[3].c_str() ) );
-		mins = Vec2( (float)atof( stringList[0].c_str() ), (float)atof( stringList[1].c_str() ) );
+		if( numValues >= 4 || !Parse( &values[numValues], piece ) )
+		{
+			return;
+		}
+		numValues++;
+	}
+	if( numValues == 4 )
+	{
+		mins = Vec2( values[0], values[1] );
+		maxs = Vec2( values[2], values[3] );
 	}
 }
 
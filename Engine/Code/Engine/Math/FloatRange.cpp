@@ -17,20 +17,7 @@ FloatRange::FloatRange( float min, float max )
 
 FloatRange::FloatRange( const char* asText )
 {
-	Strings stringList = SplitStringOnDelimiter( asText, '~' );
-	if( (int) stringList.size() == 1 )
-	{
-		float num = (float) atof( stringList[0].c_str() );
-		minimum = num;
-		maximum = num;
-	}
-	if( (int) stringList.size() == 2 )
-	{
-		float firstNum = (float) atof( stringList[0].c_str() );
-		float secondNum = (float) atof( stringList[1].c_str() );
-		minimum = firstNum;
-		maximum = secondNum;
-	}
+	SetFromText( asText );
 }
 
 bool FloatRange::IsInRange( float value ) const
@@ -76,21 +63,18 @@ void FloatRange::Set( float newMinimum, float newMaximum )
 
 bool FloatRange::SetFromText( const char* asText )
 {
-	Strings stringList = SplitStringOnDelimiter( asText, '~' );
-	if( (int) stringList.size() == 1 )
+	// "5" or "2~7"
+	float values[2] = { 0.f, 0.f };
+	int numValues = 0;
+	for( std::string_view piece : SplitStringView( asText, '~' ) )
 	{
-		float num = (float) atof( stringList[0].c_str() );
-		minimum = num;
-		maximum = num;
-		return true;
+		if( numValues >= 2 || !Parse( &values[numValues], piece ) )
+		{
+			return false;
+		}
+		numValues++;
 	}
-	if( (int) stringList.size() == 2 )
-	{
-		float firstNum = (float) atof( stringList[0].c_str() );
-		float secondNum = (float) atof( stringList[1].c_str() );
-		minimum = firstNum;
-		maximum = secondNum;
-		return true;
-	}
-	return false;
+	minimum = values[0];
+	maximum = numValues == 2 ? values[1] : values[0];
+	return true;
 }
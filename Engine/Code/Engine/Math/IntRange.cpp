@@ -17,20 +17,7 @@ IntRange::IntRange( int min, int max )
 
 IntRange::IntRange( const char* asText )
 {
-	Strings stringList = SplitStringOnDelimiter( asText, '~' );
-	if ( stringList.size() == 1 )
-	{
-		int num = atoi( stringList[0].c_str() );
-		minimum = num;
-		maximum = num;
-	}
-	if( stringList.size() == 2 )
-	{
-		int firstNum = atoi( stringList[0].c_str() );
-		int secondNum = atoi( stringList[1].c_str() );
-		minimum = firstNum;
-		maximum = secondNum;
-	}
+	SetFromText( asText );
 }
 
 bool IntRange::IsInRange( int value ) const
@@ -76,21 +63,18 @@ void IntRange::Set( int newMinimum, int newMaximum )
 
 bool IntRange::SetFromText( const char* asText )
 {
-	Strings stringList = SplitStringOnDelimiter( asText, '~' );
-	if( stringList.size() == 1 )
+	// "5" or "2~7"
+	int values[2] = { 0, 0 };
+	int numValues = 0;
+	for( std::string_view piece : SplitStringView( asText, '~' ) )
 	{
-		int num = atoi( stringList[0].c_str() );
-		minimum = num;
-		maximum = num;
-		return true;
+		if( numValues >= 2 || !Parse( &values[numValues], piece ) )
+		{
+			return false;
+		}
+		numValues++;
 	}
-	if( stringList.size() == 2 )
-	{
-		int firstNum = atoi( stringList[0].c_str() );
-		int secondNum = atoi( stringList[1].c_str() );
-		minimum = firstNum;
-		maximum = secondNum;
-		return true;
-	}
-	return false;
+	minimum = values[0];
+	maximum = numValues == 2 ? values[1] : values[0];
+	return true;
 }
@@ -75,14 +75,7 @@ void IntVec2::RotateMinus90Degrees()
 
 void IntVec2::SetFromText( const char* text )
 {
-	Strings stringList = SplitStringOnDelimiter( text, ',' );
-	if( (int) stringList.size() == 2 )
-	{
-		int firstNum = atoi( stringList[0].c_str() );
-		int secondNum = atoi( stringList[1].c_str() );
-		x = firstNum;
-		y = secondNum;
-	}
+	Parse( this, std::string_view( text ) );
 }
 
 bool IntVec2::operator==( const IntVec2& compare ) const
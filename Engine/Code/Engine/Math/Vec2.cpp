@@ -221,14 +221,7 @@ void Vec2::Reflect( const Vec2& referVec2 )
 
 void Vec2::SetFromText( const char* text )
 {
-	Strings stringList = SplitStringOnDelimiter( text, ',' );
-	if ( (int) stringList.size() == 2 )
-	{
-		float firstNum = (float) atof( stringList[0].c_str() );
-		float secondNum = (float) atof( stringList[1].c_str() );
-		x = firstNum;
-		y = secondNum;
-	}
+	Parse( this, std::string_view( text ) );
 }
 
 
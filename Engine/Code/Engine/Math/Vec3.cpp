@@ -96,16 +96,7 @@ const Vec2 Vec3::GetXY() const
 
 void Vec3::SetFromText( const char* text )
 {
-	Strings stringList = SplitStringOnDelimiter( text, ',' );
-	if( (int)stringList.size() == 3 )
-	{
-		float firstNum = (float)atof( stringList[0].c_str() );
-		float secondNum = (float)atof( stringList[1].c_str() );
-		float thirdNum = (float)atof( stringList[2].c_str() );
-		x = firstNum;
-		y = secondNum;
-		z = thirdNum;
-	}
+	Parse( this, std::string_view( text ) );
 }
 
 
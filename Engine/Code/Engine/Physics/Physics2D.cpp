@@ -4,7 +4,9 @@
 #include "Engine/Physics/PolygonCollider2D.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 #include "Engine/Core/Timer.hpp"
+#include "Engine/Core/Profiler.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 
 Physics2D::Physics2D()
@@ -33,6 +35,7 @@ void Physics2D::BeginFrame()
 
 void Physics2D::Update( float deltaSeconds )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PHYSICS );
 	UNUSED( deltaSeconds );
 	while( m_stepTimer->CheckAndReset() )
 	{
@@ -70,6 +73,7 @@ void Physics2D::CleanUpDestroyedObjects()
 
 void Physics2D::SimulateStep( float deltaSeconds )
 {
+	PROFILE_SCOPE( "Physics2D::SimulateStep" );
 	ApplyEffectors( deltaSeconds );	// apply gravity to all dynamic objects
 	MoveRigidbodies( deltaSeconds );// apply an euler step to all rigidbodies, and reset per-frame data
 	DetectCollisions();	 // determine all pairs of intersecting colliders
@@ -375,6 +379,7 @@ bool Physics2D::IsNewCollision( const Collision2D& col )
 
 Rigidbody2D* Physics2D::CreateRigidbody()
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PHYSICS );
 	Rigidbody2D* rb = new Rigidbody2D();
 	rb->m_system = this;
 	m_rigidbodyList.push_back(rb);
@@ -392,6 +397,7 @@ void Physics2D::DestroyRigidbody( Rigidbody2D* rb )
 
 DiscCollider2D* Physics2D::CreateDiscCollider( Vec2 localPosition, float radius )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PHYSICS );
 	DiscCollider2D* discCollider = new DiscCollider2D();
 	discCollider->m_radius = radius;
 	discCollider->m_localPosition = localPosition;
@@ -404,6 +410,7 @@ DiscCollider2D* Physics2D::CreateDiscCollider( Vec2 localPosition, float radius
 
 PolygonCollider2D* Physics2D::CreatePolygonCollider( Vec2 const* points, uint pointCount, bool isMakeConvexFromPointCloud )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_PHYSICS );
 	PolygonCollider2D* polygonCollider = new PolygonCollider2D();
 	if ( isMakeConvexFromPointCloud )
 	{
@@ -22,7 +22,7 @@ static LRESULT CALLBACK WindowsMessageHandlingProcedure( HWND windowHandle, UINT
 	case WM_CLOSE:
 	{
 		EventSystem* eventSystem = window->GetEventSystem();
-		eventSystem->FireEvent("quit");
+		eventSystem->FireEvent( EVENT_ID( "quit" ) );
 		return 0; // "Consumes" this message (tells Windows "okay, we handled it")
 	}
 
@@ -134,7 +134,7 @@ Window::~Window()
 	UnregisterWindowClass();
 }
 
-bool Window::Open( std::string const& title, float clientAspect,float maxClientFractionOfDesktop /*0.9*/ )
+bool Window::Open( std::string const& title, float clientAspect,float maxClientFractionOfDesktop /*0.9*/, bool isVisible /*true*/ )
 {
 	// #SD1ToDo: Add support for fullscreen mode (requires different window style flags than windowed mode)
 	const DWORD windowStyleFlags = WS_CAPTION | WS_BORDER | WS_THICKFRAME | WS_SYSMENU | WS_OVERLAPPED;
@@ -196,9 +196,12 @@ bool Window::Open( std::string const& title, float clientAspect,float maxClientF
 	if (hwnd == nullptr)
 		return false;
 
-	ShowWindow( hwnd, SW_SHOW );
-	SetForegroundWindow( hwnd );
-	SetFocus( hwnd );
+	if( isVisible )
+	{
+		ShowWindow( hwnd, SW_SHOW );
+		SetForegroundWindow( hwnd );
+		SetFocus( hwnd );
+	}
 
 	HCURSOR cursor = LoadCursor( NULL, IDC_ARROW );
 	SetCursor( cursor );
@@ -9,7 +9,7 @@ public:
 	Window();
 	~Window();
 
-	bool Open( std::string const& title, float clientAspect, float maxClientFractionOfDesktop );
+	bool Open( std::string const& title, float clientAspect, float maxClientFractionOfDesktop, bool isVisible = true );		// hidden windows still render, for headless runs
 	void Close();
 
 	void SetInputSystem( InputSystem* input );
@@ -19,8 +19,9 @@ const Texture* BitmapFont::GetTexture() const
 	return &m_glyphSpriteSheet.GetTexture();
 }
 
-void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, const Vec2& textMins, 
-	float cellHeight, const std::string& text, const Rgba8& tint, float cellAspect )
+template <typename VERTEX_ALLOCATOR>
+void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& vertexArray, const Vec2& textMins, 
+	float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect )
 {
 	for( int textIndex = 0;textIndex < text.length();textIndex++ ) 
 	{
@@ -44,7 +45,8 @@ void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, const
 	}
 }
 
-void BitmapFont::AddVertsForText3D( std::vector<Vertex_PCU>& vertexArray, const Vec3& textMins, float cellHeight, const std::string& text, const Rgba8& tint, float cellAspect )
+template <typename VERTEX_ALLOCATOR>
+void BitmapFont::AddVertsForText3D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& vertexArray, const Vec3& textMins, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect )
 {
 	for( int textIndex = 0; textIndex < text.length(); textIndex++ )
 	{
@@ -68,8 +70,9 @@ void BitmapFont::AddVertsForText3D( std::vector<Vertex_PCU>& vertexArray, const
 	}
 }
 
-void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, const AABB2& box,
-	float cellHeight, const std::string& text, const Rgba8& tint, float cellAspect, const Vec2& alignment )
+template <typename VERTEX_ALLOCATOR>
+void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& vertexArray, const AABB2& box,
+	float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect, const Vec2& alignment )
 {
 	float totalWidth = 0.f;
 	for( int textIndex = 0; textIndex < text.length(); textIndex++ )
@@ -87,7 +90,14 @@ void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, c
 	AddVertsForText2D( vertexArray, textAABB2.mins, cellHeight, text, tint, cellAspect );
 }
 
-Vec2 BitmapFont::GetDimensionsForText2D( float cellHeight, const std::string& text, float cellAspect )
+template void BitmapFont::AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, const Vec2& textMins, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect );
+template void BitmapFont::AddVertsForText2D( FrameVector<Vertex_PCU>& vertexArray, const Vec2& textMins, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect );
+template void BitmapFont::AddVertsForText3D( std::vector<Vertex_PCU>& vertexArray, const Vec3& textMins, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect );
+template void BitmapFont::AddVertsForText3D( FrameVector<Vertex_PCU>& vertexArray, const Vec3& textMins, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect );
+template void BitmapFont::AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, const AABB2& box, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect, const Vec2& alignment );
+template void BitmapFont::AddVertsForTextInBox2D( FrameVector<Vertex_PCU>& vertexArray, const AABB2& box, float cellHeight, std::string_view text, const Rgba8& tint, float cellAspect, const Vec2& alignment );
+
+Vec2 BitmapFont::GetDimensionsForText2D( float cellHeight, std::string_view text, float cellAspect )
 {
 	float totalWidth = 0.f;
 	for( int textIndex = 0; textIndex < text.length(); textIndex++ )
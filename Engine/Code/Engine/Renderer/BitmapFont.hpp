@@ -4,8 +4,10 @@
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FrameAllocator.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 
 class RenderContext;
 
@@ -20,16 +22,20 @@ private:
 public:
 	const Texture* GetTexture() const;
 
-	void AddVertsForText2D( std::vector<Vertex_PCU>& vertexArray, const Vec2& textMins,
-		float cellHeight, const std::string& text, const Rgba8& tint=Rgba8::WHITE, float cellAspect=1.f );
+	template <typename VERTEX_ALLOCATOR>
+	void AddVertsForText2D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& vertexArray, const Vec2& textMins,
+		float cellHeight, std::string_view text, const Rgba8& tint=Rgba8::WHITE, float cellAspect=1.f );
 
-	void AddVertsForText3D( std::vector<Vertex_PCU>& vertexArray, const Vec3& textMins,
-		float cellHeight, const std::string& text, const Rgba8& tint=Rgba8::WHITE, float cellAspect=1.f );
+	template <typename VERTEX_ALLOCATOR>
+	void AddVertsForText3D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& vertexArray, const Vec3& textMins,
+		float cellHeight, std::string_view text, const Rgba8& tint=Rgba8::WHITE, float cellAspect=1.f );
 
-	void AddVertsForTextInBox2D( std::vector<Vertex_PCU>& vertexArray, const AABB2& box, float cellHeight,
-		const std::string& text, const Rgba8& tint=Rgba8::WHITE, float cellAspect=1.f,
+	template <typename VERTEX_ALLOCATOR>
+	void AddVertsForTextInBox2D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& vertexArray, const AABB2& box, float cellHeight,
+		std::string_view text, const Rgba8& tint=Rgba8::WHITE, float cellAspect=1.f,
 		const Vec2& alignment=ALIGN_CENTERED );
-	Vec2 GetDimensionsForText2D( float cellHeight, const std::string& text, float cellAspect=1.f );
+	// AddVertsFor* are instantiated for std::vector and FrameVector
+	Vec2 GetDimensionsForText2D( float cellHeight, std::string_view text, float cellAspect=1.f );
 
 
 protected:
@@ -6,6 +6,7 @@
 #include "Engine/Math/OBB2.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/Timer.hpp"
+#include "Engine/Core/Profiler.hpp"
 
 extern BitmapFont* g_theFont;
 extern RenderContext* g_theRenderer;
@@ -28,6 +29,8 @@ public:
 
 	RenderContext* m_context;
 	Camera* m_camera;
+	Camera* m_screenCamera = nullptr;		// owned, UBO bound to m_screenCameraContext
+	RenderContext* m_screenCameraContext = nullptr;
 	Clock* m_clock;
 
 	float m_screenHeight = 0.f;
@@ -81,6 +84,13 @@ void DebugRenderSystemShutdown()
 		}
 	}
 
+	if( g_debugRenderSystem->m_screenCamera )
+	{
+		g_debugRenderSystem->m_screenCamera->ClearupUBO();
+		delete g_debugRenderSystem->m_screenCamera;
+		g_debugRenderSystem->m_screenCamera = nullptr;
+	}
+
 	delete g_debugRenderSystem;
 	g_debugRenderSystem = nullptr;
 }
@@ -173,6 +183,7 @@ void DebugRenderWorldToCamera( Camera* cam )
 
 void DebugRenderScreenTo( RenderContext* context )
 {
+	PROFILE_SCOPE( "DebugRenderScreenTo" );
 	RenderContext* ctx = context;
 	g_debugRenderSystem->m_context = ctx;
 	g_currentRenderContext = ctx;
@@ -180,12 +191,24 @@ void DebugRenderScreenTo( RenderContext* context )
 	if( !g_debugRenderSystem->isRendering )
 		return;
 
-	Camera* camera = new Camera();
+	// one screen camera reused every frame, rebuilt only if the target context changes
+	Camera* camera = g_debugRenderSystem->m_screenCamera;
+	if( camera == nullptr || g_debugRenderSystem->m_screenCameraContext != ctx )
+	{
+		if( camera )
+		{
+			camera->ClearupUBO();
+			delete camera;
+		}
+		camera = new Camera();
+		camera->InitialUBO( ctx );
+		camera->SetClearMode( CLEAR_NONE );
+		g_debugRenderSystem->m_screenCamera = camera;
+		g_debugRenderSystem->m_screenCameraContext = ctx;
+	}
 	Vec2 min = Vec2::ZERO;
 	Vec2 max = Vec2( g_debugRenderSystem->m_screenWidth, g_debugRenderSystem->m_screenHeight );
 	camera->SetProjectionOrthographic( min, max, -1.0f, 1.0f );
-	camera->InitialUBO( ctx );
-	camera->SetClearMode( CLEAR_NONE );
 	g_debugRenderSystem->m_camera = camera;
 	g_currentCamera = camera;
 
@@ -215,9 +238,6 @@ void DebugRenderScreenTo( RenderContext* context )
 	}
 
 	ctx->EndCamera( *camera );
-
-	camera->ClearupUBO();
-	delete camera;
 }
 
 void DebugRenderEndFrame()
@@ -24,19 +24,17 @@ bool DebugRenderObject::IsOld() const
 		return false;
 	}
 
-	return m_timer->HasElapsed();
+	return m_timer.HasElapsed();
 }
 
 DebugRenderObject::~DebugRenderObject()
 {
-	delete m_timer;
-	m_timer = nullptr;
 }
 
 Rgba8 DebugRenderObject::GetCurrentColor() const
 {
 	Rgba8 color = Rgba8::WHITE;
-	float remainingTime = (float)m_timer->GetSecondsRemaining();
+	float remainingTime = (float)m_timer.GetSecondsRemaining();
 	remainingTime = RangeMap( 0.f, m_duration, 0.f, 1.f, remainingTime );
 	char colorDiff_r = (char)((m_endColor.r - m_startColor.r) * remainingTime);
 	char colorDiff_g = (char)((m_endColor.g - m_startColor.g) * remainingTime);
@@ -51,7 +49,7 @@ Rgba8 DebugRenderObject::GetCurrentColor() const
 Rgba8 DebugRenderObject::GetCurrentColor( const Rgba8& startColor, const Rgba8& endColor ) const
 {
 	Rgba8 color = Rgba8::WHITE;
-	float remainingTime = (float)m_timer->GetSecondsRemaining();
+	float remainingTime = (float)m_timer.GetSecondsRemaining();
 	remainingTime = RangeMap( 0.f, m_duration, 0.f, 1.f, remainingTime );
 	char colorDiff_r = (char)((endColor.r - startColor.r) * remainingTime);
 	char colorDiff_g = (char)((endColor.g - startColor.g) * remainingTime);
@@ -73,8 +71,7 @@ DebugRenderObject_Point::DebugRenderObject_Point( Vec3 pos, float size, Rgba8 st
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	m_mesh = new GPUMesh( g_currentRenderContext );
 	std::vector<Vertex_PCU> vertices;
@@ -120,8 +117,7 @@ DebugRenderObject_Quad::DebugRenderObject_Quad( Vec3* points, AABB2 uvs, Rgba8 s
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	AppendQuad( m_vertices, m_point0, m_point1, m_point2, m_point3, m_uvs, Rgba8::WHITE );
 }
@@ -158,8 +154,7 @@ DebugRenderObject_Line::DebugRenderObject_Line( Vec3 p0, Rgba8 p0_start_color, R
 	m_endColor = p0_end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 }
 
 DebugRenderObject_Line::~DebugRenderObject_Line()
@@ -203,8 +198,7 @@ DebugRenderObject_Arrow::DebugRenderObject_Arrow( Vec3 p0, Rgba8 p0_start_color,
 	m_endColor = p0_end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	Vec3 translationNor = (m_endPoint - m_startPoint).GetNormalized();
 	const float coneLength = 1.f;
@@ -250,8 +244,7 @@ DebugRenderObject_WireBounds::DebugRenderObject_WireBounds( AABB3 bounds, Rgba8
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	m_mesh = new GPUMesh( g_currentRenderContext );
 	std::vector<Vertex_PCU> vertices;
@@ -297,8 +290,7 @@ DebugRenderObject_WireSphere::DebugRenderObject_WireSphere( Vec3 pos, float size
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	m_mesh = new GPUMesh( g_currentRenderContext );
 	std::vector<Vertex_PCU> vertices;
@@ -343,8 +335,7 @@ DebugRenderObject_Basis::DebugRenderObject_Basis( Mat44 basis, Rgba8 start_color
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	m_mesh = new GPUMesh( g_currentRenderContext );
 	std::vector<Vertex_PCU> vertices;
@@ -409,8 +400,7 @@ DebugRenderObject_Text::DebugRenderObject_Text( std::string text, Mat44 basis, V
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	AppendText3D( m_vertices, text, position, 1.f, g_theFont, Rgba8::WHITE );
 }
@@ -446,8 +436,7 @@ DebugRenderObject_BillboardText::DebugRenderObject_BillboardText( std::string te
 	m_endColor = end_color;
 	m_mode = mode;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	Vec2 textDimension = g_theFont->GetDimensionsForText2D( 1.f, text );
 	Vec3 localPosition = Vec3( -textDimension.x * pivot.x, -textDimension.y * pivot.y, 0.f );
@@ -487,8 +476,7 @@ DebugRenderObject_ScreenPoint::DebugRenderObject_ScreenPoint( Vec2 center, float
 	m_startColor = start_color;
 	m_endColor = end_color;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	AppendCircle( m_vertices, Vec3( center, 0.f ), m_size, Rgba8::WHITE );
 }
@@ -516,8 +504,7 @@ DebugRenderObject_ScreenLine::DebugRenderObject_ScreenLine( Vec2 p0, Rgba8 p0_st
 	m_pos1EndColor = p1_end_color;
 
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	Vec2 center = (p1 + p0) * 0.5f;
 	float width = (p1 - p0).GetLength();
@@ -534,7 +521,7 @@ void DebugRenderObject_ScreenLine::RenderObject() const
 {
 	Rgba8 startColor = GetCurrentColor( m_startColor, m_endColor );
 	Rgba8 endColor = GetCurrentColor( m_pos1StartColor, m_pos1EndColor );
-	std::vector<Vertex_PCU> vertices;
+	FrameVector<Vertex_PCU> vertices;
 	Vec2 point[4];
 	m_line.GetCornerPosition( point );
 	AppendQuad( vertices, Vec3(point[0], 0.f), Vec3(point[1], 0.f), Vec3(point[2], 0.f), Vec3(point[3], 0.f), AABB2::ZERO_TO_ONE, startColor, endColor, startColor, endColor );
@@ -554,8 +541,7 @@ DebugRenderObject_ScreenArrow::DebugRenderObject_ScreenArrow( Vec2 p0, Rgba8 p0_
 	m_pos1EndColor = p1_end_color;
 
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 
 	float triHeight = 40.f;
 	Vec2 lineEndPos = p1 - p0;
@@ -583,7 +569,7 @@ void DebugRenderObject_ScreenArrow::RenderObject() const
 {
 	Rgba8 startColor = GetCurrentColor( m_startColor, m_endColor );
 	Rgba8 endColor = GetCurrentColor( m_pos1StartColor, m_pos1EndColor );
-	std::vector<Vertex_PCU> vertices;
+	FrameVector<Vertex_PCU> vertices;
 	Vec2 point[4];
 	m_line.GetCornerPosition( point );
 	AppendQuad( vertices, Vec3( point[0], 0.f ), Vec3( point[1], 0.f ), Vec3( point[2], 0.f ), Vec3( point[3], 0.f ), AABB2::ZERO_TO_ONE, startColor, endColor, startColor, endColor );
@@ -599,8 +585,7 @@ DebugRenderObject_ScreenQuad::DebugRenderObject_ScreenQuad( AABB2 bounds, Rgba8
 	m_startColor = start_color;
 	m_endColor = end_color;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 	m_bounds = bounds;
 	m_tex = tex;
 	m_uvs = uvs;
@@ -629,8 +614,7 @@ DebugRenderObject_ScreenText::DebugRenderObject_ScreenText( std::string text, Ve
 	m_startColor = start_color;
 	m_endColor = end_color;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 	m_position = pos;
 	m_size = size;
 
@@ -654,8 +638,7 @@ DebugRenderObject_ScreenMessage::DebugRenderObject_ScreenMessage( std::string te
 	m_startColor = start_color;
 	m_endColor = end_color;
 	m_duration = duration;
-	m_timer = new Timer();
-	m_timer->SetSeconds( g_currentClock, duration );
+	m_timer.SetSeconds( g_currentClock, duration );
 	m_text = text;
 }
 
@@ -678,7 +661,7 @@ void DebugRenderObject_ScreenMessage::RenderMessage( uint index ) const
 
 	Vec2 printPos = Vec2( screenBox.maxs.x - textDimension.x, screenBox.maxs.y - textDimension.y - ( textDimension.y * index ) );
 
-	std::vector<Vertex_PCU> textVerts;
+	FrameVector<Vertex_PCU> textVerts;
 	g_theFont->AddVertsForText2D( textVerts, printPos, lineHegiht, m_text );
 	g_currentRenderContext->BindTexture( g_theFont->GetTexture() );
 	g_currentRenderContext->SetModelTint( color );
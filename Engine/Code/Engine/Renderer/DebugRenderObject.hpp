@@ -1,10 +1,10 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Timer.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Math/OBB2.hpp"
 
-class Timer;
 class RenderContext;
 class GPUMesh;
 class DebugRenderSystem;
@@ -30,7 +30,7 @@ public:
 	eDebugRenderMode m_mode;
 	float m_duration;
 
-	Timer* m_timer = nullptr;
+	Timer m_timer;
 };
 
 //------------------------------------------------------------------------------------------------------------------------
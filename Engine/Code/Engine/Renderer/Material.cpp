@@ -5,13 +5,30 @@
 #include "Engine/Renderer/Sampler.hpp"
 #include "Engine/Renderer/RenderBuffer.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Core/DefinitionCache.hpp"
+#include "Engine/Core/StringID.hpp"
 
-static std::map< std::string, Material* > s_definitionMap;
+static StringIDMap<Material*> s_definitionMap;
+constexpr unsigned int MATERIAL_CACHE_VERSION = 1;		// bump whenever AppendToBuffer changes
 
 STATIC void Material::LoadDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath )
 {
+	DefinitionCache cache( "MaterialDefs", MATERIAL_CACHE_VERSION );
+	cache.AddSourceFile( deinitionsXmlFilePath );
+	if( cache.Load() )
+	{
+		BufferParser& parser = cache.GetParser();
+		int numDefinitions = parser.ParseInt32();
+		for( int definitionIndex = 0; definitionIndex < numDefinitions; definitionIndex++ )
+		{
+			Material* newMaterial = new Material( context, parser );
+			s_definitionMap[InternStringID( newMaterial->m_name )] = newMaterial;
+		}
+		return;
+	}
+
 	XmlDocument mapXmlDoc;
-	mapXmlDoc.LoadFile( &deinitionsXmlFilePath[0] );
+	LoadXmlDocumentFromFile( mapXmlDoc, deinitionsXmlFilePath );
 	XmlElement* mapDefsElement = mapXmlDoc.RootElement();
 	if( mapDefsElement == nullptr )
 	{
@@ -22,22 +39,27 @@ STATIC void Material::LoadDefinitions( RenderContext* context, const std::string
 	while( shaderStateDefElement )
 	{
 		Material* newShaderStateDef = new Material( context, *shaderStateDefElement );
-		if( s_definitionMap.count( newShaderStateDef->m_name ) > 0 )
+		if( s_definitionMap.count( HashStringID( newShaderStateDef->m_name ) ) > 0 )
 		{
 			ERROR_AND_DIE( Stringf( "ShaderState Definitions include the same name \"%s\"", newShaderStateDef->m_name.c_str() ) );
 		}
-		s_definitionMap[newShaderStateDef->m_name] = newShaderStateDef;
+		s_definitionMap[InternStringID( newShaderStateDef->m_name )] = newShaderStateDef;
 		shaderStateDefElement = shaderStateDefElement->NextSiblingElement();
 	}
+
+	BufferWriter& writer = cache.GetWriter();
+	writer.AppendInt32( (int)s_definitionMap.size() );
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->AppendToBuffer( writer );
+	}
+	cache.Save();
 }
 
 STATIC Material* Material::GetDefinitions( const std::string& deinitionsName )
 {
-	if( s_definitionMap.count( deinitionsName ) > 0 )
-	{
-		return s_definitionMap.at( deinitionsName );
-	}
-	return nullptr;
+	auto found = s_definitionMap.find( HashStringID( deinitionsName ) );
+	return found != s_definitionMap.end() ? found->second : nullptr;
 }
 
 Material::Material( RenderContext* context, const XmlElement& definitionXmlElement )
@@ -100,6 +122,39 @@ Material::Material( RenderContext* context, const std::string& shaderStateName )
 	m_ubo = new RenderBuffer( m_context, UNIFORM_BUFFER_BIT, MEMORY_HINT_DYNAMIC );
 }
 
+Material::Material( RenderContext* context, BufferParser& parser )
+{
+	m_context = context;
+	m_ubo = new RenderBuffer( m_context, UNIFORM_BUFFER_BIT, MEMORY_HINT_DYNAMIC );
+
+	m_name = parser.ParseString();
+	m_shaderState = m_context->GetShaderStateFromName( parser.ParseString() );
+	m_tint = parser.ParseRgba8();
+	m_specularFactor = parser.ParseFloat();
+	m_specularPower = parser.ParseFloat();
+
+	int numTextures = parser.ParseInt32();
+	for( int textureIndex = 0; textureIndex < numTextures; textureIndex++ )
+	{
+		uint slot = parser.ParseUint32();
+		std::string texPath = parser.ParseString();
+
+		// the built in defaults have no path
+		if( texPath.empty() && slot == 0 )
+		{
+			SetDiffuseTexture( (Texture*)nullptr );
+		}
+		else if( texPath.empty() && slot == 1 )
+		{
+			SetNormalTexture( (Texture*)nullptr );
+		}
+		else
+		{
+			SetTexture( slot, texPath );
+		}
+	}
+}
+
 Material::~Material()
 {
 	delete m_ubo;
@@ -167,3 +222,19 @@ void Material::SetShaderStateByName( const std::string& name )
 {
 	m_shaderState = m_context->GetShaderStateFromName( name );
 }
+
+void Material::AppendToBuffer( BufferWriter& writer ) const
+{
+	writer.AppendString( m_name );
+	writer.AppendString( m_shaderState != nullptr ? m_shaderState->m_name : "" );
+	writer.AppendRgba8( m_tint );
+	writer.AppendFloat( m_specularFactor );
+	writer.AppendFloat( m_specularPower );
+
+	writer.AppendInt32( (int)m_textureMap.size() );
+	for( const auto& slotTexture : m_textureMap )
+	{
+		writer.AppendUint32( slotTexture.first );
+		writer.AppendString( slotTexture.second != nullptr ? slotTexture.second->GetFilePath() : "" );
+	}
+}
@@ -10,6 +10,8 @@ class Texture;
 class Sampler;
 class RenderBuffer;
 class RenderContext;
+class BufferWriter;
+class BufferParser;
 
 class Material
 {
@@ -20,8 +22,11 @@ public:
 public:
 	Material( RenderContext* context, const std::string& shaderStateName );
 	Material( RenderContext* context, const XmlElement& definitionXmlElement );
+	Material( RenderContext* context, BufferParser& parser );		// from the definition cache
 	~Material();
 
+	void AppendToBuffer( BufferWriter& writer ) const;
+
 	void UpdateUBOIfDirty();
 
 	void SetTexture( uint slot, Texture* tex );
@@ -2,6 +2,7 @@
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/FileView.hpp"
 #include "Engine/Core/Mikkt.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/AABB3.hpp"
@@ -21,14 +22,16 @@ void AppendAABB2D( std::vector<Vertex_PCU>& verts, const AABB2& aabb2, const Rgb
 	verts.push_back( Vertex_PCU( Vec3( aabb2.maxs.x, aabb2.maxs.y, 0.f ), color, Vec2( 1.f, 1.f ) ) );
 }
 
-void AppendTriangle2D( std::vector<Vertex_PCU>& verts, Vec2 p0, Vec2 p1, Vec2 p2, const Rgba8& color )
+template <typename VERTEX_ALLOCATOR>
+void AppendTriangle2D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, Vec2 p0, Vec2 p1, Vec2 p2, const Rgba8& color )
 {
 	verts.push_back( Vertex_PCU( Vec3( p0, 0.f ), color, Vec2::ZERO ) );
 	verts.push_back( Vertex_PCU( Vec3( p1, 0.f ), color, Vec2::ZERO ) );
 	verts.push_back( Vertex_PCU( Vec3( p2, 0.f ), color, Vec2::ZERO ) );
 }
 
-void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color )
+template <typename VERTEX_ALLOCATOR>
+void AppendQuad( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color )
 {
 	// 2 --- 3
 	// | \   |
@@ -43,7 +46,8 @@ void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3
 	verts.push_back( Vertex_PCU( p2, color, Vec2( uvs.mins.x, uvs.maxs.y ) ) );
 }
 
-void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color0, const Rgba8& color1, const Rgba8& color2, const Rgba8& color3 )
+template <typename VERTEX_ALLOCATOR>
+void AppendQuad( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color0, const Rgba8& color1, const Rgba8& color2, const Rgba8& color3 )
 {
 	verts.push_back( Vertex_PCU( p0, color0, uvs.mins ) );
 	verts.push_back( Vertex_PCU( p1, color1, Vec2( uvs.maxs.x, uvs.mins.y ) ) );
@@ -54,6 +58,13 @@ void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3
 	verts.push_back( Vertex_PCU( p2, color2, Vec2( uvs.mins.x, uvs.maxs.y ) ) );
 }
 
+template void AppendTriangle2D( std::vector<Vertex_PCU>& verts, Vec2 p0, Vec2 p1, Vec2 p2, const Rgba8& color );
+template void AppendTriangle2D( FrameVector<Vertex_PCU>& verts, Vec2 p0, Vec2 p1, Vec2 p2, const Rgba8& color );
+template void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color );
+template void AppendQuad( FrameVector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color );
+template void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color0, const Rgba8& color1, const Rgba8& color2, const Rgba8& color3 );
+template void AppendQuad( FrameVector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color0, const Rgba8& color1, const Rgba8& color2, const Rgba8& color3 );
+
 void AppendCircle( std::vector<Vertex_PCU>& verts, Vec3 center, float radius, const Rgba8& color )
 {
 	const int vertexNumber = 64;
@@ -569,86 +580,123 @@ void AppendIndexedCubeToVerts( std::vector<Vertex_PCUTBN>& verts, std::vector<ui
 		Vec3( aabb3.maxs.x, aabb3.mins.y, aabb3.maxs.z ), Vec3( aabb3.maxs.x, aabb3.maxs.y, aabb3.maxs.z ), AABB2::ZERO_TO_ONE, color );
 }
 
+//------------------------------------------------------------------------
+// reads up to maxValues numbers, returns how many tokens were left on the line
+static int ReadObjFloats( TextTokenReader& tokens, float* out_values, int maxValues )
+{
+	int numTokens = 0;
+	TextSpan token;
+	while( tokens.ReadToken( token ) )
+	{
+		if( numTokens < maxValues )
+		{
+			out_values[numTokens] = token.ToFloat();
+		}
+		numTokens++;
+	}
+	return numTokens;
+}
+
 void LoadOBJToVertexArray( std::vector<Vertex_PCUTBN>& vertices, char const* filename, mesh_import_options_t const& options )
 {
-	std::string fileStr = FileRend( std::string( filename ) );
-	Strings objFile = SplitStringOnDelimiter( fileStr, '\n' );
+	FileView objFile( filename );
+	TextLineReader lines( objFile );
 
 	std::vector<Vec3> tempVertices;
 	std::vector<Vec2> tempUVs;
 	std::vector<Vec3> tempNormals;
-	for( int i = 0; i < (int)objFile.size(); ++i )
+	TextSpan currentLine;
+	while( lines.ReadLine( currentLine ) )
 	{
-		std::string currentLineTexts = objFile[i];
-		if( currentLineTexts.find( "v " ) == 0 )
+		TextTokenReader tokens( currentLine );
+		TextSpan keyword;
+		if( !tokens.ReadToken( keyword ) )
 		{
-			Vec3 vertex;
-			Strings strings = SplitStringOnDelimiterWithoutEmpty( currentLineTexts, ' ' );
-			if ( (int) strings.size() != 4 )
+			continue;
+		}
+
+		if( keyword.Equals( "v" ) )
+		{
+			float values[3];
+			if ( ReadObjFloats( tokens, values, 3 ) != 3 )
 			{
-				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", std::string( filename ).c_str(), i ) );
+				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", filename, lines.GetLineNumber() ) );
 			}
-			 
-			vertex.SetFromText( Stringf( "%s,%s,%s", strings[1].c_str(), strings[2].c_str(), strings[3].c_str() ).c_str() );
+
+			Vec3 vertex = Vec3( values[0], values[1], values[2] );
 			vertex = options.transform.TransformPosition3D( vertex );
 			tempVertices.push_back( vertex );
 		}
-		else if( currentLineTexts.find( "vn " ) == 0 )
+		else if( keyword.Equals( "vn" ) )
 		{
-			Vec3 normal;
-			Strings strings = SplitStringOnDelimiterWithoutEmpty( currentLineTexts, ' ' );
-			if( (int)strings.size() != 4 )
+			float values[3];
+			if( ReadObjFloats( tokens, values, 3 ) != 3 )
 			{
-				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", std::string( filename ).c_str(), i ) );
+				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", filename, lines.GetLineNumber() ) );
 			}
 
-			normal.SetFromText( Stringf( "%s,%s,%s", strings[1].c_str(), strings[2].c_str(), strings[3].c_str() ).c_str() );
+			Vec3 normal = Vec3( values[0], values[1], values[2] );
 			normal = options.transform.TransformVector3D( normal );
 			tempNormals.push_back( normal );
 		}
-		else if( currentLineTexts.find( "vt " ) == 0 )
+		else if( keyword.Equals( "vt" ) )
 		{
-			Vec2 uv;
-			Strings strings = SplitStringOnDelimiterWithoutEmpty( currentLineTexts, ' ' );
-			if( (int)strings.size() != 3 && (int)strings.size() != 4 )
+			float values[3];
+			int numValues = ReadObjFloats( tokens, values, 3 );
+			if( numValues != 2 && numValues != 3 )
 			{
-				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", std::string( filename ).c_str(), i ) );
+				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", filename, lines.GetLineNumber() ) );
 			}
 
-			uv.SetFromText( Stringf( "%s,%s", strings[1].c_str(), strings[2].c_str() ).c_str() );
+			Vec2 uv = Vec2( values[0], values[1] );
 			if ( options.invert_v )
 			{
 				uv = Vec2( uv.x, 1.f - uv.y );
 			}
 			tempUVs.push_back( uv );
 		}
-		else if( currentLineTexts.find( "f " ) == 0 )
+		else if( keyword.Equals( "f" ) )
 		{
-			Strings strings = SplitStringOnDelimiterWithoutEmpty( currentLineTexts, ' ' );
-			if( (int)strings.size() < 4 )
+			// triangles and quads only
+			TextSpan faceVertices[5];
+			int numFaceVertices = 0;
+			while( numFaceVertices < 5 && tokens.ReadToken( faceVertices[numFaceVertices] ) )
+			{
+				numFaceVertices++;
+			}
+			if( numFaceVertices < 3 || numFaceVertices > 4 )
 			{
-				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", std::string( filename ).c_str(), i ) );
+				ERROR_AND_DIE( Stringf( "\"%s\" has a error in line %i.", filename, lines.GetLineNumber() ) );
 			}
 
-			int stringSize = (int) strings.size();
+			int stringSize = numFaceVertices + 1;
 			uint vertexIndexes[4];
 			Vertex_PCUTBN vertexArray[4];
 			bool recalculateNormal = true;
 			for( int j = 1; j < stringSize; ++j )
 			{
-				Strings vertexStr = SplitStringOnDelimiter( strings[j], '/' );
-				int vertexIndex = GetIntFromString( &vertexStr[0][0] ) - 1;
-				int uvIndex = GetIntFromString( &vertexStr[1][0] ) - 1;
+				// v, v/vt, v//vn or v/vt/vn
+				TextTokenReader indexTokens( faceVertices[j-1], "/", true );
+				TextSpan indexStrs[3];
+				int numIndexStrs = 0;
+				while( numIndexStrs < 3 && indexTokens.ReadToken( indexStrs[numIndexStrs] ) )
+				{
+					numIndexStrs++;
+				}
+
+				int vertexIndex = indexStrs[0].ToInt() - 1;
+				int uvIndex = numIndexStrs > 1 ? indexStrs[1].ToInt() - 1 : -1;
 				Vec3 normal = Vec3::ZERO;
-				if ( (int) vertexStr.size() == 3 )
+				if ( numIndexStrs == 3 && !indexStrs[2].IsEmpty() )
 				{
-					int normalIndex = GetIntFromString( &vertexStr[2][0] ) - 1;
+					int normalIndex = indexStrs[2].ToInt() - 1;
 					normal = tempNormals[normalIndex];
 					recalculateNormal = false;
 				}
 
+				Vec2 uv = uvIndex >= 0 ? tempUVs[uvIndex] : Vec2::ZERO;
 				vertexIndexes[j-1] = (uint) vertices.size();
-				vertexArray[j-1] = Vertex_PCUTBN( tempVertices[vertexIndex], Rgba8::WHITE, tempUVs[uvIndex], Vec3::ZERO, Vec3::ZERO, normal );
+				vertexArray[j-1] = Vertex_PCUTBN( tempVertices[vertexIndex], Rgba8::WHITE, uv, Vec3::ZERO, Vec3::ZERO, normal );
 			}
 
 			// Recalculate normal
@@ -692,11 +740,11 @@ void LoadOBJToVertexArray( std::vector<Vertex_PCUTBN>& vertices, char const* fil
 				{
 					if( options.invert_winding_order )
 					{
-						GenerateNormal( pcutbnArray2[0], pcutbnArray2[2], pcutbnArray2[3], options.invert_winding_order );
+						GenerateNormal( pcutbnArray2[0], pcutbnArray2[2], pcutbnArray2[1], options.invert_winding_order );
 					}
 					else
 					{
-						GenerateNormal( pcutbnArray2[0], pcutbnArray2[3], pcutbnArray2[2], options.invert_winding_order );
+						GenerateNormal( pcutbnArray2[0], pcutbnArray2[1], pcutbnArray2[2], options.invert_winding_order );
 					}
 				}
 				vertices.insert( vertices.end(), std::begin( pcutbnArray2 ), std::end( pcutbnArray2 ) );
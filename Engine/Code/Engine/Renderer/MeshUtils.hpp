@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FrameAllocator.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Math/Mat44.hpp"
@@ -22,9 +23,13 @@ struct mesh_import_options_t
 //												Vertex PCU functions
 //------------------------------------------------------------------------------------------------------------------------
 void AppendAABB2D( std::vector<Vertex_PCU>& verts, const AABB2& aabb2, const Rgba8& color );
-void AppendTriangle2D( std::vector<Vertex_PCU>& verts, Vec2 p0, Vec2 p1, Vec2 p2, const Rgba8& color );
-void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color );
-void AppendQuad( std::vector<Vertex_PCU>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color0, const Rgba8& color1, const Rgba8& color2, const Rgba8& color3 );
+// instantiated for std::vector and FrameVector
+template <typename VERTEX_ALLOCATOR>
+void AppendTriangle2D( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, Vec2 p0, Vec2 p1, Vec2 p2, const Rgba8& color );
+template <typename VERTEX_ALLOCATOR>
+void AppendQuad( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color );
+template <typename VERTEX_ALLOCATOR>
+void AppendQuad( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3, AABB2 uvs, const Rgba8& color0, const Rgba8& color1, const Rgba8& color2, const Rgba8& color3 );
 void AppendCircle( std::vector<Vertex_PCU>& verts, Vec3 center, float radius, const Rgba8& color );
 void AppendText3D( std::vector<Vertex_PCU>& verts, const std::string& text, const Vec3& position, float size, BitmapFont* font, const Rgba8& color );
 void AppendIndexedCubeToVerts( std::vector<Vertex_PCU>& verts, std::vector<uint>& indices, const AABB3& aabb3 );
@@ -3,6 +3,9 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/ImageAtlas.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
 #include "Engine/Core/Todo.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Renderer/D3D11Common.hpp"
@@ -28,6 +31,7 @@
 
 void RenderContext::Startup( Window* window )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	IDXGISwapChain* swapchain;
 
 	UINT flags = D3D11_CREATE_DEVICE_SINGLETHREADED;
@@ -258,6 +262,7 @@ void RenderContext::BeginCamera( const Camera& camera )
 		}
 	}
 	m_lastVBO = nullptr;
+	m_lastTextureSRV = nullptr;
 
 	CreateDefaultRasterState();
 	SetModelMatrix( Mat44::IDENTITY );
@@ -308,7 +313,11 @@ void RenderContext::BindTexture( const Texture* texture )
 
 	TextureView* shaderResourceView = tex->GetOrCreateShaderResourceView();
 	ID3D11ShaderResourceView* srvHandle = shaderResourceView->GetAsSRV();
-	m_context->PSSetShaderResources( 0, 1, &srvHandle );
+	if( m_lastTextureSRV != srvHandle )
+	{
+		m_context->PSSetShaderResources( 0, 1, &srvHandle );
+		m_lastTextureSRV = srvHandle;
+	}
 }
 
 void RenderContext::BindTextureCube( const TextureCube* texture )
@@ -345,6 +354,10 @@ void RenderContext::BindTextureOnSlot( uint slot, const Texture* texture )
 		TextureView* shaderResourceView = tex->GetOrCreateShaderResourceView();
 		ID3D11ShaderResourceView* srvHandle = shaderResourceView->GetAsSRV();
 		m_context->PSSetShaderResources( slot, 1, &srvHandle );
+		if( slot == 0 )
+		{
+			m_lastTextureSRV = srvHandle;
+		}
 	}
 }
 
@@ -392,6 +405,7 @@ void RenderContext::BindShaderFromFile( char const* filename )
 
 Shader* RenderContext::CreateOrGetShader( char const* filename )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	for( int index = 0; index < (int) m_shaderList.size(); index++ )
 	{
 		if( strcmp(m_shaderList[index]->GetFilePath(), filename) == 0 )
@@ -504,6 +518,7 @@ void RenderContext::BindMaterialFromName( const std::string& name )
 
 Texture* RenderContext::CreateOrGetTextureFromFile( const char* imageFilePath )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	for (int index = 0;index < (int) m_textureList.size();index++)
 	{
 		if (m_textureList[index]->GetFilePath() == imageFilePath)
@@ -511,6 +526,17 @@ Texture* RenderContext::CreateOrGetTextureFromFile( const char* imageFilePath )
 			return m_textureList[index];
 		}
 	}
+
+	// already decoding on a worker, no sense starting over
+	QueuedTexture* queuedTexture = FindQueuedTexture( imageFilePath );
+	if( queuedTexture != nullptr )
+	{
+		if( g_theJobSystem != nullptr )
+		{
+			g_theJobSystem->WaitFor( queuedTexture->m_decodeCounter );
+		}
+		return CreateTextureFromImage( *queuedTexture->m_image );
+	}
 	return CreateTextureFromFile( imageFilePath );
 }
 
@@ -544,14 +570,6 @@ void RenderContext::DrawVertexArray( int numVertexes, const Vertex_PCU* vertexes
 	DrawMesh( m_immediateMesh );
 }
 
-void RenderContext::DrawVertexArray( const std::vector<Vertex_PCU> vertexes )
-{
-	if ( (int) vertexes.size() == 0 )
-		return;
-
-	DrawVertexArray( (int) vertexes.size(), &vertexes[0] );
-}
-
 void RenderContext::DrawLine( const Vec2& startVec2, const Vec2& endVec2, const Rgba8& color, float thickness )
 {
 	const float r = thickness * 0.5f;
@@ -1129,6 +1147,7 @@ BitmapFont* RenderContext::CreateBitmapFontFromFile( const char* filePath, const
 
 BitmapFont* RenderContext::CreateOrGetBitmapFont( const char* bitmapFontFilePathNoExtension )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	for( int index = 0; index < m_loadedFonts.size(); index++ )
 	{
 		if( m_loadedFonts[index]->m_fontName == bitmapFontFilePathNoExtension )
@@ -1141,6 +1160,7 @@ BitmapFont* RenderContext::CreateOrGetBitmapFont( const char* bitmapFontFilePath
 
 BitmapFont* RenderContext::CreateOrGetBitmapFont( const char* bitmapFontFilePathNoExtension, const IntVec2& simpleGridLayout )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	for( int index = 0; index < m_loadedFonts.size(); index++ )
 	{
 		if( m_loadedFonts[index]->m_fontName == bitmapFontFilePathNoExtension )
@@ -1153,6 +1173,7 @@ BitmapFont* RenderContext::CreateOrGetBitmapFont( const char* bitmapFontFilePath
 
 Texture* RenderContext::CreateRenderTarget( const IntVec2& texelSize )
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	D3D11_TEXTURE2D_DESC desc;
 	desc.Width = texelSize.x;
 	desc.Height = texelSize.y;
@@ -1245,27 +1266,22 @@ void RenderContext::UpdateLayoutIfNeeded()
 
 Texture* RenderContext::CreateTextureFromFile( const char* imageFilePath )
 {
-	//unsigned int textureID = 0;
-	int imageTexelSizeX = 0; // This will be filled in for us to indicate image width
-	int imageTexelSizeY = 0; // This will be filled in for us to indicate image height
-	int numComponents = 0; // This will be filled in for us to indicate how many color components the image had (e.g. 3=RGB=24bit, 4=RGBA=32bit)
-	int numComponentsRequested = 4; // don't care; we support 3 (24-bit RGB) or 4 (32-bit RGBA)
-	
-	// Load (and decompress) the image RGB(A) bytes from a file on disk into a memory buffer (array of bytes)
-	stbi_set_flip_vertically_on_load( 1 ); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
-	unsigned char* imageData = stbi_load( imageFilePath, &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
+	// Image flips so uvTexCoords has origin (0,0) at BOTTOM LEFT
+	Image image( imageFilePath );
+	return CreateTextureFromImage( image );
+}
+
+Texture* RenderContext::CreateTextureFromImage( const Image& image )
+{
+	IntVec2 dimensions = image.GetDimensions();
 
-	// Check if the load was successful
-	GUARANTEE_OR_DIE( imageData, Stringf( "Failed to load image \"%s\"", imageFilePath ) );
-	GUARANTEE_OR_DIE( numComponents == 4 && imageTexelSizeX > 0 && imageTexelSizeY > 0, Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)", imageFilePath, numComponents, imageTexelSizeX, imageTexelSizeY ) );
-	
 	// describe the texture
 	D3D11_TEXTURE2D_DESC desc;
-	desc.Width = imageTexelSizeX;
-	desc.Height = imageTexelSizeY;
+	desc.Width = dimensions.x;
+	desc.Height = dimensions.y;
 	desc.MipLevels = 1; // setting to 0 means there's a full chain (or can generate a full chain)
 	desc.ArraySize = 1; // only one texture
-	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // for now assume 4 channel RGBA
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // Image is always 4 channel RGBA
 	desc.SampleDesc.Count = 1;
 	desc.SampleDesc.Quality = 0;
 	desc.Usage = D3D11_USAGE_IMMUTABLE; // loaded from image - probably not changing
@@ -1273,20 +1289,185 @@ Texture* RenderContext::CreateTextureFromFile( const char* imageFilePath )
 	desc.CPUAccessFlags = 0; // Determines how I can access this resource CPU side 
 	desc.MiscFlags = 0;
 
+	// straight from the Image's texels, D3D keeps its own copy
 	D3D11_SUBRESOURCE_DATA initialData;
-	initialData.pSysMem = imageData;
-	initialData.SysMemPitch = imageTexelSizeX * 4;
+	initialData.pSysMem = image.GetTexelsBuffer();
+	initialData.SysMemPitch = dimensions.x * 4;
 	initialData.SysMemSlicePitch = 0;
 
 	// DirectX Creation
 	ID3D11Texture2D* texHandle = nullptr;
 	m_device->CreateTexture2D( &desc, &initialData, &texHandle );
 
-	//// Free the raw image texel data now that we've sent a copy of it down to the GPU to be stored in video memory
-	stbi_image_free( imageData );
-	Texture* tex = new Texture( imageFilePath, this, texHandle );
-	m_textureList.push_back( tex );
-	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Texture %s loading succeed!", imageFilePath ) );
+	const std::string& imageFilePath = image.GetImageFilePath();
+	Texture* tex = new Texture( imageFilePath.c_str(), this, texHandle );
+	{
+		std::lock_guard<std::mutex> lock( m_textureListMutex );
+		m_textureList.push_back( tex );
+	}
+	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Texture %s loading succeed!", imageFilePath.c_str() ) );
 	
 	return tex;
+}
+
+void RenderContext::PreloadTexturesFromFiles( const std::vector<std::string>& imageFilePaths )
+{
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
+	std::vector<std::string> filePathsToLoad;
+	for( const std::string& imageFilePath : imageFilePaths )
+	{
+		bool isLoaded = false;
+		for( int index = 0; index < (int)m_textureList.size() && !isLoaded; index++ )
+		{
+			isLoaded = m_textureList[index]->GetFilePath() == imageFilePath;
+		}
+		if( !isLoaded )
+		{
+			filePathsToLoad.push_back( imageFilePath );
+		}
+	}
+
+	std::vector<Image*> images;
+	LoadImagesInParallel( filePathsToLoad, images );
+	for( Image* image : images )
+	{
+		CreateTextureFromImage( *image );
+		delete image;
+	}
+}
+
+void RenderContext::QueueTextureFromFile( const std::string& imageFilePath )
+{
+	QueuedTexture* queuedTexture = nullptr;
+	{
+		std::lock_guard<std::mutex> lock( m_textureListMutex );
+		for( const Texture* texture : m_textureList )
+		{
+			if( texture->GetFilePath() == imageFilePath )
+			{
+				return;
+			}
+		}
+		for( const QueuedTexture& alreadyQueued : m_queuedTextures )
+		{
+			if( alreadyQueued.m_filePath == imageFilePath )
+			{
+				return;
+			}
+		}
+		m_queuedTextures.emplace_back();
+		queuedTexture = &m_queuedTextures.back();
+		queuedTexture->m_filePath = imageFilePath;
+	}
+
+	auto decodeImage = [queuedTexture]()
+	{
+		MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
+		queuedTexture->m_image = new Image( queuedTexture->m_filePath.c_str() );
+	};
+	if( g_theJobSystem != nullptr )
+	{
+		g_theJobSystem->Run( decodeImage, &queuedTexture->m_decodeCounter );
+	}
+	else
+	{
+		decodeImage();
+	}
+}
+
+void RenderContext::FinishQueuedTextures()
+{
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
+	std::deque<QueuedTexture> queuedTextures;
+	{
+		std::lock_guard<std::mutex> lock( m_textureListMutex );
+		queuedTextures.swap( m_queuedTextures );
+	}
+
+	for( QueuedTexture& queuedTexture : queuedTextures )
+	{
+		if( g_theJobSystem != nullptr )
+		{
+			g_theJobSystem->WaitFor( queuedTexture.m_decodeCounter );
+		}
+
+		// CreateOrGetTextureFromFile may have wanted it sooner
+		bool isLoaded = false;
+		for( int index = 0; index < (int)m_textureList.size() && !isLoaded; index++ )
+		{
+			isLoaded = m_textureList[index]->GetFilePath() == queuedTexture.m_filePath;
+		}
+		if( !isLoaded )
+		{
+			CreateTextureFromImage( *queuedTexture.m_image );
+		}
+		delete queuedTexture.m_image;
+	}
+}
+
+RenderContext::QueuedTexture* RenderContext::FindQueuedTexture( const std::string& imageFilePath )
+{
+	std::lock_guard<std::mutex> lock( m_textureListMutex );
+	for( QueuedTexture& queuedTexture : m_queuedTextures )
+	{
+		if( queuedTexture.m_filePath == imageFilePath )
+		{
+			return &queuedTexture;
+		}
+	}
+	return nullptr;
+}
+
+Texture* RenderContext::CreateTextureAtlas( const char* atlasName, const std::vector<std::string>& imageFilePaths, const std::vector<IntVec2>& spriteLayouts )
+{
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
+	GUARANTEE_OR_DIE( imageFilePaths.size() == spriteLayouts.size(), "CreateTextureAtlas needs a sprite layout for every image" );
+
+	// anything already handed out as its own texture has to stay that way
+	std::vector<std::string> filePathsToPack;
+	std::vector<IntVec2> layoutsToPack;
+	for( int pathIndex = 0; pathIndex < (int)imageFilePaths.size(); pathIndex++ )
+	{
+		bool isLoaded = false;
+		for( int index = 0; index < (int)m_textureList.size() && !isLoaded; index++ )
+		{
+			isLoaded = m_textureList[index]->GetFilePath() == imageFilePaths[pathIndex];
+		}
+		if( isLoaded )
+		{
+			g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "%s is already a texture, left out of %s", imageFilePaths[pathIndex].c_str(), atlasName ) );
+			continue;
+		}
+		filePathsToPack.push_back( imageFilePaths[pathIndex] );
+		layoutsToPack.push_back( spriteLayouts[pathIndex] );
+	}
+
+	std::vector<Image*> images;
+	LoadImagesInParallel( filePathsToPack, images );
+
+	ImageAtlas atlas;
+	for( int imageIndex = 0; imageIndex < (int)images.size(); imageIndex++ )
+	{
+		atlas.AddImage( *images[imageIndex], layoutsToPack[imageIndex] );
+	}
+	GUARANTEE_OR_DIE( atlas.Pack(), Stringf( "%s doesn't fit in one texture", atlasName ) );
+
+	Image& atlasImage = *atlas.GetAtlasImage();
+	atlasImage.SetImageFilePath( atlasName );
+	Texture* atlasTexture = CreateTextureFromImage( atlasImage );
+	for( const ImageAtlasEntry& entry : atlas.GetEntries() )
+	{
+		std::lock_guard<std::mutex> lock( m_textureListMutex );
+		m_textureList.push_back( new Texture( entry, atlasTexture ) );
+	}
+
+	IntVec2 atlasDimensions = atlasImage.GetDimensions();
+	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "%s: %i images in %ix%i, %.0f%% used", atlasName, (int)images.size(),
+		atlasDimensions.x, atlasDimensions.y, atlas.GetPackedFraction() * 100.f ) );
+
+	for( Image* image : images )
+	{
+		delete image;
+	}
+	return atlasTexture;
 }
\ No newline at end of file
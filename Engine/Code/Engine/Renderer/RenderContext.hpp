@@ -12,6 +12,9 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Polygon2.hpp"
 #include "Engine/Platform/Window.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <deque>
+#include <mutex>
 #include <vector>
 #include <map>
 
@@ -30,6 +33,7 @@ class Sampler;
 class GPUMesh;
 class Material;
 class TextureCube;
+class Image;
 
 struct light_t
 {
@@ -131,7 +135,16 @@ public:
 	//------------------------------------------------------------------------------------------------------------------------
 	Shader*		 CreateOrGetShader( char const* filename );
 	Texture*	 CreateOrGetTextureFromFile( const char* imageFilePath );
+	Texture*	 CreateTextureFromImage( const Image& image );
 	Texture*	 CreateTextureFromColor( Rgba8 color );
+	void		 PreloadTexturesFromFiles( const std::vector<std::string>& imageFilePaths );		// decodes on the job system, creates on this thread
+	// Callable from any thread, the decode starts on the job system straight away. The texture is
+	// created by FinishQueuedTextures, or earlier by CreateOrGetTextureFromFile waiting on that one decode.
+	void		 QueueTextureFromFile( const std::string& imageFilePath );
+	void		 FinishQueuedTextures();		// main thread, creates everything queued so far
+	// Packs every image, a cell at a time, into one texture. Afterwards each path resolves to a
+	// region of it, so only pass images that are drawn through a SpriteSheet or BitmapFont.
+	Texture*	 CreateTextureAtlas( const char* atlasName, const std::vector<std::string>& imageFilePaths, const std::vector<IntVec2>& spriteLayouts );
 	BitmapFont*  CreateOrGetBitmapFont( const char* bitmapFontFilePathNoExtension );
 	BitmapFont*  CreateOrGetBitmapFont( const char* bitmapFontFilePathNoExtension, const IntVec2& simpleGridLayout );
 	Texture*	 CreateRenderTarget( const IntVec2& texelSize );
@@ -183,7 +196,8 @@ public:
 	void Draw( int numVertexes, int vertexOffset = 0 );
 	void DrawIndexed( int indexCount, int vertexOffset, int baseVertexOffset );
 	void DrawVertexArray( int numVertexes, const Vertex_PCU* vertexes );
-	void DrawVertexArray( const std::vector<Vertex_PCU> vertexes );
+	template <typename VERTEX_ALLOCATOR>
+	void DrawVertexArray( std::vector<Vertex_PCU, VERTEX_ALLOCATOR> const& vertexes )	{ if( !vertexes.empty() ) { DrawVertexArray( (int)vertexes.size(), vertexes.data() ); } }
 	void DrawLine( const Vec2& startVec2, const Vec2& endVec2, const Rgba8& color, float thickness );
 	void DrawLinesFromPoints( int pointsCount, const Vec2* points, const Rgba8& color, float thickness );
 	void DrawAABB2D( const AABB2& bounds, const Rgba8& tint );
@@ -196,16 +210,28 @@ public:
 	void DrawText2D( const std::string& text, const Vec2& position, float size, BitmapFont* font, const Rgba8& color );
 	void DrawMesh( GPUMesh* mesh );
 
+private:
+	struct QueuedTexture
+	{
+		std::string m_filePath;
+		Image* m_image = nullptr;
+		JobCounter m_decodeCounter;
+	};
+
 private:
 	void		UpdateLayoutIfNeeded();
 	BitmapFont* CreateBitmapFontFromFile( const char* filePath );
 	BitmapFont* CreateBitmapFontFromFile( const char* filePath, const IntVec2& simpleGridLayout );
 	Texture*	CreateTextureFromFile( const char* imageFilePath );
+	QueuedTexture* FindQueuedTexture( const std::string& imageFilePath );
 	void		CreateBlendState();
 	void		CreateDefaultRasterState();
 
 private:
+	// only the main thread adds textures, under this lock so QueueTextureFromFile can look from anywhere
+	std::mutex m_textureListMutex;
 	std::vector<Texture*> m_textureList;
+	std::deque<QueuedTexture> m_queuedTextures;		// deque so entries stay put while their decode job runs
 	std::vector<Shader*> m_shaderList;
 	std::vector<BitmapFont*> m_loadedFonts;
 	std::map<std::string, std::vector<Vertex_PCUTBN>> m_objList;
@@ -217,6 +243,7 @@ public:
 	bool m_isDrawing = false;
 	ID3D11Device*			m_device = nullptr;
 	ID3D11Buffer*			m_lastVBO = nullptr;
+	ID3D11ShaderResourceView* m_lastTextureSRV = nullptr;		// slot 0, atlas regions share one
 	ID3D11DeviceContext*	m_context = nullptr; // Immediate context
 
 	bool		m_shaderHasChanged = false;
@@ -5,38 +5,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include <stdio.h>
 #include <d3dcompiler.h>
-#include "..\Core\FileUtils.hpp"
-
-void* FileRendToNewBuffer( std::string const& filename, size_t *out_size = nullptr )
-{
-	FILE* fp = nullptr;
-	fopen_s( &fp, filename.c_str(), "r" );
-	if ( fp == nullptr )
-	{
-		return nullptr;
-	}
-
-	// get the size of the file
-	fseek( fp, 0, SEEK_END );
-	long file_size = ftell(fp);
-
-	unsigned char* buffer = new unsigned char[file_size + 1];
-	if ( nullptr != buffer )
-	{
-		fseek( fp, 0, SEEK_SET );
-		size_t bytes_read = fread( buffer, 1, (size_t)file_size, fp );
-		buffer[bytes_read] = NULL;
-
-		if( out_size != nullptr )
-		{
-			*out_size = (size_t)file_size;
-		}
-	}
-
-	fclose( fp );
-
-	return buffer;
-}
+#include "Engine/Core/FileView.hpp"
 
 Shader::Shader( RenderContext* context )
 	:m_owner(context)
@@ -50,16 +19,15 @@ Shader::~Shader()
 
 bool Shader::CreateFromFile( std::string const& filename )
 {
-	size_t file_size = 0;
-	void* source = FileRendToNewBuffer( filename, &file_size );
-	if (source == nullptr)
+	// both stages compile straight out of the mapped file
+	FileView source( filename );
+	if ( !source.IsOpen() )
 	{
 		return false;
 	}
-	m_vertexStage.Complie( m_owner, filename, source, file_size, SHADER_STAGE_VERTEX );
-	m_fragmentStage.Complie( m_owner, filename, source, file_size, SHADER_STAGE_FRAGMENT );
+	m_vertexStage.Complie( m_owner, filename, source.GetData(), source.GetSize(), SHADER_STAGE_VERTEX );
+	m_fragmentStage.Complie( m_owner, filename, source.GetData(), source.GetSize(), SHADER_STAGE_FRAGMENT );
 
-	delete[] source;
 	m_fileName = filename;
 
 	return m_vertexStage.IsValid() && m_fragmentStage.IsValid();
@@ -3,13 +3,30 @@
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DefinitionCache.hpp"
+#include "Engine/Core/StringID.hpp"
 
-static std::map< std::string, ShaderState* > s_definitionMap;
+static StringIDMap<ShaderState*> s_definitionMap;
+constexpr unsigned int SHADER_STATE_CACHE_VERSION = 1;		// bump whenever AppendToBuffer changes
 
 STATIC void ShaderState::LoadDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath )
 {
+	DefinitionCache cache( "ShaderStateDefs", SHADER_STATE_CACHE_VERSION );
+	cache.AddSourceFile( deinitionsXmlFilePath );
+	if( cache.Load() )
+	{
+		BufferParser& parser = cache.GetParser();
+		int numDefinitions = parser.ParseInt32();
+		for( int definitionIndex = 0; definitionIndex < numDefinitions; definitionIndex++ )
+		{
+			ShaderState* newShaderStateDef = new ShaderState( context, parser );
+			s_definitionMap[InternStringID( newShaderStateDef->m_name )] = newShaderStateDef;
+		}
+		return;
+	}
+
 	XmlDocument mapXmlDoc;
-	mapXmlDoc.LoadFile( &deinitionsXmlFilePath[0] );
+	LoadXmlDocumentFromFile( mapXmlDoc, deinitionsXmlFilePath );
 	XmlElement* mapDefsElement = mapXmlDoc.RootElement();
 	if( mapDefsElement == nullptr )
 	{
@@ -20,22 +37,27 @@ STATIC void ShaderState::LoadDefinitions( RenderContext* context, const std::str
 	while( shaderStateDefElement )
 	{
 		ShaderState* newShaderStateDef = new ShaderState( context, *shaderStateDefElement );
-		if( s_definitionMap.count( newShaderStateDef->m_name ) > 0 )
+		if( s_definitionMap.count( HashStringID( newShaderStateDef->m_name ) ) > 0 )
 		{
 			ERROR_AND_DIE( Stringf( "ShaderState Definitions include the same name \"%s\"", newShaderStateDef->m_name.c_str() ) );
 		}
-		s_definitionMap[newShaderStateDef->m_name] = newShaderStateDef;
+		s_definitionMap[InternStringID( newShaderStateDef->m_name )] = newShaderStateDef;
 		shaderStateDefElement = shaderStateDefElement->NextSiblingElement();
 	}
+
+	BufferWriter& writer = cache.GetWriter();
+	writer.AppendInt32( (int)s_definitionMap.size() );
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->AppendToBuffer( writer );
+	}
+	cache.Save();
 }
 
 STATIC ShaderState* ShaderState::GetDefinitions( const std::string& deinitionsName )
 {
-	if( s_definitionMap.count( deinitionsName ) > 0 )
-	{
-		return s_definitionMap.at( deinitionsName );
-	}
-	return nullptr;
+	auto found = s_definitionMap.find( HashStringID( deinitionsName ) );
+	return found != s_definitionMap.end() ? found->second : nullptr;
 }
 
 ShaderState::ShaderState( RenderContext* context, const XmlElement& definitionXmlElement )
@@ -162,6 +184,31 @@ ShaderState::ShaderState( RenderContext* context, const XmlElement& definitionXm
 	}
 }
 
+ShaderState::ShaderState( RenderContext* context, BufferParser& parser )
+{
+	m_name = parser.ParseString();
+	std::string path = parser.ParseString();
+	m_shader = context->CreateOrGetShader( &path[0] );
+	m_writeDepth = parser.ParseBool();
+	m_blendMode = (eBlendMode)parser.ParseByte();
+	m_depth = (eCompareOp)parser.ParseByte();
+	m_windingOrder = (eWindingOrder)parser.ParseByte();
+	m_cullMode = (eCullMode)parser.ParseByte();
+	m_fillMode = (eFillMode)parser.ParseByte();
+}
+
 ShaderState::~ShaderState()
 {
 }
+
+void ShaderState::AppendToBuffer( BufferWriter& writer ) const
+{
+	writer.AppendString( m_name );
+	writer.AppendString( m_shader != nullptr ? m_shader->GetFilePath() : "" );
+	writer.AppendBool( m_writeDepth );
+	writer.AppendByte( (unsigned char)m_blendMode );
+	writer.AppendByte( (unsigned char)m_depth );
+	writer.AppendByte( (unsigned char)m_windingOrder );
+	writer.AppendByte( (unsigned char)m_cullMode );
+	writer.AppendByte( (unsigned char)m_fillMode );
+}
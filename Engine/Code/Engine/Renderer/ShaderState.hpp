@@ -5,6 +5,8 @@
 
 class Shader;
 class RenderContext;
+class BufferWriter;
+class BufferParser;
 
 enum class eWindingOrder
 {
@@ -52,8 +54,11 @@ public:
 
 public:
 	explicit ShaderState( RenderContext* context, const XmlElement& definitionXmlElement );
+	explicit ShaderState( RenderContext* context, BufferParser& parser );		// from the definition cache
 	~ShaderState();
 
+	void AppendToBuffer( BufferWriter& writer ) const;
+
 public:
 	Shader* m_shader;
 
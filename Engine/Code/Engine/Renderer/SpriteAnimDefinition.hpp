@@ -17,6 +17,10 @@ public:
 		float durationSeconds, SpriteAnimPlaybackType playbackType = SpriteAnimPlaybackType::LOOP );
 
 	const SpriteDefinition& GetSpriteDefAtTime( float seconds ) const;
+	const SpriteSheet&		GetSpriteSheet() const		{ return m_spriteSheet; }
+	float					GetDurationSeconds() const	{ return m_durationSeconds; }
+	SpriteAnimPlaybackType	GetPlaybackType() const		{ return m_playbackType; }
+	const std::vector<int>&	GetSpriteIndexes() const	{ return m_spriteIndexes; }
 
 private:
 	const SpriteSheet&		m_spriteSheet;
@@ -27,7 +27,8 @@ const Texture& SpriteDefinition::GetTexture() const
 
 float SpriteDefinition::GetAspect() const
 {
-	float textureAspect = m_spriteSheet.GetTexture().GetAspect();
+	// the uvs are in whatever gets bound, the atlas if the sheet was packed into one
+	float textureAspect = m_spriteSheet.GetTexture().GetBoundTexture()->GetAspect();
 	float uvWidth = fabsf( m_uvAtMaxs.x - m_uvAtMins.x );
 	float uvHeight = fabsf( m_uvAtMaxs.y - m_uvAtMins.y );
 	return textureAspect * ( uvWidth / uvHeight );
@@ -20,9 +20,9 @@ SpriteSheet::SpriteSheet( const Texture& texture, const IntVec2& simpleGridLayou
 		float vAtMaxY = 1.0f - vPerSpriteGridY * static_cast<float>( spriteGridY );
 		float uAtMaxX = uAtMinX + uPerSpriteGridX;
 		float vAtMinY = vAtMaxY - vPerSpriteGridY;
-		Vec2 uvAtMins( uAtMinX, vAtMinY );
-		Vec2 uvAtMaxs( uAtMaxX, vAtMaxY );
-		m_spriteDefs.push_back( SpriteDefinition( *this, spriteIndex, uvAtMins, uvAtMaxs ) );
+		// an atlased texture moves each cell to wherever it got packed
+		AABB2 uvs = texture.GetAtlasUVs( AABB2( uAtMinX, vAtMinY, uAtMaxX, vAtMaxY ) );
+		m_spriteDefs.push_back( SpriteDefinition( *this, spriteIndex, uvs.mins, uvs.maxs ) );
 	}
 }
 
@@ -2,6 +2,8 @@
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/TextureView.hpp"
 #include "Engine/Renderer/D3D11Common.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <math.h>
 
 Texture::Texture( const char* filePath, RenderContext* ctx, ID3D11Texture2D* handle )
 	: Texture(ctx, handle)
@@ -48,6 +50,16 @@ Texture::Texture( RenderContext* ctx, ID3D11Texture2D* handle )
 	m_dimensions = IntVec2( desc.Width, desc.Height );
 }
 
+Texture::Texture( const ImageAtlasEntry& atlasEntry, Texture* atlas )
+	:m_owner( atlas->GetRenderContext() ),
+	m_imageFilePath( atlasEntry.m_name ),
+	m_dimensions( atlasEntry.m_sourceDimensions ),
+	m_atlas( atlas ),
+	m_atlasCellLayout( atlasEntry.m_cellLayout ),
+	m_atlasCells( atlasEntry.m_cells )
+{
+}
+
 Texture::~Texture()
 {
 	delete m_renderTargetView;
@@ -82,6 +94,11 @@ TextureView* Texture::GetOrCreateRenderTargetView()
 
 TextureView* Texture::GetOrCreateShaderResourceView()
 {
+	if( m_atlas != nullptr )
+	{
+		return m_atlas->GetOrCreateShaderResourceView();
+	}
+
 	if ( m_shaderResourceView != nullptr )
 	{
 		return m_shaderResourceView;
@@ -187,3 +204,20 @@ float Texture::GetAspect() const
 {
 	return (float) m_dimensions.x / (float) m_dimensions.y;
 }
+
+AABB2 Texture::GetAtlasUVs( const AABB2& uvs ) const
+{
+	if( m_atlas == nullptr )
+	{
+		return uvs;
+	}
+
+	Vec2 center = uvs.GetCenter();
+	int cellX = Clamp( (int)floorf( center.x * (float)m_atlasCellLayout.x ), 0, m_atlasCellLayout.x - 1 );
+	int cellYFromTop = Clamp( m_atlasCellLayout.y - 1 - (int)floorf( center.y * (float)m_atlasCellLayout.y ), 0, m_atlasCellLayout.y - 1 );
+	const ImageAtlasCell& cell = m_atlasCells[cellYFromTop * m_atlasCellLayout.x + cellX];
+
+	Vec2 atlasMins = cell.m_atlasUVs.GetPointAtUV( cell.m_sourceUVs.GetUVForPoint( uvs.mins ) );
+	Vec2 atlasMaxs = cell.m_atlasUVs.GetPointAtUV( cell.m_sourceUVs.GetUVForPoint( uvs.maxs ) );
+	return AABB2( atlasMins, atlasMaxs );
+}
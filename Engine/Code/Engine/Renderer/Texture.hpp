@@ -2,6 +2,7 @@
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ImageAtlas.hpp"
 #include <string>
 
 class RenderContext;
@@ -15,6 +16,7 @@ public:
 	explicit Texture( const char* filePath, RenderContext* ctx, ID3D11Texture2D* handle );
 	explicit Texture( const Rgba8& color, RenderContext* ctx );
 	explicit Texture( RenderContext* ctx, ID3D11Texture2D* handle );
+	explicit Texture( const ImageAtlasEntry& atlasEntry, Texture* atlas );		// a region of atlas, binds as the atlas
 	~Texture();
 
 	TextureView* GetOrCreateRenderTargetView();
@@ -27,6 +29,12 @@ public:
 	float				GetAspect() const;
 	RenderContext*		GetRenderContext() const { return m_owner; }
 	ID3D11Texture2D*	GetHandle() const { return m_handle; }
+	bool				IsInAtlas() const { return m_atlas != nullptr; }
+	const Texture*		GetBoundTexture() const { return m_atlas != nullptr ? m_atlas : this; }
+
+	// uvs within this image to uvs within whatever actually gets bound. Atlased sprite sheets
+	// are packed a cell at a time, so a rect must stay inside the cell its center falls in.
+	AABB2				GetAtlasUVs( const AABB2& uvs ) const;
 
 	static Texture* CreateDepthStencilBuffer( RenderContext* ctx, uint widht, uint height );
 
@@ -36,6 +44,10 @@ private:
 	std::string m_imageFilePath;
 	IntVec2		m_dimensions;
 
+	Texture*					m_atlas = nullptr;
+	IntVec2						m_atlasCellLayout = IntVec2( 1, 1 );
+	std::vector<ImageAtlasCell>	m_atlasCells;
+
 	TextureView*  m_renderTargetView = nullptr;
 	TextureView*  m_shaderResourceView = nullptr;
 	TextureView*  m_depthStencilView = nullptr;
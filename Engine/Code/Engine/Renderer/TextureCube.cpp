@@ -75,7 +75,7 @@ TextureCube::TextureCube( RenderContext* ctx, Image& src )
 	int pitch = width * 4;
 	int total_pitch = 4 * pitch;
 	int row = width * total_pitch;
-	unsigned char* start = src.GetTexelsBuffer();
+	const unsigned char* start = src.GetTexelsBuffer();
 
 	int offsets[] =
 	{
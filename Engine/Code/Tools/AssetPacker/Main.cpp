@@ -0,0 +1,299 @@
+//-----------------------------------------------------------------------------------------------
+// AssetPacker: packs a data folder into an asset archive the engine can mount (see AssetArchive.hpp)
+//
+//	AssetPacker <dataFolder> <archive> [-compress] [-align=N] [-exclude=<pattern>]...
+//
+// Paths are stored relative to the folder the packer runs from, so run it from the game's Run
+// folder, e.g. "AssetPacker Data Data.pak -compress -exclude=Data/GameConfig.xml".
+//-----------------------------------------------------------------------------------------------
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/Compression.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+//-----------------------------------------------------------------------------------------------
+struct PackedFile
+{
+	std::string m_path;
+	AssetArchiveEntry m_entry;
+};
+
+struct PackerOptions
+{
+	std::string m_dataFolder;
+	std::string m_archivePath;
+	bool m_compress = false;
+	unsigned int m_alignment = 64;
+	std::vector<std::string> m_excludePatterns;
+};
+
+//-----------------------------------------------------------------------------------------------
+static bool IsExcluded( PackerOptions const& options, std::string const& path )
+{
+	for( std::string const& pattern : options.m_excludePatterns )
+	{
+		if( DoesFileNameMatchPattern( path.c_str(), pattern.c_str() ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static void GatherFilesInFolder( PackerOptions const& options, std::string const& folderPath, std::vector<std::string>& out_filePaths )
+{
+#ifdef _WIN32
+	std::string searchPattern = folderPath + "/*";
+	_finddata_t fileInfo;
+	intptr_t searchHandle = _findfirst( searchPattern.c_str(), &fileInfo );
+	if( searchHandle == -1 )
+	{
+		return;
+	}
+	do
+	{
+		if( strcmp( fileInfo.name, "." ) == 0 || strcmp( fileInfo.name, ".." ) == 0 )
+		{
+			continue;
+		}
+
+		std::string path = folderPath + "/" + fileInfo.name;
+		if( ( fileInfo.attrib & _A_SUBDIR ) != 0 )
+		{
+			GatherFilesInFolder( options, path, out_filePaths );
+		}
+		else if( !IsExcluded( options, path ) )
+		{
+			out_filePaths.push_back( path );
+		}
+	} while( _findnext( searchHandle, &fileInfo ) == 0 );
+	_findclose( searchHandle );
+#else
+	DIR* folder = opendir( folderPath.c_str() );
+	if( folder == nullptr )
+	{
+		return;
+	}
+	while( dirent* folderEntry = readdir( folder ) )
+	{
+		if( strcmp( folderEntry->d_name, "." ) == 0 || strcmp( folderEntry->d_name, ".." ) == 0 )
+		{
+			continue;
+		}
+
+		std::string path = folderPath + "/" + folderEntry->d_name;
+		struct stat fileStatus;
+		if( stat( path.c_str(), &fileStatus ) != 0 )
+		{
+			continue;
+		}
+		if( S_ISDIR( fileStatus.st_mode ) )
+		{
+			GatherFilesInFolder( options, path, out_filePaths );
+		}
+		else if( !IsExcluded( options, path ) )
+		{
+			out_filePaths.push_back( path );
+		}
+	}
+	closedir( folder );
+#endif
+}
+
+static bool ReadWholeFile( std::string const& path, std::vector<unsigned char>& out_bytes )
+{
+	FILE* file = fopen( path.c_str(), "rb" );
+	if( file == nullptr )
+	{
+		return false;
+	}
+
+	fseek( file, 0, SEEK_END );
+	long fileSize = ftell( file );
+	fseek( file, 0, SEEK_SET );
+	out_bytes.resize( fileSize > 0 ? (size_t)fileSize : 0 );
+	size_t bytesRead = out_bytes.empty() ? 0 : fread( out_bytes.data(), 1, out_bytes.size(), file );
+	fclose( file );
+	return bytesRead == out_bytes.size();
+}
+
+static void PadToAlignment( FILE* archive, unsigned long long& offset, unsigned int alignment )
+{
+	static char const zeroes[4096] = {};
+	unsigned long long alignedOffset = ( offset + alignment - 1 ) / alignment * alignment;
+	while( offset < alignedOffset )
+	{
+		size_t padding = (size_t)std::min<unsigned long long>( alignedOffset - offset, sizeof( zeroes ) );
+		fwrite( zeroes, 1, padding, archive );
+		offset += padding;
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+static bool ParseOptions( int argc, char** argv, PackerOptions& out_options )
+{
+	std::vector<std::string> positionalArgs;
+	for( int argIndex = 1; argIndex < argc; argIndex++ )
+	{
+		char const* arg = argv[argIndex];
+		if( strcmp( arg, "-compress" ) == 0 )
+		{
+			out_options.m_compress = true;
+		}
+		else if( strncmp( arg, "-align=", 7 ) == 0 )
+		{
+			out_options.m_alignment = (unsigned int)atoi( arg + 7 );
+		}
+		else if( strncmp( arg, "-exclude=", 9 ) == 0 )
+		{
+			out_options.m_excludePatterns.push_back( arg + 9 );
+		}
+		else if( arg[0] == '-' )
+		{
+			printf( "Unknown option %s\n", arg );
+			return false;
+		}
+		else
+		{
+			positionalArgs.push_back( arg );
+		}
+	}
+
+	// entries and the index get read in place, so keep everything at least 8 byte aligned
+	bool isPowerOfTwo = out_options.m_alignment != 0 && ( out_options.m_alignment & ( out_options.m_alignment - 1 ) ) == 0;
+	if( positionalArgs.size() != 2 || !isPowerOfTwo || out_options.m_alignment < 8 )
+	{
+		return false;
+	}
+
+	out_options.m_dataFolder = positionalArgs[0];
+	out_options.m_archivePath = positionalArgs[1];
+	while( out_options.m_dataFolder.size() > 1 && ( out_options.m_dataFolder.back() == '/' || out_options.m_dataFolder.back() == '\\' ) )
+	{
+		out_options.m_dataFolder.pop_back();
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+	PackerOptions options;
+	if( !ParseOptions( argc, argv, options ) )
+	{
+		printf( "Usage: AssetPacker <dataFolder> <archive> [-compress] [-align=N] [-exclude=<pattern>]...\n" );
+		return 1;
+	}
+
+	std::vector<std::string> filePaths;
+	GatherFilesInFolder( options, options.m_dataFolder, filePaths );
+	std::sort( filePaths.begin(), filePaths.end() );
+
+	FILE* archive = fopen( options.m_archivePath.c_str(), "wb" );
+	if( archive == nullptr )
+	{
+		printf( "Couldn't open %s for writing\n", options.m_archivePath.c_str() );
+		return 1;
+	}
+
+	// header goes in last, once the offsets are known
+	AssetArchiveHeader header;
+	header.m_entryAlignment = options.m_alignment;
+	fwrite( &header, sizeof( header ), 1, archive );
+	unsigned long long offset = sizeof( header );
+
+	std::vector<PackedFile> packedFiles;
+	std::vector<unsigned char> fileBytes;
+	std::vector<unsigned char> compressedBytes;
+	unsigned long long totalSize = 0;
+	unsigned long long totalStoredSize = 0;
+	for( std::string const& filePath : filePaths )
+	{
+		if( !ReadWholeFile( filePath, fileBytes ) )
+		{
+			printf( "Couldn't read %s\n", filePath.c_str() );
+			fclose( archive );
+			return 1;
+		}
+
+		PackedFile packedFile;
+		packedFile.m_path = filePath;
+		packedFile.m_entry.m_pathHash = HashAssetPath( filePath.c_str(), filePath.size() );
+		packedFile.m_entry.m_size = fileBytes.size();
+
+		// only keep the compressed copy when it's worth a decompress at load time
+		unsigned char const* storedBytes = fileBytes.data();
+		size_t storedSize = fileBytes.size();
+		if( options.m_compress && !fileBytes.empty() )
+		{
+			compressedBytes.resize( GetLZ4CompressBound( fileBytes.size() ) );
+			size_t compressedSize = CompressLZ4( fileBytes.data(), fileBytes.size(), compressedBytes.data(), compressedBytes.size() );
+			if( compressedSize > 0 && compressedSize < fileBytes.size() * 9 / 10 )
+			{
+				storedBytes = compressedBytes.data();
+				storedSize = compressedSize;
+				packedFile.m_entry.m_flags |= ASSET_ARCHIVE_ENTRY_LZ4;
+			}
+		}
+
+		PadToAlignment( archive, offset, options.m_alignment );
+		packedFile.m_entry.m_dataOffset = offset;
+		packedFile.m_entry.m_storedSize = storedSize;
+		if( storedSize > 0 )
+		{
+			fwrite( storedBytes, 1, storedSize, archive );
+		}
+		offset += storedSize;
+
+		totalSize += fileBytes.size();
+		totalStoredSize += storedSize;
+		packedFiles.push_back( packedFile );
+	}
+
+	std::stable_sort( packedFiles.begin(), packedFiles.end(), []( PackedFile const& a, PackedFile const& b ) { return a.m_entry.m_pathHash < b.m_entry.m_pathHash; } );
+
+	std::string pathBlock;
+	for( PackedFile& packedFile : packedFiles )
+	{
+		packedFile.m_entry.m_pathOffset = (unsigned int)pathBlock.size();
+		pathBlock.append( packedFile.m_path.c_str(), packedFile.m_path.size() + 1 );
+	}
+
+	PadToAlignment( archive, offset, 8 );
+	header.m_numEntries = (unsigned int)packedFiles.size();
+	header.m_indexOffset = offset;
+	for( PackedFile const& packedFile : packedFiles )
+	{
+		fwrite( &packedFile.m_entry, sizeof( AssetArchiveEntry ), 1, archive );
+		offset += sizeof( AssetArchiveEntry );
+	}
+
+	header.m_pathsOffset = offset;
+	header.m_pathsSize = pathBlock.size();
+	fwrite( pathBlock.data(), 1, pathBlock.size(), archive );
+
+	fseek( archive, 0, SEEK_SET );
+	fwrite( &header, sizeof( header ), 1, archive );
+	bool wasWritten = ferror( archive ) == 0;
+	fclose( archive );
+	if( !wasWritten )
+	{
+		printf( "Failed writing %s\n", options.m_archivePath.c_str() );
+		return 1;
+	}
+
+	printf( "Packed %u files from %s into %s: %.1f KB -> %.1f KB\n", header.m_numEntries, options.m_dataFolder.c_str(),
+		options.m_archivePath.c_str(), totalSize / 1024.0, totalStoredSize / 1024.0 );
+	return 0;
+}
@@ -1,35 +1,121 @@
 #include "ActorDefinition.hpp"
 #include "GameCommon.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DefinitionCache.hpp"
 
-STATIC std::map< std::string, ActorDefinition* > ActorDefinition::s_definitionMap;
+STATIC StringIDMap<ActorDefinition*> ActorDefinition::s_definitionMap;
+constexpr unsigned int ACTOR_DEFS_CACHE_VERSION = 1;		// bump whenever AppendToBuffer changes
 
-STATIC void ActorDefinition::LoadDefinitions( const std::string& deinitionsXmlFilePath )
+STATIC void ActorDefinition::ParseDefinitions( const std::string& deinitionsXmlFilePath )
 {
+	DefinitionCache cache( "ActorDefs", ACTOR_DEFS_CACHE_VERSION );
+	cache.AddSourceFile( deinitionsXmlFilePath );
+	cache.AddSourceValue( g_gameConfigBlackboard.GetValue( g_gameConfigSlots.m_imgFilePrefix, "Data/Images/" ) );
+	if( cache.Load() )
+	{
+		BufferParser& parser = cache.GetParser();
+		int numDefinitions = parser.ParseInt32();
+		for( int definitionIndex = 0; definitionIndex < numDefinitions; definitionIndex++ )
+		{
+			ActorDefinition* newActorDef = new ActorDefinition( parser );
+			s_definitionMap[InternStringID( newActorDef->m_name )] = newActorDef;
+		}
+		return;
+	}
+
+	for( ActorDefinition* newActorDef : ParseDefinitionsFile( deinitionsXmlFilePath ) )
+	{
+		s_definitionMap[InternStringID( newActorDef->m_name )] = newActorDef;
+	}
+
+	BufferWriter& writer = cache.GetWriter();
+	writer.AppendInt32( (int)s_definitionMap.size() );
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->AppendToBuffer( writer );
+	}
+	cache.Save();
+}
+
+STATIC void ActorDefinition::LinkDefinitions()
+{
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->m_animSetDef->CreateSpriteAnims();
+	}
+}
+
+STATIC ActorDefinition* ActorDefinition::GetDefinitions( const std::string& deinitionsName )
+{
+	auto found = s_definitionMap.find( HashStringID( deinitionsName ) );
+	return found != s_definitionMap.end() ? found->second : nullptr;
+}
+
+STATIC std::vector<ActorDefinition*> ActorDefinition::ParseDefinitionsFile( const std::string& deinitionsXmlFilePath )
+{
+	std::vector<ActorDefinition*> actorDefs;
 	XmlDocument mapXmlDoc;
-	mapXmlDoc.LoadFile( &deinitionsXmlFilePath[0] );
+	LoadXmlDocumentFromFile( mapXmlDoc, deinitionsXmlFilePath );
 	XmlElement* mapDefsElement = mapXmlDoc.RootElement();
 	if( mapDefsElement == nullptr )
 	{
 		g_theConsole->PrintString( Rgba8::RED, "WARNING: Actor definitions file not found" );
-		return;
+		return actorDefs;
 	}
 	XmlElement* actorDefElement = mapDefsElement->FirstChildElement();
 	while( actorDefElement )
 	{
-		ActorDefinition* newMapDef = new ActorDefinition( *actorDefElement );
-		s_definitionMap[newMapDef->m_name] = newMapDef;
+		actorDefs.push_back( new ActorDefinition( *actorDefElement ) );
 		actorDefElement = actorDefElement->NextSiblingElement();
 	}
+	return actorDefs;
 }
 
-STATIC ActorDefinition* ActorDefinition::GetDefinitions( const std::string& deinitionsName )
+STATIC int ActorDefinition::ReloadDefinitions( const std::string& deinitionsXmlFilePath )
 {
-	if ( s_definitionMap.count( deinitionsName ) > 0 )
+	std::vector<ActorDefinition*> reloadedActorDefs = ParseDefinitionsFile( deinitionsXmlFilePath );
+	if( reloadedActorDefs.empty() )
 	{
-		return s_definitionMap.at( deinitionsName );
+		return -1;
 	}
-	return nullptr;
+
+	g_theRenderer->FinishQueuedTextures();
+	int numReloaded = 0;
+	for( ActorDefinition* reloadedActorDef : reloadedActorDefs )
+	{
+		ActorDefinition*& actorDef = s_definitionMap[InternStringID( reloadedActorDef->m_name )];
+		if( actorDef == nullptr )
+		{
+			actorDef = reloadedActorDef;
+			actorDef->m_animSetDef->CreateSpriteAnims();
+			numReloaded++;
+			continue;
+		}
+
+		// live entities look their anims up by name every frame, losing one would throw
+		bool hasEveryAnim = true;
+		for( const SpriteAnimRecord& animRecord : actorDef->m_animSetDef->m_animRecords )
+		{
+			hasEveryAnim = hasEveryAnim && reloadedActorDef->m_animSetDef->HasAnimRecord( animRecord.m_name );
+		}
+		if( !hasEveryAnim )
+		{
+			g_theConsole->PrintString( Rgba8::RED, Stringf( "WARNING: %s reload dropped an animation, kept the old one", actorDef->m_name.c_str() ) );
+			delete reloadedActorDef->m_animSetDef;
+			delete reloadedActorDef;
+			continue;
+		}
+
+		// entities keep their definition pointer, so the new contents move into the old object.
+		// nothing holds on to anims between frames, the old set can go
+		SpriteAnimSetDefinition* oldAnimSetDef = actorDef->m_animSetDef;
+		*actorDef = *reloadedActorDef;
+		actorDef->m_animSetDef->CreateSpriteAnims();
+		delete oldAnimSetDef;
+		delete reloadedActorDef;
+		numReloaded++;
+	}
+	return numReloaded;
 }
 
 ActorDefinition::ActorDefinition( const XmlElement& actorDefElement )
@@ -38,6 +124,11 @@ ActorDefinition::ActorDefinition( const XmlElement& actorDefElement )
 
 }
 
+ActorDefinition::ActorDefinition( BufferParser& parser )
+	:EntityDefinition( parser )
+{
+}
+
 ActorDefinition::~ActorDefinition()
 {
 }
\ No newline at end of file
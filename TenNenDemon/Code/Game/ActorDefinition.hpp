@@ -1,21 +1,28 @@
 #pragma once
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/StringID.hpp"
 #include "Engine/Renderer/SpriteDefinition.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "EntityDefinition.hpp"
 #include <map>
 #include <string>
+#include <vector>
 
 class ActorDefinition : public EntityDefinition
 {
 public:
-	static std::map< std::string, ActorDefinition* >	s_definitionMap;
-	static void LoadDefinitions( const std::string& deinitionsXmlFilePath );
+	static StringIDMap<ActorDefinition*>	s_definitionMap;
+	static void ParseDefinitions( const std::string& deinitionsXmlFilePath );	// any thread, touches nothing but this registry
+	static void LinkDefinitions();												// main thread, after the queued textures are finished
 	static ActorDefinition* GetDefinitions( const std::string& deinitionsName );
 
+	static std::vector<ActorDefinition*> ParseDefinitionsFile( const std::string& deinitionsXmlFilePath );	// any thread, straight from XML and not registered
+	static int ReloadDefinitions( const std::string& deinitionsXmlFilePath );	// main thread, patches same named defs in place; -1 if the file didn't parse
+
 public:
 	ActorDefinition( const XmlElement& actorDefElement );
+	ActorDefinition( BufferParser& parser );
 	~ActorDefinition();
 
 private:
@@ -3,14 +3,22 @@
 #include "Engine/Platform/Window.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/AssetArchive.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/CommandScript.hpp"
+#include "Engine/Core/FrameAllocator.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/Profiler.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 
 RenderContext* g_theRenderer = nullptr;
 InputSystem* g_theInput = nullptr;
 DevConsole* g_theConsole = nullptr;
 EventSystem* g_theEventSystem = nullptr;
+JobSystem* g_theJobSystem = nullptr;
 AudioSystem* g_theAudio = nullptr;
 
 extern App* g_theApp;
@@ -19,6 +27,57 @@ eGameState g_gameState = MAIN_MENU;
 bool g_isDebugMode = false;
 bool g_isDebugCamera = false;
 
+//------------------------------------------------------------------------
+AppLaunchOptions ParseAppLaunchOptions( std::string_view commandLine )
+{
+	// split on spaces, "quoted paths" stay whole
+	std::vector<std::string> arguments;
+	size_t charIndex = 0;
+	while( charIndex < commandLine.size() )
+	{
+		if( commandLine[charIndex] == ' ' )
+		{
+			charIndex++;
+			continue;
+		}
+
+		char endChar = ' ';
+		if( commandLine[charIndex] == '"' )
+		{
+			endChar = '"';
+			charIndex++;
+		}
+		size_t argumentEnd = commandLine.find( endChar, charIndex );
+		if( argumentEnd == std::string_view::npos )
+		{
+			argumentEnd = commandLine.size();
+		}
+		arguments.emplace_back( commandLine.substr( charIndex, argumentEnd - charIndex ) );
+		charIndex = argumentEnd + 1;
+	}
+
+	AppLaunchOptions launchOptions;
+	for( int argumentIndex = 0; argumentIndex < (int)arguments.size(); argumentIndex++ )
+	{
+		std::string const& argument = arguments[argumentIndex];
+		bool hasValue = argumentIndex + 1 < (int)arguments.size();
+		if( argument == "--script" && hasValue )
+		{
+			launchOptions.m_scriptFilePath = arguments[++argumentIndex];
+		}
+		else if( argument == "--report" && hasValue )
+		{
+			launchOptions.m_reportFilePath = arguments[++argumentIndex];
+		}
+		else if( argument == "--headless" )
+		{
+			launchOptions.m_isHeadless = true;
+		}
+	}
+	return launchOptions;
+}
+
+//------------------------------------------------------------------------
 App::App()
 {
 }
@@ -27,9 +86,19 @@ App::~App()
 {
 }
 
-void App::Startup()
+void App::Startup( AppLaunchOptions const& launchOptions )
 {
+	double startupStartSeconds = GetCurrentTimeSeconds();
+	ProfilerStartup();
+	LoggerStartup();
 	Clock::SystemStartup();
+	ResolveGameConfigSlots();
+
+	// shipped builds read everything out of Data.pak, development builds just don't have one
+	MountAssetArchive( "Data.pak" );
+
+	g_theJobSystem = new JobSystem();
+	g_theJobSystem->Startup();
 
 	g_theRenderer = new RenderContext();
 	g_theInput = new InputSystem();
@@ -47,14 +116,46 @@ void App::Startup()
 
 	g_theWindow->SetInputSystem( g_theInput );
 	g_theWindow->SetEventSystem( g_theEventSystem );
+
+	double startupSeconds = GetCurrentTimeSeconds() - startupStartSeconds;
+	std::string startupMessage = Stringf( "Startup took %.1f ms (%s)", startupSeconds * 1000.0, GetNumMountedAssetArchives() > 0 ? "Data.pak" : "loose files" );
+	LOG_INFO( "App", "%s", startupMessage );
+	g_theConsole->PrintString( Rgba8::WHITE, startupMessage );
+
+	if( launchOptions.m_scriptFilePath != "" )
+	{
+		m_scriptReportFilePath = launchOptions.m_reportFilePath;
+		if( m_scriptReportFilePath == "" )
+		{
+			std::string scriptName = launchOptions.m_scriptFilePath.substr( launchOptions.m_scriptFilePath.find_last_of( "/\\" ) + 1 );
+			m_scriptReportFilePath = Stringf( "Logs/%s.report.txt", scriptName.substr( 0, scriptName.find( '.' ) ).c_str() );
+		}
+
+		m_script = new CommandScript();
+		if( !m_script->LoadFromFile( launchOptions.m_scriptFilePath ) )
+		{
+			m_exitCode = 1;
+			m_isQuitting = true;
+		}
+	}
 }
 
 void App::Shutdown()
 {
+	delete m_script;
+	m_script = nullptr;
+
 	g_theRenderer->Shutdown();
 	g_theGame->Shutdown();
 	g_theAudio->Shutdown();
 	DebugRenderSystemShutdown();
+
+	g_theJobSystem->Shutdown();
+	delete g_theJobSystem;
+	g_theJobSystem = nullptr;
+	UnmountAllAssetArchives();
+	LoggerShutdown();
+	ProfilerShutdown();
 }
 
 void App::RunFrame()
@@ -63,14 +164,21 @@ void App::RunFrame()
 	double timeThisFrameStarted = GetCurrentTimeSeconds();
 	double deltaSeconds = timeThisFrameStarted - timeLastFrameStarted;
 	timeLastFrameStarted = timeThisFrameStarted;
+	m_lastFrameSeconds = deltaSeconds;
 	// Clamped to a maximum deltaSeconds of 0.1f
 	deltaSeconds > 0.1f?deltaSeconds = 0.1f:true;
 
-	Clock::GetMaster()->Update( deltaSeconds );
-	BeginFrame();
-	Update( ( float ) deltaSeconds );
-	Render();
-	EndFrame();
+	{
+		PROFILE_SCOPE( "App::RunFrame" );
+		Clock::GetMaster()->Update( deltaSeconds );
+		BeginFrame();
+		Update( ( float ) deltaSeconds );
+		Render();
+		EndFrame();
+	}
+	ProfilerEndFrame();
+	LoggerEndFrame();
+	MemoryTrackerEndFrame();
 }
 
 bool App::IsQuitting() const
@@ -105,11 +213,20 @@ void App::JoystickButtonControl()
 
 void App::BeginFrame()
 {
+	// transient vertex and string buffers from two frames ago are reused from here on
+	FrameArenaBeginFrame();
+
 	g_theRenderer->BeginFrame();
 	g_theInput->BeginFrame();
 	g_theConsole->BeginFrame();
 	g_theAudio->BeginFrame();
 	DebugRenderBeginFrame();
+
+	// events queued last frame (or from other threads) fire here, before any system updates
+	g_theEventSystem->DispatchQueuedEvents();
+
+	// work handed back by jobs that must touch the renderer or other main-thread-only systems
+	g_theJobSystem->RunMainThreadJobs();
 }
 
 void App::EndFrame()
@@ -126,11 +243,39 @@ void App::Update( float deltaSeconds )
 	g_theRenderer->UpdateFrameTime( deltaSeconds );
 	JoystickButtonControl();
 	g_theConsole->Update( deltaSeconds );
+	UpdateScript();
 	g_theGame->Update( deltaSeconds );
 }
 
+void App::UpdateScript()
+{
+	if( m_script == nullptr || m_isQuitting )
+	{
+		return;
+	}
+
+	// commands run where typed ones would, after the console and before the game.
+	// a script with no steps is finished before it starts, it still gets its report
+	if( !m_script->IsFinished() )
+	{
+		m_script->Update( m_lastFrameSeconds );
+		if( !m_script->IsFinished() )
+		{
+			return;
+		}
+	}
+
+	if( !m_script->WriteReport( m_scriptReportFilePath ) )
+	{
+		LOG_ERROR( "Script", "Couldn't write %s", m_scriptReportFilePath );
+	}
+	m_exitCode = m_script->GetNumFailedCommands() > 0 ? 1 : 0;
+	HandleQuitRequested();
+}
+
 void App::Render() const
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_RENDER );
 	g_theGame->Render();
 	g_theGame->RenderDebug();
 }
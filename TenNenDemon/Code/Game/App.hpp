@@ -1,15 +1,28 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
 #include "Game.hpp"
+#include <string_view>
 
+class CommandScript;
 
+//------------------------------------------------------------------------
+struct AppLaunchOptions
+{
+	std::string m_scriptFilePath;		// --script <file>: run its commands, write a report and quit
+	std::string m_reportFilePath;		// --report <file>: Logs/<script name>.report.txt when not given
+	bool m_isHeadless = false;			// --headless: the window stays hidden, frames still render
+};
+
+AppLaunchOptions ParseAppLaunchOptions( std::string_view commandLine );
+
+//------------------------------------------------------------------------
 class App
 {
 public:
 	App();
 	~App();
 
-	void Startup();
+	void Startup( AppLaunchOptions const& launchOptions );
 	void Shutdown();
 	void RunFrame();
 
@@ -18,14 +31,21 @@ public:
 	bool HandleKeyPressed( unsigned char keyCode );
 	bool HandleKeyReleased( unsigned char keyCode );
 	bool HandleQuitRequested();
+	int GetExitCode() const { return m_exitCode; }
 
 private:
 	void BeginFrame();
 	void EndFrame();
 	void Update( float deltaSeconds );
 	void Render() const;
+	void UpdateScript();
 
 private:
 	bool m_isQuitting = false;
+	int m_exitCode = 0;
+
+	CommandScript* m_script = nullptr;
+	std::string m_scriptReportFilePath;
+	double m_lastFrameSeconds = 0.0;		// unclamped, for the script's frame time stats
 
 };
\ No newline at end of file
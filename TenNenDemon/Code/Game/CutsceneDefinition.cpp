@@ -2,34 +2,116 @@
 #include "Game/GameCommon.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/DefinitionCache.hpp"
+#include "Engine/Core/JobSystem.hpp"
 
-STATIC std::map< std::string, CutsceneDefinition* > CutsceneDefinition::s_definitionMap;
+STATIC StringIDMap<CutsceneDefinition*> CutsceneDefinition::s_definitionMap;
+constexpr unsigned int CUTSCENE_DEFS_CACHE_VERSION = 1;		// bump whenever AppendToBuffer changes
 
-STATIC void CutsceneDefinition::LoadDefinitions( const std::string& folderPath )
+STATIC void CutsceneDefinition::ParseDefinitions( const std::string& folderPath )
 {
 	Strings fileNames = GetFileNamesInFolder( folderPath, "*.xml" );
 
-	for( int i = 0; i < (int)fileNames.size(); ++i )
+	// one cache for the whole folder, adding or removing a file misses too
+	DefinitionCache cache( "CutsceneDefs", CUTSCENE_DEFS_CACHE_VERSION );
+	for( const std::string& fileName : fileNames )
 	{
-		const std::string& cutsceneFileName = fileNames[i];
-		std::string cutsceneName = GetFileBaseName( cutsceneFileName );
+		cache.AddSourceFile( folderPath + fileName );
+	}
+	if( cache.Load() )
+	{
+		BufferParser& parser = cache.GetParser();
+		int numDefinitions = parser.ParseInt32();
+		for( int definitionIndex = 0; definitionIndex < numDefinitions; definitionIndex++ )
+		{
+			CutsceneDefinition* newCutsceneDef = new CutsceneDefinition( parser );
+			s_definitionMap[InternStringID( newCutsceneDef->m_name )] = newCutsceneDef;
+		}
+		return;
+	}
 
-		std::string cutsceneFilePath = folderPath + cutsceneFileName;
-		XmlDocument cutsceneFileDoc;
-		cutsceneFileDoc.LoadFile( &cutsceneFilePath[0] );
+	// one file per cutscene, each parsed on its own job and registered afterwards
+	std::vector<CutsceneDefinition*> newCutsceneDefs( fileNames.size(), nullptr );
+	auto parseCutsceneFiles = [&fileNames, &newCutsceneDefs, &folderPath]( int beginIndex, int endIndex )
+	{
+		for( int i = beginIndex; i < endIndex; ++i )
+		{
+			newCutsceneDefs[i] = ParseDefinitionFile( folderPath, fileNames[i] );
+		}
+	};
+	g_theJobSystem->ParallelFor( 0, (int)fileNames.size(), 1, parseCutsceneFiles );
 
-		CutsceneDefinition* newCutsceneDef = new CutsceneDefinition( *cutsceneFileDoc.RootElement(), cutsceneName );
-		s_definitionMap[cutsceneName] = newCutsceneDef;
+	for( CutsceneDefinition* newCutsceneDef : newCutsceneDefs )
+	{
+		if( newCutsceneDef == nullptr )
+		{
+			continue;
+		}
+		s_definitionMap[InternStringID( newCutsceneDef->m_name )] = newCutsceneDef;
 	}
+
+	BufferWriter& writer = cache.GetWriter();
+	writer.AppendInt32( (int)s_definitionMap.size() );
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->AppendToBuffer( writer );
+	}
+	cache.Save();
 }
 
-CutsceneDefinition* CutsceneDefinition::GetDefinitions( const std::string& deinitionsName )
+STATIC void CutsceneDefinition::LinkDefinitions()
 {
-	if( s_definitionMap.count( deinitionsName ) > 0 )
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->Link();
+	}
+}
+
+STATIC CutsceneDefinition* CutsceneDefinition::ParseDefinitionFile( const std::string& folderPath, const std::string& fileName )
+{
+	XmlDocument cutsceneFileDoc;
+	LoadXmlDocumentFromFile( cutsceneFileDoc, folderPath + fileName );
+	if( cutsceneFileDoc.RootElement() == nullptr )
+	{
+		return nullptr;
+	}
+	return new CutsceneDefinition( *cutsceneFileDoc.RootElement(), GetFileBaseName( fileName ) );
+}
+
+STATIC int CutsceneDefinition::ReloadDefinition( const std::string& folderPath, const std::string& fileName )
+{
+	// a cutscene with no lines can't be played, most likely the file was caught half saved
+	CutsceneDefinition* reloadedCutsceneDef = ParseDefinitionFile( folderPath, fileName );
+	if( reloadedCutsceneDef == nullptr || reloadedCutsceneDef->m_lines.empty() )
+	{
+		delete reloadedCutsceneDef;
+		return -1;
+	}
+
+	g_theRenderer->FinishQueuedTextures();
+	CutsceneDefinition*& cutsceneDef = s_definitionMap[InternStringID( reloadedCutsceneDef->m_name )];
+	if( cutsceneDef == nullptr )
+	{
+		cutsceneDef = reloadedCutsceneDef;
+	}
+	else
 	{
-		return s_definitionMap.at( deinitionsName );
+		// maps and a playing cutscene point at the old object, only its lines get swapped out
+		for( CutsceneLines* line : cutsceneDef->m_lines )
+		{
+			delete line;
+		}
+		cutsceneDef->m_lines.swap( reloadedCutsceneDef->m_lines );
+		delete reloadedCutsceneDef;
 	}
-	return nullptr;
+	cutsceneDef->Link();
+	return 1;
+}
+
+CutsceneDefinition* CutsceneDefinition::GetDefinitions( const std::string& deinitionsName )
+{
+	auto found = s_definitionMap.find( HashStringID( deinitionsName ) );
+	return found != s_definitionMap.end() ? found->second : nullptr;
 }
 
 CutsceneDefinition::CutsceneDefinition( const XmlElement& cutsceneDefElement, const std::string& name )
@@ -39,26 +121,24 @@ CutsceneDefinition::CutsceneDefinition( const XmlElement& cutsceneDefElement, co
 	while( LinesElement )
 	{
 		std::string backgroundPath = ParseXmlAttribute( *LinesElement, "background", "" );
-		Texture* bgTex = nullptr;
 		if ( backgroundPath != "" )
 		{
-			bgTex = g_theRenderer->CreateOrGetTextureFromFile( backgroundPath.c_str() );
+			g_theRenderer->QueueTextureFromFile( backgroundPath );
 		}
 
 		for( const XmlElement* line = LinesElement->FirstChildElement( "Line" ); line; line = line->NextSiblingElement( "Line" ) )
 		{
 			std::string characterImage = ParseXmlAttribute( *line, "characterImage", "" );
-			Texture* characterTex = nullptr;
 			if ( "" != characterImage )
 			{
-				characterTex = g_theRenderer->CreateOrGetTextureFromFile( characterImage.c_str() );
+				g_theRenderer->QueueTextureFromFile( characterImage );
 			}
 			std::string lineStr = ParseXmlAttribute( *line, "line", "" );
 
 			CutsceneLines* newLine = new CutsceneLines();
-			newLine->m_background = bgTex;
+			newLine->m_backgroundFilePath = backgroundPath;
 			newLine->m_line = lineStr;
-			newLine->m_characterImage = characterTex;
+			newLine->m_characterImageFilePath = characterImage;
 			newLine->m_characterName = ParseXmlAttribute( *line, "characterName", "" );
 			m_lines.push_back( newLine );
 		}
@@ -66,6 +146,58 @@ CutsceneDefinition::CutsceneDefinition( const XmlElement& cutsceneDefElement, co
 	}
 }
 
+CutsceneDefinition::CutsceneDefinition( BufferParser& parser )
+{
+	m_name = parser.ParseString();
+	int numLines = parser.ParseInt32();
+	for( int lineIndex = 0; lineIndex < numLines; lineIndex++ )
+	{
+		CutsceneLines* newLine = new CutsceneLines();
+		newLine->m_line = parser.ParseString();
+		newLine->m_characterName = parser.ParseString();
+
+		newLine->m_backgroundFilePath = parser.ParseString();
+		if( newLine->m_backgroundFilePath != "" )
+		{
+			g_theRenderer->QueueTextureFromFile( newLine->m_backgroundFilePath );
+		}
+		newLine->m_characterImageFilePath = parser.ParseString();
+		if( newLine->m_characterImageFilePath != "" )
+		{
+			g_theRenderer->QueueTextureFromFile( newLine->m_characterImageFilePath );
+		}
+		m_lines.push_back( newLine );
+	}
+}
+
 CutsceneDefinition::~CutsceneDefinition()
 {
 }
+
+void CutsceneDefinition::Link()
+{
+	for( CutsceneLines* line : m_lines )
+	{
+		if( line->m_backgroundFilePath != "" )
+		{
+			line->m_background = g_theRenderer->CreateOrGetTextureFromFile( line->m_backgroundFilePath.c_str() );
+		}
+		if( line->m_characterImageFilePath != "" )
+		{
+			line->m_characterImage = g_theRenderer->CreateOrGetTextureFromFile( line->m_characterImageFilePath.c_str() );
+		}
+	}
+}
+
+void CutsceneDefinition::AppendToBuffer( BufferWriter& writer ) const
+{
+	writer.AppendString( m_name );
+	writer.AppendInt32( (int)m_lines.size() );
+	for( const CutsceneLines* line : m_lines )
+	{
+		writer.AppendString( line->m_line );
+		writer.AppendString( line->m_characterName );
+		writer.AppendString( line->m_backgroundFilePath );
+		writer.AppendString( line->m_characterImageFilePath );
+	}
+}
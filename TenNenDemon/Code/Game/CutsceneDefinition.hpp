@@ -1,34 +1,47 @@
 #pragma once
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/StringID.hpp"
 #include <map>
 #include <vector>
 #include <string>
 
 class Texture;
+class BufferWriter;
+class BufferParser;
 
 struct CutsceneLines
 {
 	std::string m_line = "";
 	std::string m_characterName = "";
-	Texture* m_background = nullptr;
+	std::string m_backgroundFilePath = "";
+	std::string m_characterImageFilePath = "";
+	Texture* m_background = nullptr;		// both set by LinkDefinitions
 	Texture* m_characterImage = nullptr;
 };
 
 class CutsceneDefinition
 {
 public:
-	static void LoadDefinitions( const std::string& folderPath );
+	static void ParseDefinitions( const std::string& folderPath );		// any thread, touches nothing but this registry
+	static void LinkDefinitions();										// main thread, after the queued textures are finished
 	static CutsceneDefinition* GetDefinitions( const std::string& deinitionsName );
 
+	static CutsceneDefinition* ParseDefinitionFile( const std::string& folderPath, const std::string& fileName );	// any thread, not registered; nullptr if it didn't parse
+	static int ReloadDefinition( const std::string& folderPath, const std::string& fileName );	// main thread, patches the same named def in place; -1 if the file didn't parse
+
 public:
 	CutsceneDefinition( const XmlElement& cutsceneDefElement, const std::string& name );
+	CutsceneDefinition( BufferParser& parser );
 	~CutsceneDefinition();
 
+	void Link();		// main thread, textures
+	void AppendToBuffer( BufferWriter& writer ) const;
+
 private:
-	static std::map< std::string, CutsceneDefinition* >	s_definitionMap;
+	static StringIDMap<CutsceneDefinition*>	s_definitionMap;
 
 public:
 	std::string m_name = "";
-	std::vector<const CutsceneLines*> m_lines;
+	std::vector<CutsceneLines*> m_lines;
 
 };
\ No newline at end of file
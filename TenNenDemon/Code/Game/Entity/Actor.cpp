@@ -25,8 +25,8 @@ void Actor::Update( float deltaSeconds )
 
 void Actor::Render() const
 {
-	std::vector<Vertex_PCU> verts;
-	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( "Idle" );
+	FrameVector<Vertex_PCU> verts;
+	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( STRING_ID( "Idle" ) );
 	SpriteDefinition sd = animDef->GetSpriteDefAtTime( (float) m_map->m_mapClock->GetTotalTime() );
 	Vec2 uvAtMins, uvAtMaxs;
 	sd.GetUVs( uvAtMins, uvAtMaxs );
@@ -74,7 +74,7 @@ void Actor::ChangePlayerSprite()
 	}
 	if ( m_isAttacking )
 	{
-		if ( m_timer->HasElapsed() )
+		if ( m_timer.HasElapsed() )
 		{
 			m_isAttacking = false;
 		}
@@ -8,9 +8,9 @@
 Entity::Entity( Game* theGame, Map* theMap, const Vec2& pos )
 	:m_game(theGame),
 	m_map(theMap),
+	m_timer( theMap->m_mapClock ),
 	m_position( pos )
 {
-	m_timer = new Timer( m_map->m_mapClock );
 }
 
 Entity::~Entity()
@@ -28,7 +28,7 @@ void Entity::Update( float deltaSeconds )
 	Vec2 direction = targetPosition - originPosition;
 	m_position += direction * m_speed * deltaSeconds;
 	AABB2 bounds = m_map->m_tiles[m_map->GetTileIndexForTileCoords( m_targetPositionIndex )].GetBounds();
-	if( IsPointInsideAABB2D( m_position, bounds ) || m_timer->HasElapsed() )
+	if( IsPointInsideAABB2D( m_position, bounds ) || m_timer.HasElapsed() )
 	{
 		m_isMoving = false;
 		m_currentPositionIndex = m_targetPositionIndex;
@@ -57,7 +57,7 @@ void Entity::Move( int targetIndexX, int targetIndexY )
 		return;
 	}
 
-	m_timer->SetSeconds( m_map->m_mapClock, 0.05f );
+	m_timer.SetSeconds( m_map->m_mapClock, 0.05f );
 	m_isMoving = true;
 	m_targetPositionIndex = IntVec2( targetIndexX, targetIndexY );
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Core/Timer.hpp"
 #include "Game/EntityDefinition.hpp"
 #include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
@@ -8,7 +9,6 @@
 #include <string>
 
 class Map;
-class Timer;
 
 class Entity
 {
@@ -32,7 +32,7 @@ public:
 	Map* m_map = nullptr;
 
 	std::string			m_name = "UNNAMED";
-	Timer*				m_timer = nullptr;
+	Timer				m_timer;
 	eEntityType			m_entityType = ENTITY_TYPE_UNKNOWN;
 	int					m_entityID = 0;
 	EntityDefinition*	m_entityDef = nullptr;
@@ -29,8 +29,8 @@ void Fireball::Update( float deltaSeconds )
 
 void Fireball::Render() const
 {
-	std::vector<Vertex_PCU> verts;
-	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( m_spriteName );
+	FrameVector<Vertex_PCU> verts;
+	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( m_spriteID );
 	SpriteDefinition sd = animDef->GetSpriteDefAtTime( (float)m_map->m_mapClock->GetTotalTime() );
 	Vec2 uvAtMins, uvAtMaxs;
 	sd.GetUVs( uvAtMins, uvAtMaxs );
@@ -62,18 +62,18 @@ void Fireball::SetMovingDirection( const IntVec2& movingDirection )
 	m_movingDirection = movingDirection;
 	if ( movingDirection == IntVec2( 1, 0 ) )
 	{
-		m_spriteName = "East";
+		m_spriteID = STRING_ID( "East" );
 	}
 	else if ( movingDirection == IntVec2( -1, 0 ) )
 	{
-		m_spriteName = "West";
+		m_spriteID = STRING_ID( "West" );
 	}
 	else if ( movingDirection == IntVec2( 0, 1 ) )
 	{
-		m_spriteName = "North";
+		m_spriteID = STRING_ID( "North" );
 	}
 	else if ( movingDirection == IntVec2( 0, -1 ) )
 	{
-		m_spriteName = "South";
+		m_spriteID = STRING_ID( "South" );
 	}
 }
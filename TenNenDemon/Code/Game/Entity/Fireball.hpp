@@ -18,6 +18,6 @@ public:
 
 public:
 	IntVec2 m_movingDirection = IntVec2( 1, 0 );
-	std::string m_spriteName = "East";
+	StringID m_spriteID = STRING_ID( "East" );
 
 };
\ No newline at end of file
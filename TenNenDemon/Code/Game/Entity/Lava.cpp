@@ -25,6 +25,7 @@ Lava::Lava( Game* theGame, Map* theMap, const Vec2& pos, EnvironmentEntityDefini
 	m_emitter->m_interval = 0.1f;
 	m_emitter->m_spawnOffsetMin = Vec3( -0.6f, -0.5f, 0.f );
 	m_emitter->m_spawnOffsetMax = Vec3( 0.3f, 0.5f, 0.f );
+	m_emitter->SetCapacity( 16, PARTICLE_OVERFLOW_DROP );
 	m_emitter->m_texture = g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/steam-texture.png" );
 }
 
@@ -39,14 +40,14 @@ void Lava::Update( float deltaSeconds )
 
 void Lava::Render() const
 {
-	std::vector<Vertex_PCU> verts;
-	std::string spriteName = "Normal";
+	FrameVector<Vertex_PCU> verts;
+	StringID spriteID = STRING_ID( "Normal" );
 	if ( m_isFilled )
 	{
-		spriteName = "Filled";
+		spriteID = STRING_ID( "Filled" );
 		m_emitter->m_stopCreatingParticle = true;
 	}
-	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( spriteName );
+	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( spriteID );
 	SpriteDefinition sd = animDef->GetSpriteDefAtTime( (float)m_map->m_mapClock->GetTotalTime() );
 	Vec2 uvAtMins, uvAtMaxs;
 	sd.GetUVs( uvAtMins, uvAtMaxs );
@@ -36,8 +36,8 @@ void Player::Update( float deltaSeconds )
 
 void Player::Render() const
 {
-	std::vector<Vertex_PCU> verts;
-	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( "Idle" );
+	FrameVector<Vertex_PCU> verts;
+	SpriteAnimDefinition* animDef = m_entityDef->m_animSetDef->m_spriteAnims.at( STRING_ID( "Idle" ) );
 	SpriteDefinition sd = animDef->GetSpriteDefAtTime( (float) m_map->m_mapClock->GetTotalTime() );
 	Vec2 uvAtMins, uvAtMaxs;
 	sd.GetUVs( uvAtMins, uvAtMaxs );
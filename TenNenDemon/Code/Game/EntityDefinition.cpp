@@ -1,5 +1,6 @@
 #include "EntityDefinition.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
+#include "Engine/Core/BufferUtils.hpp"
 
 EntityDefinition::EntityDefinition( const XmlElement& definitionXmlElement )
 {
@@ -15,6 +16,26 @@ EntityDefinition::EntityDefinition( const XmlElement& definitionXmlElement )
 	m_animSetDef = new SpriteAnimSetDefinition( spriteAnimSetElement );
 }
 
+EntityDefinition::EntityDefinition( BufferParser& parser )
+{
+	m_name = parser.ParseString();
+	m_faction = parser.ParseString();
+	m_physicsRadius = parser.ParseFloat();
+	m_drawRadius = parser.ParseFloat();
+	m_localDrawBounds = parser.ParseAABB2();
+	m_animSetDef = new SpriteAnimSetDefinition( parser );
+}
+
 EntityDefinition::~EntityDefinition()
 {
 }
+
+void EntityDefinition::AppendToBuffer( BufferWriter& writer ) const
+{
+	writer.AppendString( m_name );
+	writer.AppendString( m_faction );
+	writer.AppendFloat( m_physicsRadius );
+	writer.AppendFloat( m_drawRadius );
+	writer.AppendAABB2( m_localDrawBounds );
+	m_animSetDef->AppendToBuffer( writer );
+}
@@ -23,12 +23,18 @@ enum Faction
 	FACTION_NEUTRAL
 };
 
+class BufferWriter;
+class BufferParser;
+
 class EntityDefinition
 {
 public:
 	explicit EntityDefinition( const XmlElement& definitionXmlElement );
+	explicit EntityDefinition( BufferParser& parser );
 	virtual ~EntityDefinition();
 
+	virtual void AppendToBuffer( BufferWriter& writer ) const;
+
 public:
 	std::string					m_name;
 	std::string					m_faction;
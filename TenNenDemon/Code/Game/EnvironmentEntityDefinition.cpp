@@ -2,8 +2,8 @@
 
 EnvironmentEntityDefinition::EnvironmentEntityDefinition( const std::string& name, const IntVec2& startIndex, eEntityType entityType )
 {
+	m_actorName = name;
 	m_startIndex = startIndex;
-	m_actorDef = ActorDefinition::GetDefinitions( name );
 	m_entityType = entityType;
 }
 
@@ -10,8 +10,9 @@ public:
 	~EnvironmentEntityDefinition();
 
 public:
+	std::string m_actorName;
 	IntVec2 m_startIndex = IntVec2::ZERO;
 	eEntityType m_entityType = ENTITY_TYPE_BREAKABLE_OBJECT;
-	ActorDefinition* m_actorDef = nullptr;
+	ActorDefinition* m_actorDef = nullptr;		// looked up by MapDefinition::LinkDefinitions
 
 };
\ No newline at end of file
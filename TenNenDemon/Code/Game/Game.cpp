@@ -19,6 +19,14 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/DefinitionCache.hpp"
+#include "Engine/Core/FileWatcher.hpp"
+#include "Engine/Core/AssetArchive.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Math/AABB3.hpp"
 
 extern EventSystem* g_theEventSystem;
@@ -36,6 +44,7 @@ Game::~Game()
 
 void Game::Startup()
 {
+	MEMORY_TAG_SCOPE( MEMORY_TAG_GAME );
 	m_worldCamera = new Camera( Vec2( WORLD_SIZE_X, WORLD_SIZE_Y ) );
 	m_worldCamera->SetProjectionOrthographic( WORLD_SIZE_Y );
 	m_worldCamera->m_clearColor = Rgba8( 0, 0, 5 );
@@ -47,21 +56,43 @@ void Game::Startup()
 	m_devConsoleCamera->InitialUBO( g_theRenderer );
 	g_theConsole->SetCamera(m_devConsoleCamera);
 
-	ShaderState::LoadDefinitions( g_theRenderer, "Data/Definitions/ShaderStateDefs.xml" );
-	Material::LoadDefinitions( g_theRenderer, "Data/Definitions/MaterialDefs.xml" );
-	CutsceneDefinition::LoadDefinitions( "Data/Definitions/Cutscenes/" );
-	ActorDefinition::LoadDefinitions( "Data/Definitions/ActorDefs.xml" );
-	MapDefinition::LoadDefinitions( g_theRenderer, "Data/Definitions/MapDefs.xml" );
+	// everything drawn in the world a sprite at a time shares one texture, so those draws stop rebinding
+	{
+		std::vector<std::string> spriteSheetFilePaths = {
+			"Data/Images/Main_character_6x2.png",
+			"Data/Images/Rock.png",
+			"Data/Images/FLAMEbase0001.png",
+			"Data/Images/Terrain_9x6.png",
+			"Data/Images/shark_5x1.png",
+			"Data/Images/Fireball_4x1.png",
+			"Data/Images/Cutscenes/booper_spritesheet_7x4.png",
+			"Data/Fonts/MyFixedFont.png",
+		};
+		std::vector<IntVec2> spriteLayouts = {
+			IntVec2( 6, 2 ), IntVec2( 1, 1 ), IntVec2( 1, 1 ), IntVec2( 9, 6 ), IntVec2( 5, 1 ), IntVec2( 4, 1 ), IntVec2( 7, 4 ), IntVec2( 16, 16 ),
+		};
+		g_theRenderer->CreateTextureAtlas( "SpriteAtlas", spriteSheetFilePaths, spriteLayouts );
+	}
+
+	LoadAllDefinitions();
+
+	// loose files only, a packed build has nothing to edit
+	if( g_gameConfigBlackboard.GetValue( g_gameConfigSlots.m_hotReloadDefinitions, true ) && GetNumMountedAssetArchives() == 0 )
+	{
+		m_definitionWatcher = new FileWatcher();
+		m_definitionWatcher->AddFolder( "Data/Definitions", "*.xml" );
+		m_definitionWatcher->AddFolder( "Data/Definitions/Cutscenes", "*.xml" );
+	}
 
 	g_theFont = g_theRenderer->CreateOrGetBitmapFont( "Data/Fonts/MyFixedFont" ); // NO FILE EXTENSION!
-	g_theEventSystem->FireEvent( "megumin" );
+	g_theEventSystem->FireEvent( EVENT_ID( "megumin" ) );
 
 	m_world = new World( this );
 	//m_world->EnterMap( g_gameConfigBlackboard.GetValue( "startMap", "" ) );
 
 	SpriteSheet* spriteSheet = new SpriteSheet( *g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/mainUIexport_oUI_4x2.png" ), IntVec2( 4, 2 ) );
 	m_bgAnim = new SpriteAnimDefinition( *spriteSheet, 0, 7, 0.5f, SpriteAnimPlaybackType::LOOP );
-	m_volume = g_gameConfigBlackboard.GetValue( "soundVolume", 1.f );
+	m_volume = g_gameConfigBlackboard.GetValue( g_gameConfigSlots.m_soundVolume, 1.f );
 	LoadAllAudio( "Data/Audio" );
 	m_currentAudio = g_theAudio->PlaySound( g_theAudio->CreateOrGetSound( "Data/Audio/Menu_Apropos.mp3" ), true, m_volume );
 
@@ -111,6 +142,9 @@ void Game::Startup()
 
 void Game::Update( float deltaSeconds )
 {
+	PROFILE_SCOPE( "Game::Update" );
+	MEMORY_TAG_SCOPE( MEMORY_TAG_GAME );
+	UpdateDefinitionHotReload();
 	UpdateBasicInput();
 	if ( g_theConsole->IsOpen() )
 	{
@@ -219,13 +253,13 @@ void Game::UpdateMainMenu( float deltaSeconds )
 		switch( m_uiButtonIndex )
 		{
 		case 0:
-			m_world->EnterMap( g_gameConfigBlackboard.GetValue( "startMap", "" ) );
+			m_world->EnterMap( g_gameConfigBlackboard.GetValue( g_gameConfigSlots.m_startMap, "" ) );
 			ChangeGameState( PLAY_MODE );
 			break;
 		case 1: ChangeGameState( LEVEL_SELECT );	break;
 		case 2: ChangeGameState( SETTINGS );		break;
 		case 3: ChangeGameState( CONTROLS );		break;
-		case 4: g_theEventSystem->FireEvent("quit"); break;
+		case 4: g_theEventSystem->FireEvent( EVENT_ID( "quit" ) ); break;
 		default: break;
 		}
 		g_theAudio->PlaySound( g_theAudio->CreateOrGetSound( "Data/Audio/button_menu_confirm_01.mp3" ), false, m_volume );
@@ -236,6 +270,9 @@ void Game::UpdateMainMenu( float deltaSeconds )
 
 void Game::Shutdown()
 {
+	delete m_definitionWatcher;
+	m_definitionWatcher = nullptr;
+
 	m_worldCamera->ClearupUBO();
 	m_devConsoleCamera->ClearupUBO();
 
@@ -286,7 +323,7 @@ void Game::RenderMainMenu() const
 
 	AABB2 bgBounds = AABB2( Vec2::ZERO, Vec2( WORLD_SIZE_X, WORLD_SIZE_Y ) );
 	bgBounds.Translate( -Vec2( WORLD_SIZE_X, WORLD_SIZE_Y ) * 0.5f );
-	std::vector<Vertex_PCU> vertices;
+	FrameVector<Vertex_PCU> vertices;
 	AppendQuad( vertices, Vec3( bgBounds.mins, 0.f ), Vec3( bgBounds.maxs.x, bgBounds.mins.y, 0.f ),
 		Vec3( bgBounds.mins.x, bgBounds.maxs.y, 0.f ), Vec3( bgBounds.maxs, 0.f ), AABB2::ZERO_TO_ONE, Rgba8::WHITE );
 	Texture* bgTex = g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/UI/background.png" );
@@ -438,12 +475,12 @@ void Game::UpdateBasicInput()
 		{
 			switch( g_gameState )
 			{
-			case MAIN_MENU:		g_theEventSystem->FireEvent( "quit" );	break;
+			case MAIN_MENU:		g_theEventSystem->FireEvent( EVENT_ID( "quit" ) );	break;
 			case LEVEL_SELECT:	ChangeGameState( MAIN_MENU );			break;
 			case PLAY_MODE:												break;
 			case SETTINGS:		ChangeGameState( MAIN_MENU );			break;
 			case CONTROLS:		ChangeGameState( MAIN_MENU );			break;
-			default:			g_theEventSystem->FireEvent( "quit" );	break;
+			default:			g_theEventSystem->FireEvent( EVENT_ID( "quit" ) );	break;
 			}
 			g_theAudio->PlaySound( g_theAudio->CreateOrGetSound( "Data/Audio/button_menu_back_01.mp3" ), false, m_volume );
 		}
@@ -487,6 +524,150 @@ void Game::LoadAllAudio( const char* folderPath ) const
 	}
 }
 
+//------------------------------------------------------------------------
+// Cutscenes, actors and maps only read their own files, so they parse on workers while the
+// renderer's definitions load here. Every image they name, and everything else in the image
+// folders, decodes on the job system meanwhile. Pointers between definitions and textures are
+// filled in afterwards, in dependency order, on this thread.
+//------------------------------------------------------------------------
+void Game::LoadAllDefinitions() const
+{
+	MEMORY_TAG_SCOPE( MEMORY_TAG_DEFINITIONS );
+	double definitionsStartSeconds = GetCurrentTimeSeconds();
+
+	for( const char* imageFolder : { "Data/Images", "Data/Images/UI", "Data/Images/Cutscenes" } )
+	{
+		Strings fileNames = GetFileNamesInFolder( imageFolder, "*.png" );
+		for( const std::string& fileName : fileNames )
+		{
+			g_theRenderer->QueueTextureFromFile( Stringf( "%s/%s", imageFolder, fileName.c_str() ) );
+		}
+	}
+
+	JobCounter parseCounter;
+	g_theJobSystem->Run( []() { MEMORY_TAG_SCOPE( MEMORY_TAG_DEFINITIONS ); CutsceneDefinition::ParseDefinitions( "Data/Definitions/Cutscenes/" ); }, &parseCounter );
+	g_theJobSystem->Run( []() { MEMORY_TAG_SCOPE( MEMORY_TAG_DEFINITIONS ); ActorDefinition::ParseDefinitions( "Data/Definitions/ActorDefs.xml" ); }, &parseCounter );
+	g_theJobSystem->Run( []() { MEMORY_TAG_SCOPE( MEMORY_TAG_DEFINITIONS ); MapDefinition::ParseDefinitions( g_theRenderer, "Data/Definitions/MapDefs.xml" ); }, &parseCounter );
+
+	ShaderState::LoadDefinitions( g_theRenderer, "Data/Definitions/ShaderStateDefs.xml" );
+	Material::LoadDefinitions( g_theRenderer, "Data/Definitions/MaterialDefs.xml" );
+	double mainThreadSeconds = GetCurrentTimeSeconds() - definitionsStartSeconds;
+
+	g_theJobSystem->WaitFor( parseCounter );
+	g_theRenderer->FinishQueuedTextures();
+	double parseSeconds = GetCurrentTimeSeconds() - definitionsStartSeconds;
+
+	CutsceneDefinition::LinkDefinitions();
+	ActorDefinition::LinkDefinitions();
+	MapDefinition::LinkDefinitions( g_theRenderer );
+
+	double definitionsSeconds = GetCurrentTimeSeconds() - definitionsStartSeconds;
+	int numCachesLoaded = DefinitionCache::s_numLoaded.load();
+	int numCachesRebuilt = DefinitionCache::s_numRebuilt.load();
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "Definitions loaded in %.2f ms (%i from cache, %i parsed from XML)",
+		definitionsSeconds * 1000.0, numCachesLoaded, numCachesRebuilt ) );
+
+	// into the log file too, so a cold run and a warm run can be compared afterwards
+	char const* cacheState = numCachesRebuilt == 0 ? "warm" : ( numCachesLoaded == 0 ? "cold" : "partly warm" );
+	LOG_INFO( "Definitions", "Loaded with a %s cache in %.2f ms: renderer defs %.2f ms, parse + image decode %.2f ms, link %.2f ms", cacheState,
+		definitionsSeconds * 1000.0, mainThreadSeconds * 1000.0, parseSeconds * 1000.0, ( definitionsSeconds - parseSeconds ) * 1000.0 );
+	g_theConsole->PrintString( Rgba8::WHITE, Stringf( "  renderer defs %.2f ms, parse + image decode %.2f ms, link %.2f ms",
+		mainThreadSeconds * 1000.0, parseSeconds * 1000.0, ( definitionsSeconds - parseSeconds ) * 1000.0 ) );
+}
+
+//------------------------------------------------------------------------
+// start of the frame, before anything reads a definition
+void Game::UpdateDefinitionHotReload()
+{
+	if( m_definitionWatcher == nullptr )
+	{
+		return;
+	}
+
+	std::vector<FileChange> changes;
+	m_definitionWatcher->GetChangedFiles( changes );
+	for( const FileChange& change : changes )
+	{
+		if( change.m_wasRemoved )
+		{
+			g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "%s was removed, its definitions stay loaded", change.m_filePath.c_str() ) );
+			continue;
+		}
+		ReloadDefinitionFile( change.m_filePath, change.m_writtenSeconds );
+	}
+}
+
+bool Game::ReloadDefinitionFile( const std::string& filePath, double writtenSeconds )
+{
+	MEMORY_TAG_SCOPE( MEMORY_TAG_DEFINITIONS );
+	double reloadStartSeconds = GetCurrentTimeSeconds();
+	const std::string cutscenesFolderPath = "Data/Definitions/Cutscenes/";
+	Map* currentMap = m_world != nullptr ? m_world->GetCurrentMap() : nullptr;
+
+	int numReloaded = 0;
+	if( filePath.compare( 0, cutscenesFolderPath.size(), cutscenesFolderPath ) == 0 )
+	{
+		numReloaded = CutsceneDefinition::ReloadDefinition( cutscenesFolderPath, filePath.substr( cutscenesFolderPath.size() ) );
+
+		// a playing cutscene may have lost lines, and a new one may be one a map was already asking for
+		if( currentMap != nullptr && currentMap->m_cutscenePlayer.m_currentCutscene != nullptr )
+		{
+			CutscenePlayer& cutscenePlayer = currentMap->m_cutscenePlayer;
+			int numLines = (int)cutscenePlayer.m_currentCutscene->m_lines.size();
+			cutscenePlayer.m_currentLineIndex = cutscenePlayer.m_currentLineIndex < numLines ? cutscenePlayer.m_currentLineIndex : numLines - 1;
+		}
+		MapDefinition::LinkDefinitions( g_theRenderer );
+	}
+	else if( filePath == "Data/Definitions/ActorDefs.xml" )
+	{
+		numReloaded = ActorDefinition::ReloadDefinitions( filePath );
+		MapDefinition::LinkDefinitions( g_theRenderer );
+	}
+	else if( filePath == "Data/Definitions/MapDefs.xml" )
+	{
+		numReloaded = MapDefinition::ReloadDefinitions( g_theRenderer, filePath );
+	}
+	else
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, Stringf( "%s can't be hot reloaded, restart to pick it up", filePath.c_str() ) );
+		return false;
+	}
+
+	if( numReloaded < 0 )
+	{
+		LOG_WARNING( "Definitions", "Couldn't parse %s, kept the old definitions", filePath );
+		return false;
+	}
+
+	double reloadedSeconds = GetCurrentTimeSeconds();
+	double reloadMilliseconds = ( reloadedSeconds - reloadStartSeconds ) * 1000.0;
+	double latencyMilliseconds = ( reloadedSeconds - writtenSeconds ) * 1000.0;
+	g_theConsole->PrintString( Rgba8::GREEN, Stringf( "Reloaded %s: %i definitions in %.2f ms, %.0f ms after it was saved", filePath.c_str(), numReloaded, reloadMilliseconds, latencyMilliseconds ) );
+	LOG_INFO( "Definitions", "Reloaded %s: %i definitions in %.2f ms, %.0f ms after it was saved", filePath, numReloaded, reloadMilliseconds, latencyMilliseconds );
+	if( currentMap != nullptr && filePath == "Data/Definitions/MapDefs.xml" )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, "The current map keeps its old layout until restart_map" );
+	}
+	return true;
+}
+
+COMMAND( reload_definitions, "Reload every map, actor and cutscene definition file now, without waiting for a save.", "" )
+{
+	UNUSED( args );
+	// cutscenes and actors first, so the maps link against the new ones
+	Strings filePaths;
+	for( const std::string& fileName : GetFileNamesInFolder( "Data/Definitions/Cutscenes", "*.xml" ) )
+	{
+		filePaths.push_back( "Data/Definitions/Cutscenes/" + fileName );
+	}
+	filePaths.push_back( "Data/Definitions/ActorDefs.xml" );
+	filePaths.push_back( "Data/Definitions/MapDefs.xml" );
+	for( const std::string& filePath : filePaths )
+	{
+		g_theGame->ReloadDefinitionFile( filePath, GetCurrentTimeSeconds() );
+	}
+}
+
 COMMAND( megumin, "Megumin will appear on console.", "" )
 {
 	UNUSED(args);
@@ -13,6 +13,7 @@ class World;
 class Map;
 class SpriteAnimDefinition;
 class ParticleSystem;
+class FileWatcher;
 
 class Game
 {
@@ -44,6 +45,9 @@ public:
 	Map* GetCurrentMap() const;
 	Camera* GetWorldCamera() const { return m_worldCamera; }
 	void LoadAllAudio( const char* folderPath ) const;
+	void LoadAllDefinitions() const;
+	void UpdateDefinitionHotReload();
+	bool ReloadDefinitionFile( const std::string& filePath, double writtenSeconds );	// false if it isn't hot reloadable or didn't parse
 
 public:
 	RandomNumberGenerator m_rng;
@@ -66,4 +70,5 @@ private:
 	SpriteAnimDefinition* m_bgAnim = nullptr;
 	SoundPlaybackID m_currentAudio;
 	ParticleSystem* m_particleSystem = nullptr;
+	FileWatcher* m_definitionWatcher = nullptr;		// Data/Definitions, null in packed builds
 };
\ No newline at end of file
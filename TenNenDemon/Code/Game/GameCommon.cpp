@@ -1,5 +1,16 @@
 #include "GameCommon.hpp"
 #include "Game.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+GameConfigSlots g_gameConfigSlots;
+
+void ResolveGameConfigSlots()
+{
+	g_gameConfigSlots.m_imgFilePrefix = g_gameConfigBlackboard.ResolveSlot( "imgFilePrefix" );
+	g_gameConfigSlots.m_startMap = g_gameConfigBlackboard.ResolveSlot( "startMap" );
+	g_gameConfigSlots.m_soundVolume = g_gameConfigBlackboard.ResolveSlot( "soundVolume" );
+	g_gameConfigSlots.m_hotReloadDefinitions = g_gameConfigBlackboard.ResolveSlot( "hotReloadDefinitions" );
+}
 
 void DrawLine( const Vec2& startVec2, const Vec2& endVec2, const Rgba8& color, float thickness )
 {
@@ -89,7 +100,8 @@ void AppendVertsForAABB2D( std::vector<Vertex_PCU>& vertVector, const AABB2& loc
 	vertVector.push_back( Vertex_PCU( Vec3( maxVec2.x, maxVec2.y, 0.f ), color, Vec2( 1.f, 1.f ) ) );
 }
 
-void AddVertsForAABB2( std::vector<Vertex_PCU>& verts, const AABB2& localBounds, const Rgba8& color, const Vec2& uvMins, const Vec2& uvMaxs )
+template <typename VERTEX_ALLOCATOR>
+void AddVertsForAABB2( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, const AABB2& localBounds, const Rgba8& color, const Vec2& uvMins, const Vec2& uvMaxs )
 {
 	Vec2 minVec2 = localBounds.mins;
 	Vec2 maxVec2 = localBounds.maxs;
@@ -102,3 +114,6 @@ void AddVertsForAABB2( std::vector<Vertex_PCU>& verts, const AABB2& localBounds,
 	verts.push_back( Vertex_PCU( Vec3( minVec2.x, maxVec2.y, 0.f ), color, Vec2( uvMins.x, uvMaxs.y ) ) );
 	verts.push_back( Vertex_PCU( Vec3( maxVec2.x, maxVec2.y, 0.f ), color, Vec2( uvMaxs.x, uvMaxs.y ) ) );
 }
+
+template void AddVertsForAABB2( std::vector<Vertex_PCU>& verts, const AABB2& localBounds, const Rgba8& color, const Vec2& uvMins, const Vec2& uvMaxs );
+template void AddVertsForAABB2( FrameVector<Vertex_PCU>& verts, const AABB2& localBounds, const Rgba8& color, const Vec2& uvMins, const Vec2& uvMaxs );
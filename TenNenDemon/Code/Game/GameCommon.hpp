@@ -7,6 +7,7 @@
 #include "Engine/Input/XboxController.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
 
 #define VK_LEFT           0x25
 #define VK_UP             0x26
@@ -49,6 +50,17 @@ extern bool g_isDebugMode;
 extern bool g_isDebugCamera;
 extern eGameState g_gameState;
 
+// GameConfig.xml keys the game reads, resolved once so lookups skip the key map
+struct GameConfigSlots
+{
+	NamedStringSlot m_imgFilePrefix;
+	NamedStringSlot m_startMap;
+	NamedStringSlot m_soundVolume;
+	NamedStringSlot m_hotReloadDefinitions;
+};
+extern GameConfigSlots g_gameConfigSlots;
+void ResolveGameConfigSlots();
+
 constexpr float SCREEN_ASPECT = 2.f;
 constexpr float UI_SIZE_X = 1600.f;
 constexpr float UI_SIZE_Y = 800.f;
@@ -78,4 +90,5 @@ const Vec3 CAMERA_START_POSITION = Vec3::ZERO;
 void DrawLine( const Vec2& startVec2, const Vec2& endVec2, const Rgba8& color, float thickness );
 void DrawRing( const Vec2& centerVec2, float radius, const Rgba8& color, float thickness );
 void AppendVertsForAABB2D( std::vector<Vertex_PCU>& vertVector, const AABB2& localBounds, const Rgba8& color );
-void AddVertsForAABB2( std::vector<Vertex_PCU>& verts, const AABB2& localBounds, const Rgba8& color, const Vec2& uvMins, const Vec2& uvMaxs );
\ No newline at end of file
+template <typename VERTEX_ALLOCATOR>
+void AddVertsForAABB2( std::vector<Vertex_PCU, VERTEX_ALLOCATOR>& verts, const AABB2& localBounds, const Rgba8& color, const Vec2& uvMins, const Vec2& uvMaxs );	// std::vector and FrameVector
\ No newline at end of file
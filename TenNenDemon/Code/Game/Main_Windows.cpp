@@ -28,16 +28,16 @@ constexpr float CLIENT_ASPECT = 2.0f;
 int WINAPI WinMain( _In_ HINSTANCE applicationInstanceHandle, _In_opt_ HINSTANCE , _In_ LPSTR commandLineString, _In_ int )
 {
 	UNUSED( applicationInstanceHandle );
-	UNUSED( commandLineString );
+	AppLaunchOptions launchOptions = ParseAppLaunchOptions( commandLineString );
 
 	g_gameConfigBlackboard.PopulateFromXmlFile( "Data/GameConfig.xml" );
 	g_theWindow = new Window();
 
-	g_theWindow->Open( g_gameConfigBlackboard.GetValue( "appName", APP_NAME ), g_gameConfigBlackboard.GetValue( "windowAspect", CLIENT_ASPECT ), 0.9f );
+	g_theWindow->Open( g_gameConfigBlackboard.GetValue( "appName", APP_NAME ), g_gameConfigBlackboard.GetValue( "windowAspect", CLIENT_ASPECT ), 0.9f, !launchOptions.m_isHeadless );
 
 	//TheApp_Startup( applicationInstanceHandle, commandLineString );
 	g_theApp = new App();
-	g_theApp->Startup();
+	g_theApp->Startup( launchOptions );
 
 	// Program main loop; keep running frames until it's time to quit
 	while( !g_theApp->IsQuitting() )
@@ -47,6 +47,7 @@ int WINAPI WinMain( _In_ HINSTANCE applicationInstanceHandle, _In_opt_ HINSTANCE
 	}
 
 	g_theApp->Shutdown();
+	int exitCode = g_theApp->GetExitCode();
 	delete g_theApp;
 	g_theApp = nullptr;
 
@@ -54,5 +55,5 @@ int WINAPI WinMain( _In_ HINSTANCE applicationInstanceHandle, _In_opt_ HINSTANCE
 	delete g_theWindow;
 	g_theWindow = nullptr;
 
-	return 0;
+	return exitCode;
 }
@@ -21,6 +21,7 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Timer.hpp"
+#include "Engine/Core/Profiler.hpp"
 
 Map::Map( Game* game, const std::string& name )
 	:m_game( game ),
@@ -43,10 +44,10 @@ Map::Map( Game* game, const std::string& name )
 		SpawnNewEnvironmentEntity( GetTileCenterPosition( def->m_startIndex ), def, def->m_entityType );
 	}
 
-	SpriteSheet* spriteSheet = new SpriteSheet( *g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Cutscenes/booper_spritesheet_7x4.png" ), IntVec2( 7, 4 ) );
-	m_cutscenePlayer.m_booperAnim = new SpriteAnimDefinition( *spriteSheet, 0, 14, 1.f, SpriteAnimPlaybackType::LOOP );
-	SpriteSheet* spriteSheet2 = new SpriteSheet( *g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/UI/success_spritesheet_2x8.png" ), IntVec2( 2, 8 ) );
-	m_successAnim = new SpriteAnimDefinition( *spriteSheet2, 0, 7, 0.8f, SpriteAnimPlaybackType::ONCE );
+	m_booperSpriteSheet = new SpriteSheet( *g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Cutscenes/booper_spritesheet_7x4.png" ), IntVec2( 7, 4 ) );
+	m_cutscenePlayer.m_booperAnim = new SpriteAnimDefinition( *m_booperSpriteSheet, 0, 14, 1.f, SpriteAnimPlaybackType::LOOP );
+	m_successSpriteSheet = new SpriteSheet( *g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/UI/success_spritesheet_2x8.png" ), IntVec2( 2, 8 ) );
+	m_successAnim = new SpriteAnimDefinition( *m_successSpriteSheet, 0, 7, 0.8f, SpriteAnimPlaybackType::ONCE );
 
 	m_playerDust = m_particleSystem->CreateEmitter();
 	m_playerDust->m_color = Rgba8( 66, 26, 2 );
@@ -56,10 +57,22 @@ Map::Map( Game* game, const std::string& name )
 	m_playerDust->m_scale = Vec3( 0.1f, 0.1f, 1.f );
 	m_playerDust->m_velocity = 0.5f;
 	m_playerDust->m_interval = 0.005f;
+	m_playerDust->SetCapacity( 256, PARTICLE_OVERFLOW_DROP );
 }
 
 Map::~Map()
 {
+	delete m_cutscenePlayer.m_booperAnim;
+	m_cutscenePlayer.m_booperAnim = nullptr;
+	delete m_successAnim;
+	m_successAnim = nullptr;
+	delete m_booperSpriteSheet;
+	m_booperSpriteSheet = nullptr;
+	delete m_successSpriteSheet;
+	m_successSpriteSheet = nullptr;
+
+	// only one map is alive at a time, nothing points at reloaded-away definitions past this
+	MapDefinition::FreeRetiredEnvironmentEntities();
 }
 
 Entity* Map::SpawnNewEntity( const std::string& name, const Vec2& pos, eEntityType entityType )
@@ -515,6 +528,7 @@ Vec2 Map::GetTileCenterPosition( int tileX, int tileY ) const
 
 void Map::Update( float deltaSeconds )
 {
+	PROFILE_SCOPE( "Map::Update" );
 	if( m_cutscenePlayer.m_isPlayingCutscene )
 	{
 		UpdateCutscene( deltaSeconds );
@@ -606,7 +620,9 @@ void CutscenePlayer::NextCutsceneLine()
 		m_isPlayingCutscene = false;
 		if ( "" != m_afterPlayingEventName )
 		{
-			g_theEventSystem->FireEvent( m_afterPlayingEventName );
+			// deferred, the event may tear down this map
+			g_theEventSystem->QueueEvent( m_afterPlayingEventName );
+			m_isWaitingForAfterPlayingEvent = true;
 		}
 	}
 }
@@ -11,6 +11,7 @@ class MapDefinition;
 class EnvironmentEntityDefinition;
 class CutsceneDefinition;
 class SpriteAnimDefinition;
+class SpriteSheet;
 class ParticleSystem;
 class Emitter;
 
@@ -21,6 +22,7 @@ public:
 	bool						m_isPlayingCutscene = false;
 	int							m_currentLineIndex = 0;
 	std::string					m_afterPlayingEventName = "";
+	bool						m_isWaitingForAfterPlayingEvent = false;
 	std::string					m_line = "";
 	SpriteAnimDefinition*		m_booperAnim = nullptr;
 	float						m_age = 0.f;
@@ -98,6 +100,8 @@ public:
 	CutscenePlayer m_cutscenePlayer;
 	Timer* m_successTimer = nullptr;
 	SpriteAnimDefinition* m_successAnim = nullptr;
+	SpriteSheet* m_booperSpriteSheet = nullptr;
+	SpriteSheet* m_successSpriteSheet = nullptr;
 	ParticleSystem* m_particleSystem = nullptr;
 	Emitter* m_playerDust = nullptr;
 };
\ No newline at end of file
@@ -5,18 +5,62 @@
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Renderer/SpriteDefinition.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
+#include "Engine/Core/DefinitionCache.hpp"
+#include <algorithm>
 
-STATIC std::map< std::string, MapDefinition* > MapDefinition::s_definitionMap;
+STATIC StringIDMap<MapDefinition*> MapDefinition::s_definitionMap;
+STATIC std::vector<EnvironmentEntityDefinition*> MapDefinition::s_retiredEnvironmentEntities;
+constexpr unsigned int MAP_DEFS_CACHE_VERSION = 1;		// bump whenever AppendToBuffer changes
 
-STATIC void MapDefinition::LoadDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath )
+STATIC void MapDefinition::ParseDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath )
 {
+	// actors and cutscenes are stored by name and only looked up when linking, so their own edits don't matter here
+	DefinitionCache cache( "MapDefs", MAP_DEFS_CACHE_VERSION );
+	cache.AddSourceFile( deinitionsXmlFilePath );
+	if( cache.Load() )
+	{
+		BufferParser& parser = cache.GetParser();
+		int numDefinitions = parser.ParseInt32();
+		for( int definitionIndex = 0; definitionIndex < numDefinitions; definitionIndex++ )
+		{
+			MapDefinition* newMapDef = new MapDefinition( context, parser );
+			s_definitionMap[InternStringID( newMapDef->m_name )] = newMapDef;
+		}
+		return;
+	}
+
+	for( MapDefinition* newMapDef : ParseDefinitionsFile( context, deinitionsXmlFilePath ) )
+	{
+		s_definitionMap[InternStringID( newMapDef->m_name )] = newMapDef;
+	}
+
+	BufferWriter& writer = cache.GetWriter();
+	writer.AppendInt32( (int)s_definitionMap.size() );
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->AppendToBuffer( writer );
+	}
+	cache.Save();
+}
+
+STATIC void MapDefinition::LinkDefinitions( RenderContext* context )
+{
+	for( const auto& definition : s_definitionMap )
+	{
+		definition.second->Link( context );
+	}
+}
+
+STATIC std::vector<MapDefinition*> MapDefinition::ParseDefinitionsFile( RenderContext* context, const std::string& deinitionsXmlFilePath )
+{
+	std::vector<MapDefinition*> mapDefs;
 	XmlDocument mapXmlDoc;
-	mapXmlDoc.LoadFile( &deinitionsXmlFilePath[0] );
+	LoadXmlDocumentFromFile( mapXmlDoc, deinitionsXmlFilePath );
 	XmlElement* mapDefsElement = mapXmlDoc.RootElement();
 	if( mapDefsElement == nullptr )
 	{
 		g_theConsole->PrintString( Rgba8::RED, "WARNING: Map definitions file not found" );
-		return;
+		return mapDefs;
 	}
 
 	XmlElement* legendElement = mapDefsElement->FirstChildElement( "Legend" );
@@ -26,27 +70,63 @@ STATIC void MapDefinition::LoadDefinitions( RenderContext* context, const std::s
 	XmlElement* mapDefElement = mapDefsElement->FirstChildElement("MapDefinition");
 	while( mapDefElement )
 	{
-		MapDefinition* newMapDef = new MapDefinition( context, *mapDefElement, legendMap );
-		s_definitionMap[newMapDef->m_name] = newMapDef;
+		mapDefs.push_back( new MapDefinition( context, *mapDefElement, legendMap ) );
 		mapDefElement = mapDefElement->NextSiblingElement("MapDefinition");
 	}
+	return mapDefs;
 }
 
-STATIC MapDefinition* MapDefinition::GetDefinitions( const std::string& mapName )
+STATIC int MapDefinition::ReloadDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath )
+{
+	// a file caught half saved parses as nothing, keep what was there
+	std::vector<MapDefinition*> reloadedMapDefs = ParseDefinitionsFile( context, deinitionsXmlFilePath );
+	if( reloadedMapDefs.empty() )
+	{
+		return -1;
+	}
+
+	context->FinishQueuedTextures();
+	for( MapDefinition* reloadedMapDef : reloadedMapDefs )
+	{
+		MapDefinition*& mapDef = s_definitionMap[InternStringID( reloadedMapDef->m_name )];
+		if( mapDef == nullptr )
+		{
+			mapDef = reloadedMapDef;
+		}
+		else
+		{
+			// live maps hold on to the old object, so the new contents move into it.
+			// their entities still point at the old environment entity definitions, those wait until the map goes
+			s_retiredEnvironmentEntities.insert( s_retiredEnvironmentEntities.end(), mapDef->m_environmentEntities.begin(), mapDef->m_environmentEntities.end() );
+			*mapDef = std::move( *reloadedMapDef );
+			delete reloadedMapDef;
+		}
+		mapDef->Link( context );
+	}
+	return (int)reloadedMapDefs.size();
+}
+
+STATIC void MapDefinition::FreeRetiredEnvironmentEntities()
 {
-	if( s_definitionMap.count( mapName ) > 0 )
+	for( EnvironmentEntityDefinition* entityDef : s_retiredEnvironmentEntities )
 	{
-		return s_definitionMap.at( mapName );
+		delete entityDef;
 	}
-	return nullptr;
+	s_retiredEnvironmentEntities.clear();
+}
+
+STATIC MapDefinition* MapDefinition::GetDefinitions( const std::string& mapName )
+{
+	auto found = s_definitionMap.find( HashStringID( mapName ) );
+	return found != s_definitionMap.end() ? found->second : nullptr;
 }
 
 STATIC Strings MapDefinition::GetAllMapNames()
 {
 	Strings mapNames;
-	for( std::map< std::string, MapDefinition* >::iterator it = s_definitionMap.begin(); it != s_definitionMap.end(); ++it )
+	for( MapDefinition* mapDef : GetAllMapDefs() )
 	{
-		mapNames.push_back( it->first );
+		mapNames.push_back( mapDef->m_name );
 	}
 	return mapNames;
 }
@@ -54,11 +134,13 @@ STATIC Strings MapDefinition::GetAllMapNames()
 STATIC const std::vector<MapDefinition*> MapDefinition::GetAllMapDefs()
 {
 	std::vector<MapDefinition*> mapDefs;
-
-	for( std::map< std::string, MapDefinition* >::iterator it = s_definitionMap.begin(); it != s_definitionMap.end(); ++it )
+	for( const auto& definition : s_definitionMap )
 	{
-		mapDefs.push_back( it->second );
+		mapDefs.push_back( definition.second );
 	}
+
+	// level select lists them in name order, the registry is unordered
+	std::sort( mapDefs.begin(), mapDefs.end(), []( const MapDefinition* a, const MapDefinition* b ) { return a->m_name < b->m_name; } );
 	return mapDefs;
 }
 
@@ -69,7 +151,8 @@ MapDefinition::MapDefinition( RenderContext* context, const XmlElement& mapDefEl
 	m_dimensions = ParseXmlAttribute( mapDefElement, "dimensions", m_dimensions );
 	m_mapStartPoint = ParseXmlAttribute( mapDefElement, "mapStartPoint", Vec2::ZERO );
 	std::string bgImageText = ParseXmlAttribute( mapDefElement, "backgroundImage", "" );
-	m_backgroundImage = context->CreateOrGetTextureFromFile( Stringf( "Data/Images/%s.png", bgImageText.c_str() ).c_str() );
+	m_backgroundImageFilePath = Stringf( "Data/Images/%s.png", bgImageText.c_str() );
+	context->QueueTextureFromFile( m_backgroundImageFilePath );
 
 	// Map Setup
 	const XmlElement* mapSetUpElement = mapDefElement.FirstChildElement( "MapSetUp" );
@@ -98,15 +181,13 @@ MapDefinition::MapDefinition( RenderContext* context, const XmlElement& mapDefEl
 		const XmlElement* beforeLevelElement = cutscenesElement->FirstChildElement( "BeforeLevel" );
 		if ( beforeLevelElement )
 		{
-			std::string beforeLevelStr = ParseXmlAttribute( *beforeLevelElement, "name", "" );
-			m_beforeLevelCutscene = CutsceneDefinition::GetDefinitions( beforeLevelStr );
+			m_beforeLevelCutsceneName = ParseXmlAttribute( *beforeLevelElement, "name", "" );
 		}
 
 		const XmlElement* afterLevelElement = cutscenesElement->FirstChildElement( "AfterLevel" );
 		if ( afterLevelElement )
 		{
-			std::string afterLevelStr = ParseXmlAttribute( *afterLevelElement, "name", "" );
-			m_afterLevelCutscene = CutsceneDefinition::GetDefinitions( afterLevelStr );
+			m_afterLevelCutsceneName = ParseXmlAttribute( *afterLevelElement, "name", "" );
 		}
 	}
 
@@ -147,10 +228,69 @@ MapDefinition::MapDefinition( RenderContext* context, const XmlElement& mapDefEl
 	}
 }
 
+MapDefinition::MapDefinition( RenderContext* context, BufferParser& parser )
+{
+	m_name = parser.ParseString();
+	m_levelName = parser.ParseString();
+	m_nextLevelName = parser.ParseString();
+	m_dimensions = parser.ParseIntVec2();
+	m_playerStartIndex = parser.ParseIntVec2();
+	m_petStartIndex = parser.ParseIntVec2();
+	m_mapStartPoint = parser.ParseVec2();
+	m_backgroundImageFilePath = parser.ParseString();
+	context->QueueTextureFromFile( m_backgroundImageFilePath );
+	m_startAbilityLimitNumber = parser.ParseInt32();
+	m_beforeLevelCutsceneName = parser.ParseString();
+	m_afterLevelCutsceneName = parser.ParseString();
+
+	int numEntities = parser.ParseInt32();
+	for( int entityIndex = 0; entityIndex < numEntities; entityIndex++ )
+	{
+		std::string name = parser.ParseString();
+		IntVec2 startIndex = parser.ParseIntVec2();
+		eEntityType type = (eEntityType)parser.ParseByte();
+		m_environmentEntities.push_back( new EnvironmentEntityDefinition( name, startIndex, type ) );
+	}
+}
+
 MapDefinition::~MapDefinition()
 {
 }
 
+void MapDefinition::Link( RenderContext* context )
+{
+	m_backgroundImage = context->CreateOrGetTextureFromFile( m_backgroundImageFilePath.c_str() );
+	m_beforeLevelCutscene = CutsceneDefinition::GetDefinitions( m_beforeLevelCutsceneName );
+	m_afterLevelCutscene = CutsceneDefinition::GetDefinitions( m_afterLevelCutsceneName );
+	for( EnvironmentEntityDefinition* entityDef : m_environmentEntities )
+	{
+		entityDef->m_actorDef = ActorDefinition::GetDefinitions( entityDef->m_actorName );
+	}
+}
+
+void MapDefinition::AppendToBuffer( BufferWriter& writer ) const
+{
+	writer.AppendString( m_name );
+	writer.AppendString( m_levelName );
+	writer.AppendString( m_nextLevelName );
+	writer.AppendIntVec2( m_dimensions );
+	writer.AppendIntVec2( m_playerStartIndex );
+	writer.AppendIntVec2( m_petStartIndex );
+	writer.AppendVec2( m_mapStartPoint );
+	writer.AppendString( m_backgroundImageFilePath );
+	writer.AppendInt32( m_startAbilityLimitNumber );
+	writer.AppendString( m_beforeLevelCutsceneName );
+	writer.AppendString( m_afterLevelCutsceneName );
+
+	writer.AppendInt32( (int)m_environmentEntities.size() );
+	for( const EnvironmentEntityDefinition* entityDef : m_environmentEntities )
+	{
+		writer.AppendString( entityDef->m_actorName );
+		writer.AppendIntVec2( entityDef->m_startIndex );
+		writer.AppendByte( (unsigned char)entityDef->m_entityType );
+	}
+}
+
 STATIC void MapDefinition::InitialLegend( std::map<char, std::string>& out, const XmlElement& legendElement )
 {
 	for ( const XmlElement* entityElement = legendElement.FirstChildElement("Entity"); entityElement; entityElement = entityElement->NextSiblingElement("Entity") )
@@ -1,6 +1,7 @@
 #pragma once
 #include "Game/EntityDefinition.hpp"
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/StringID.hpp"
 #include <map>
 #include <vector>
 
@@ -12,17 +13,28 @@ class CutsceneDefinition;
 class MapDefinition
 {
 public:
-	static std::map< std::string, MapDefinition* >	s_definitionMap;
+	static StringIDMap<MapDefinition*>	s_definitionMap;
+	static std::vector<EnvironmentEntityDefinition*>	s_retiredEnvironmentEntities;	// replaced by a reload, live entities may still point at them
 
-	static void LoadDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath );
+	static void ParseDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath );	// any thread, touches nothing but this registry
+	static void LinkDefinitions( RenderContext* context );		// main thread, after actors and cutscenes are linked and the queued textures are finished
 	static MapDefinition* GetDefinitions( const std::string& mapName );
 
+	static std::vector<MapDefinition*> ParseDefinitionsFile( RenderContext* context, const std::string& deinitionsXmlFilePath );	// any thread, straight from XML and not registered
+	static int ReloadDefinitions( RenderContext* context, const std::string& deinitionsXmlFilePath );	// main thread, patches same named defs in place; -1 if the file didn't parse
+
+	static void FreeRetiredEnvironmentEntities();		// once no map is alive
 	static Strings GetAllMapNames();
 	static const std::vector<MapDefinition*> GetAllMapDefs();
 
 public:
 	MapDefinition( RenderContext* context, const XmlElement& mapDefElement, const std::map<char, std::string>& legendMap );
+	MapDefinition( RenderContext* context, BufferParser& parser );
 	~MapDefinition();
+	MapDefinition& operator=( MapDefinition&& moveFrom ) = default;	// how a reload patches a live def
+
+	void Link( RenderContext* context );		// main thread, textures, cutscenes and actors by name
+	void AppendToBuffer( BufferWriter& writer ) const;
 
 	static void InitialLegend( std::map<char, std::string>& out, const XmlElement& legendElement );
 
@@ -34,9 +46,12 @@ public:
 	IntVec2							m_playerStartIndex = IntVec2::ZERO;
 	IntVec2							m_petStartIndex = IntVec2(2,2);
 	Vec2							m_mapStartPoint = Vec2::ZERO;
+	std::string						m_backgroundImageFilePath = "";
 	Texture*						m_backgroundImage = nullptr;
 	int								m_startAbilityLimitNumber = 5;
 	std::vector<EnvironmentEntityDefinition*>	m_environmentEntities;
+	std::string						m_beforeLevelCutsceneName = "";
+	std::string						m_afterLevelCutsceneName = "";
 	CutsceneDefinition*				m_beforeLevelCutscene = nullptr;
 	CutsceneDefinition*				m_afterLevelCutscene = nullptr;
 
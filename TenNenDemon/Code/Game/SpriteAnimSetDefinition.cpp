@@ -1,32 +1,103 @@
 #include "SpriteAnimSetDefinition.hpp"
 #include "GameCommon.hpp"
+#include "Engine/Core/BufferUtils.hpp"
 
 SpriteAnimSetDefinition::SpriteAnimSetDefinition( const XmlElement* spriteAnimSetElement )
 {
-	IntVec2 spriteLayout = ParseXmlAttribute( *spriteAnimSetElement, "spriteLayout", IntVec2::ONE );
+	m_spriteLayout = ParseXmlAttribute( *spriteAnimSetElement, "spriteLayout", IntVec2::ONE );
 	float defaultFPS = ParseXmlAttribute( *spriteAnimSetElement, "fps", 10.f );
-	std::string filePath = Stringf( "%s%s", g_gameConfigBlackboard.GetValue( "imgFilePrefix", "Data/Images/" ).c_str(), ParseXmlAttribute( *spriteAnimSetElement, "spriteSheet", "" ).c_str() );
-	Texture* texture = g_theRenderer->CreateOrGetTextureFromFile( &filePath[0] );
-	SpriteSheet* spriteSheet = new SpriteSheet( *texture, spriteLayout );
+	m_spriteSheetFilePath = Stringf( "%s%s", g_gameConfigBlackboard.GetValue( g_gameConfigSlots.m_imgFilePrefix, "Data/Images/" ).c_str(), ParseXmlAttribute( *spriteAnimSetElement, "spriteSheet", "" ).c_str() );
+	g_theRenderer->QueueTextureFromFile( m_spriteSheetFilePath );
 
 	const XmlElement* spriteAnimElement = spriteAnimSetElement->FirstChildElement();
 	while( spriteAnimElement )
 	{
-		std::string name = ParseXmlAttribute( *spriteAnimElement, "name", "UNNAMED" );
-		Strings spriteIndexes = SplitStringOnDelimiter( ParseXmlAttribute( *spriteAnimElement, "spriteIndexes", "0" ), ',' );
-		std::vector<int> spriteIndexList;
-		for (std::string numStr : spriteIndexes)
+		SpriteAnimRecord animRecord;
+		animRecord.m_name = ParseXmlAttribute( *spriteAnimElement, "name", "UNNAMED" );
+		std::string spriteIndexes = ParseXmlAttribute( *spriteAnimElement, "spriteIndexes", "0" );
+		for( std::string_view numText : SplitStringView( spriteIndexes, ',' ) )
 		{
-			spriteIndexList.push_back( atoi( &numStr[0] ) );
+			int spriteIndex = 0;
+			Parse( &spriteIndex, numText );
+			animRecord.m_spriteIndexes.push_back( spriteIndex );
 		}
 		float fps = ParseXmlAttribute( *spriteAnimElement, "fps", defaultFPS );
 		float frameSec = 1.f / fps;
-		SpriteAnimDefinition* animDef = new SpriteAnimDefinition( *spriteSheet, spriteIndexList, (int) spriteIndexList.size() * frameSec, SpriteAnimPlaybackType::LOOP );
-		m_spriteAnims[name] = animDef;
+		animRecord.m_durationSeconds = (int) animRecord.m_spriteIndexes.size() * frameSec;
+		m_animRecords.push_back( animRecord );
 		spriteAnimElement = spriteAnimElement->NextSiblingElement();
 	}
 }
 
+SpriteAnimSetDefinition::SpriteAnimSetDefinition( BufferParser& parser )
+{
+	m_spriteSheetFilePath = parser.ParseString();
+	m_spriteLayout = parser.ParseIntVec2();
+	g_theRenderer->QueueTextureFromFile( m_spriteSheetFilePath );
+
+	m_animRecords.resize( (size_t)parser.ParseInt32() );
+	for( SpriteAnimRecord& animRecord : m_animRecords )
+	{
+		animRecord.m_name = parser.ParseString();
+		animRecord.m_durationSeconds = parser.ParseFloat();
+		animRecord.m_playbackType = (SpriteAnimPlaybackType)parser.ParseByte();
+		animRecord.m_spriteIndexes.resize( (size_t)parser.ParseInt32() );
+		for( int& spriteIndex : animRecord.m_spriteIndexes )
+		{
+			spriteIndex = parser.ParseInt32();
+		}
+	}
+}
+
 SpriteAnimSetDefinition::~SpriteAnimSetDefinition()
 {
+	for( const auto& spriteAnim : m_spriteAnims )
+	{
+		delete spriteAnim.second;
+	}
+	m_spriteAnims.clear();
+	delete m_spriteSheet;
+	m_spriteSheet = nullptr;
+}
+
+bool SpriteAnimSetDefinition::HasAnimRecord( const std::string& animName ) const
+{
+	for( const SpriteAnimRecord& animRecord : m_animRecords )
+	{
+		if( animRecord.m_name == animName )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void SpriteAnimSetDefinition::CreateSpriteAnims()
+{
+	Texture* texture = g_theRenderer->CreateOrGetTextureFromFile( m_spriteSheetFilePath.c_str() );
+	m_spriteSheet = new SpriteSheet( *texture, m_spriteLayout );
+	for( const SpriteAnimRecord& animRecord : m_animRecords )
+	{
+		m_spriteAnims[InternStringID( animRecord.m_name )] = new SpriteAnimDefinition( *m_spriteSheet, animRecord.m_spriteIndexes, animRecord.m_durationSeconds, animRecord.m_playbackType );
+	}
+}
+
+void SpriteAnimSetDefinition::AppendToBuffer( BufferWriter& writer ) const
+{
+	writer.AppendString( m_spriteSheetFilePath );
+	writer.AppendIntVec2( m_spriteLayout );
+
+	// records keep their file order, the map would sort them by name
+	writer.AppendInt32( (int)m_animRecords.size() );
+	for( const SpriteAnimRecord& animRecord : m_animRecords )
+	{
+		writer.AppendString( animRecord.m_name );
+		writer.AppendFloat( animRecord.m_durationSeconds );
+		writer.AppendByte( (unsigned char)animRecord.m_playbackType );
+		writer.AppendInt32( (int)animRecord.m_spriteIndexes.size() );
+		for( int spriteIndex : animRecord.m_spriteIndexes )
+		{
+			writer.AppendInt32( spriteIndex );
+		}
+	}
 }
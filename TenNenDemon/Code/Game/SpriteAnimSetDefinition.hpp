@@ -1,16 +1,40 @@
 #pragma once
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/StringID.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
-#include <map>
 #include <string>
+#include <vector>
+
+class BufferWriter;
+class BufferParser;
+
+// what an anim was parsed as, kept so the set can be built and written out again later
+struct SpriteAnimRecord
+{
+	std::string				m_name;
+	float					m_durationSeconds = 1.f;
+	SpriteAnimPlaybackType	m_playbackType = SpriteAnimPlaybackType::LOOP;
+	std::vector<int>		m_spriteIndexes;
+};
 
 class SpriteAnimSetDefinition
 {
 public:
+	// both parse on any thread and only queue the sheet's texture, CreateSpriteAnims builds the rest
 	SpriteAnimSetDefinition( const XmlElement* spriteAnimSetElement );
+	SpriteAnimSetDefinition( BufferParser& parser );
 	~SpriteAnimSetDefinition();
 
+	void CreateSpriteAnims();		// main thread, once the queued textures are finished
+	bool HasAnimRecord( const std::string& animName ) const;
+	void AppendToBuffer( BufferWriter& writer ) const;
+
 public:
-	std::map< std::string, SpriteAnimDefinition* > m_spriteAnims;
+	std::string						m_spriteSheetFilePath;
+	IntVec2							m_spriteLayout = IntVec2::ONE;
+	std::vector<SpriteAnimRecord>	m_animRecords;
+
+	SpriteSheet* m_spriteSheet = nullptr;
+	StringIDMap<SpriteAnimDefinition*> m_spriteAnims;		// by STRING_ID of the anim name
 
-};
\ No newline at end of file
+};
@@ -30,7 +30,7 @@ void Tile::Render() const
 	{
 		Vec2 uvAtMins, uvAtMaxs;
 		tileDefinition->GetUVs( uvAtMins, uvAtMaxs );
-		std::vector<Vertex_PCU> verts;
+		FrameVector<Vertex_PCU> verts;
 		AddVertsForAABB2( verts, GetBounds(), tileDefinition->m_tint, uvAtMins, uvAtMaxs );
 		TransformVertexArray( (int)verts.size(), &verts[0], 1.f, 0.f, Vec2::ZERO );
 		g_theRenderer->BindTexture( g_theRenderer->CreateOrGetTextureFromFile( "Data/Images/Terrain_32x32.png" ) );
@@ -40,7 +40,7 @@ void Tile::Render() const
 
 void Tile::DebugModeRender() const
 {
-	std::vector<Vertex_PCU> verts;
+	FrameVector<Vertex_PCU> verts;
 	AABB2 tileRange = GetBounds();
 
 	Vec2 mousePos = g_theInput->GetMouseNormalizedClientPos();
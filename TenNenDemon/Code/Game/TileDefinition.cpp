@@ -11,7 +11,7 @@ STATIC std::map< std::string, TileDefinition* > TileDefinition::s_definitionMap;
 STATIC void TileDefinition::LoadDefinitions( const std::string& deinitionsXmlFilePath )
 {
 	XmlDocument tileXmlDoc;
-	tileXmlDoc.LoadFile( &deinitionsXmlFilePath[0] );
+	LoadXmlDocumentFromFile( tileXmlDoc, deinitionsXmlFilePath );
 	XmlElement* tileDefsElement = tileXmlDoc.RootElement();
 	if ( tileDefsElement == nullptr )
 	{
@@ -31,7 +31,7 @@ STATIC void TileDefinition::LoadDefinitions( const std::string& deinitionsXmlFil
 STATIC void TileDefinition::InitialTileSpriteSheet( const XmlElement& tileDefsElement )
 {
 	std::string spriteSheetFilePath = ParseXmlAttribute( tileDefsElement, "spriteSheet", "" );
-	spriteSheetFilePath = Stringf( "%s%s", g_gameConfigBlackboard.GetValue( "imgFilePrefix", "Data/Images/" ).c_str(), spriteSheetFilePath.c_str() );
+	spriteSheetFilePath = Stringf( "%s%s", g_gameConfigBlackboard.GetValue( g_gameConfigSlots.m_imgFilePrefix, "Data/Images/" ).c_str(), spriteSheetFilePath.c_str() );
 	IntVec2 spriteLayout = ParseXmlAttribute( tileDefsElement, "spriteLayout", IntVec2::ZERO );
 	g_tileSpriteSheet = new SpriteSheet( *g_theRenderer->CreateOrGetTextureFromFile( &spriteSheetFilePath[0] ), spriteLayout );
 }
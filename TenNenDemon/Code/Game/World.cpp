@@ -24,7 +24,7 @@ void World::Update( float deltaSeconds )
 	{
 		if( m_currentMap->m_successTimer->HasElapsed() )
 		{
-			if ( !m_currentMap->m_cutscenePlayer.IsPlayingCutscene() )
+			if ( !m_currentMap->m_cutscenePlayer.IsPlayingCutscene() && !m_currentMap->m_cutscenePlayer.m_isWaitingForAfterPlayingEvent )
 			{
 				if( m_currentMap->m_mapDef->m_afterLevelCutscene )
 				{
@@ -156,6 +156,39 @@ COMMAND( enter_map, "Enter map by name.", "name" )
 		return;
 	}
 	g_theGame->m_world->EnterMap( mapName );
+	if( g_gameState != PLAY_MODE )
+	{
+		g_theGame->ChangeGameState( PLAY_MODE );
+	}
+}
+
+COMMAND( restart_map, "Restart the current map without its cutscene, like pressing R.", "" )
+{
+	UNUSED( args );
+	if( g_gameState != PLAY_MODE || g_theGame->GetCurrentMap() == nullptr )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, "No map to restart" );
+		return;
+	}
+	g_theGame->m_world->RestartCurrentMap( false );
+}
+
+COMMAND( cast_fireball, "Cast fireballs from the player, ignoring the map's limit. e.g. cast_fireball direction=1,0 count=10", "direction,count" )
+{
+	Map* currentMap = g_theGame->GetCurrentMap();
+	if( g_gameState != PLAY_MODE || currentMap == nullptr )
+	{
+		g_theConsole->PrintString( Rgba8::YELLOW, "No map to cast fireballs in" );
+		return;
+	}
+
+	IntVec2 direction = args.GetValue( "direction", IntVec2( 1, 0 ) );
+	int numFireballs = args.GetValue( "count", 1 );
+	for( int fireballIndex = 0; fireballIndex < numFireballs; fireballIndex++ )
+	{
+		currentMap->m_abilityLimitNumber++;
+		currentMap->UseFireballAbility( direction );
+	}
 }
 
 COMMAND( next_map, "Go to next map.", "" )